@@ -98,7 +98,12 @@ bool ConcurrentHelper::IsModerateMemory()
 
 std::string ConcurrentHelper::GetCurrentTimeStampWithMS()
 {
-    auto tp = std::chrono::system_clock::now();
+    return GetTimeStampWithMS(GetMilliseconds());
+}
+
+std::string ConcurrentHelper::GetTimeStampWithMS(uint64_t milliseconds)
+{
+    std::chrono::system_clock::time_point tp {std::chrono::milliseconds(milliseconds)};
     auto timeVal = std::chrono::system_clock::to_time_t(tp);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()) % 1000; // 1000: modulo
     int outMs = static_cast<int>(ms.count());
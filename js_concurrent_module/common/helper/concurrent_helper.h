@@ -120,6 +120,8 @@ public:
     }
 
     static std::string GetCurrentTimeStampWithMS();
+    // milliseconds is the time since epoch, as returned by GetMilliseconds
+    static std::string GetTimeStampWithMS(uint64_t milliseconds);
 
 #if defined(OHOS_PLATFORM)
     static std::optional<double> GetSystemMemoryRatio();
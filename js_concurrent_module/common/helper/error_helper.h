@@ -144,6 +144,9 @@ public:
             case ERR_TASKGROUP_EXECUTE_TIMEOUT:
                 errTitle = "TaskGroup timed out.";
                 break;
+            case ERR_TASK_DEADLINE_EXCEEDED:
+                errTitle = "The deadline of the task has passed before it started.";
+                break;
             default:
                 break;
         }
@@ -321,6 +324,8 @@ public:
     static const int32_t ERR_TASKGROUP_EXECUTE_AGAIN = 10200059;
     // 10200070 : taskGroup timed out.
     static const int32_t ERR_TASKGROUP_EXECUTE_TIMEOUT = 10200070;
+    // 10200071 : The deadline of the task has passed before it started.
+    static const int32_t ERR_TASK_DEADLINE_EXCEEDED = 10200071;
 };
 } // namespace Commonlibrary::Concurrent::Common::Helper
 #endif // JS_CONCURRENT_MODULE_COMMON_HELPER_ERROR_HELPER_H
\ No newline at end of file
@@ -20,9 +20,11 @@
 #define HITRACE_HELPER_START_TRACE(msg) StartTrace(HITRACE_TAG_COMMONLIBRARY, msg)
 #define HITRACE_HELPER_FINISH_TRACE FinishTrace(HITRACE_TAG_COMMONLIBRARY)
 #define HITRACE_HELPER_COUNT_TRACE(msg, count) CountTrace(HITRACE_TAG_COMMONLIBRARY, msg, count)
+#define HITRACE_HELPER_IS_ENABLED IsTagEnabled(HITRACE_TAG_COMMONLIBRARY)
 #else
 #define HITRACE_HELPER_METER_NAME(msg)
 #define HITRACE_HELPER_START_TRACE(msg)
 #define HITRACE_HELPER_FINISH_TRACE
 #define HITRACE_HELPER_COUNT_TRACE(msg, count)
+#define HITRACE_HELPER_IS_ENABLED false
 #endif
\ No newline at end of file
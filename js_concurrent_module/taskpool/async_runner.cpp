@@ -14,17 +14,53 @@
  */
 #include "async_runner.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
+#include <cmath>
 #include "base_runner_manager.h"
 #include "async_runner_manager.h"
 #include "helper/error_helper.h"
 #include "helper/napi_helper.h"
+#include "helper/object_helper.h"
 #include "task_manager.h"
+#include "timer_wheel.h"
 #include "tools/log.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
 static constexpr char EXECUTE_STR[] = "execute";
+static constexpr char SET_RATE_LIMIT_STR[] = "setRateLimit";
+static constexpr char ON_BACKPRESSURE_STR[] = "onBackpressure";
+static constexpr char ON_DRAIN_STR[] = "onDrain";
+static constexpr char ON_WATERMARK_STR[] = "TaskPoolOnAsyncRunnerWatermark";
+static constexpr double MILLISECONDS_PER_SECOND = 1000.0;
+// 100: ms, a rate timer overdue this long is taken as stuck on a busy env
+static constexpr uint64_t RATE_TIMER_SLACK = 100;
+
+struct RateTimerMessage {
+    RateTimerMessage(uint64_t runnerId, napi_env env) : runnerId(runnerId), env(env) {}
+    ~RateTimerMessage() = default;
+
+    uint64_t runnerId;
+    napi_env env;
+    uint64_t timerId {};
+};
+
+static uint64_t GetSteadyMilliseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static void SetWatermarkCallback(napi_env env, std::unordered_map<napi_env, napi_ref>& callbacks, napi_value callback)
+{
+    napi_ref& callbackRef = callbacks[env];
+    if (callbackRef != nullptr) {
+        napi_delete_reference(env, callbackRef);
+    }
+    callbackRef = NapiHelper::CreateReference(env, callback, 1);
+}
 
 BaseRunnerManager& AsyncRunner::GetManager()
 {
@@ -74,6 +110,9 @@ bool AsyncRunner::AsyncRunnerConstructorInner(napi_env env, napi_value& thisVar,
 {
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_FUNCTION(EXECUTE_STR, Execute),
+        DECLARE_NAPI_FUNCTION(SET_RATE_LIMIT_STR, SetRateLimit),
+        DECLARE_NAPI_FUNCTION(ON_BACKPRESSURE_STR, OnBackpressure),
+        DECLARE_NAPI_FUNCTION(ON_DRAIN_STR, OnDrain),
     };
     return RunnerConstructorInner(env, thisVar, asyncRunner, properties,
                                   sizeof(properties) / sizeof(properties[0]));
@@ -143,6 +182,132 @@ napi_value AsyncRunner::Execute(napi_env env, napi_callback_info cbinfo)
     return promise;
 }
 
+napi_value AsyncRunner::SetRateLimit(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = 2; // 2 : tasksPerSecond, burst
+    napi_value args[2];
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
+    if (argc < 1 || argc > 2) { // 2 : tasksPerSecond, burst
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "The numbers of setRateLimit's params not more than two or less one.");
+        return nullptr;
+    }
+    if (!NapiHelper::IsNumber(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "The type of setRateLimit's first param must be number.");
+        return nullptr;
+    }
+    double rate = 0;
+    napi_get_value_double(env, args[0], &rate);
+    if (!(rate >= 0) || std::isinf(rate)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "TasksPerSecond must be a finite number greater than or equal zero.");
+        return nullptr;
+    }
+    double burst = 1;
+    if (argc > 1) {
+        if (!NapiHelper::IsNumber(env, args[1])) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "The type of setRateLimit's second param must be number.");
+            return nullptr;
+        }
+        napi_get_value_double(env, args[1], &burst);
+        if (!(burst >= 1) || std::isinf(burst)) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Burst must be a finite number not less than one.");
+            return nullptr;
+        }
+    }
+    AsyncRunner* asyncRunner = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncRunner));
+    if (asyncRunner == nullptr) {
+        return nullptr;
+    }
+    uint64_t runnerId = asyncRunner->runnerId_;
+    WatermarkSignal signal;
+    {
+        std::unique_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+        asyncRunner->rate_ = rate;
+        asyncRunner->burst_ = std::floor(burst);
+        // a new limit starts with a full bucket, the tasks held back by the previous one may go now
+        asyncRunner->tokens_ = asyncRunner->burst_;
+        asyncRunner->refillTime_ = GetSteadyMilliseconds();
+        asyncRunner->DispatchWaitingTasks(env, signal);
+    }
+    SendWatermarkSignal(runnerId, signal);
+    HILOG_INFO("taskpool:: asyncRunner %{public}s rate limit %{public}f, burst %{public}f",
+               std::to_string(runnerId).c_str(), rate, burst);
+    return nullptr;
+}
+
+bool AsyncRunner::GetWatermarkArgs(napi_env env, napi_callback_info cbinfo, AsyncRunner*& asyncRunner,
+                                   uint32_t& watermark, napi_value& callback)
+{
+    size_t argc = 2; // 2 : watermark, callback
+    napi_value args[2];
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
+    if (argc != 2) { // 2 : watermark, callback
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "The numbers of params must be two.");
+        return false;
+    }
+    if (!NapiHelper::IsNumber(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "The type of the watermark must be number.");
+        return false;
+    }
+    int32_t value = NapiHelper::GetInt32Value(env, args[0]);
+    if (value < 0) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "The watermark must be greater than or equal zero.");
+        return false;
+    }
+    if (!NapiHelper::IsFunction(env, args[1])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "The type of the callback must be function.");
+        return false;
+    }
+    napi_unwrap(env, thisVar, reinterpret_cast<void**>(&asyncRunner));
+    if (asyncRunner == nullptr) {
+        return false;
+    }
+    watermark = static_cast<uint32_t>(value);
+    callback = args[1];
+    return true;
+}
+
+napi_value AsyncRunner::OnBackpressure(napi_env env, napi_callback_info cbinfo)
+{
+    AsyncRunner* asyncRunner = nullptr;
+    uint32_t highWatermark = 0;
+    napi_value callback = nullptr;
+    if (!GetWatermarkArgs(env, cbinfo, asyncRunner, highWatermark, callback)) {
+        return nullptr;
+    }
+    std::unique_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+    if (highWatermark <= asyncRunner->lowWatermark_) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "HighWatermark must be greater than lowWatermark.");
+        return nullptr;
+    }
+    asyncRunner->highWatermark_ = highWatermark;
+    SetWatermarkCallback(env, asyncRunner->backpressureCallbacks_, callback);
+    return nullptr;
+}
+
+napi_value AsyncRunner::OnDrain(napi_env env, napi_callback_info cbinfo)
+{
+    AsyncRunner* asyncRunner = nullptr;
+    uint32_t lowWatermark = 0;
+    napi_value callback = nullptr;
+    if (!GetWatermarkArgs(env, cbinfo, asyncRunner, lowWatermark, callback)) {
+        return nullptr;
+    }
+    std::unique_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+    if (asyncRunner->highWatermark_ != 0 && lowWatermark >= asyncRunner->highWatermark_) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "LowWatermark must be less than highWatermark.");
+        return nullptr;
+    }
+    asyncRunner->lowWatermark_ = lowWatermark;
+    SetWatermarkCallback(env, asyncRunner->drainCallbacks_, callback);
+    return nullptr;
+}
+
 AsyncRunner* AsyncRunner::CheckAndCreateAsyncRunner(napi_env env, napi_value& thisVar, napi_value name,
                                                     napi_value runningCapacity, napi_value waitingCapacity)
 {
@@ -231,23 +396,40 @@ void AsyncRunner::ExecuteTaskImmediately(AsyncRunner* asyncRunner, Task* task)
 bool AsyncRunner::AddTasksToAsyncRunner(AsyncRunner* asyncRunner, Task* task)
 {
     Task* frontTask = nullptr;
+    uint64_t runnerId = asyncRunner->runnerId_;
+    WatermarkSignal signal;
     {
         std::unique_lock<std::shared_mutex> asyncRunnerLock(asyncRunner->taskMutex_);
+        uint64_t now = GetSteadyMilliseconds();
+        bool isRateLimited = false;
         if (asyncRunner->runningCount_ < asyncRunner->runningCapacity_) {
-            asyncRunner->runningCount_.fetch_add(1);
-            return false;
+            // under a rate limit the tasks waiting for a token go first
+            if (asyncRunner->rate_ <= 0 || (asyncRunner->tasks_.empty() && asyncRunner->TakeRateToken(now))) {
+                asyncRunner->runningCount_.fetch_add(1);
+                return false;
+            }
+            isRateLimited = true;
+            asyncRunner->CountRateLimited(task);
         }
         if (asyncRunner->waitingCapacity_ && asyncRunner->tasks_.size() == asyncRunner->waitingCapacity_) {
             frontTask = asyncRunner->tasks_.front();
             asyncRunner->tasks_.pop_front();
             frontTask->taskState_ = ExecuteState::CANCELED;
+            asyncRunner->discardedNum_++;
         }
         asyncRunner->tasks_.push_back(task);
+        asyncRunner->maxWaitingNum_ = std::max(asyncRunner->maxWaitingNum_,
+                                               static_cast<uint32_t>(asyncRunner->tasks_.size()));
+        if (isRateLimited) {
+            asyncRunner->ArmRateTimer(task->env_, now);
+        }
+        asyncRunner->UpdateWatermarkState(signal);
     }
 
     if (frontTask != nullptr) {
         asyncRunner->TriggerRejectErrorTimer(frontTask, ErrorHelper::ERR_ASYNCRUNNER_TASK_DISCARDED);
     }
+    SendWatermarkSignal(runnerId, signal);
     return true;
 }
 
@@ -263,10 +445,21 @@ void AsyncRunner::TriggerRejectErrorTimer(Task* task, int32_t errCode, bool isWa
     task->DiscardAsyncRunnerTask(message);
 }
 
-void AsyncRunner::TriggerWaitingTask()
+void AsyncRunner::TriggerWaitingTask(napi_env env)
 {
-    std::unique_lock<std::shared_mutex> lock(taskMutex_);
-    DecreaseRunningCount();
+    uint64_t runnerId = runnerId_;
+    WatermarkSignal signal;
+    {
+        std::unique_lock<std::shared_mutex> lock(taskMutex_);
+        DecreaseRunningCount();
+        DispatchWaitingTasks(env, signal);
+    }
+    SendWatermarkSignal(runnerId, signal);
+}
+
+void AsyncRunner::DispatchWaitingTasks(napi_env env, WatermarkSignal& signal)
+{
+    uint64_t now = GetSteadyMilliseconds();
     Task* task = nullptr;
     std::string message = "";
     while (runningCount_ < runningCapacity_) {
@@ -274,6 +467,11 @@ void AsyncRunner::TriggerWaitingTask()
             HILOG_DEBUG("taskpool:: asyncRunner %{public}s empty.", std::to_string(runnerId_).c_str());
             break;
         }
+        if (!TakeRateToken(now)) {
+            CountRateLimited(tasks_.front());
+            ArmRateTimer(env, now);
+            break;
+        }
         task = tasks_.front();
         tasks_.pop_front();
         runningCount_.fetch_add(1);
@@ -287,6 +485,228 @@ void AsyncRunner::TriggerWaitingTask()
         TaskManager::GetInstance().PushLog(message);
         TaskManager::GetInstance().EnqueueTaskId(task->taskId_, task->asyncTaskPriority_);
     }
+    UpdateWatermarkState(signal);
+}
+
+void AsyncRunner::RefillRateTokens(uint64_t now)
+{
+    if (now <= refillTime_) {
+        return;
+    }
+    double tokens = tokens_ + static_cast<double>(now - refillTime_) * rate_ / MILLISECONDS_PER_SECOND;
+    tokens_ = std::min(burst_, tokens);
+    refillTime_ = now;
+}
+
+bool AsyncRunner::TakeRateToken(uint64_t now)
+{
+    if (rate_ <= 0) {
+        return true;
+    }
+    RefillRateTokens(now);
+    if (tokens_ < 1) {
+        return false;
+    }
+    tokens_ -= 1;
+    return true;
+}
+
+void AsyncRunner::ArmRateTimer(napi_env env, uint64_t now)
+{
+    if (env == nullptr || rate_ <= 0 || tasks_.empty()) {
+        return;
+    }
+    // a timer on a busy env may not fire in time, the next env adds another one once it is overdue
+    if (rateTimers_.find(rateTimerEnv_) != rateTimers_.end() && now < rateTimerDeadline_ + RATE_TIMER_SLACK) {
+        return;
+    }
+    RefillRateTokens(now);
+    double wait = std::ceil((1 - tokens_) * MILLISECONDS_PER_SECOND / rate_);
+    uint64_t timeout = wait < 1 ? 1 : static_cast<uint64_t>(wait);
+    CancelRateTimer(env);
+    RateTimerMessage* message = new RateTimerMessage(runnerId_, env);
+    message->timerId = TimerWheel::AddTimer(env, timeout, 0, RateTimerCallback, message);
+    if (message->timerId == 0) {
+        HILOG_ERROR("taskpool:: asyncRunner %{public}s failed to add the rate timer",
+                    std::to_string(runnerId_).c_str());
+        delete message;
+        return;
+    }
+    rateTimers_[env] = message;
+    rateTimerEnv_ = env;
+    rateTimerDeadline_ = now + timeout;
+}
+
+void AsyncRunner::CancelRateTimer(napi_env env)
+{
+    auto iter = rateTimers_.find(env);
+    if (iter == rateTimers_.end()) {
+        return;
+    }
+    // the timer has not fired, the message is freed here whether it is canceled or dropped with the timer wheel
+    TimerWheel::CancelTimer(env, iter->second->timerId);
+    delete iter->second;
+    rateTimers_.erase(iter);
+}
+
+void AsyncRunner::CountRateLimited(Task* task)
+{
+    // a task waits for a token again each time the rate timer fires, it is counted the first time only
+    if (!task->isRateLimited_) {
+        task->isRateLimited_ = true;
+        rateLimitedNum_++;
+    }
+}
+
+void AsyncRunner::RateTimerCallback(void* data)
+{
+    RateTimerMessage* message = static_cast<RateTimerMessage*>(data);
+    uint64_t runnerId = message->runnerId;
+    napi_env env = message->env;
+    delete message;
+    AsyncRunnerManager& manager = AsyncRunnerManager::GetInstance();
+    // the runner may have gone while the timer was pending
+    if (!manager.FindRunnerAndRef(runnerId)) {
+        return;
+    }
+    AsyncRunner* asyncRunner = manager.GetRunner(runnerId);
+    WatermarkSignal signal;
+    {
+        std::unique_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+        asyncRunner->rateTimers_.erase(env);
+        asyncRunner->DispatchWaitingTasks(env, signal);
+    }
+    SendWatermarkSignal(runnerId, signal);
+    manager.UnrefAndDestroyRunner(asyncRunner);
+}
+
+void AsyncRunner::UpdateWatermarkState(WatermarkSignal& signal)
+{
+    uint32_t waitingNum = static_cast<uint32_t>(tasks_.size());
+    std::unordered_map<napi_env, napi_ref>* callbacks = nullptr;
+    if (highWatermark_ == 0) {
+        isBackpressured_ = false;
+        return;
+    }
+    // the gap between the watermarks keeps the signals from flapping around one depth
+    if (!isBackpressured_ && waitingNum >= highWatermark_) {
+        isBackpressured_ = true;
+        backpressureNum_++;
+        callbacks = &backpressureCallbacks_;
+    } else if (isBackpressured_ && waitingNum <= lowWatermark_) {
+        isBackpressured_ = false;
+        callbacks = &drainCallbacks_;
+    } else {
+        return;
+    }
+    signal.isBackpressure = isBackpressured_;
+    signal.waitingNum = waitingNum;
+    for (const auto& [env, callbackRef] : *callbacks) {
+        signal.envs.push_back(env);
+    }
+}
+
+void AsyncRunner::CheckWatermarks()
+{
+    uint64_t runnerId = runnerId_;
+    WatermarkSignal signal;
+    {
+        std::unique_lock<std::shared_mutex> lock(taskMutex_);
+        UpdateWatermarkState(signal);
+    }
+    SendWatermarkSignal(runnerId, signal);
+}
+
+void AsyncRunner::SendWatermarkSignal(uint64_t runnerId, const WatermarkSignal& signal)
+{
+    bool isBackpressure = signal.isBackpressure;
+    uint32_t waitingNum = signal.waitingNum;
+    for (napi_env env : signal.envs) {
+        auto onWatermark = [env, runnerId, isBackpressure, waitingNum]([[maybe_unused]] void* data) {
+            CallWatermarkCallback(env, runnerId, isBackpressure, waitingNum);
+        };
+        uint64_t handleId = 0;
+        napi_status status = napi_send_cancelable_event(env, onWatermark, nullptr, napi_eprio_high,
+                                                        &handleId, ON_WATERMARK_STR);
+        if (status != napi_ok) {
+            HILOG_ERROR("taskpool:: failed to send the watermark event of asyncRunner %{public}s",
+                        std::to_string(runnerId).c_str());
+        }
+    }
+}
+
+void AsyncRunner::CallWatermarkCallback(napi_env env, uint64_t runnerId, bool isBackpressure, uint32_t waitingNum)
+{
+    AsyncRunnerManager& manager = AsyncRunnerManager::GetInstance();
+    if (!manager.FindRunnerAndRef(runnerId)) {
+        return;
+    }
+    AsyncRunner* asyncRunner = manager.GetRunner(runnerId);
+    napi_ref callbackRef = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+        auto& callbacks = isBackpressure ? asyncRunner->backpressureCallbacks_ : asyncRunner->drainCallbacks_;
+        auto iter = callbacks.find(env);
+        if (iter != callbacks.end()) {
+            callbackRef = iter->second;
+        }
+    }
+    // the callbacks of env are only released on env, so the reference stays valid during the call
+    if (callbackRef != nullptr) {
+        napi_status status = napi_ok;
+        HandleScope scope(env, status);
+        if (status == napi_ok) {
+            napi_value callback = NapiHelper::GetReferenceValue(env, callbackRef);
+            napi_value argv = NapiHelper::CreateUint32(env, waitingNum);
+            napi_value result = nullptr;
+            napi_call_function(env, NapiHelper::GetGlobalObject(env), callback, 1, &argv, &result);
+            if (NapiHelper::IsExceptionPending(env)) {
+                napi_value exception = nullptr;
+                napi_get_and_clear_last_exception(env, &exception);
+                HILOG_ERROR("taskpool:: an exception has occurred in the watermark callback of asyncRunner");
+            }
+        }
+    }
+    manager.UnrefAndDestroyRunner(asyncRunner);
+}
+
+void AsyncRunner::ReleaseEnvData(napi_env env)
+{
+    std::unique_lock<std::shared_mutex> lock(taskMutex_);
+    for (auto* callbacks : {&backpressureCallbacks_, &drainCallbacks_}) {
+        auto iter = callbacks->find(env);
+        if (iter != callbacks->end()) {
+            napi_delete_reference(env, iter->second);
+            callbacks->erase(iter);
+        }
+    }
+    CancelRateTimer(env);
+}
+
+napi_value AsyncRunner::GetRunnerInfo(napi_env env)
+{
+    napi_value runnerInfo = nullptr;
+    napi_create_object(env, &runnerInfo);
+    std::shared_lock<std::shared_mutex> lock(taskMutex_);
+    napi_value name = nullptr;
+    napi_create_string_utf8(env, name_.c_str(), name_.size(), &name);
+    napi_set_named_property(env, runnerInfo, "name", name);
+    napi_set_named_property(env, runnerInfo, "runningNum", NapiHelper::CreateUint32(env, runningCount_));
+    napi_set_named_property(env, runnerInfo, "waitingNum",
+                            NapiHelper::CreateUint32(env, static_cast<uint32_t>(tasks_.size())));
+    napi_set_named_property(env, runnerInfo, "maxWaitingNum", NapiHelper::CreateUint32(env, maxWaitingNum_));
+    std::pair<const char*, uint64_t> counters[] = {
+        {"discardedNum", discardedNum_}, {"rateLimitedNum", rateLimitedNum_}, {"backpressureNum", backpressureNum_},
+    };
+    for (const auto& [key, counter] : counters) {
+        napi_value value = nullptr;
+        napi_create_int64(env, static_cast<int64_t>(counter), &value);
+        napi_set_named_property(env, runnerInfo, key, value);
+    }
+    napi_value isBackpressured = nullptr;
+    napi_get_boolean(env, isBackpressured_, &isBackpressured);
+    napi_set_named_property(env, runnerInfo, "isBackpressured", isBackpressured);
+    return runnerInfo;
 }
 
 AsyncRunner* AsyncRunner::CreateGlobalRunner(const std::string& name, uint32_t runningCapacity,
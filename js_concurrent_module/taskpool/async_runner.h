@@ -17,11 +17,13 @@
 #define JS_CONCURRENT_MODULE_TASKPOOL_ASYNC_RUNNER_H
 
 #include <unordered_map>
+#include <vector>
 #include "task.h"
 #include "base_runner.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 class AsyncRunnerManager;
+struct RateTimerMessage;
 class AsyncRunner : public BaseRunner {
 public:
     AsyncRunner() = default;
@@ -29,13 +31,20 @@ public:
 
     static napi_value AsyncRunnerConstructor(napi_env env, napi_callback_info cbinfo);
     static napi_value Execute(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetRateLimit(napi_env env, napi_callback_info cbinfo);
+    static napi_value OnBackpressure(napi_env env, napi_callback_info cbinfo);
+    static napi_value OnDrain(napi_env env, napi_callback_info cbinfo);
     static AsyncRunner* CreateGlobalRunner(const std::string& name, uint32_t runningCapacity, uint32_t waitingCapacity);
     void TriggerRejectErrorTimer(Task* task, int32_t errCode, bool isWaiting = false);
-    void TriggerWaitingTask();
+    void TriggerWaitingTask(napi_env env);
     void DecreaseRunningCount();
+    // checks the watermarks after a waiting task is removed outside the runner
+    void CheckWatermarks();
+    napi_value GetRunnerInfo(napi_env env);
 
 protected:
     BaseRunnerManager& GetManager() override;
+    void ReleaseEnvData(napi_env env) override;
     void LogRunnerConstructor(std::string name, uint64_t runnerId) override;
     void LogRunnerConstructorInnerReturn(napi_status status) override;
 
@@ -45,18 +54,62 @@ private:
     AsyncRunner(AsyncRunner &&) = delete;
     AsyncRunner& operator=(AsyncRunner &&) = delete;
 
+    // the callbacks to call once the depth of the waiting queue crosses a watermark
+    struct WatermarkSignal {
+        bool isBackpressure = false;
+        uint32_t waitingNum = 0;
+        std::vector<napi_env> envs {};
+    };
+
     static bool AsyncRunnerConstructorInner(napi_env env, napi_value& thisVar, AsyncRunner* asyncRunner);
     static void ExecuteTaskImmediately(AsyncRunner* asyncRunner, Task* task);
     static AsyncRunner* CheckAndCreateAsyncRunner(napi_env env, napi_value &thisVar, napi_value name,
                                                   napi_value runningCapacity, napi_value waitingCapacity);
     static bool CheckExecuteArgs(napi_env env, napi_value napiTask, napi_value napiPriority);
     static bool AddTasksToAsyncRunner(AsyncRunner* asyncRunner, Task* task);
+    static void RateTimerCallback(void* data);
+    static void SendWatermarkSignal(uint64_t runnerId, const WatermarkSignal& signal);
+    static bool GetWatermarkArgs(napi_env env, napi_callback_info cbinfo, AsyncRunner*& asyncRunner,
+                                 uint32_t& watermark, napi_value& callback);
+    static void CallWatermarkCallback(napi_env env, uint64_t runnerId, bool isBackpressure, uint32_t waitingNum);
+
+    // the members below are called with taskMutex_ held
+    void DispatchWaitingTasks(napi_env env, WatermarkSignal& signal);
+    void RefillRateTokens(uint64_t now);
+    bool TakeRateToken(uint64_t now);
+    void ArmRateTimer(napi_env env, uint64_t now);
+    void CancelRateTimer(napi_env env);
+    void CountRateLimited(Task* task);
+    void UpdateWatermarkState(WatermarkSignal& signal);
 
     friend class NativeEngineTest;
 public:
     uint32_t runningCapacity_ {};
     uint32_t waitingCapacity_ {};
     std::atomic<uint32_t> runningCount_ {}; // running task count
+
+    // token bucket of the rate mode, rate_ 0 means no limit
+    double rate_ {}; // tasks per second
+    double burst_ {};
+    double tokens_ {};
+    uint64_t refillTime_ {};
+    // the timers which dispatch the waiting tasks once a token is due, rateTimerEnv_ holds the latest one
+    std::unordered_map<napi_env, RateTimerMessage*> rateTimers_ {}; // one timer for each env at most
+    napi_env rateTimerEnv_ {nullptr};
+    uint64_t rateTimerDeadline_ {};
+
+    // watermarks of the waiting queue, highWatermark_ 0 means no backpressure signal
+    uint32_t highWatermark_ {};
+    uint32_t lowWatermark_ {};
+    bool isBackpressured_ {false};
+    // <env, callback>, a callback is called on the env which registered it
+    std::unordered_map<napi_env, napi_ref> backpressureCallbacks_ {};
+    std::unordered_map<napi_env, napi_ref> drainCallbacks_ {};
+
+    uint32_t maxWaitingNum_ {};
+    uint64_t discardedNum_ {};
+    uint64_t rateLimitedNum_ {};
+    uint64_t backpressureNum_ {};
 };
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
 #endif // JS_CONCURRENT_MODULE_TASKPOOL_ASYNC_RUNNER_H
\ No newline at end of file
@@ -81,7 +81,7 @@ bool AsyncRunnerManager::TriggerAsyncRunner(napi_env env, Task* lastTask)
         HILOG_ERROR("taskpool:: trigger asyncRunner is remove.");
         return false;
     }
-    asyncRunner->TriggerWaitingTask();
+    asyncRunner->TriggerWaitingTask(env);
     return true;
 }
 
@@ -114,6 +114,7 @@ void AsyncRunnerManager::CancelAsyncRunnerTask(napi_env env, Task* task)
     
     if (asyncRunner != nullptr) {
         if (asyncRunner->RemoveWaitingTask(task)) {
+            asyncRunner->CheckWatermarks();
             asyncRunner->TriggerRejectErrorTimer(task, ErrorHelper::ERR_ASYNCRUNNER_TASK_CANCELED);
         }
     }
@@ -134,4 +135,16 @@ void AsyncRunnerManager::DecreaseRunningCount(uint64_t asyncRunnerId)
     AsyncRunner* asyncRunner = static_cast<AsyncRunner*>(iter->second);
     asyncRunner->DecreaseRunningCount();
 }
+
+napi_value AsyncRunnerManager::GetAsyncRunnerInfos(napi_env env)
+{
+    std::unique_lock<std::mutex> lock(runnersMutex_);
+    napi_value runnerInfos = nullptr;
+    napi_create_array_with_length(env, runners_.size(), &runnerInfos);
+    uint32_t index = 0;
+    for (const auto& [runnerId, runner] : runners_) {
+        napi_set_element(env, runnerInfos, index++, static_cast<AsyncRunner*>(runner)->GetRunnerInfo(env));
+    }
+    return runnerInfos;
+}
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
\ No newline at end of file
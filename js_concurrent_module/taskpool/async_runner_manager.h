@@ -44,6 +44,8 @@ public:
     bool TriggerAsyncRunner(napi_env env, Task* lastTask);
     void CancelAsyncRunnerTask(napi_env env, Task* task);
     void DecreaseRunningCount(uint64_t asyncRunnerId);
+    // the queue depth and counters of every asyncRunner
+    napi_value GetAsyncRunnerInfos(napi_env env);
 
 protected:
     bool CheckGlobalRunnerParams(napi_env env, BaseRunner *runner, void* config) override;
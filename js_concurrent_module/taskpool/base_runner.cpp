@@ -44,6 +44,7 @@ void BaseRunner::RunnerDestructor(napi_env env, void* data, [[maybe_unused]] voi
     if (runner == nullptr) {
         return;
     }
+    runner->ReleaseEnvData(env);
     baseRunner->GetManager().UnrefAndDestroyRunner(runner);
 }
 
@@ -40,6 +40,8 @@ public:
 protected:
     virtual void LogRunnerConstructor(std::string name, uint64_t runnerId) = 0;
     virtual void LogRunnerConstructorInnerReturn(napi_status status) = 0;
+    // the runner object of env is collected, releases what the runner keeps for env
+    virtual void ReleaseEnvData([[maybe_unused]] napi_env env) {}
 
 private:
     BaseRunner(const BaseRunner &) = delete;
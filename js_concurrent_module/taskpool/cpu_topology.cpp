@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+
+#include "tools/log.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+static constexpr char SYSFS_CPU_ROOT[] = "/sys/devices/system/cpu";
+static constexpr uint32_t MAX_CPU_NUM = 1024; // 1024: a cpu list beyond this is taken as invalid
+static constexpr int DECIMAL = 10; // 10: the cpu numbers are decimal
+// the files rating a core, tried in turn until one is present for every core
+static constexpr const char* RATING_FILES[] = {"/cpu_capacity", "/cpufreq/cpuinfo_max_freq"};
+
+static bool ReadLine(const std::string& path, std::string& line)
+{
+    std::ifstream file(path);
+    return file.is_open() && static_cast<bool>(std::getline(file, line));
+}
+
+static bool ReadValue(const std::string& path, uint64_t& value)
+{
+    std::ifstream file(path);
+    return file.is_open() && static_cast<bool>(file >> value);
+}
+
+static bool ParseCpu(const std::string& str, uint32_t& cpu)
+{
+    if (str.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    unsigned long value = std::strtoul(str.c_str(), &end, DECIMAL);
+    if (end == str.c_str() || *end != '\0' || value >= MAX_CPU_NUM) {
+        return false;
+    }
+    cpu = static_cast<uint32_t>(value);
+    return true;
+}
+
+CpuTopology::CpuTopology(const std::string& sysfsRoot)
+{
+    Probe(sysfsRoot);
+}
+
+CpuTopology& CpuTopology::GetInstance()
+{
+    static CpuTopology topology(SYSFS_CPU_ROOT);
+    return topology;
+}
+
+std::vector<uint32_t> CpuTopology::ParseCpuList(const std::string& cpuList)
+{
+    std::vector<uint32_t> cpus {};
+    std::string list = cpuList;
+    list.erase(std::remove_if(list.begin(), list.end(), [](unsigned char c) { return std::isspace(c); }), list.end());
+    size_t begin = 0;
+    while (begin < list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string range = list.substr(begin, end - begin);
+        size_t dash = range.find('-');
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (dash == std::string::npos) {
+            if (!ParseCpu(range, first)) {
+                return {};
+            }
+            last = first;
+        } else if (!ParseCpu(range.substr(0, dash), first) || !ParseCpu(range.substr(dash + 1), last) ||
+                   first > last) {
+            return {};
+        }
+        for (uint32_t cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+        begin = end + 1;
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+void CpuTopology::Probe(const std::string& sysfsRoot)
+{
+    std::string cpuList {};
+    if (!ReadLine(sysfsRoot + "/online", cpuList) && !ReadLine(sysfsRoot + "/possible", cpuList)) {
+        HILOG_INFO("taskpool:: no cpu list in %{public}s", sysfsRoot.c_str());
+        return;
+    }
+    std::vector<uint32_t> cpus = ParseCpuList(cpuList);
+    if (cpus.empty()) {
+        HILOG_WARN("taskpool:: invalid cpu list %{public}s", cpuList.c_str());
+        return;
+    }
+    std::vector<uint64_t> ratings {};
+    for (const char* ratingFile : RATING_FILES) {
+        ratings.clear();
+        for (uint32_t cpu : cpus) {
+            uint64_t rating = 0;
+            if (!ReadValue(sysfsRoot + "/cpu" + std::to_string(cpu) + ratingFile, rating)) {
+                break;
+            }
+            ratings.push_back(rating);
+        }
+        if (ratings.size() == cpus.size()) {
+            break;
+        }
+    }
+    if (ratings.size() != cpus.size()) {
+        HILOG_INFO("taskpool:: the cores of %{public}s are not rated", sysfsRoot.c_str());
+        return;
+    }
+    allCpus_ = cpus;
+    uint64_t minRating = *std::min_element(ratings.begin(), ratings.end());
+    for (size_t i = 0; i < cpus.size(); i++) {
+        if (ratings[i] == minRating) {
+            efficiencyCpus_.push_back(cpus[i]);
+        } else {
+            performanceCpus_.push_back(cpus[i]);
+        }
+    }
+    HILOG_INFO("taskpool:: %{public}zu performance cpus, %{public}zu efficiency cpus",
+               performanceCpus_.size(), efficiencyCpus_.size());
+}
+
+bool CpuTopology::IsHeterogeneous() const
+{
+    return !performanceCpus_.empty() && !efficiencyCpus_.empty();
+}
+
+const std::vector<uint32_t>& CpuTopology::GetCpus(CoreClass coreClass) const
+{
+    switch (coreClass) {
+        case CoreClass::PERFORMANCE:
+            return performanceCpus_;
+        case CoreClass::EFFICIENCY:
+            return efficiencyCpus_;
+        default:
+            return allCpus_;
+    }
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
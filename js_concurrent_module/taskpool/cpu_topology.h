@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_CPU_TOPOLOGY_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_CPU_TOPOLOGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+// the class of cores a worker is bound to, NONE means the worker runs on all the cores
+enum class CoreClass : uint32_t { NONE, PERFORMANCE, EFFICIENCY };
+
+// The performance and efficiency cores of the device, read once from sysfs.
+// A core is rated by cpuN/cpu_capacity, or by cpuN/cpufreq/cpuinfo_max_freq if some core has no capacity.
+// The cores with the lowest rating are the efficiency cores and all the others are performance cores, so the
+// middle cores of a three-cluster device run the compute tasks as well.
+class CpuTopology {
+public:
+    explicit CpuTopology(const std::string& sysfsRoot);
+    ~CpuTopology() = default;
+
+    static CpuTopology& GetInstance();
+    // "0-3,6" -> {0, 1, 2, 3, 6}, an invalid list gives no cpu
+    static std::vector<uint32_t> ParseCpuList(const std::string& cpuList);
+
+    // false if the cores are all alike or the topology is unknown, then no worker is bound
+    bool IsHeterogeneous() const;
+    // all the rated cores for NONE
+    const std::vector<uint32_t>& GetCpus(CoreClass coreClass) const;
+
+private:
+    CpuTopology(const CpuTopology &) = delete;
+    CpuTopology& operator=(const CpuTopology &) = delete;
+    CpuTopology(CpuTopology &&) = delete;
+    CpuTopology& operator=(CpuTopology &&) = delete;
+
+    void Probe(const std::string& sysfsRoot);
+
+    std::vector<uint32_t> performanceCpus_ {};
+    std::vector<uint32_t> efficiencyCpus_ {};
+    std::vector<uint32_t> allCpus_ {};
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_CPU_TOPOLOGY_H
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dependency_graph.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+bool DependencyGraph::AddDependencies(uint32_t taskId, const std::set<uint32_t>& dependIds)
+{
+    if (dependIds.empty()) {
+        return true;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = GetOrCreateNode(taskId, false);
+    std::vector<Node*> addedNodes {};
+    for (uint32_t dependId : dependIds) {
+        Node* dependNode = dependId == taskId ? node : GetOrCreateNode(dependId, true);
+        if (dependNode != node && FindEdge(dependNode, node) != SIZE_MAX) {
+            continue;
+        }
+        if (dependNode == node || !AddEdge(dependNode, node)) {
+            // roll back, removing edges keeps the order valid
+            for (Node* addedNode : addedNodes) {
+                RemoveEdge(addedNode, FindEdge(addedNode, node));
+                TryEraseNode(addedNode);
+            }
+            if (dependNode != node) {
+                TryEraseNode(dependNode);
+            }
+            TryEraseNode(node);
+            return false;
+        }
+        addedNodes.push_back(dependNode);
+    }
+    return true;
+}
+
+bool DependencyGraph::RemoveDependency(uint32_t taskId, uint32_t dependId)
+{
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    Node* dependNode = FindNode(dependId);
+    if (node == nullptr || dependNode == nullptr || node == dependNode) {
+        return false;
+    }
+    size_t index = FindEdge(dependNode, node);
+    if (index == SIZE_MAX) {
+        return false;
+    }
+    RemoveEdge(dependNode, index);
+    TryEraseNode(dependNode);
+    TryEraseNode(node);
+    return true;
+}
+
+std::vector<std::pair<uint32_t, Priority>> DependencyGraph::Complete(uint32_t taskId)
+{
+    std::vector<std::pair<uint32_t, Priority>> readyTasks {};
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return readyTasks;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    if (node == nullptr) {
+        return readyTasks;
+    }
+    while (!node->successors.empty()) {
+        Node* successor = node->successors.back().node;
+        RemoveEdge(node, node->successors.size() - 1);
+        uint64_t state = successor->state.load(std::memory_order_acquire);
+        if ((state & IN_DEGREE_MASK) == 0 && (state & PARKED_FLAG) != 0) {
+            successor->state.fetch_and(~(PARKED_FLAG | PRIORITY_MASK), std::memory_order_acq_rel);
+            auto priority = static_cast<Priority>((state & PRIORITY_MASK) >> PRIORITY_SHIFT);
+            readyTasks.emplace_back(successor->taskId, priority);
+        }
+        TryEraseNode(successor);
+    }
+    TryEraseNode(node);
+    return readyTasks;
+}
+
+std::vector<uint32_t> DependencyGraph::RemoveSuccessors(uint32_t taskId)
+{
+    std::vector<uint32_t> successorIds {};
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return successorIds;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    if (node == nullptr) {
+        return successorIds;
+    }
+    while (!node->successors.empty()) {
+        Node* successor = node->successors.back().node;
+        successorIds.push_back(successor->taskId);
+        RemoveEdge(node, node->successors.size() - 1);
+        TryEraseNode(successor);
+    }
+    TryEraseNode(node);
+    return successorIds;
+}
+
+void DependencyGraph::RemovePredecessors(uint32_t taskId)
+{
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    if (node == nullptr) {
+        return;
+    }
+    while (!node->predecessors.empty()) {
+        Edge edge = node->predecessors.back();
+        RemoveEdge(edge.node, edge.index);
+        TryEraseNode(edge.node);
+    }
+    TryEraseNode(node);
+}
+
+void DependencyGraph::RemoveTask(uint32_t taskId)
+{
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    auto iter = nodes_.find(taskId);
+    if (iter == nodes_.end()) {
+        return;
+    }
+    Node* node = iter->second.get();
+    std::vector<Node*> neighbors {};
+    while (!node->predecessors.empty()) {
+        Edge edge = node->predecessors.back();
+        neighbors.push_back(edge.node);
+        RemoveEdge(edge.node, edge.index);
+    }
+    while (!node->successors.empty()) {
+        neighbors.push_back(node->successors.back().node);
+        RemoveEdge(node, node->successors.size() - 1);
+    }
+    nodes_.erase(iter);
+    nodeNum_.fetch_sub(1, std::memory_order_release);
+    for (Node* neighbor : neighbors) {
+        TryEraseNode(neighbor);
+    }
+}
+
+bool DependencyGraph::HasPredecessor(uint32_t taskId) const
+{
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    return node != nullptr && (node->state.load(std::memory_order_acquire) & IN_DEGREE_MASK) != 0;
+}
+
+bool DependencyGraph::HasSuccessor(uint32_t taskId) const
+{
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    return node != nullptr && !node->successors.empty();
+}
+
+bool DependencyGraph::TryPark(uint32_t taskId, Priority priority)
+{
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    if (node == nullptr) {
+        return false;
+    }
+    // the in-degree only drops under the exclusive lock, so Complete sees the parked flag
+    uint64_t state = node->state.load(std::memory_order_acquire);
+    uint64_t newState = 0;
+    do {
+        if ((state & IN_DEGREE_MASK) == 0) {
+            return false;
+        }
+        newState = (state & IN_DEGREE_MASK) | PARKED_FLAG | (static_cast<uint64_t>(priority) << PRIORITY_SHIFT);
+    } while (!node->state.compare_exchange_weak(state, newState, std::memory_order_acq_rel));
+    return true;
+}
+
+void DependencyGraph::Park(uint32_t taskId, Priority priority)
+{
+    if (taskId == 0) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = GetOrCreateNode(taskId, false);
+    uint64_t state = node->state.load(std::memory_order_relaxed) & IN_DEGREE_MASK;
+    node->state.store(state | PARKED_FLAG | (static_cast<uint64_t>(priority) << PRIORITY_SHIFT),
+        std::memory_order_release);
+}
+
+std::pair<uint32_t, Priority> DependencyGraph::Unpark(uint32_t taskId)
+{
+    std::pair<uint32_t, Priority> result = std::make_pair(0, Priority::DEFAULT);
+    if (nodeNum_.load(std::memory_order_acquire) == 0) {
+        return result;
+    }
+    bool isIsolated = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(graphMutex_);
+        Node* node = FindNode(taskId);
+        if (node == nullptr) {
+            return result;
+        }
+        uint64_t state = node->state.fetch_and(~(PARKED_FLAG | PRIORITY_MASK), std::memory_order_acq_rel);
+        if ((state & PARKED_FLAG) == 0) {
+            return result;
+        }
+        result = std::make_pair(taskId, static_cast<Priority>((state & PRIORITY_MASK) >> PRIORITY_SHIFT));
+        isIsolated = (state & IN_DEGREE_MASK) == 0 && node->successors.empty();
+    }
+    if (isIsolated) {
+        TryEraseNode(taskId);
+    }
+    return result;
+}
+
+std::string DependencyGraph::GetDependInfo(uint32_t taskId) const
+{
+    std::vector<uint32_t> dependIds {};
+    {
+        std::shared_lock<std::shared_mutex> lock(graphMutex_);
+        Node* node = FindNode(taskId);
+        if (node == nullptr) {
+            return "";
+        }
+        for (const Edge& edge : node->predecessors) {
+            dependIds.push_back(edge.node->taskId);
+        }
+    }
+    std::sort(dependIds.begin(), dependIds.end());
+    std::string str = "";
+    for (uint32_t id : dependIds) {
+        str += " " + std::to_string(id);
+    }
+    return str;
+}
+
+uint32_t DependencyGraph::GetNodeNum() const
+{
+    return nodeNum_.load(std::memory_order_acquire);
+}
+
+void DependencyGraph::Clear()
+{
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    nodes_.clear();
+    nodeNum_.store(0, std::memory_order_release);
+    maxOrder_ = 0;
+    minOrder_ = 0;
+}
+
+DependencyGraph::Node* DependencyGraph::FindNode(uint32_t taskId) const
+{
+    auto iter = nodes_.find(taskId);
+    return iter == nodes_.end() ? nullptr : iter->second.get();
+}
+
+DependencyGraph::Node* DependencyGraph::GetOrCreateNode(uint32_t taskId, bool isPredecessor)
+{
+    auto iter = nodes_.find(taskId);
+    if (iter != nodes_.end()) {
+        return iter->second.get();
+    }
+    // a new node has no edge yet, putting it at the proper end keeps the common case free of reordering
+    int64_t order = isPredecessor ? --minOrder_ : ++maxOrder_;
+    auto result = nodes_.emplace(taskId, std::make_unique<Node>(taskId, order));
+    nodeNum_.fetch_add(1, std::memory_order_release);
+    return result.first->second.get();
+}
+
+size_t DependencyGraph::FindEdge(const Node* from, const Node* to)
+{
+    // search the shorter side, a new node has no edge at all
+    if (from->successors.size() <= to->predecessors.size()) {
+        for (size_t i = 0; i < from->successors.size(); i++) {
+            if (from->successors[i].node == to) {
+                return i;
+            }
+        }
+        return SIZE_MAX;
+    }
+    for (const Edge& edge : to->predecessors) {
+        if (edge.node == from) {
+            return edge.index;
+        }
+    }
+    return SIZE_MAX;
+}
+
+bool DependencyGraph::AddEdge(Node* from, Node* to)
+{
+    if (from->order > to->order) {
+        // the edge goes against the order, only the nodes ordered between both ends can be on a cycle
+        std::vector<Node*> forward {};
+        if (!SearchForward(to, from->order, forward)) {
+            return false;
+        }
+        std::vector<Node*> backward {};
+        SearchBackward(from, to->order, backward);
+        Reorder(backward, forward);
+    }
+    from->successors.push_back({to, to->predecessors.size()});
+    to->predecessors.push_back({from, from->successors.size() - 1});
+    to->state.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void DependencyGraph::RemoveEdge(Node* from, size_t index)
+{
+    Edge edge = from->successors[index];
+    UnlinkPredecessor(edge.node, edge.index);
+    UnlinkSuccessor(from, index);
+    edge.node->state.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void DependencyGraph::UnlinkSuccessor(Node* node, size_t index)
+{
+    auto& edges = node->successors;
+    if (index + 1 != edges.size()) {
+        // move the last edge into the hole and point its opposite entry at the new position
+        edges[index] = edges.back();
+        edges[index].node->predecessors[edges[index].index].index = index;
+    }
+    edges.pop_back();
+}
+
+void DependencyGraph::UnlinkPredecessor(Node* node, size_t index)
+{
+    auto& edges = node->predecessors;
+    if (index + 1 != edges.size()) {
+        edges[index] = edges.back();
+        edges[index].node->successors[edges[index].index].index = index;
+    }
+    edges.pop_back();
+}
+
+bool DependencyGraph::SearchForward(Node* start, int64_t upperBound, std::vector<Node*>& visited)
+{
+    uint64_t mark = ++visitMark_;
+    std::vector<Node*> stack {start};
+    start->visitMark = mark;
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        visited.push_back(node);
+        for (const Edge& edge : node->successors) {
+            Node* successor = edge.node;
+            if (successor->order == upperBound) {
+                // reached the start of the new edge
+                return false;
+            }
+            if (successor->order < upperBound && successor->visitMark != mark) {
+                successor->visitMark = mark;
+                stack.push_back(successor);
+            }
+        }
+    }
+    return true;
+}
+
+void DependencyGraph::SearchBackward(Node* start, int64_t lowerBound, std::vector<Node*>& visited)
+{
+    uint64_t mark = ++visitMark_;
+    std::vector<Node*> stack {start};
+    start->visitMark = mark;
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        visited.push_back(node);
+        for (const Edge& edge : node->predecessors) {
+            Node* predecessor = edge.node;
+            if (predecessor->order > lowerBound && predecessor->visitMark != mark) {
+                predecessor->visitMark = mark;
+                stack.push_back(predecessor);
+            }
+        }
+    }
+}
+
+void DependencyGraph::Reorder(std::vector<Node*>& backward, std::vector<Node*>& forward)
+{
+    // hand the orders of both sets out again, the nodes reaching the new edge first
+    auto byOrder = [](const Node* left, const Node* right) { return left->order < right->order; };
+    std::sort(backward.begin(), backward.end(), byOrder);
+    std::sort(forward.begin(), forward.end(), byOrder);
+    std::vector<int64_t> orders {};
+    orders.reserve(backward.size() + forward.size());
+    for (const Node* node : backward) {
+        orders.push_back(node->order);
+    }
+    for (const Node* node : forward) {
+        orders.push_back(node->order);
+    }
+    std::sort(orders.begin(), orders.end());
+    size_t index = 0;
+    for (Node* node : backward) {
+        node->order = orders[index++];
+    }
+    for (Node* node : forward) {
+        node->order = orders[index++];
+    }
+}
+
+void DependencyGraph::TryEraseNode(Node* node)
+{
+    // no edge and not parked
+    if (node->state.load(std::memory_order_acquire) != 0 || !node->successors.empty()) {
+        return;
+    }
+    nodes_.erase(node->taskId);
+    nodeNum_.fetch_sub(1, std::memory_order_release);
+}
+
+void DependencyGraph::TryEraseNode(uint32_t taskId)
+{
+    std::unique_lock<std::shared_mutex> lock(graphMutex_);
+    Node* node = FindNode(taskId);
+    if (node != nullptr) {
+        TryEraseNode(node);
+    }
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
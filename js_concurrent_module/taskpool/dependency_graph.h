@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_DEPENDENCY_GRAPH_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_DEPENDENCY_GRAPH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Platform;
+
+// The dependencies between tasks, an edge runs from a task to the tasks which depend on it.
+// Every node keeps its predecessors and successors in vectors and its in-degree in an atomic word together with
+// the pending state, a task which is executed before its dependencies have finished is parked in its node and
+// handed back by Complete once the in-degree drops to 0.
+// The nodes keep a topological order which is repaired locally when an edge goes against it (Pearce-Kelly),
+// so a cycle check only visits the nodes between the two ends of the new edge.
+// Structural updates take the graph lock exclusively, the queries and parking on the dequeue path share it.
+class DependencyGraph {
+public:
+    DependencyGraph() = default;
+    ~DependencyGraph() = default;
+    DependencyGraph(const DependencyGraph&) = delete;
+    DependencyGraph& operator=(const DependencyGraph&) = delete;
+
+    // taskId depends on every id of dependIds, returns false and adds nothing if an edge closes a cycle
+    bool AddDependencies(uint32_t taskId, const std::set<uint32_t>& dependIds);
+    // returns false if taskId does not depend on dependId
+    bool RemoveDependency(uint32_t taskId, uint32_t dependId);
+    // drops the edges from taskId, returns the pending tasks which have no dependency left
+    std::vector<std::pair<uint32_t, Priority>> Complete(uint32_t taskId);
+    // drops the edges from taskId without releasing the successors, returns the successors
+    std::vector<uint32_t> RemoveSuccessors(uint32_t taskId);
+    void RemovePredecessors(uint32_t taskId);
+    // drops the node with all its edges and its pending state
+    void RemoveTask(uint32_t taskId);
+
+    bool HasPredecessor(uint32_t taskId) const;
+    bool HasSuccessor(uint32_t taskId) const;
+
+    // parks the task only if it still has dependencies, returns false if it can run
+    bool TryPark(uint32_t taskId, Priority priority);
+    void Park(uint32_t taskId, Priority priority);
+    // returns <0, DEFAULT> if the task is not parked
+    std::pair<uint32_t, Priority> Unpark(uint32_t taskId);
+
+    std::string GetDependInfo(uint32_t taskId) const;
+    uint32_t GetNodeNum() const;
+    void Clear();
+
+private:
+    static constexpr uint64_t IN_DEGREE_MASK = 0xFFFFFFFF; // 0xFFFFFFFF: the in-degree in the low half
+    static constexpr uint32_t PRIORITY_SHIFT = 32; // 32: the pending priority lives above the in-degree
+    static constexpr uint64_t PRIORITY_MASK = 0xFFULL << PRIORITY_SHIFT; // 0xFF: 8 bits for the priority
+    static constexpr uint64_t PARKED_FLAG = 1ULL << 40; // 40: above the priority
+
+    struct Node;
+    struct Edge {
+        Node* node;
+        size_t index; // the position of the same edge in the opposite vector of node, for O(1) removal
+    };
+
+    struct Node {
+        explicit Node(uint32_t id, int64_t position) : taskId(id), order(position) {}
+
+        uint32_t taskId;
+        // <PARKED_FLAG, priority, in-degree>
+        std::atomic<uint64_t> state {0};
+        std::vector<Edge> predecessors {};
+        std::vector<Edge> successors {};
+        int64_t order; // every edge goes from a lower order to a higher one
+        uint64_t visitMark = 0;
+    };
+
+    Node* FindNode(uint32_t taskId) const;
+    Node* GetOrCreateNode(uint32_t taskId, bool isPredecessor);
+    // returns the position of the edge in from->successors, or SIZE_MAX
+    static size_t FindEdge(const Node* from, const Node* to);
+    bool AddEdge(Node* from, Node* to);
+    static void RemoveEdge(Node* from, size_t index);
+    static void UnlinkSuccessor(Node* node, size_t index);
+    static void UnlinkPredecessor(Node* node, size_t index);
+    bool SearchForward(Node* start, int64_t upperBound, std::vector<Node*>& visited);
+    void SearchBackward(Node* start, int64_t lowerBound, std::vector<Node*>& visited);
+    static void Reorder(std::vector<Node*>& backward, std::vector<Node*>& forward);
+    void TryEraseNode(Node* node);
+    void TryEraseNode(uint32_t taskId);
+
+    std::unordered_map<uint32_t, std::unique_ptr<Node>> nodes_ {};
+    mutable std::shared_mutex graphMutex_;
+    // lets the dequeue path skip the lock while no task has a dependency
+    std::atomic<uint32_t> nodeNum_ {0};
+    // the new successors are appended after maxOrder_, the new predecessors before minOrder_
+    int64_t maxOrder_ = 0;
+    int64_t minOrder_ = 0;
+    uint64_t visitMark_ = 0;
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_DEPENDENCY_GRAPH_H
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "function_cache.h"
+
+#include <algorithm>
+
+#include "helper/napi_helper.h"
+#include "task_manager.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Concurrent::Common::Helper;
+
+static constexpr size_t MAX_ENTRY_NUM_PER_ENV = 32; // 32: hot concurrent functions kept for each env
+
+FunctionCache& FunctionCache::GetInstance()
+{
+    static FunctionCache functionCache;
+    return functionCache;
+}
+
+std::shared_ptr<FunctionSerialization> FunctionCache::GetSerialization(napi_env env, napi_value func,
+                                                                      bool defaultTransfer, bool defaultCloneSendable)
+{
+    napi_value napiName = NapiHelper::GetNameProperty(env, func, NAME);
+    std::string name = NapiHelper::GetString(env, napiName);
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex_);
+        ReleaseRetiredUnsafe(env);
+        auto iter = entries_.find(env);
+        if (iter != entries_.end()) {
+            auto serialization = FindEntry(env, iter->second, func, name, defaultTransfer, defaultCloneSendable);
+            if (serialization != nullptr) {
+                serializeHitCount_++;
+                return serialization;
+            }
+        }
+    }
+    serializeMissCount_++;
+    void* data = Task::SerializeFunction(env, func, defaultTransfer, defaultCloneSendable);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    auto serialization = std::make_shared<FunctionSerialization>(env, data);
+    napi_ref funcRef = NapiHelper::CreateReference(env, func, 0);
+    std::lock_guard<std::mutex> lock(entriesMutex_);
+    auto [iter, isNewEnv] = entries_.try_emplace(env);
+    if (isNewEnv) {
+        napi_add_env_cleanup_hook(env, EnvCleanupHook, env);
+    }
+    std::list<Entry>& entries = iter->second;
+    if (entries.size() >= MAX_ENTRY_NUM_PER_ENV) {
+        NapiHelper::DeleteReference(env, entries.back().funcRef);
+        RetireUnsafe(env, std::move(entries.back().serialization));
+        entries.pop_back();
+    }
+    entries.push_front({name, funcRef, defaultTransfer, defaultCloneSendable, serialization});
+    return serialization;
+}
+
+std::shared_ptr<FunctionSerialization> FunctionCache::FindEntry(napi_env env, std::list<Entry>& entries,
+                                                                napi_value func, const std::string& name,
+                                                                bool defaultTransfer, bool defaultCloneSendable)
+{
+    for (auto iter = entries.begin(); iter != entries.end(); ++iter) {
+        if (iter->name != name || iter->defaultTransfer != defaultTransfer ||
+            iter->defaultCloneSendable != defaultCloneSendable) {
+            continue;
+        }
+        napi_value cachedFunc = NapiHelper::GetReferenceValue(env, iter->funcRef);
+        if (cachedFunc == nullptr) {
+            // the function has been collected, a new function with the same name can not match it anymore
+            NapiHelper::DeleteReference(env, iter->funcRef);
+            RetireUnsafe(env, std::move(iter->serialization));
+            entries.erase(iter);
+            return nullptr;
+        }
+        if (!NapiHelper::IsStrictEqual(env, cachedFunc, func)) {
+            continue;
+        }
+        entries.splice(entries.begin(), entries, iter);
+        return iter->serialization;
+    }
+    return nullptr;
+}
+
+void FunctionCache::RetireUnsafe(napi_env env, std::shared_ptr<FunctionSerialization>&& serialization)
+{
+    if (serialization.use_count() == 1) {
+        ReleaseData(env, *serialization);
+        return;
+    }
+    retired_[env].push_back(std::move(serialization));
+}
+
+void FunctionCache::ReleaseRetiredUnsafe(napi_env env)
+{
+    auto iter = retired_.find(env);
+    if (iter == retired_.end()) {
+        return;
+    }
+    // a serialization only held here has no task left to copy it from, so its count can not grow again
+    auto& serializations = iter->second;
+    serializations.erase(std::remove_if(serializations.begin(), serializations.end(),
+        [env](const std::shared_ptr<FunctionSerialization>& serialization) {
+            if (serialization.use_count() != 1) {
+                return false;
+            }
+            ReleaseData(env, *serialization);
+            return true;
+        }), serializations.end());
+    if (serializations.empty()) {
+        retired_.erase(iter);
+    }
+}
+
+void FunctionCache::Release(napi_env env, std::shared_ptr<FunctionSerialization>& serialization)
+{
+    if (serialization == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(entriesMutex_);
+    auto iter = retired_.find(serialization->hostEnv);
+    // 2: the retired list and the caller, no other holder is left to copy it from
+    if (iter != retired_.end() && serialization.use_count() == 2) {
+        auto& serializations = iter->second;
+        auto retiredIter = std::find(serializations.begin(), serializations.end(), serialization);
+        if (retiredIter != serializations.end()) {
+            ReleaseData(env, *serialization);
+            serializations.erase(retiredIter);
+            if (serializations.empty()) {
+                retired_.erase(iter);
+            }
+        }
+    }
+    serialization = nullptr;
+}
+
+void FunctionCache::ReleaseData(napi_env env, FunctionSerialization& serialization)
+{
+    std::lock_guard<std::mutex> lock(serialization.mutex);
+    if (serialization.data != nullptr) {
+        napi_delete_serialization_data(env, serialization.data);
+        serialization.data = nullptr;
+    }
+}
+
+void FunctionCache::EnvCleanupHook(void* data)
+{
+    FunctionCache::GetInstance().RemoveEnv(static_cast<napi_env>(data));
+}
+
+void FunctionCache::RemoveEnv(napi_env env)
+{
+    std::lock_guard<std::mutex> lock(entriesMutex_);
+    auto iter = entries_.find(env);
+    if (iter == entries_.end()) {
+        return;
+    }
+    // the tasks still holding a serialization of the env fail to deserialize it instead of using a dead env
+    for (auto& entry : iter->second) {
+        NapiHelper::DeleteReference(env, entry.funcRef);
+        ReleaseData(env, *entry.serialization);
+    }
+    entries_.erase(iter);
+    auto retiredIter = retired_.find(env);
+    if (retiredIter != retired_.end()) {
+        for (auto& serialization : retiredIter->second) {
+            ReleaseData(env, *serialization);
+        }
+        retired_.erase(retiredIter);
+    }
+}
+
+void FunctionCache::CountDeserialization(bool isHit)
+{
+    if (isHit) {
+        deserializeHitCount_++;
+    } else {
+        deserializeMissCount_++;
+    }
+}
+
+napi_value FunctionCache::GetCacheInfo(napi_env env)
+{
+    napi_value cacheInfo = NapiHelper::CreateObject(env);
+    napi_value serializeHits = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(serializeHitCount_.load()), &serializeHits);
+    napi_value serializeMisses = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(serializeMissCount_.load()), &serializeMisses);
+    napi_value deserializeHits = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(deserializeHitCount_.load()), &deserializeHits);
+    napi_value deserializeMisses = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(deserializeMissCount_.load()), &deserializeMisses);
+    napi_set_named_property(env, cacheInfo, "serializeHits", serializeHits);
+    napi_set_named_property(env, cacheInfo, "serializeMisses", serializeMisses);
+    napi_set_named_property(env, cacheInfo, "deserializeHits", deserializeHits);
+    napi_set_named_property(env, cacheInfo, "deserializeMisses", deserializeMisses);
+    return cacheInfo;
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_FUNCTION_CACHE_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_FUNCTION_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "napi/native_api.h"
+#include "task.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+// Caches the serialization of concurrent functions so that repeated executions of the same function only
+// serialize their arguments. Entries are kept per host env and hold the function weakly, they are dropped
+// when the function is collected, when the env is torn down, or in LRU order once the env has too many.
+// The cache owns the serialization data: a dropped entry still used by tasks is retired, and its data is
+// released by the last task that drops it, or when the env is torn down.
+class FunctionCache {
+public:
+    static FunctionCache& GetInstance();
+
+    // returns nullptr with a pending exception if the function can not be serialized
+    std::shared_ptr<FunctionSerialization> GetSerialization(napi_env env, napi_value func,
+                                                           bool defaultTransfer = true,
+                                                           bool defaultCloneSendable = false);
+    // called by the workers for their per-worker cache of deserialized functions
+    void CountDeserialization(bool isHit);
+    // drops a reference taken from the cache, the data of a retired serialization is released with env
+    // when the reference is its last one outside the cache
+    void Release(napi_env env, std::shared_ptr<FunctionSerialization>& serialization);
+    napi_value GetCacheInfo(napi_env env);
+
+private:
+    FunctionCache() = default;
+    ~FunctionCache() = default;
+    FunctionCache(const FunctionCache &) = delete;
+    FunctionCache& operator=(const FunctionCache &) = delete;
+    FunctionCache(FunctionCache &&) = delete;
+    FunctionCache& operator=(FunctionCache &&) = delete;
+
+    struct Entry {
+        std::string name {};
+        napi_ref funcRef = nullptr; // weak reference
+        bool defaultTransfer = true;
+        bool defaultCloneSendable = false;
+        std::shared_ptr<FunctionSerialization> serialization = nullptr;
+    };
+
+    static void EnvCleanupHook(void* data);
+    std::shared_ptr<FunctionSerialization> FindEntry(napi_env env, std::list<Entry>& entries, napi_value func,
+                                                     const std::string& name, bool defaultTransfer,
+                                                     bool defaultCloneSendable);
+    void RetireUnsafe(napi_env env, std::shared_ptr<FunctionSerialization>&& serialization);
+    void ReleaseRetiredUnsafe(napi_env env);
+    static void ReleaseData(napi_env env, FunctionSerialization& serialization);
+    void RemoveEnv(napi_env env);
+
+    // <hostEnv, entries in most recently used order>
+    std::unordered_map<napi_env, std::list<Entry>> entries_ {};
+    // <hostEnv, serializations dropped from the entries but maybe still held by tasks>
+    std::unordered_map<napi_env, std::vector<std::shared_ptr<FunctionSerialization>>> retired_ {};
+    std::mutex entriesMutex_;
+    std::atomic<uint64_t> serializeHitCount_ = 0;
+    std::atomic<uint64_t> serializeMissCount_ = 0;
+    std::atomic<uint64_t> deserializeHitCount_ = 0;
+    std::atomic<uint64_t> deserializeMissCount_ = 0;
+    friend class NativeEngineTest;
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_FUNCTION_CACHE_H
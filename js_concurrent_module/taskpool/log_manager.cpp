@@ -15,10 +15,77 @@
 
 #include "log_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 static constexpr uint32_t MAX_LOG_SIZE = 50000;
 static constexpr uint32_t LOG_PRINT_SIZE = 450;
 static constexpr uint32_t WAITING_INTERVAL = 1000; // 1000: 1s
+static constexpr uint64_t EVENT_TIME_MASK = (1ULL << 56) - 1; // 56: the timestamp takes the low 56 bits
+static constexpr uint32_t EVENT_PRIORITY_SHIFT = 56; // 56: the priority takes bits 56-59
+static constexpr uint32_t EVENT_TYPE_SHIFT = 60; // 60: the type takes bits 60-63
+static constexpr uint64_t EVENT_FIELD_MASK = 0xF;
+static constexpr uint32_t WORKER_ID_SHIFT = 32;
+static constexpr uint64_t US_PER_MS = 1000;
+
+static uint64_t GetSteadyMicroseconds()
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+uint64_t TaskEventRing::Push(const TaskEvent& event)
+{
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    Entry& entry = entries_[head & (CAPACITY - 1)];
+    entry.seq.store(head * 2 + 1, std::memory_order_relaxed); // 2: the sequence is odd while writing
+    std::atomic_thread_fence(std::memory_order_release);
+    uint64_t meta = (static_cast<uint64_t>(event.priority & EVENT_FIELD_MASK) << EVENT_PRIORITY_SHIFT) |
+        (static_cast<uint64_t>(event.type) << EVENT_TYPE_SHIFT);
+    entry.time.store((event.timestamp & EVENT_TIME_MASK) | meta, std::memory_order_relaxed);
+    entry.ids.store(event.taskId | (static_cast<uint64_t>(event.workerId) << WORKER_ID_SHIFT),
+                    std::memory_order_relaxed);
+    entry.seq.store(head * 2 + 2, std::memory_order_release); // 2: even once written
+    head_.store(head + 1, std::memory_order_release);
+    return std::min<uint64_t>(head + 1 - tail_.load(std::memory_order_relaxed), CAPACITY);
+}
+
+void TaskEventRing::Take(std::vector<TaskEvent>& events, size_t maxCount)
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (head - tail > CAPACITY) {
+        // the oldest events have been overwritten
+        tail = head - CAPACITY;
+    }
+    for (; tail < head && maxCount > 0; tail++) {
+        const Entry& entry = entries_[tail & (CAPACITY - 1)];
+        uint64_t seq = entry.seq.load(std::memory_order_acquire);
+        uint64_t time = entry.time.load(std::memory_order_relaxed);
+        uint64_t ids = entry.ids.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq != tail * 2 + 2 || entry.seq.load(std::memory_order_relaxed) != seq) { // 2: see Push
+            // the entry is overwritten by the owner meanwhile
+            continue;
+        }
+        TaskEvent event;
+        event.timestamp = time & EVENT_TIME_MASK;
+        event.priority = static_cast<uint8_t>((time >> EVENT_PRIORITY_SHIFT) & EVENT_FIELD_MASK);
+        event.type = static_cast<TaskEventType>((time >> EVENT_TYPE_SHIFT) & EVENT_FIELD_MASK);
+        event.taskId = static_cast<uint32_t>(ids);
+        event.workerId = static_cast<uint32_t>(ids >> WORKER_ID_SHIFT);
+        events.push_back(event);
+        maxCount--;
+    }
+    tail_.store(tail, std::memory_order_release);
+}
+
+uint64_t TaskEventRing::GetPendingNum() const
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    return std::min<uint64_t>(head - tail_.load(std::memory_order_acquire), CAPACITY);
+}
 
 void LogManager::PrintLog()
 {
@@ -37,6 +104,91 @@ void LogManager::PrintLog()
     for (size_t i = 0; i < outputContainer.size(); i++) {
         HILOG_INFO("taskpool::%{public}s", outputContainer[i].c_str());
     }
+    PrintTaskEvents();
+}
+
+void LogManager::PrintTaskEvents()
+{
+    std::vector<TaskEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(eventRingsMutex_);
+        for (auto& ring : eventRings_) {
+            ring->Take(events, LOG_PRINT_SIZE);
+        }
+    }
+    if (events.empty()) {
+        return;
+    }
+    std::sort(events.begin(), events.end(), [](const TaskEvent& lhs, const TaskEvent& rhs) {
+        return lhs.timestamp < rhs.timestamp;
+    });
+    uint64_t nowTime = ConcurrentHelper::GetMilliseconds();
+    uint64_t nowSteadyTime = GetSteadyMicroseconds();
+    for (const auto& event : events) {
+        HILOG_INFO("taskpool::%{public}s", FormatTaskEvent(event, nowTime, nowSteadyTime).c_str());
+    }
+}
+
+std::string LogManager::FormatTaskEvent(const TaskEvent& event, uint64_t nowTime, uint64_t nowSteadyTime)
+{
+    // map the steady timestamp to the wall clock of now
+    uint64_t elapsed = nowSteadyTime > event.timestamp ? (nowSteadyTime - event.timestamp) / US_PER_MS : 0;
+    uint64_t eventTime = nowTime > elapsed ? nowTime - elapsed : 0;
+    return "Task Perform: " + std::to_string(event.taskId) + ", priority: " + std::to_string(event.priority) +
+        ", worker: " + std::to_string(event.workerId) + ", " + ConcurrentHelper::GetTimeStampWithMS(eventTime);
+}
+
+TaskEventRing* LogManager::AcquireEventRing()
+{
+    std::lock_guard<std::mutex> lock(eventRingsMutex_);
+    for (auto& ring : eventRings_) {
+        if (!ring->inUse_) {
+            ring->inUse_ = true;
+            return ring.get();
+        }
+    }
+    auto ring = std::make_unique<TaskEventRing>();
+    ring->inUse_ = true;
+    eventRings_.push_back(std::move(ring));
+    return eventRings_.back().get();
+}
+
+void LogManager::ReleaseEventRing(TaskEventRing* ring)
+{
+    if (ring == nullptr) {
+        return;
+    }
+    // the pending events are kept and printed later
+    std::lock_guard<std::mutex> lock(eventRingsMutex_);
+    ring->inUse_ = false;
+}
+
+bool LogManager::RecordTaskEvent(TaskEventRing* ring, TaskEventType type, uint32_t taskId, uint8_t priority,
+                                 uint32_t workerId)
+{
+    if (ring == nullptr) {
+        return false;
+    }
+    TaskEvent event;
+    event.timestamp = GetSteadyMicroseconds();
+    event.taskId = taskId;
+    event.workerId = workerId;
+    event.priority = priority;
+    event.type = type;
+    if (ring->Push(event) < LOG_PRINT_SIZE) {
+        return false;
+    }
+    return IsPrintInterval(ConcurrentHelper::GetMilliseconds());
+}
+
+bool LogManager::IsPrintInterval(uint64_t nowTime)
+{
+    uint64_t printTime = printTime_;
+    if ((nowTime - printTime) < WAITING_INTERVAL) {
+        return false;
+    }
+    // only one of the racing callers triggers the print
+    return printTime_.compare_exchange_strong(printTime, nowTime);
 }
 
 bool LogManager::PushLog(const std::string& msg)
@@ -70,8 +222,16 @@ bool LogManager::IsNeedPrint()
 
 bool LogManager::IsEmpty()
 {
-    std::lock_guard<std::mutex> lock(logQueueMutex_);
-    return logQueue_.empty();
+    {
+        std::lock_guard<std::mutex> lock(logQueueMutex_);
+        if (!logQueue_.empty()) {
+            return false;
+        }
+    }
+    std::lock_guard<std::mutex> lock(eventRingsMutex_);
+    return std::all_of(eventRings_.begin(), eventRings_.end(), [](const auto& ring) {
+        return ring->GetPendingNum() == 0;
+    });
 }
 
 void LogManager::PushLogFront(const std::string& msg)
@@ -18,8 +18,11 @@
 
 #include "tools/log.h"
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -28,6 +31,48 @@
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
 
+enum class TaskEventType : uint8_t { PERFORM = 0 };
+
+// a task event recorded in binary form, it is formatted only when the logs are printed
+struct TaskEvent {
+    uint64_t timestamp = 0; // steady clock, in us
+    uint32_t taskId = 0;
+    uint32_t workerId = 0;
+    uint8_t priority = 0;
+    TaskEventType type = TaskEventType::PERFORM;
+};
+
+// A fixed-size ring of task events with a single writer, the thread which owns the ring.
+// The writer never waits, when the ring is full the oldest events are overwritten. Every entry is guarded by
+// a sequence number so that the reader drops the entries which are overwritten while it reads them.
+class TaskEventRing {
+public:
+    static constexpr uint32_t CAPACITY = 512; // 512: power of 2
+
+    TaskEventRing() = default;
+    ~TaskEventRing() = default;
+
+    // only called by the owner, returns the number of events which are not taken yet
+    uint64_t Push(const TaskEvent& event);
+    // only called under LogManager::eventRingsMutex_, takes at most maxCount events in order
+    void Take(std::vector<TaskEvent>& events, size_t maxCount);
+    uint64_t GetPendingNum() const;
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> seq {0}; // odd while the entry is written
+        std::atomic<uint64_t> time {0}; // the timestamp, with the priority and the type in the highest byte
+        std::atomic<uint64_t> ids {0}; // the taskId in the low half, the workerId in the high half
+    };
+
+    std::array<Entry, CAPACITY> entries_ {};
+    std::atomic<uint64_t> head_ {0};
+    std::atomic<uint64_t> tail_ {0};
+    std::atomic<bool> inUse_ {false};
+
+    friend class LogManager;
+};
+
 class LogManager {
 public:
     LogManager() = default;
@@ -42,9 +87,23 @@ public:
     bool IsEmpty();
     void PushLogFront(const std::string& msg);
 
+    // for the task events of the workers
+    TaskEventRing* AcquireEventRing();
+    void ReleaseEventRing(TaskEventRing* ring);
+    // returns true if the logs should be printed, like PushLog
+    bool RecordTaskEvent(TaskEventRing* ring, TaskEventType type, uint32_t taskId, uint8_t priority,
+                         uint32_t workerId);
+
 private:
+    bool IsPrintInterval(uint64_t nowTime);
+    void PrintTaskEvents();
+    static std::string FormatTaskEvent(const TaskEvent& event, uint64_t nowTime, uint64_t nowSteadyTime);
+
     std::deque<std::string> logQueue_ {};
     std::mutex logQueueMutex_;
+    // the rings are reused by later workers and freed with the LogManager
+    std::vector<std::unique_ptr<TaskEventRing>> eventRings_ {};
+    std::mutex eventRingsMutex_;
     std::atomic<uint64_t> printTime_ {0};
     std::atomic<uint64_t> size_ {0};
 
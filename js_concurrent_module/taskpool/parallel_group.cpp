@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel_group.h"
+
+#include "function_cache.h"
+#include "task_group_manager.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Concurrent::Common::Helper;
+
+static constexpr uint32_t CHUNKS_PER_THREAD = 4; // 4: a few chunks per thread even out the uneven chunks
+
+ParallelGroup::ParallelGroup(napi_env env, uint32_t chunkNum, Priority priority)
+    : env_(env), priority_(priority), chunkNum_(chunkNum)
+{
+    groupId_ = reinterpret_cast<uint64_t>(this);
+}
+
+uint32_t ParallelGroup::GetChunkSize(uint32_t length, uint32_t chunkSize, uint32_t threadNum)
+{
+    if (chunkSize != 0) {
+        return chunkSize;
+    }
+    uint64_t expectedNum = static_cast<uint64_t>(threadNum == 0 ? 1 : threadNum) * CHUNKS_PER_THREAD;
+    uint64_t size = (static_cast<uint64_t>(length) + expectedNum - 1) / expectedNum;
+    return size == 0 ? 1 : static_cast<uint32_t>(size);
+}
+
+uint32_t ParallelGroup::GetChunkNum(uint32_t length, uint32_t chunkSize)
+{
+    if (chunkSize == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>((static_cast<uint64_t>(length) + chunkSize - 1) / chunkSize);
+}
+
+void ParallelGroup::HostEnvCleanupHook(void* data)
+{
+    if (data == nullptr) {
+        HILOG_ERROR("taskpool:: parallelGroup cleanupHook arg is nullptr");
+        return;
+    }
+    // the tasks in flight find no group when they come back
+    ParallelGroup* group = static_cast<ParallelGroup*>(data);
+    TaskGroupManager::GetInstance().RemoveParallelGroup(group->groupId_);
+    group->ReleaseData(group->env_);
+    delete group;
+}
+
+uint64_t ParallelGroup::GetGroupId() const
+{
+    return groupId_;
+}
+
+bool ParallelGroup::IsMapReduce() const
+{
+    return reduceFunction_ != nullptr;
+}
+
+void ParallelGroup::SetReduceFunction(const std::string& name, const std::shared_ptr<FunctionSerialization>& function)
+{
+    reduceName_ = name;
+    reduceFunction_ = function;
+    uint32_t levelSize = chunkNum_;
+    while (true) {
+        levels_.emplace_back(levelSize, nullptr);
+        if (levelSize <= 1) {
+            break;
+        }
+        levelSize = (levelSize + 1) / 2; // 2: a binary tree
+    }
+}
+
+void ParallelGroup::StoreTaskSlot(uint32_t taskId, Slot slot)
+{
+    taskSlots_.emplace(taskId, slot);
+}
+
+ParallelGroup::Slot ParallelGroup::TakeTaskSlot(uint32_t taskId)
+{
+    Slot slot {0, 0};
+    auto iter = taskSlots_.find(taskId);
+    if (iter != taskSlots_.end()) {
+        slot = iter->second;
+        taskSlots_.erase(iter);
+    }
+    return slot;
+}
+
+std::pair<napi_value, napi_value> ParallelGroup::UpdateSlot(napi_env env, Slot& slot, napi_value value)
+{
+    if (!IsMapReduce()) {
+        napi_value resArr = NapiHelper::GetReferenceValue(env, resArr_);
+        napi_set_element(env, resArr, slot.second, value);
+        if (++finishedNum_ == chunkNum_) {
+            Resolve(env, resArr);
+        }
+        return {nullptr, nullptr};
+    }
+    while (slot.first + 1 < levels_.size()) {
+        auto& level = levels_[slot.first];
+        uint32_t neighbour = slot.second ^ 1;
+        Slot parent {slot.first + 1, slot.second / 2}; // 2: a binary tree
+        if (neighbour >= level.size()) {
+            // the last value of a level with an odd size moves up unchanged
+            slot = parent;
+            continue;
+        }
+        if (level[neighbour] == nullptr) {
+            level[slot.second] = NapiHelper::CreateReference(env, value, 1);
+            return {nullptr, nullptr};
+        }
+        napi_value neighbourValue = NapiHelper::GetReferenceValue(env, level[neighbour]);
+        napi_delete_reference(env, level[neighbour]);
+        level[neighbour] = nullptr;
+        bool isLeft = slot.second < neighbour;
+        slot = parent;
+        return isLeft ? std::make_pair(value, neighbourValue) : std::make_pair(neighbourValue, value);
+    }
+    Resolve(env, value);
+    return {nullptr, nullptr};
+}
+
+void ParallelGroup::Resolve(napi_env env, napi_value value)
+{
+    if (isSettled_) {
+        return;
+    }
+    isSettled_ = true;
+    napi_resolve_deferred(env, deferred_, value);
+}
+
+void ParallelGroup::Reject(napi_env env, napi_value error)
+{
+    if (isSettled_) {
+        return;
+    }
+    isSettled_ = true;
+    if (error == nullptr) {
+        error = NapiHelper::GetUndefinedValue(env);
+    }
+    napi_reject_deferred(env, deferred_, error);
+}
+
+bool ParallelGroup::IsSettled() const
+{
+    return isSettled_;
+}
+
+bool ParallelGroup::IsFinished() const
+{
+    return isSettled_ && taskSlots_.empty();
+}
+
+void ParallelGroup::ReleaseData(napi_env env)
+{
+    if (resArr_ != nullptr) {
+        napi_delete_reference(env, resArr_);
+        resArr_ = nullptr;
+    }
+    for (auto& level : levels_) {
+        for (napi_ref& ref : level) {
+            if (ref != nullptr) {
+                napi_delete_reference(env, ref);
+                ref = nullptr;
+            }
+        }
+    }
+    FunctionCache::GetInstance().Release(env, reduceFunction_);
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
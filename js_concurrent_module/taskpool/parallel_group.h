@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_PARALLEL_GROUP_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_PARALLEL_GROUP_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "task.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+// The state of one parallelFor or mapReduce call, it lives on the host env until the promise is settled and
+// the last chunk or reduction task has come back.
+// The chunk results of parallelFor are stored by chunk index. The chunk results of mapReduce are the leaves of a
+// binary tree, two neighbours are reduced by a task as soon as both are available, so the reductions run on the
+// workers in parallel and keep the order of the chunks, only the associativity of reduceFn is required.
+class ParallelGroup {
+public:
+    // <level, index> of a value in the reduction tree
+    using Slot = std::pair<uint32_t, uint32_t>;
+
+    ParallelGroup(napi_env env, uint32_t chunkNum, Priority priority);
+    ~ParallelGroup() = default;
+
+    // chunkSize 0 splits the length into a few chunks per thread
+    static uint32_t GetChunkSize(uint32_t length, uint32_t chunkSize, uint32_t threadNum);
+    static uint32_t GetChunkNum(uint32_t length, uint32_t chunkSize);
+    static void HostEnvCleanupHook(void* data);
+
+    uint64_t GetGroupId() const;
+    bool IsMapReduce() const;
+    void SetReduceFunction(const std::string& name, const std::shared_ptr<FunctionSerialization>& function);
+    void StoreTaskSlot(uint32_t taskId, Slot slot);
+    // returns the slot of the task and forgets it, the group is done once no task is left and it is settled
+    Slot TakeTaskSlot(uint32_t taskId);
+    // stores the value of a slot, returns the pair to reduce if its neighbour is already there
+    // or <nullptr, nullptr> if the value has to wait, the value of the root settles the group
+    std::pair<napi_value, napi_value> UpdateSlot(napi_env env, Slot& slot, napi_value value);
+    void Resolve(napi_env env, napi_value value);
+    void Reject(napi_env env, napi_value error);
+    bool IsSettled() const;
+    bool IsFinished() const;
+    void ReleaseData(napi_env env);
+
+private:
+    ParallelGroup(const ParallelGroup &) = delete;
+    ParallelGroup& operator=(const ParallelGroup &) = delete;
+    ParallelGroup(ParallelGroup &&) = delete;
+    ParallelGroup& operator=(ParallelGroup &&) = delete;
+
+    friend class TaskPool;
+    friend class NativeEngineTest;
+
+    napi_env env_ = nullptr;
+    uint64_t groupId_ {};
+    napi_deferred deferred_ {nullptr};
+    Priority priority_ {Priority::DEFAULT};
+    uint32_t chunkNum_ {};
+    // the chunk results of parallelFor
+    napi_ref resArr_ {nullptr};
+    // the waiting values of mapReduce, levels_[0] are the chunk results and the last level is the root
+    std::vector<std::vector<napi_ref>> levels_ {};
+    std::string reduceName_ {};
+    std::shared_ptr<FunctionSerialization> reduceFunction_ {nullptr};
+    // <taskId, slot> of the tasks in flight
+    std::unordered_map<uint32_t, Slot> taskSlots_ {};
+    uint32_t finishedNum_ {};
+    bool isSettled_ {false};
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_PARALLEL_GROUP_H
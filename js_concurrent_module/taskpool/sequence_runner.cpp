@@ -21,6 +21,8 @@ namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
 static constexpr char EXECUTE_STR[] = "execute";
 static constexpr char SEQ_RUNNER_ID_STR[] = "seqRunnerId";
+static constexpr char SET_WORKER_AFFINITY_STR[] = "setWorkerAffinity";
+static constexpr uint64_t AFFINITY_IDLE_TIMEOUT = 1000; // 1000: ms a runner stays bound to its worker when idle
 
 BaseRunnerManager& SequenceRunner::GetManager()
 {
@@ -34,6 +36,7 @@ bool SequenceRunner::SeqRunnerConstructorInner(napi_env env, napi_value& thisVar
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_PROPERTY(SEQ_RUNNER_ID_STR, napiSeqRunnerId),
         DECLARE_NAPI_FUNCTION(EXECUTE_STR, Execute),
+        DECLARE_NAPI_FUNCTION(SET_WORKER_AFFINITY_STR, SetWorkerAffinity),
     };
     return RunnerConstructorInner(env, thisVar, seqRunner, properties,
                                   sizeof(properties) / sizeof(properties[0]));
@@ -149,6 +152,7 @@ napi_value SequenceRunner::Execute(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
     std::string message = "";
+    Worker* affinityWorker = seqRunner->GetAffinityWorker();
     if (seqRunner->UpdateCurrentTaskId(task->taskId_)) {
         task->StoreEnqueueTime();
         message = " taskId " + std::to_string(task->taskId_) + " in seqRunner " + std::to_string(seqRunnerId) +
@@ -157,7 +161,7 @@ napi_value SequenceRunner::Execute(napi_env env, napi_callback_info cbinfo)
         message += " " + task->enqueueTime_;
         task->IncreaseRefCount();
         task->UpdateTaskStateToWaiting();
-        ExecuteTaskImmediately(task->taskId_, seqRunner->priority_);
+        ExecuteTaskImmediately(task->taskId_, seqRunner->priority_, affinityWorker);
     } else {
         message = " add taskId: " + std::to_string(task->taskId_) + " to seqRunner " +
                 std::to_string(seqRunnerId) + ".";
@@ -169,9 +173,70 @@ napi_value SequenceRunner::Execute(napi_env env, napi_callback_info cbinfo)
     return promise;
 }
 
-void SequenceRunner::ExecuteTaskImmediately(uint32_t taskId, Priority priority)
+void SequenceRunner::ExecuteTaskImmediately(uint32_t taskId, Priority priority, Worker* affinityWorker)
 {
-    TaskManager::GetInstance().EnqueueTaskId(taskId, priority);
+    TaskManager::GetInstance().EnqueueTaskId(taskId, priority, affinityWorker);
+}
+
+napi_value SequenceRunner::SetWorkerAffinity(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = 2; // 2: isAffinity and idleTimeout
+    napi_value args[2]; // 2: isAffinity and idleTimeout
+    napi_value thisVar;
+    napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
+    if (argc < 1 || !NapiHelper::IsTypeForNapiValue(env, args[0], napi_boolean)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the type of setWorkerAffinity's first param must be boolean.");
+        return nullptr;
+    }
+    uint64_t idleTimeout = AFFINITY_IDLE_TIMEOUT;
+    if (argc == 2 && NapiHelper::IsNotUndefined(env, args[1])) { // 2: idleTimeout is given
+        if (!NapiHelper::IsNumber(env, args[1]) || NapiHelper::GetInt32Value(env, args[1]) < 0) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the type of setWorkerAffinity's second param must be a non-negative number.");
+            return nullptr;
+        }
+        idleTimeout = NapiHelper::GetUint32Value(env, args[1]);
+    }
+    napi_value napiSeqRunnerId = NapiHelper::GetNameProperty(env, thisVar, SEQ_RUNNER_ID_STR);
+    uint64_t seqRunnerId = NapiHelper::GetUint64Value(env, napiSeqRunnerId);
+    SequenceRunner* seqRunner = SequenceRunnerManager::GetInstance().GetRunner(seqRunnerId);
+    if (seqRunner == nullptr) {
+        return nullptr;
+    }
+    std::unique_lock<std::shared_mutex> lock(seqRunner->taskMutex_);
+    seqRunner->isAffinity_ = NapiHelper::GetBooleanValue(env, args[0]);
+    seqRunner->affinityIdleTimeout_ = idleTimeout;
+    seqRunner->affinityWorker_ = nullptr;
+    return nullptr;
+}
+
+void SequenceRunner::UpdateAffinityWorker(Task* lastTask)
+{
+    std::unique_lock<std::shared_mutex> lock(taskMutex_);
+    if (!isAffinity_) {
+        return;
+    }
+    // a task canceled before it ran has no worker, the runner stays with the one it has
+    Worker* worker = lastTask->GetWorker();
+    if (worker != nullptr) {
+        affinityWorker_ = worker;
+    }
+    affinityTime_ = ConcurrentHelper::GetMilliseconds();
+}
+
+Worker* SequenceRunner::GetAffinityWorker()
+{
+    std::unique_lock<std::shared_mutex> lock(taskMutex_);
+    if (!isAffinity_ || affinityWorker_ == nullptr) {
+        return nullptr;
+    }
+    // the runner has had no work for a while, the next task may run on any worker and is bound to that one
+    if (ConcurrentHelper::GetMilliseconds() - affinityTime_ > affinityIdleTimeout_) {
+        affinityWorker_ = nullptr;
+        return nullptr;
+    }
+    return affinityWorker_;
 }
 
 void SequenceRunner::AddTask(Task* task)
@@ -182,6 +247,7 @@ void SequenceRunner::AddTask(Task* task)
 
 void SequenceRunner::TriggerTask(napi_env env)
 {
+    Worker* affinityWorker = GetAffinityWorker();
     std::unique_lock<std::shared_mutex> lock(taskMutex_);
     if (tasks_.empty()) {
         currentTaskId_ = 0;
@@ -215,7 +281,7 @@ void SequenceRunner::TriggerTask(napi_env env)
         HILOG_DEBUG("seqRunner:: Trigger task %{public}s in seqRunner %{public}s.",
                     std::to_string(task->taskId_).c_str(), std::to_string(runnerId_).c_str());
         task->StoreEnqueueTime();
-        TaskManager::GetInstance().EnqueueTaskId(task->taskId_, priority_);
+        TaskManager::GetInstance().EnqueueTaskId(task->taskId_, priority_, affinityWorker);
     }
 }
 
@@ -31,8 +31,13 @@ public:
         : BaseRunner(name, isGlobal), priority_(priority) {}
     static napi_value SeqRunnerConstructor(napi_env env, napi_callback_info cbinfo);
     static napi_value Execute(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetWorkerAffinity(napi_env env, napi_callback_info cbinfo);
     void AddTask(Task* task);
     void TriggerTask(napi_env env);
+    // for the worker affinity, the next task is bound to the worker which has run the last one
+    void UpdateAffinityWorker(Task* lastTask);
+    // returns nullptr if the affinity is off or the runner has been idle for longer than the idle timeout
+    Worker* GetAffinityWorker();
 
 protected:
     BaseRunnerManager& GetManager() override;
@@ -45,7 +50,7 @@ private:
     SequenceRunner(SequenceRunner &&) = delete;
     SequenceRunner& operator=(SequenceRunner &&) = delete;
 
-    static void ExecuteTaskImmediately(uint32_t taskId, Priority priority);
+    static void ExecuteTaskImmediately(uint32_t taskId, Priority priority, Worker* affinityWorker);
     static bool SeqRunnerConstructorInner(napi_env env, napi_value& thisVar, SequenceRunner* seqRunner);
     bool UpdateCurrentTaskId(uint32_t taskId);
 
@@ -53,6 +58,11 @@ private:
 public:
     std::atomic<uint64_t> currentTaskId_ {};
     Priority priority_ {Priority::DEFAULT};
+    // for the worker affinity, written under taskMutex_
+    bool isAffinity_ {false};
+    uint64_t affinityIdleTimeout_ {};
+    Worker* affinityWorker_ {nullptr}; // only compared with the live workers, never dereferenced here
+    uint64_t affinityTime_ {}; // when the last task of the runner finished
 };
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
 #endif // JS_CONCURRENT_MODULE_TASKPOOL_RUNNER_H
\ No newline at end of file
@@ -101,6 +101,7 @@ bool SequenceRunnerManager::TriggerSeqRunner(napi_env env, Task* lastTask)
         HILOG_ERROR("taskpool:: only front task can trigger seqRunner.");
         return false;
     }
+    seqRunner->UpdateAffinityWorker(lastTask);
     seqRunner->TriggerTask(env);
     return true;
 }
@@ -16,10 +16,12 @@
 #include "task.h"
 
 #include "async_runner_manager.h"
+#include "function_cache.h"
 #include "helper/concurrent_helper.h"
 #include "helper/hitrace_helper.h"
 #include "sequence_runner_manager.h"
 #include "taskpool.h"
+#include "timer_wheel.h"
 #include "worker.h"
 #if defined(ENABLE_CONCURRENCY_INTEROP)
 #include "napi/native_node_hybrid_api.h"
@@ -29,12 +31,16 @@ namespace Commonlibrary::Concurrent::TaskPoolModule {
 static constexpr char ONRECEIVEDATA_STR[] = "onReceiveData";
 static constexpr char SETTRANSFERLIST_STR[] = "setTransferList";
 static constexpr char SET_CLONE_LIST_STR[] = "setCloneList";
+static constexpr char SET_RESULT_TRANSFER_LIST_STR[] = "setResultTransferList";
+static constexpr char SET_WORKLOAD_STR[] = "setWorkload";
 static constexpr char ONENQUEUED_STR[] = "onEnqueued";
 static constexpr char ONSTARTEXECUTION_STR[] = "onStartExecution";
 static constexpr char ONEXECUTIONFAILED_STR[] = "onExecutionFailed";
 static constexpr char ONEXECUTIONSUCCEEDED_STR[] = "onExecutionSucceeded";
 static constexpr char ISDONE_STR[] = "isDone";
 static constexpr char ON_RESULT_STR[] = "TaskPoolOnResultTask";
+static constexpr size_t SEND_DATA_BATCH_NUM = 64; // 64: messages of sendData posted in one batch at most
+static constexpr uint64_t SEND_DATA_BATCH_INTERVAL = 16; // 16: ms between two batches of sendData at least
 
 const std::unordered_map<Priority, napi_event_priority> g_napiPriorityMap = {
     {Priority::IDLE, napi_eprio_idle},
@@ -47,6 +53,20 @@ const std::unordered_map<Priority, napi_event_priority> g_napiPriorityMap = {
 
 using namespace Commonlibrary::Concurrent::Common::Helper;
 
+TaskInfo::~TaskInfo()
+{
+    if (serializationFunction != nullptr) {
+        napi_delete_serialization_data(hostEnv, serializationFunction);
+        serializationFunction = nullptr;
+    }
+
+    if (serializationArguments != nullptr) {
+        napi_delete_serialization_data(hostEnv, serializationArguments);
+        serializationArguments = nullptr;
+    }
+    FunctionCache::GetInstance().Release(hostEnv, sharedFunction);
+}
+
 napi_value Task::TaskConstructor(napi_env env, napi_callback_info cbinfo)
 {
     // check argv count
@@ -221,6 +241,8 @@ Task* Task::GenerateTask(napi_env env, napi_value napiTask, napi_value func,
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_FUNCTION(SETTRANSFERLIST_STR, SetTransferList),
         DECLARE_NAPI_FUNCTION(SET_CLONE_LIST_STR, SetCloneList),
+        DECLARE_NAPI_FUNCTION(SET_RESULT_TRANSFER_LIST_STR, SetResultTransferList),
+        DECLARE_NAPI_FUNCTION(SET_WORKLOAD_STR, SetWorkload),
         DECLARE_NAPI_FUNCTION(ONRECEIVEDATA_STR, OnReceiveData),
         DECLARE_NAPI_FUNCTION(ADD_DEPENDENCY_STR, AddDependency),
         DECLARE_NAPI_FUNCTION(REMOVE_DEPENDENCY_STR, RemoveDependency),
@@ -266,6 +288,30 @@ Task* Task::GenerateFunctionTask(napi_env env, napi_value func, napi_value* args
     return task;
 }
 
+Task* Task::GenerateBatchFunctionTask(napi_env env, const std::string& name,
+                                      const std::shared_ptr<FunctionSerialization>& function, napi_value args,
+                                      Priority priority)
+{
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    void* serializationArguments = SerializeArguments(env, args, {undefined, undefined, true, false});
+    if (serializationArguments == nullptr) {
+        HILOG_ERROR("taskpool:: task GenerateBatchFunctionTask end, serializationArguments is nullptr");
+        return nullptr;
+    }
+    TaskInfo* taskInfo = new TaskInfo(env);
+    taskInfo->sharedFunction = function;
+    taskInfo->serializationArguments = serializationArguments;
+    taskInfo->priority = priority;
+    reinterpret_cast<NativeEngine*>(env)->IncreaseSubEnvCounter();
+    Task* task = new Task(env, TaskType::FUNCTION_TASK, name.c_str());
+    task->currentTaskInfo_ = taskInfo;
+    task->InitHandle(env);
+    if (!task->IsMainThreadTask()) {
+        napi_add_env_cleanup_hook(env, CleanupHookFunc, task);
+    }
+    return task;
+}
+
 napi_value Task::GetTaskInfoPromise(napi_env env, napi_value task, TaskType taskType, Priority priority)
 {
     TaskInfo* taskInfo = GetTaskInfo(env, task, priority);
@@ -415,6 +461,83 @@ napi_value Task::SetCloneList(napi_env env, napi_callback_info cbinfo)
     return nullptr;
 }
 
+napi_value Task::SetResultTransferList(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_value thisVar;
+    napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
+    if (argc > 1) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the number of setResultTransferList parma must be less than 2.");
+        return nullptr;
+    }
+    Task* task = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void**>(&task));
+    if (task == nullptr) {
+        HILOG_ERROR("taskpool:: task is nullptr");
+        return nullptr;
+    }
+    // the buffers of the result live on the worker, so they are named by their keys in the result
+    std::vector<std::string> resultTransferList {};
+    if (argc == 1) {
+        if (!NapiHelper::IsArray(env, args[0])) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the type of setResultTransferList first param must be array.");
+            return nullptr;
+        }
+        uint32_t arrayLength = NapiHelper::GetArrayLength(env, args[0]);
+        for (uint32_t i = 0; i < arrayLength; i++) {
+            napi_value key = NapiHelper::GetElement(env, args[0], i);
+            if (NapiHelper::IsNumber(env, key)) {
+                resultTransferList.push_back(std::to_string(NapiHelper::GetUint32Value(env, key)));
+            } else if (NapiHelper::IsString(env, key)) {
+                resultTransferList.push_back(NapiHelper::GetString(env, key));
+            } else {
+                ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                    "the type of the element in array must be string or number.");
+                return nullptr;
+            }
+        }
+    }
+    std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
+    task->hasResultTransferList_ = true;
+    task->resultTransferList_ = std::move(resultTransferList);
+    return nullptr;
+}
+
+napi_value Task::SetWorkload(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_value thisVar;
+    napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
+    if (argc != 1) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the number of setWorkload param must be 1.");
+        return nullptr;
+    }
+    if (!NapiHelper::IsNumber(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of setWorkload param must be number.");
+        return nullptr;
+    }
+    uint32_t workload = NapiHelper::GetUint32Value(env, args[0]);
+    if (workload > static_cast<uint32_t>(Workload::BACKGROUND)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the value of setWorkload param is error.");
+        return nullptr;
+    }
+    Task* task = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void**>(&task));
+    if (task == nullptr) {
+        HILOG_ERROR("taskpool:: task is nullptr");
+        return nullptr;
+    }
+    task->workload_ = static_cast<Workload>(workload);
+    if (task->workload_ != Workload::DEFAULT) {
+        TaskManager::GetInstance().EnableCoreAffinity();
+    }
+    return nullptr;
+}
+
 napi_value Task::IsCanceled(napi_env env, napi_callback_info cbinfo)
 {
     bool isCanceled = false;
@@ -428,8 +551,8 @@ napi_value Task::IsCanceled(napi_env env, napi_callback_info cbinfo)
     if (data == nullptr) {
         HILOG_ERROR("taskpool:: call isCanceled not in Concurrent function");
     } else {
-        Task* task = static_cast<Task*>(data);
-        if (!TaskManager::GetInstance().IsValidTask(task)) {
+        Task* task = TaskManager::GetInstance().GetValidTask(data);
+        if (task == nullptr) {
             HILOG_ERROR("taskpool:: call isCanceled because task is invalid");
             return NapiHelper::CreateBooleanValue(env, isCanceled);
         }
@@ -441,10 +564,10 @@ napi_value Task::IsCanceled(napi_env env, napi_callback_info cbinfo)
 napi_value Task::OnReceiveData(napi_env env, napi_callback_info cbinfo)
 {
     size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
-    if (argc >= 2) { // 2: the number of parmas
-        HILOG_ERROR("taskpool:: the number of OnReceiveData parma must be less than 2");
+    if (argc > 2) { // 2: the callback and the options
+        HILOG_ERROR("taskpool:: the number of OnReceiveData parma must be less than 3");
         ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
-            "the number of OnReceiveData parma must be less than 2.");
+            "the number of OnReceiveData parma must be less than 3.");
         return nullptr;
     }
 
@@ -458,7 +581,7 @@ napi_value Task::OnReceiveData(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
 
-    napi_value args[1];
+    napi_value args[2]; // 2: the callback and the options
     napi_get_cb_info(env, cbinfo, &argc, args, &thisVar, nullptr);
     napi_valuetype type;
     NAPI_CALL(env, napi_typeof(env, args[0], &type));
@@ -468,6 +591,19 @@ napi_value Task::OnReceiveData(napi_env env, napi_callback_info cbinfo)
             "the type of onReceiveData's parameter must be function.");
         return nullptr;
     }
+    bool isBatch = false;
+    if (argc == 2 && NapiHelper::IsNotUndefined(env, args[1])) { // 2: the options are given
+        if (!NapiHelper::IsObject(env, args[1])) {
+            HILOG_ERROR("taskpool:: OnReceiveData's options should be object");
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the type of onReceiveData's options must be object.");
+            return nullptr;
+        }
+        napi_value batch = NapiHelper::GetNameProperty(env, args[1], "batch");
+        if (NapiHelper::IsTypeForNapiValue(env, batch, napi_boolean)) {
+            isBatch = NapiHelper::GetBooleanValue(env, batch);
+        }
+    }
     // store callbackInfo
     napi_value napiTaskId = NapiHelper::GetNameProperty(env, thisVar, "taskId");
     uint32_t taskId = NapiHelper::GetUint32Value(env, napiTaskId);
@@ -478,6 +614,7 @@ napi_value Task::OnReceiveData(napi_env env, napi_callback_info cbinfo)
     }
     napi_ref callbackRef = Helper::NapiHelper::CreateReference(env, args[0], 1);
     std::shared_ptr<CallbackInfo> callbackInfo = std::make_shared<CallbackInfo>(env, 1, callbackRef);
+    callbackInfo->isBatch = isBatch;
     TaskManager::GetInstance().RegisterCallback(env, taskId, callbackInfo, "OnReceiveData: Add listener");
     return nullptr;
 }
@@ -507,8 +644,8 @@ napi_value Task::SendData(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
 
-    Task* task = static_cast<Task*>(data);
-    if (!TaskManager::GetInstance().IsValidTask(task)) { // LOCV_EXCL_BR_LINE
+    Task* task = TaskManager::GetInstance().GetValidTask(data);
+    if (task == nullptr) { // LOCV_EXCL_BR_LINE
         HILOG_ERROR("taskpool:: SendData is not called because task is invalid");
         ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "sendData: task is invalid");
         return nullptr;
@@ -539,11 +676,59 @@ napi_value Task::SendData(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
 
-    TaskResultInfo* resultInfo = new TaskResultInfo(env, task->GetTaskId(), serializationArgs);
-    TaskManager::GetInstance().ExecuteSendData(env, resultInfo, task->GetTaskId(), task);
+    if (!TaskManager::GetInstance().HasSendDataCallback(task->GetTaskId())) {
+        HILOG_ERROR("taskpool:: the callback in SendData is not registered on the host side");
+        ErrorHelper::ThrowError(env, ErrorHelper::ERR_NOT_REGISTERED);
+        napi_delete_serialization_data(env, serializationArgs);
+        return nullptr;
+    }
+    task->AppendSendData(env, serializationArgs);
     return nullptr;
 }
 
+void Task::AppendSendData(napi_env env, void* serializationArgs)
+{
+    uint64_t now = ConcurrentHelper::GetMilliseconds();
+    std::vector<void*> batch {};
+    bool isOpened = false;
+    {
+        std::lock_guard<std::mutex> lock(sendDataMutex_);
+        isOpened = sendDataBatch_.empty();
+        sendDataBatch_.push_back(serializationArgs);
+        // a message after a quiet interval is posted at once, a full batch too
+        if (sendDataBatch_.size() >= SEND_DATA_BATCH_NUM || now - sendDataFlushTime_ >= SEND_DATA_BATCH_INTERVAL) {
+            batch.swap(sendDataBatch_);
+            sendDataFlushTime_ = now;
+        }
+    }
+    // a burst joins the open batch, the host takes it with the messages sent until then when the flush runs
+    if (batch.empty() && !isOpened) {
+        return;
+    }
+    TaskResultInfo* resultInfo = new TaskResultInfo(env, taskId_, std::move(batch));
+    // there is no caller to throw to, the messages are dropped if the callback has been removed meanwhile
+    TaskManager::GetInstance().ExecuteSendData(env, resultInfo, taskId_, this, false);
+}
+
+void Task::FlushSendData(napi_env env)
+{
+    std::vector<void*> batch = TakeSendData();
+    if (batch.empty()) {
+        return;
+    }
+    TaskResultInfo* resultInfo = new TaskResultInfo(env, taskId_, std::move(batch));
+    TaskManager::GetInstance().ExecuteSendData(env, resultInfo, taskId_, this, false);
+}
+
+std::vector<void*> Task::TakeSendData()
+{
+    std::vector<void*> batch {};
+    std::lock_guard<std::mutex> lock(sendDataMutex_);
+    batch.swap(sendDataBatch_);
+    sendDataFlushTime_ = ConcurrentHelper::GetMilliseconds();
+    return batch;
+}
+
 napi_value Task::AddDependency(napi_env env, napi_callback_info cbinfo)
 {
     size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
@@ -1058,6 +1243,11 @@ bool Task::IsFunctionTask() const
     return taskType_ == TaskType::FUNCTION_TASK;
 }
 
+bool Task::IsParallelTask() const
+{
+    return parallelId_ != 0;
+}
+
 bool Task::IsLongTask() const
 {
     return isLongTask_;
@@ -1087,12 +1277,18 @@ TaskInfo* Task::GenerateTaskInfo(napi_env env, napi_value func, napi_value args,
     std::tuple<napi_value, napi_value, bool, bool> params = {
         transferList, cloneList, defaultTransfer, defaultCloneSendable
     };
-    auto [serializationFunction, serializationArguments] = GetSerializeResult(env, func, args, params);
-    if (serializationFunction == nullptr || serializationArguments == nullptr) {
+    // the function is serialized once and shared by its later executions
+    auto sharedFunction = FunctionCache::GetInstance().GetSerialization(env, func, defaultTransfer,
+                                                                        defaultCloneSendable);
+    if (sharedFunction == nullptr) {
+        return nullptr;
+    }
+    void* serializationArguments = SerializeArguments(env, args, params);
+    if (serializationArguments == nullptr) {
         return nullptr;
     }
     TaskInfo* taskInfo = new TaskInfo(env);
-    taskInfo->serializationFunction = serializationFunction;
+    taskInfo->sharedFunction = sharedFunction;
     taskInfo->serializationArguments = serializationArguments;
     taskInfo->priority = priority;
     reinterpret_cast<NativeEngine*>(env)->IncreaseSubEnvCounter();
@@ -1176,6 +1372,7 @@ napi_value Task::DeserializeValue(napi_env env, napi_value* func, napi_value* ar
 {
     void* serializationFunction = nullptr;
     void* serializationArguments = nullptr;
+    std::shared_ptr<FunctionSerialization> sharedFunction = nullptr;
     {
         std::lock_guard<std::recursive_mutex> lock(taskMutex_);
         if (UNLIKELY(currentTaskInfo_ == nullptr)) {
@@ -1184,26 +1381,24 @@ napi_value Task::DeserializeValue(napi_env env, napi_value* func, napi_value* ar
         }
         serializationFunction = currentTaskInfo_->serializationFunction;
         serializationArguments = currentTaskInfo_->serializationArguments;
+        sharedFunction = currentTaskInfo_->sharedFunction;
         if (!IsGroupFunctionTask()) {
             currentTaskInfo_->serializationFunction = nullptr;
             currentTaskInfo_->serializationArguments = nullptr;
+            currentTaskInfo_->sharedFunction = nullptr;
         }
     }
     AsyncStackScope asyncStackScope(this);
     napi_status status = napi_ok;
     std::string errMessage = "";
-#if defined(ENABLE_CONCURRENCY_INTEROP)
-    bool isHybridVM = ANIHelper::IsHybridVM(env);
-    if (isHybridVM) {
-        status = napi_deserialize_hybrid(env, serializationFunction, func);
+    if (sharedFunction != nullptr) {
+        status = DeserializeSharedFunction(env, sharedFunction, func);
+        FunctionCache::GetInstance().Release(env, sharedFunction);
     } else {
-        status = napi_deserialize(env, serializationFunction, func);
-    }
-#else
-    status = napi_deserialize(env, serializationFunction, func);
-#endif
-    if (!IsGroupFunctionTask()) {
-        napi_delete_serialization_data(env, serializationFunction);
+        status = DeserializeData(env, serializationFunction, func);
+        if (!IsGroupFunctionTask()) {
+            napi_delete_serialization_data(env, serializationFunction);
+        }
     }
     if (status != napi_ok || func == nullptr) {
         errMessage = "taskpool:: failed to deserialize function.";
@@ -1213,15 +1408,7 @@ napi_value Task::DeserializeValue(napi_env env, napi_value* func, napi_value* ar
         return err;
     }
 
-#if defined(ENABLE_CONCURRENCY_INTEROP)
-    if (isHybridVM) {
-        status = napi_deserialize_hybrid(env, serializationArguments, args);
-    } else {
-        status = napi_deserialize(env, serializationArguments, args);
-    }
-#else
-    status = napi_deserialize(env, serializationArguments, args);
-#endif
+    status = DeserializeData(env, serializationArguments, args);
     if (!IsGroupFunctionTask()) {
         napi_delete_serialization_data(env, serializationArguments);
     }
@@ -1235,6 +1422,42 @@ napi_value Task::DeserializeValue(napi_env env, napi_value* func, napi_value* ar
     return nullptr;
 }
 
+napi_status Task::DeserializeSharedFunction(napi_env env, const std::shared_ptr<FunctionSerialization>& function,
+                                            napi_value* func)
+{
+    // reuse the function already deserialized by this worker
+    Worker* worker = static_cast<Worker*>(worker_);
+    if (worker != nullptr) {
+        *func = worker->GetCachedFunction(env, function->id);
+        if (*func != nullptr) {
+            return napi_ok;
+        }
+    }
+    napi_status status = napi_ok;
+    {
+        std::lock_guard<std::mutex> lock(function->mutex);
+        if (function->data == nullptr) {
+            // released with its host env
+            return napi_invalid_arg;
+        }
+        status = DeserializeData(env, function->data, func);
+    }
+    if (status == napi_ok && worker != nullptr) {
+        worker->CacheFunction(env, function->id, *func);
+    }
+    return status;
+}
+
+napi_status Task::DeserializeData(napi_env env, void* data, napi_value* value)
+{
+#if defined(ENABLE_CONCURRENCY_INTEROP)
+    if (ANIHelper::IsHybridVM(env)) {
+        return napi_deserialize_hybrid(env, data, value);
+    }
+#endif
+    return napi_deserialize(env, data, value);
+}
+
 void Task::StoreTaskDuration()
 {
     HILOG_DEBUG("taskpool:: task:%{public}s StoreTaskDuration", std::to_string(taskId_).c_str());
@@ -1521,19 +1744,14 @@ void Task::ClearDelayedTimers()
     std::list<napi_deferred> deferreds {};
     {
         std::lock_guard<std::recursive_mutex> lock(taskMutex_);
-        TaskMessage* taskMessage = nullptr;
-        for (auto t: delayedTimers_) {
-            if (t == nullptr) {
+        for (auto& [timerId, taskMessage] : delayedTimers_) {
+            if (taskMessage == nullptr) {
                 continue;
             }
-            taskMessage = static_cast<TaskMessage*>(t->data);
+            // the message is owned here, the wheel may already be gone when the env is cleaned up
+            TimerWheel::CancelTimer(env_, timerId);
             deferreds.push_back(taskMessage->deferred);
             napi_reference_unref(env_, taskRef_, nullptr);
-            uv_timer_stop(t);
-            uv_close(reinterpret_cast<uv_handle_t*>(t), [](uv_handle_t* handle) {
-                delete (uv_timer_t*)handle;
-                handle = nullptr;
-            });
             delete taskMessage;
             taskMessage = nullptr;
         }
@@ -2037,7 +2255,20 @@ std::tuple<napi_value, napi_value, napi_value, napi_value> Task::GetSerializePar
 std::tuple<void*, void*> Task::GetSerializeResult(napi_env env, napi_value func, napi_value args,
                                                   std::tuple<napi_value, napi_value, bool, bool> transferAndCloneParams)
 {
-    auto [transferList, cloneList, defaultTransfer, defaultCloneSendable] = transferAndCloneParams;
+    [[maybe_unused]] auto [transferList, cloneList, defaultTransfer, defaultCloneSendable] = transferAndCloneParams;
+    void* serializationFunction = SerializeFunction(env, func, defaultTransfer, defaultCloneSendable);
+    if (serializationFunction == nullptr) {
+        return {nullptr, nullptr};
+    }
+    void* serializationArguments = SerializeArguments(env, args, transferAndCloneParams);
+    if (serializationArguments == nullptr) { // LOCV_EXCL_BR_LINE
+        return {nullptr, nullptr};
+    }
+    return {serializationFunction, serializationArguments};
+}
+
+void* Task::SerializeFunction(napi_env env, napi_value func, bool defaultTransfer, bool defaultCloneSendable)
+{
     napi_value undefined = NapiHelper::GetUndefinedValue(env);
     void* serializationFunction = nullptr;
     std::string errString = "";
@@ -2060,12 +2291,20 @@ std::tuple<void*, void*> Task::GetSerializeResult(napi_env env, napi_value func,
         errMessage = "taskpool: failed to serialize function.\nSerialize error: " + errString;
         HILOG_ERROR("%{public}s", errMessage.c_str());
         ErrorHelper::ThrowError(env, ErrorHelper::ERR_NOT_CONCURRENT_FUNCTION, errMessage.c_str());
-        return {nullptr, nullptr};
+        return nullptr;
     }
+    return serializationFunction;
+}
+
+void* Task::SerializeArguments(napi_env env, napi_value args,
+                               std::tuple<napi_value, napi_value, bool, bool> transferAndCloneParams)
+{
+    auto [transferList, cloneList, defaultTransfer, defaultCloneSendable] = transferAndCloneParams;
     void* serializationArguments = nullptr;
-    errMessage = "";
+    std::string errString = "";
+    napi_status status = napi_ok;
 #if defined(ENABLE_CONCURRENCY_INTEROP)
-    if (isHybridVM) {
+    if (ANIHelper::IsHybridVM(env)) {
         napi_serialize_hybrid(env, args, transferList, cloneList, &serializationArguments);
         status = (serializationArguments != nullptr) ? napi_ok : napi_generic_failure;
     } else {
@@ -2077,12 +2316,12 @@ std::tuple<void*, void*> Task::GetSerializeResult(napi_env env, napi_value func,
                                              defaultCloneSendable, &serializationArguments, errString);
 #endif
     if (status != napi_ok || serializationArguments == nullptr) { // LOCV_EXCL_BR_LINE
-        errMessage = "taskpool: failed to serialize arguments.\nSerialize error: " + errString;
+        std::string errMessage = "taskpool: failed to serialize arguments.\nSerialize error: " + errString;
         HILOG_ERROR("%{public}s", errMessage.c_str());
         ErrorHelper::ThrowError(env, ErrorHelper::ERR_WORKER_SERIALIZATION, errMessage.c_str());
-        return {nullptr, nullptr};
+        return nullptr;
     }
-    return {serializationFunction, serializationArguments};
+    return serializationArguments;
 }
 
 void Task::TriggerEnqueueCallback()
@@ -2158,11 +2397,11 @@ bool Task::UpdateTaskStateToTimeout()
 void Task::ClearTimeoutTimer()
 {
     std::lock_guard<std::recursive_mutex> lock(taskMutex_);
-    if (!IsTimeoutTask() || timer_ == nullptr || IsTimeoutState()) {
+    if (!IsTimeoutTask() || timerId_ == 0 || IsTimeoutState()) {
         return;
     }
-    uv_timer_stop(timer_);
-    ConcurrentHelper::UvHandleClose(timer_);
+    delete static_cast<TaskTimeoutMessage*>(TimerWheel::CancelTimer(env_, timerId_));
+    timerId_ = 0;
 }
 
 void Task::SetTimeout(uint32_t timeout)
@@ -2171,6 +2410,21 @@ void Task::SetTimeout(uint32_t timeout)
     timeout_ = timeout;
 }
 
+void Task::SetDeadline(uint32_t deadline)
+{
+    deadline_ = deadline == 0 ? 0 : ConcurrentHelper::GetMilliseconds() + deadline;
+}
+
+uint64_t Task::GetDeadline() const
+{
+    return deadline_;
+}
+
+bool Task::HasDeadline() const
+{
+    return deadline_ != 0;
+}
+
 bool Task::CheckAddDependency(napi_env env, Task* task)
 {
     std::string errMessage = "";
@@ -16,8 +16,10 @@
 #ifndef JS_CONCURRENT_MODULE_TASKPOOL_TASK_H
 #define JS_CONCURRENT_MODULE_TASKPOOL_TASK_H
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -25,6 +27,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <uv.h>
+#include <vector>
 
 #include "helper/async_stack_helper.h"
 #include "helper/concurrent_helper.h"
@@ -57,28 +60,39 @@ enum TaskType {
     GROUP_FUNCTION_TASK,
     ASYNCRUNNER_TASK
 };
+// set by setWorkload, the COMPUTE tasks run on the performance cores and the BACKGROUND tasks on the efficiency
+// cores, the idle workers already bound to those cores are preferred
+enum class Workload : uint32_t { DEFAULT, COMPUTE, BACKGROUND };
 
 struct GroupInfo;
+struct TaskMessage;
 class Worker;
-struct TaskInfo {
-    explicit TaskInfo(napi_env env): hostEnv(env) {}
-    ~TaskInfo()
+// the serialization data of a concurrent function shared by several tasks, the data is owned by the
+// FunctionCache of its host env and released there on the host thread, the last owner may run on a worker
+struct FunctionSerialization {
+    FunctionSerialization(napi_env env, void* data) : hostEnv(env), data(data), id(GenerateId()) {}
+    ~FunctionSerialization() = default;
+    static uint64_t GenerateId()
     {
-        if (serializationFunction != nullptr) {
-            napi_delete_serialization_data(hostEnv, serializationFunction);
-            serializationFunction = nullptr;
-        }
-
-        if (serializationArguments != nullptr) {
-            napi_delete_serialization_data(hostEnv, serializationArguments);
-            serializationArguments = nullptr;
-        }
+        static std::atomic<uint64_t> nextId {1};
+        return nextId++;
     }
+
+    napi_env hostEnv = nullptr;
+    void* data = nullptr; // nullptr once released with its host env
+    uint64_t id = 0; // never reused, workers key their deserialized functions by it
+    std::mutex mutex; // the data is not consumed by deserialization, workers deserialize it one at a time
+};
+
+struct TaskInfo {
+    explicit TaskInfo(napi_env env): hostEnv(env) {}
+    ~TaskInfo();
     napi_env hostEnv = nullptr;
     napi_deferred deferred = nullptr;
     Priority priority = Priority::DEFAULT;
     void* serializationFunction = nullptr;
     void* serializationArguments = nullptr;
+    std::shared_ptr<FunctionSerialization> sharedFunction = nullptr; // used instead of serializationFunction
 };
 
 struct TaskCurrentInfo {
@@ -133,12 +147,19 @@ public:
     {
         AsyncStackHelper::ReleaseStackId(GetAsyncStackID());
         SetAsyncStackID(0);
+        for (void* serializationArgs : sendDataBatch_) {
+            if (serializationArgs != nullptr) {
+                napi_delete_serialization_data(env_, serializationArgs);
+            }
+        }
     }
 
     static napi_value TaskConstructor(napi_env env, napi_callback_info cbinfo);
     static napi_value LongTaskConstructor(napi_env env, napi_callback_info cbinfo);
     static napi_value SetTransferList(napi_env env, napi_callback_info cbinfo);
     static napi_value SetCloneList(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetResultTransferList(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetWorkload(napi_env env, napi_callback_info cbinfo);
     static napi_value IsCanceled(napi_env env, napi_callback_info cbinfo);
     static napi_value OnReceiveData(napi_env env, napi_callback_info cbinfo);
     static napi_value SendData(napi_env env, napi_callback_info cbinfo);
@@ -159,6 +180,10 @@ public:
     static Task* GenerateTask(napi_env env, napi_value task, napi_value func,
                               napi_value name, napi_value* args, size_t argc);
     static Task* GenerateFunctionTask(napi_env env, napi_value func, napi_value* args, size_t argc, TaskType type);
+    // the task is not stored, the caller stores the whole batch with TaskManager::StoreTasks
+    static Task* GenerateBatchFunctionTask(napi_env env, const std::string& name,
+                                           const std::shared_ptr<FunctionSerialization>& function, napi_value args,
+                                           Priority priority);
     static TaskInfo* GenerateTaskInfo(napi_env env, napi_value func, napi_value args,
                                       napi_value transferList, napi_value cloneList, Priority priority,
                                       bool defaultTransfer = true, bool defaultCloneSendable = false);
@@ -186,6 +211,7 @@ public:
     bool IsCommonTask() const;
     bool IsSeqRunnerTask() const;
     bool IsFunctionTask() const;
+    bool IsParallelTask() const;
     bool IsLongTask() const;
     bool IsPeriodicTask() const;
     bool IsMainThreadTask() const;
@@ -247,6 +273,15 @@ public:
     bool UpdateTaskStateToTimeout();
     void ClearTimeoutTimer();
     void SetTimeout(uint32_t timeout);
+    // deadline is relative to now in milliseconds, 0 clears it
+    void SetDeadline(uint32_t deadline);
+    uint64_t GetDeadline() const;
+    bool HasDeadline() const;
+    // for sendData, the first message is posted at once and the burst after it as one batch. A batch is taken by
+    // the host when the flush posted as it opens runs, so it never waits for the turn of the worker to end
+    void AppendSendData(napi_env env, void* serializationArgs);
+    void FlushSendData(napi_env env);
+    std::vector<void*> TakeSendData();
     static bool CheckAddDependency(napi_env env, Task* task);
     bool CanExecuteTimeout(napi_env env, uint32_t timeout);
 
@@ -254,6 +289,10 @@ public:
                                                                                          napi_value napiTask);
     static std::tuple<void*, void*> GetSerializeResult(napi_env env, napi_value func, napi_value args,
         std::tuple<napi_value, napi_value, bool, bool> transferAndCloneParams);
+    static void* SerializeFunction(napi_env env, napi_value func, bool defaultTransfer = true,
+                                   bool defaultCloneSendable = false);
+    static void* SerializeArguments(napi_env env, napi_value args,
+        std::tuple<napi_value, napi_value, bool, bool> transferAndCloneParams);
 
     inline void SetAsyncStackID(uint64_t asyncStackID)
     {
@@ -270,6 +309,9 @@ private:
     Task& operator=(Task &&) = delete;
 
     void InitHandle(napi_env env);
+    static napi_status DeserializeData(napi_env env, void* data, napi_value* value);
+    napi_status DeserializeSharedFunction(napi_env env, const std::shared_ptr<FunctionSerialization>& function,
+                                          napi_value* func);
 
     uint64_t asyncStackID_ = 0;
 
@@ -281,6 +323,7 @@ public:
     std::atomic<ExecuteState> taskState_ {ExecuteState::NOT_FOUND};
     uint64_t groupId_ {}; // 0 for task outside taskgroup
     uint64_t runnerId_ {}; // 0 for task without runner
+    uint64_t parallelId_ {}; // 0 for task outside parallelFor and mapReduce
     TaskInfo* currentTaskInfo_ {};
     std::list<TaskInfo*> pendingTaskInfos_ {}; // for a common task executes multiple times
     void* result_ = nullptr;
@@ -296,8 +339,13 @@ public:
     bool isLongTask_ {false};
     bool defaultTransfer_ {true};
     bool defaultCloneSendable_ {false};
+    // set by setResultTransferList, only the ArrayBuffers of the result at these keys are transferred back
+    bool hasResultTransferList_ {false};
+    std::vector<std::string> resultTransferList_ {};
     std::atomic<bool> isValid_ {true};
     std::atomic<uint32_t> lifecycleCount_ {0}; // when lifecycleCount_ is 0, the task pointer can be deleted
+    std::atomic<bool> isInLocalQueue_ {false}; // the entry in a worker local queue is claimed by resetting it
+    std::atomic<Workload> workload_ {Workload::DEFAULT};
     uv_async_t* onStartCancelSignal_ = nullptr;
     uv_async_t* onStartDiscardSignal_ = nullptr;
     ListenerCallBackInfo* onEnqueuedCallBackInfo_ = nullptr;
@@ -307,18 +355,24 @@ public:
 
     // for periodic task
     bool isPeriodicTask_ {false};
-    uv_timer_t* timer_ {nullptr}; // task timeout timer or task delayed timer
+    uint64_t timerId_ {}; // task timeout timer or periodic timer in the timer wheel, 0 if there is none
     Priority periodicTaskPriority_ {Priority::DEFAULT};
 
-    std::set<uv_timer_t*> delayedTimers_ {}; // task delayed timer
+    std::unordered_map<uint64_t, TaskMessage*> delayedTimers_ {}; // <timerId, message> of the delayed executions
+
+    // for sendData, the serialized messages not posted yet, added by the worker and taken by the host
+    std::mutex sendDataMutex_ {};
+    std::vector<void*> sendDataBatch_ {};
+    uint64_t sendDataFlushTime_ {};
 
     bool isMainThreadTask_ {false};
     Priority asyncTaskPriority_ {Priority::DEFAULT};
+    bool isRateLimited_ {false}; // counted by the rateLimitedNum of its asyncRunner, under the runner lock
     std::atomic<bool> isCancelToFinish_ {false};
     uint32_t timeout_ {0};
+    std::atomic<uint64_t> deadline_ {0}; // the absolute deadline in milliseconds, 0 for task without deadline
 
     std::string enqueueTime_ {};
-    std::string runningTime_ {};
     std::atomic<uint32_t> enqueuePrintCount_ {0};
     std::atomic<uint32_t> runningPrintCount_ {0};
     std::atomic<uint64_t> addTime_ {0};
@@ -336,16 +390,31 @@ struct CallbackInfo {
     uint32_t refCount;
     napi_ref callbackRef;
     std::string type;
+    bool isBatch {false}; // the callback gets the messages of a batch as one array
 };
 
 struct TaskResultInfo {
     TaskResultInfo(napi_env workerEnv, uint32_t taskId, void* args)
-        : workerEnv(workerEnv), taskId(taskId), serializationArgs(args) {}
+        : workerEnv(workerEnv), taskId(taskId), serializationArgs({args}) {}
+    TaskResultInfo(napi_env workerEnv, uint32_t taskId, std::vector<void*>&& argsList)
+        : workerEnv(workerEnv), taskId(taskId), serializationArgs(std::move(argsList)) {}
     ~TaskResultInfo() = default;
 
+    // the messages which are dropped instead of delivered
+    void DeleteSerializationArgs(napi_env env)
+    {
+        for (void* args : serializationArgs) {
+            if (args != nullptr) {
+                napi_delete_serialization_data(env, args);
+            }
+        }
+        serializationArgs.clear();
+    }
+
     napi_env workerEnv;
     uint32_t taskId;
-    void* serializationArgs;
+    // the messages of sendData in the order they were sent, empty for the flush of an open batch
+    std::vector<void*> serializationArgs;
 };
 
 class AsyncStackScope {
@@ -17,6 +17,8 @@
 
 #include "helper/concurrent_helper.h"
 #include "task_group_manager.h"
+#include "taskpool.h"
+#include "timer_wheel.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
@@ -173,14 +175,16 @@ void TaskGroup::StartRejectResult(const uv_async_t* req)
 
 uint32_t TaskGroup::GetTaskIndex(uint32_t taskId)
 {
-    uint32_t index = 0;
-    for (uint32_t id : taskIds_) {
-        if (taskId == id) {
-            break;
+    // the tasks are only appended, so the index is rebuilt once after the last addTask
+    if (taskIndexes_.size() != taskIds_.size()) {
+        taskIndexes_.clear();
+        taskIndexes_.reserve(taskIds_.size());
+        for (uint32_t index = 0; index < taskIds_.size(); index++) {
+            taskIndexes_.emplace(taskIds_[index], index);
         }
-        index++;
     }
-    return index;
+    auto iter = taskIndexes_.find(taskId);
+    return iter == taskIndexes_.end() ? static_cast<uint32_t>(taskIds_.size()) : iter->second;
 }
 
 void TaskGroup::NotifyGroupTask(napi_env env)
@@ -348,10 +352,10 @@ bool TaskGroup::IsTimeoutState()
 void TaskGroup::ClearTimeoutTimer()
 {
     std::lock_guard<std::recursive_mutex> lock(taskGroupMutex_);
-    if (!IsTimeoutTaskGroup() || timer_ == nullptr || IsTimeoutState()) {
+    if (!IsTimeoutTaskGroup() || timerId_ == 0 || IsTimeoutState()) {
         return;
     }
-    uv_timer_stop(timer_);
-    ConcurrentHelper::UvHandleClose(timer_);
+    delete static_cast<TaskTimeoutMessage*>(TimerWheel::CancelTimer(env_, timerId_));
+    timerId_ = 0;
 }
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
\ No newline at end of file
@@ -17,6 +17,8 @@
 #define JS_CONCURRENT_MODULE_TASKPOOL_TASK_GROUP_H
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "task.h"
 #include "task_manager.h"
@@ -94,7 +96,9 @@ public:
     GroupInfo* currentGroupInfo_ {};
     std::list<GroupInfo*> pendingGroupInfos_ {};
     std::list<napi_ref> taskRefs_ {};
-    std::list<uint32_t> taskIds_ {};
+    std::vector<uint32_t> taskIds_ {};
+    // <taskId, index>, built from taskIds_ when a result comes back
+    std::unordered_map<uint32_t, uint32_t> taskIndexes_ {};
     uint32_t taskNum_ {};
     std::atomic<ExecuteState> groupState_ {ExecuteState::NOT_FOUND};
     napi_ref groupRef_ {};
@@ -102,7 +106,7 @@ public:
     uv_async_t* onRejectResultSignal_ = nullptr;
     std::atomic<bool> isValid_ {true};
     uint32_t timeout_ {0};
-    uv_timer_t* timer_ {nullptr}; // timeout timer
+    uint64_t timerId_ {}; // timeout timer in the timer wheel, 0 if there is none
 };
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
 #endif // JS_CONCURRENT_MODULE_TASKPOOL_TASK_GROUP_H
\ No newline at end of file
@@ -230,4 +230,26 @@ void TaskGroupManager::TimeoutGroup(napi_env env, uint64_t groupId)
         taskGroup->RejectResult(env, error);
     }
 }
+
+void TaskGroupManager::StoreParallelGroup(ParallelGroup* group)
+{
+    std::lock_guard<std::mutex> lock(parallelGroupsMutex_);
+    parallelGroups_.emplace(group->GetGroupId(), group);
+}
+
+void TaskGroupManager::RemoveParallelGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(parallelGroupsMutex_);
+    parallelGroups_.erase(groupId);
+}
+
+ParallelGroup* TaskGroupManager::GetParallelGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(parallelGroupsMutex_);
+    auto groupIter = parallelGroups_.find(groupId);
+    if (groupIter == parallelGroups_.end()) {
+        return nullptr;
+    }
+    return groupIter->second;
+}
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
\ No newline at end of file
@@ -16,6 +16,7 @@
 #ifndef JS_CONCURRENT_MODULE_TASKPOOL_TASK_GROUP_MANAGER_H
 #define JS_CONCURRENT_MODULE_TASKPOOL_TASK_GROUP_MANAGER_H
 
+#include "parallel_group.h"
 #include "task_group.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
@@ -32,6 +33,9 @@ public:
     void ReleaseTaskGroupData(napi_env env, TaskGroup* group);
     bool UpdateGroupState(uint64_t groupId);
     void TimeoutGroup(napi_env env, uint64_t groupId);
+    void StoreParallelGroup(ParallelGroup* group);
+    void RemoveParallelGroup(uint64_t groupId);
+    ParallelGroup* GetParallelGroup(uint64_t groupId);
 
 private:
     TaskGroupManager() = default;
@@ -44,6 +48,9 @@ private:
     // <groupId, TaskGroup>
     std::unordered_map<uint64_t, TaskGroup*> taskGroups_ {};
     std::mutex taskGroupsMutex_;
+    // <groupId, ParallelGroup>
+    std::unordered_map<uint64_t, ParallelGroup*> parallelGroups_ {};
+    std::mutex parallelGroupsMutex_;
     friend class NativeEngineTest;
 };
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
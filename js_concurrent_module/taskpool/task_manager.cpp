@@ -49,8 +49,13 @@ static constexpr int8_t USER_INTERACTION_PRIORITY_TASK_COUNT = 5;
 static constexpr int8_t DEADLINE_PRIORITY_TASK_COUNT = 5;
 static constexpr int8_t HIGH_PRIORITY_TASK_COUNT = 5;
 static constexpr int8_t MEDIUM_PRIORITY_TASK_COUNT = 5;
-static constexpr int32_t MAX_TASK_DURATION = 100; // 100: 100ms
-static constexpr uint32_t STEP_SIZE = 2;
+static constexpr uint32_t LOCAL_PRIORITY_TASK_COUNT = 5;
+static constexpr uint64_t DEADLINE_BOOST_WINDOW = 4; // 4: ms, a deadline task due this soon goes before the bands
+// the order in which DequeueTaskId serves the priority bands
+static constexpr std::array<Priority, Priority::NUMBER> PRIORITY_BAND_ORDER = {
+    Priority::USER_INTERACTION, Priority::DEADLINE_REQUEST, Priority::HIGH,
+    Priority::MEDIUM, Priority::LOW, Priority::IDLE
+};
 static constexpr uint32_t DEFAULT_THREADS = 3;
 static constexpr uint32_t DEFAULT_MIN_THREADS = 1; // 1: minimum thread num when idle
 static constexpr uint32_t MIN_TIMEOUT_TIME = 180000; // 180000: 3min
@@ -64,6 +69,7 @@ static constexpr uint32_t TRIGGER_EXPAND_INTERVAL = 10; // 10: ms, trigger reche
 static constexpr char ON_CALLBACK_STR[] = "TaskPoolOnCallbackTask";
 static constexpr char ON_ENQUEUE_STR[] = "TaskPoolOnEnqueueTask";
 static constexpr char ON_START_STR[] = "TaskPoolOnStartTask";
+static constexpr char ON_EXPIRED_STR[] = "TaskPoolOnExpiredTask";
 static constexpr uint32_t UNEXECUTE_TASK_TIME = 60000; // 60000: 1min
 static constexpr std::array<uint32_t, 6> PRINT_FREQUENCY_MAP = {10000, 30000, 60000, 300000, 600000, 1800000};
 static constexpr uint64_t RATIO = 1000;
@@ -130,14 +136,17 @@ TaskManager::~TaskManager()
     }
 
     {
-        std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-        for (auto& [_, task] : tasks_) {
+        std::lock_guard<std::mutex> lock(runningTasksMutex_);
+        tasks_.ForEach([](Task* task) {
             delete task;
-            task = nullptr;
-        }
-        tasks_.clear();
+        });
+        tasks_.Clear();
         runningTasks_.clear();
     }
+
+    for (auto& localQueue : localQueues_) {
+        delete localQueue.exchange(nullptr);
+    }
     CountTraceForWorker();
 }
 
@@ -181,6 +190,7 @@ inline void TaskManager::CountTraceForWorkerWithoutLock(bool needLog)
     HITRACE_HELPER_COUNT_TRACE("threadNum", threadNum);
     HITRACE_HELPER_COUNT_TRACE("runningThreadNum", threadNum - idleWorkers);
     HITRACE_HELPER_COUNT_TRACE("idleThreadNum", idleWorkers);
+    HITRACE_HELPER_COUNT_TRACE("wakingThreadNum", static_cast<int64_t>(wakingCount_.load()));
     AddCountTraceForWorkerLog(needLog, threadNum, idleWorkers, timeoutWorkers);
 }
 
@@ -233,21 +243,18 @@ napi_value TaskManager::GetTaskInfos(napi_env env)
     napi_value taskInfos = nullptr;
     napi_create_array(env, &taskInfos);
     std::unordered_set<std::unique_ptr<TaskCurrentInfo>> taskCurrentInfoSet {};
-    {
-        std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-        for (const auto& [_, task] : tasks_) {
-            if (task->taskState_ == ExecuteState::NOT_FOUND || task->taskState_ == ExecuteState::DELAYED ||
-                task->taskState_ == ExecuteState::FINISHED) {
-                continue;
-            }
-            auto taskCurrentInfo = std::make_unique<TaskCurrentInfo>();
-            taskCurrentInfo->taskId = task->taskId_;
-            taskCurrentInfo->name = task->name_;
-            taskCurrentInfo->taskState = task->taskState_;
-            taskCurrentInfo->startTime = task->startTime_;
-            taskCurrentInfoSet.emplace(std::move(taskCurrentInfo));
+    tasks_.ForEach([&taskCurrentInfoSet](Task* task) {
+        if (task->taskState_ == ExecuteState::NOT_FOUND || task->taskState_ == ExecuteState::DELAYED ||
+            task->taskState_ == ExecuteState::FINISHED) {
+            return;
         }
-    }
+        auto taskCurrentInfo = std::make_unique<TaskCurrentInfo>();
+        taskCurrentInfo->taskId = task->taskId_;
+        taskCurrentInfo->name = task->name_;
+        taskCurrentInfo->taskState = task->taskState_;
+        taskCurrentInfo->startTime = task->startTime_;
+        taskCurrentInfoSet.emplace(std::move(taskCurrentInfo));
+    });
     int32_t index = 0;
     for (auto& info : taskCurrentInfoSet) {
         napi_value taskInfoValue = NapiHelper::CreateObject(env);
@@ -275,6 +282,23 @@ void TaskManager::UpdateExecutedInfo(uint64_t duration)
 {
     totalExecTime_ += duration;
     totalExecCount_++;
+    GetThreadCountPolicy()->OnTaskExecuted(duration);
+}
+
+void TaskManager::SetThreadCountPolicy(std::shared_ptr<ThreadCountPolicy> policy)
+{
+    if (policy == nullptr) {
+        policy = std::make_shared<HeuristicThreadCountPolicy>();
+    }
+    HILOG_INFO("taskpool:: thread count policy:%{public}s", policy->GetName());
+    std::unique_lock<std::shared_mutex> lock(threadCountPolicyMutex_);
+    threadCountPolicy_ = std::move(policy);
+}
+
+std::shared_ptr<ThreadCountPolicy> TaskManager::GetThreadCountPolicy()
+{
+    std::shared_lock<std::shared_mutex> lock(threadCountPolicyMutex_);
+    return threadCountPolicy_;
 }
 
 uint32_t TaskManager::ComputeSuitableThreadNum()
@@ -285,16 +309,13 @@ uint32_t TaskManager::ComputeSuitableThreadNum()
 
 uint32_t TaskManager::ComputeSuitableIdleNum()
 {
-    uint32_t targetNum = 0;
-    if (GetNonIdleTaskNum() != 0 && totalExecCount_ == 0) {
-        // this branch is used for avoiding time-consuming tasks that may block the taskpool
-        targetNum = std::min(STEP_SIZE, GetNonIdleTaskNum());
-    } else if (totalExecCount_ != 0) {
-        auto durationPerTask = static_cast<double>(totalExecTime_) / totalExecCount_;
-        uint32_t result = std::ceil(durationPerTask * GetNonIdleTaskNum() / MAX_TASK_DURATION);
-        targetNum = std::min(result, GetNonIdleTaskNum());
-    }
-    return targetNum == 0 ? 1 : targetNum;
+    ThreadCountLoad load;
+    load.nonIdleTaskNum = GetNonIdleTaskNum();
+    load.totalExecCount = totalExecCount_;
+    load.totalExecTime = totalExecTime_;
+    uint32_t targetNum = GetThreadCountPolicy()->ComputeSuitableIdleNum(load);
+    HITRACE_HELPER_COUNT_TRACE("suitableIdleThreadNum", static_cast<int64_t>(targetNum));
+    return targetNum;
 }
 
 void TaskManager::CheckForBlockedWorkers()
@@ -522,7 +543,8 @@ void TaskManager::NotifyShrink(uint32_t targetNum)
 {
     std::lock_guard<std::recursive_mutex> lock(workersMutex_);
     uint32_t workerCount = workers_.size();
-    uint32_t minThread = ConcurrentHelper::IsLowMemory() ? 0 : DEFAULT_MIN_THREADS;
+    // the prewarmed workers are kept unless the memory is low
+    uint32_t minThread = ConcurrentHelper::IsLowMemory() ? 0 : std::max(DEFAULT_MIN_THREADS, prewarmNum_.load());
     // update the maxThreads_ periodically
     maxThreads_ = ConcurrentHelper::GetMaxThreads();
     if (minThread == 0) { // LCOV_EXCL_BR_LINE
@@ -594,6 +616,7 @@ void TaskManager::TriggerLoadBalance([[maybe_unused]] const uv_timer_t* req)
 {
     TaskManager& taskManager = TaskManager::GetInstance();
     taskManager.CheckForBlockedWorkers();
+    taskManager.GetThreadCountPolicy()->OnBalance();
     uint32_t targetNum = taskManager.ComputeSuitableThreadNum();
     taskManager.NotifyShrink(targetNum);
     taskManager.CountTraceForWorker(true);
@@ -825,6 +848,7 @@ void TaskManager::NotifyWorkerIdle(Worker* worker)
             return;
         }
         idleWorkers_.insert(worker);
+        worker->idleSeq_ = ++idleSeq_;
     }
     if (GetTaskNum() != 0) {
         NotifyExecuteTask();
@@ -852,6 +876,24 @@ void TaskManager::NotifyWorkerRunning(Worker* worker)
     CountTraceForWorkerWithoutLock();
 }
 
+bool TaskManager::NotifyWorkerWokenUp(Worker* worker)
+{
+    // under workersMutex_ so that NotifyExecuteTask never sees the flag and wakingCount_ out of step
+    std::lock_guard<std::recursive_mutex> lock(workersMutex_);
+    if (!worker->isWaking_.exchange(false)) {
+        return false;
+    }
+    wakingCount_--;
+    return true;
+}
+
+void TaskManager::CountSpuriousWakeup()
+{
+    // another worker has taken the task before this one woke up
+    uint64_t spuriousCount = ++spuriousWakeupCount_;
+    HITRACE_HELPER_COUNT_TRACE("spuriousWakeupNum", static_cast<int64_t>(spuriousCount));
+}
+
 uint32_t TaskManager::GetRunningWorkers()
 {
     std::lock_guard<std::recursive_mutex> lock(workersMutex_);
@@ -869,7 +911,7 @@ uint32_t TaskManager::GetTimeoutWorkers()
 uint32_t TaskManager::GetTaskNum()
 {
     std::lock_guard<std::mutex> lock(taskQueuesMutex_);
-    uint32_t sum = 0;
+    uint32_t sum = localTaskNum_ + deadlineQueue_.GetTaskNum();
     for (const auto& elements : taskQueues_) {
         sum += elements->GetTaskNum();
     }
@@ -903,18 +945,28 @@ uint32_t TaskManager::GetThreadNum()
     return workers_.size();
 }
 
-void TaskManager::EnqueueTaskId(uint32_t taskId, Priority priority)
+void TaskManager::EnqueueTaskId(uint32_t taskId, Priority priority, Worker* affinityWorker)
 {
-    {
-        std::lock_guard<std::mutex> lock(taskQueuesMutex_);
-        IncreaseTaskNum(priority);
-        if (!IsSystemApp()) {
-            priority = priority > Priority::IDLE ? Priority::HIGH : priority;
+    Task* task = GetTask(taskId);
+    if (!IsSystemApp()) {
+        priority = priority > Priority::IDLE ? Priority::HIGH : priority;
+    }
+    // the task waiting for its dependencies is parked in the graph, NotifyDependencyTaskInfo enqueues it again
+    if (dependencyGraph_.TryPark(taskId, priority)) {
+        HILOG_DEBUG("taskpool:: task:%{public}s is pending on its dependencies", std::to_string(taskId).c_str());
+    } else {
+        if (affinityWorker == nullptr) {
+            affinityWorker = GetCoreClassWorker(task);
+        }
+        if (!EnqueueDeadlineTaskId(task, priority) && !EnqueueAffinityTaskId(task, priority, affinityWorker) &&
+            !EnqueueLocalTaskId(task, priority)) {
+            std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+            IncreaseTaskNum(priority);
+            taskQueues_[priority]->EnqueueTaskId(taskId);
+            globalTaskNum_[priority]++;
         }
-        taskQueues_[priority]->EnqueueTaskId(taskId);
+        TryTriggerExpand();
     }
-    TryTriggerExpand();
-    Task* task = GetTask(taskId);
     if (task == nullptr) {
         HILOG_FATAL("taskpool:: task is nullptr");
         return;
@@ -937,10 +989,52 @@ void TaskManager::EnqueueTaskId(uint32_t taskId, Priority priority)
     }
 }
 
+void TaskManager::EnqueueTaskIds(const std::vector<Task*>& tasks, Priority priority)
+{
+    if (tasks.empty()) {
+        return;
+    }
+    if (!IsSystemApp()) {
+        priority = priority > Priority::IDLE ? Priority::HIGH : priority;
+    }
+    {
+        std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+        uint32_t queuedNum = 0;
+        for (Task* task : tasks) {
+            if (dependencyGraph_.TryPark(task->taskId_, priority)) {
+                continue;
+            }
+            IncreaseTaskNum(priority);
+            if (task->IsCommonTask() && task->HasDeadline()) {
+                deadlineQueue_.EnqueueTaskId(task->taskId_, priority, task->GetDeadline());
+                continue;
+            }
+            taskQueues_[priority]->EnqueueTaskId(task->taskId_);
+            queuedNum++;
+        }
+        globalTaskNum_[priority] += queuedNum;
+        firstDeadline_ = deadlineQueue_.GetFirstDeadline();
+    }
+    TryTriggerExpand();
+    for (Task* task : tasks) {
+        task->IncreaseTaskLifecycleCount();
+        task->TriggerEnqueueCallback();
+    }
+}
+
 bool TaskManager::EraseWaitingTaskId(uint32_t taskId, Priority priority)
 {
+    Task* task = localTaskNum_ != 0 ? GetTask(taskId) : nullptr;
     std::lock_guard<std::mutex> lock(taskQueuesMutex_);
-    if (!taskQueues_[priority]->EraseWaitingTaskId(taskId)) {
+    if (taskQueues_[priority]->EraseWaitingTaskId(taskId)) {
+        uint32_t num = globalTaskNum_[priority];
+        globalTaskNum_[priority] = num > 0 ? num - 1 : 0;
+    } else if (deadlineQueue_.EraseWaitingTaskId(taskId)) {
+        firstDeadline_ = deadlineQueue_.GetFirstDeadline();
+    } else if (task != nullptr && task->isInLocalQueue_.exchange(false)) {
+        // the entry stays in the local queue and will be skipped by the worker that pops or steals it
+        localTaskNum_--;
+    } else {
         HILOG_WARN("taskpool:: taskId is not in executeQueue when cancel");
         return false;
     }
@@ -948,11 +1042,59 @@ bool TaskManager::EraseWaitingTaskId(uint32_t taskId, Priority priority)
     return true;
 }
 
-std::pair<uint32_t, Priority> TaskManager::DequeueTaskId()
+std::pair<uint32_t, Priority> TaskManager::DequeueTaskId(Worker* worker)
+{
+    // the tasks bound to the worker go first, they were bound as the worker was idle
+    if (worker != nullptr && worker->affinityTaskNum_ != 0) {
+        auto taskInfo = DequeueAffinityTaskId(worker);
+        if (taskInfo.first != 0) {
+            return taskInfo;
+        }
+    }
+    if (worker == nullptr || worker->localQueue_ == nullptr || localTaskNum_ == 0) {
+        return DequeueGlobalTaskId();
+    }
+    // local and stolen tasks are rationed like a priority band, the global queues get a turn periodically
+    if (worker->localExecuteCount_ >= LOCAL_PRIORITY_TASK_COUNT) {
+        worker->localExecuteCount_ = 0;
+        auto taskInfo = DequeueGlobalTaskId();
+        if (taskInfo.first != 0) {
+            return taskInfo;
+        }
+    }
+    auto taskInfo = DequeueLocalTaskId(worker);
+    if (taskInfo.first != 0) {
+        worker->localExecuteCount_++;
+        return taskInfo;
+    }
+    return DequeueGlobalTaskId();
+}
+
+std::pair<uint32_t, Priority> TaskManager::DequeueGlobalTaskId()
 {
     bool isChoose = IsChooseIdle();
+    std::vector<std::pair<uint32_t, Priority>> expiredTasks {};
+    auto taskInfo = DequeueGlobalTaskIdInner(isChoose, expiredTasks);
+    if (!expiredTasks.empty()) {
+        RejectExpiredTasks(expiredTasks);
+    }
+    return taskInfo;
+}
+
+std::pair<uint32_t, Priority> TaskManager::DequeueGlobalTaskIdInner(bool isChoose,
+    std::vector<std::pair<uint32_t, Priority>>& expiredTasks)
+{
     {
         std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+        // a deadline task due soon goes before the ratio-based bands
+        if (firstDeadline_ <= ConcurrentHelper::GetMilliseconds() + DEADLINE_BOOST_WINDOW) {
+            auto taskInfo = DequeueDeadlineTaskId(DEADLINE_BOOST_WINDOW, expiredTasks);
+            if (taskInfo.first != 0) {
+                deadlineBoostCount_++;
+                return taskInfo;
+            }
+        }
+
         if (IsSystemApp()) {
             auto& userInteractionTaskQueue = taskQueues_[Priority::USER_INTERACTION];
             if (!userInteractionTaskQueue->IsEmpty() &&
@@ -961,12 +1103,23 @@ std::pair<uint32_t, Priority> TaskManager::DequeueTaskId()
                 return GetTaskByPriority(userInteractionTaskQueue, Priority::USER_INTERACTION);
             }
             userInteractionPrioExecuteCount_ = 0;
+        }
 
-            auto& deadlineTaskQueue = taskQueues_[Priority::DEADLINE_REQUEST];
-            if (!deadlineTaskQueue->IsEmpty() && deadlinePrioExecuteCount_ < DEADLINE_PRIORITY_TASK_COUNT) {
-                deadlinePrioExecuteCount_++;
+        // the deadline band serves the earliest deadline first, then the DEADLINE_REQUEST tasks in FIFO order
+        auto& deadlineTaskQueue = taskQueues_[Priority::DEADLINE_REQUEST];
+        if ((!deadlineQueue_.IsEmpty() || !deadlineTaskQueue->IsEmpty()) &&
+            deadlinePrioExecuteCount_ < DEADLINE_PRIORITY_TASK_COUNT) {
+            deadlinePrioExecuteCount_++;
+            if (!deadlineQueue_.IsEmpty()) {
+                auto taskInfo = DequeueDeadlineTaskId(UINT64_MAX, expiredTasks);
+                if (taskInfo.first != 0) {
+                    return taskInfo;
+                }
+            }
+            if (!deadlineTaskQueue->IsEmpty()) {
                 return GetTaskByPriority(deadlineTaskQueue, Priority::DEADLINE_REQUEST);
             }
+        } else {
             deadlinePrioExecuteCount_ = 0;
         }
 
@@ -1011,9 +1164,258 @@ std::pair<uint32_t, Priority> TaskManager::GetTaskByPriority(const std::unique_p
     Priority priority)
 {
     uint32_t taskId = taskQueue->DequeueTaskId();
+    uint32_t num = globalTaskNum_[priority];
+    globalTaskNum_[priority] = num > 0 ? num - 1 : 0;
+    return PrepareDequeuedTask(taskId, priority);
+}
+
+std::pair<uint32_t, Priority> TaskManager::DequeueDeadlineTaskId(uint64_t window,
+    std::vector<std::pair<uint32_t, Priority>>& expiredTasks)
+{
+    uint64_t now = ConcurrentHelper::GetMilliseconds();
+    while (deadlineQueue_.GetFirstDeadline() <= now) {
+        auto taskInfo = deadlineQueue_.DequeueTaskId();
+        DecreaseTaskNum(taskInfo.second);
+        expiredTasks.push_back(taskInfo);
+    }
+    std::pair<uint32_t, Priority> taskInfo = std::make_pair(0, Priority::LOW);
+    if (!deadlineQueue_.IsEmpty() && deadlineQueue_.GetFirstDeadline() - now <= window) {
+        auto [taskId, priority] = deadlineQueue_.DequeueTaskId();
+        taskInfo = PrepareDequeuedTask(taskId, priority);
+    }
+    firstDeadline_ = deadlineQueue_.GetFirstDeadline();
+    return taskInfo;
+}
+
+bool TaskManager::EnqueueDeadlineTaskId(Task* task, Priority priority)
+{
+    if (task == nullptr || !task->IsCommonTask() || !task->HasDeadline()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+    IncreaseTaskNum(priority);
+    deadlineQueue_.EnqueueTaskId(task->taskId_, priority, task->GetDeadline());
+    firstDeadline_ = deadlineQueue_.GetFirstDeadline();
+    return true;
+}
+
+void TaskManager::RejectExpiredTasks(const std::vector<std::pair<uint32_t, Priority>>& expiredTasks)
+{
+    for (const auto& [taskId, priority] : expiredTasks) {
+        deadlineDropCount_++;
+        Task* task = GetTask(taskId);
+        if (task == nullptr || !task->IsValid()) {
+            continue;
+        }
+        HILOG_DEBUG("taskpool:: task:%{public}s is dropped after its deadline", std::to_string(taskId).c_str());
+        // the promise is rejected on the host thread, the task never runs
+        auto onExpiredTask = [taskId = taskId]([[maybe_unused]] void* data) {
+            Task* task = TaskManager::GetInstance().GetTask(taskId);
+            if (task == nullptr) {
+                HILOG_WARN("taskpool:: expired task is null");
+                return;
+            }
+            TaskPool::RejectExpiredTask(task);
+        };
+        auto napiPrio = g_napiPriorityMap.at(priority);
+        uint64_t handleId = 0;
+        napi_status status = napi_send_cancelable_event(task->GetEnv(), onExpiredTask, nullptr, napiPrio,
+                                                        &handleId, ON_EXPIRED_STR);
+        if (status != napi_ok) {
+            HILOG_ERROR("taskpool:: failed to send event for expired task:%{public}s",
+                        std::to_string(taskId).c_str());
+        }
+    }
+}
+
+void TaskManager::RecordDeadlineResult(uint64_t deadline)
+{
+    if (ConcurrentHelper::GetMilliseconds() <= deadline) {
+        deadlineMetCount_++;
+    } else {
+        deadlineLateCount_++;
+    }
+}
+
+napi_value TaskManager::GetDeadlineInfo(napi_env env)
+{
+    uint32_t waitingNum = 0;
+    {
+        std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+        waitingNum = deadlineQueue_.GetTaskNum();
+    }
+    uint64_t metNum = deadlineMetCount_;
+    uint64_t lateNum = deadlineLateCount_;
+    uint64_t droppedNum = deadlineDropCount_;
+    napi_value deadlineInfo = nullptr;
+    napi_create_object(env, &deadlineInfo);
+    napi_set_named_property(env, deadlineInfo, "waitingNum", NapiHelper::CreateUint32(env, waitingNum));
+    napi_value value = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(metNum), &value);
+    napi_set_named_property(env, deadlineInfo, "metNum", value);
+    // a task misses its deadline if it finished late or was dropped before it started
+    napi_create_int64(env, static_cast<int64_t>(lateNum + droppedNum), &value);
+    napi_set_named_property(env, deadlineInfo, "missedNum", value);
+    napi_create_int64(env, static_cast<int64_t>(lateNum), &value);
+    napi_set_named_property(env, deadlineInfo, "lateNum", value);
+    napi_create_int64(env, static_cast<int64_t>(droppedNum), &value);
+    napi_set_named_property(env, deadlineInfo, "droppedNum", value);
+    napi_create_int64(env, static_cast<int64_t>(deadlineBoostCount_.load()), &value);
+    napi_set_named_property(env, deadlineInfo, "boostedNum", value);
+    return deadlineInfo;
+}
+
+void TaskManager::SetResultTransfer(bool isResultTransfer)
+{
+    isResultTransfer_ = isResultTransfer;
+}
+
+bool TaskManager::IsResultTransfer() const
+{
+    return isResultTransfer_;
+}
+
+void TaskManager::RecordResultBytes(uint64_t transferredBytes, uint64_t copiedBytes)
+{
+    if (transferredBytes != 0) {
+        resultTransferredBytes_ += transferredBytes;
+    }
+    if (copiedBytes != 0) {
+        resultCopiedBytes_ += copiedBytes;
+    }
+}
+
+napi_value TaskManager::GetResultTransferInfo(napi_env env)
+{
+    napi_value resultTransferInfo = nullptr;
+    napi_create_object(env, &resultTransferInfo);
+    napi_set_named_property(env, resultTransferInfo, "isTransfer",
+        NapiHelper::CreateBooleanValue(env, isResultTransfer_));
+    napi_value value = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(resultTransferredBytes_.load()), &value);
+    napi_set_named_property(env, resultTransferInfo, "transferredBytes", value);
+    napi_create_int64(env, static_cast<int64_t>(resultCopiedBytes_.load()), &value);
+    napi_set_named_property(env, resultTransferInfo, "copiedBytes", value);
+    return resultTransferInfo;
+}
+
+void TaskManager::Prewarm(uint32_t workerNum, const std::vector<std::string>& modules)
+{
+    std::string traceLabel = "Prewarm: workers " + std::to_string(workerNum) +
+        ", modules " + std::to_string(modules.size());
+    HITRACE_HELPER_METER_NAME(traceLabel);
+    bool hasNewModule = false;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex_);
+        for (const std::string& module : modules) {
+            if (module.empty() ||
+                std::find(preloadModules_.begin(), preloadModules_.end(), module) != preloadModules_.end()) {
+                continue;
+            }
+            preloadModules_.push_back(module);
+            hasNewModule = true;
+        }
+        preloadModuleNum_ = static_cast<uint32_t>(preloadModules_.size());
+    }
+    workerNum = std::min(workerNum, std::max(maxThreads_, DEFAULT_THREADS));
+    if (workerNum > prewarmNum_) {
+        prewarmNum_ = workerNum;
+    }
+    uint32_t step = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(workersMutex_);
+        if (hasNewModule) {
+            // the workers load the new modules once woken up, the ones still starting load them before they are idle
+            for (Worker* worker : workers_) {
+                ConcurrentHelper::UvCheckAndAsyncSend(worker->performTaskSignal_);
+            }
+        }
+        uint32_t workerCount = static_cast<uint32_t>(workers_.size());
+        step = workerNum > workerCount ? workerNum - workerCount : 0;
+    }
+    if (step != 0) {
+        CreateWorkers(hostEnv_, step);
+        HILOG_INFO("taskpool:: prewarm create:%{public}u, total:%{public}u", step, GetThreadNum());
+    }
+}
+
+uint32_t TaskManager::GetPreloadModuleNum() const
+{
+    return preloadModuleNum_;
+}
+
+std::vector<std::string> TaskManager::GetPreloadModules(uint32_t from)
+{
+    std::lock_guard<std::mutex> lock(preloadMutex_);
+    if (from >= preloadModules_.size()) {
+        return {};
+    }
+    return std::vector<std::string>(preloadModules_.begin() + from, preloadModules_.end());
+}
+
+void TaskManager::RecordWorkerStartupTime(uint64_t startupTime)
+{
+    workerStartupTime_ = startupTime;
+    HITRACE_HELPER_COUNT_TRACE("workerStartupTime", static_cast<int64_t>(startupTime));
+}
+
+napi_value TaskManager::GetPrewarmInfo(napi_env env)
+{
+    napi_value prewarmInfo = nullptr;
+    napi_create_object(env, &prewarmInfo);
+    napi_set_named_property(env, prewarmInfo, "workerNum", NapiHelper::CreateUint32(env, prewarmNum_));
+    napi_set_named_property(env, prewarmInfo, "moduleNum", NapiHelper::CreateUint32(env, preloadModuleNum_));
+    napi_value value = nullptr;
+    napi_create_int64(env, static_cast<int64_t>(workerStartupTime_.load()), &value);
+    napi_set_named_property(env, prewarmInfo, "workerStartupTime", value);
+    return prewarmInfo;
+}
+
+void TaskManager::EnableCoreAffinity()
+{
+    // ffrt places its workers by itself
+    if (isCoreAffinityEnabled_ || EnableFfrt() || !CpuTopology::GetInstance().IsHeterogeneous()) {
+        return;
+    }
+    if (isCoreAffinityEnabled_.exchange(true)) {
+        return;
+    }
+    HILOG_INFO("taskpool:: the workers are bound to the cores for the workloads");
+}
+
+bool TaskManager::IsCoreAffinityEnabled() const
+{
+    return isCoreAffinityEnabled_;
+}
+
+Worker* TaskManager::GetCoreClassWorker(Task* task)
+{
+    if (!isCoreAffinityEnabled_ || task == nullptr) {
+        return nullptr;
+    }
+    CoreClass coreClass = CoreClass::NONE;
+    Workload workload = task->workload_;
+    if (workload == Workload::COMPUTE) {
+        coreClass = CoreClass::PERFORMANCE;
+    } else if (workload == Workload::BACKGROUND) {
+        coreClass = CoreClass::EFFICIENCY;
+    } else {
+        return nullptr;
+    }
+    std::lock_guard<std::recursive_mutex> lock(workersMutex_);
+    for (Worker* worker : idleWorkers_) {
+        if (worker->coreClass_ == coreClass) {
+            return worker;
+        }
+    }
+    return nullptr;
+}
+
+std::pair<uint32_t, Priority> TaskManager::PrepareDequeuedTask(uint32_t taskId, Priority priority)
+{
     DecreaseTaskNum(priority);
-    if (IsDependendByTaskId(taskId)) {
-        EnqueuePendingTaskInfo(taskId, priority);
+    // a dependency may have been added after the task was enqueued
+    if (dependencyGraph_.TryPark(taskId, priority)) {
         return std::make_pair(0, priority);
     }
     preDequeneTime_ = ConcurrentHelper::GetMilliseconds();
@@ -1023,6 +1425,243 @@ std::pair<uint32_t, Priority> TaskManager::GetTaskByPriority(const std::unique_p
     return std::make_pair(taskId, priority);
 }
 
+// ---------------------------------- WorkStealing ---------------------------------------
+void TaskManager::AttachLocalQueue(Worker* worker)
+{
+    // ffrt schedules the workers by itself, so the local queues are only used by the uv thread workers
+    if (EnableFfrt()) {
+        return;
+    }
+    for (uint32_t i = 0; i < MAX_LOCAL_QUEUE_NUM; i++) {
+        if (localQueueUsed_[i].exchange(true)) {
+            continue;
+        }
+        WorkStealingQueue* localQueue = localQueues_[i];
+        if (localQueue == nullptr) {
+            localQueue = new WorkStealingQueue();
+            localQueues_[i] = localQueue;
+        }
+        worker->localQueueIndex_ = i;
+        worker->localQueue_ = localQueue;
+        return;
+    }
+    HILOG_DEBUG("taskpool:: no local queue available, the worker uses the global queues only");
+}
+
+void TaskManager::DetachLocalQueue(Worker* worker)
+{
+    WorkStealingQueue* localQueue = worker->localQueue_;
+    if (localQueue == nullptr) {
+        return;
+    }
+    // stop pushing to the local queue, then hand the remaining tasks over to the global queues
+    worker->localQueue_ = nullptr;
+    bool hasTask = false;
+    {
+        std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+        while (!localQueue->IsEmpty()) {
+            auto [taskId, priority] = localQueue->Pop();
+            if (taskId == 0 || !ClaimLocalTaskId(taskId)) {
+                continue;
+            }
+            taskQueues_[priority]->EnqueueTaskId(taskId);
+            globalTaskNum_[priority]++;
+            localTaskNum_--;
+            hasTask = true;
+        }
+    }
+    localQueueUsed_[worker->localQueueIndex_] = false;
+    if (hasTask) {
+        TryTriggerExpand();
+    }
+}
+
+bool TaskManager::EnqueueLocalTaskId(Task* task, Priority priority)
+{
+    // only the tasks submitted from a worker thread go to the local queue of that worker,
+    // idle tasks are gated by IsChooseIdle and always use the global queue
+    Worker* worker = Worker::GetCurrentWorker();
+    if (task == nullptr || worker == nullptr || worker->localQueue_ == nullptr || priority == Priority::IDLE) {
+        return false;
+    }
+    if (task->isInLocalQueue_.exchange(true)) {
+        // the task is already queued locally, one entry can only be claimed once
+        return false;
+    }
+    IncreaseTaskNum(priority);
+    localTaskNum_++;
+    if (!worker->localQueue_->Push(task->taskId_, priority)) {
+        localTaskNum_--;
+        DecreaseTaskNum(priority);
+        task->isInLocalQueue_ = false;
+        return false;
+    }
+    return true;
+}
+
+std::pair<uint32_t, Priority> TaskManager::DequeueLocalTaskId(Worker* worker)
+{
+    WorkStealingQueue* localQueue = worker->localQueue_;
+    // 1. take from the own queue in LIFO order, the task is most likely cache-warm
+    while (!localQueue->IsEmpty()) {
+        auto [peekId, peekPriority] = localQueue->PeekBottom();
+        if (peekId != 0 && HasHigherPriorityTask(peekPriority)) {
+            return std::make_pair(0, peekPriority);
+        }
+        auto [taskId, priority] = localQueue->Pop();
+        if (taskId != 0 && ClaimLocalTaskId(taskId)) {
+            localTaskNum_--;
+            return PrepareDequeuedTask(taskId, priority);
+        }
+    }
+    // 2. steal from the peers in FIFO order
+    auto [taskId, priority] = StealTaskId(worker);
+    if (taskId == 0) {
+        return std::make_pair(0, Priority::LOW);
+    }
+    if (HasHigherPriorityTask(priority)) {
+        // keep the stolen task for later and let the higher priority band go first
+        if (!localQueue->Push(taskId, priority)) {
+            MoveToGlobalQueue(taskId, priority);
+        }
+        return std::make_pair(0, priority);
+    }
+    if (!ClaimLocalTaskId(taskId)) {
+        return std::make_pair(0, priority);
+    }
+    localTaskNum_--;
+    return PrepareDequeuedTask(taskId, priority);
+}
+
+std::pair<uint32_t, Priority> TaskManager::StealTaskId(Worker* worker)
+{
+    for (uint32_t i = 1; i < MAX_LOCAL_QUEUE_NUM; i++) {
+        WorkStealingQueue* victim = localQueues_[(worker->localQueueIndex_ + i) % MAX_LOCAL_QUEUE_NUM];
+        if (victim == nullptr) {
+            continue;
+        }
+        while (!victim->IsEmpty()) {
+            auto [taskId, priority] = victim->Steal();
+            if (taskId == 0) {
+                break;
+            }
+            Task* task = GetTask(taskId);
+            // skip the entries of canceled tasks
+            if (task != nullptr && task->isInLocalQueue_) {
+                return std::make_pair(taskId, priority);
+            }
+        }
+    }
+    return std::make_pair(0, Priority::LOW);
+}
+
+bool TaskManager::ClaimLocalTaskId(uint32_t taskId)
+{
+    Task* task = GetTask(taskId);
+    return task != nullptr && task->isInLocalQueue_.exchange(false);
+}
+
+void TaskManager::MoveToGlobalQueue(uint32_t taskId, Priority priority)
+{
+    std::lock_guard<std::mutex> lock(taskQueuesMutex_);
+    if (!ClaimLocalTaskId(taskId)) {
+        return;
+    }
+    taskQueues_[priority]->EnqueueTaskId(taskId);
+    globalTaskNum_[priority]++;
+    localTaskNum_--;
+}
+
+bool TaskManager::EnqueueAffinityTaskId(Task* task, Priority priority, Worker* worker)
+{
+    // ffrt schedules the workers by itself, so only the uv thread workers are bound
+    if (task == nullptr || worker == nullptr || priority == Priority::IDLE || EnableFfrt()) {
+        return false;
+    }
+    std::lock_guard<std::recursive_mutex> lock(workersMutex_);
+    // the worker may have exited or be busy with another task, then the task is dispatched as usual
+    if (workers_.find(worker) == workers_.end() || idleWorkers_.find(worker) == idleWorkers_.end()) {
+        return false;
+    }
+    if (task->isInLocalQueue_.exchange(true)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> affinityLock(worker->affinityMutex_);
+        if (worker->isAffinityClosed_) {
+            task->isInLocalQueue_ = false;
+            return false;
+        }
+        // counted as a local task, so cancel and the idle checks treat it like one
+        IncreaseTaskNum(priority);
+        localTaskNum_++;
+        worker->affinityQueue_.emplace_back(task->taskId_, priority);
+        worker->affinityTaskNum_++;
+    }
+    HILOG_DEBUG("taskpool:: task:%{public}s is bound to worker %{public}d", std::to_string(task->taskId_).c_str(),
+        worker->tid_);
+    worker->NotifyExecuteTask();
+    return true;
+}
+
+std::pair<uint32_t, Priority> TaskManager::DequeueAffinityTaskId(Worker* worker)
+{
+    while (true) {
+        std::pair<uint32_t, Priority> entry {0, Priority::LOW};
+        {
+            std::lock_guard<std::mutex> lock(worker->affinityMutex_);
+            if (worker->affinityQueue_.empty()) {
+                return entry;
+            }
+            entry = worker->affinityQueue_.front();
+            worker->affinityQueue_.pop_front();
+            worker->affinityTaskNum_--;
+        }
+        // the entries of canceled tasks are skipped
+        if (ClaimLocalTaskId(entry.first)) {
+            localTaskNum_--;
+            return PrepareDequeuedTask(entry.first, entry.second);
+        }
+    }
+}
+
+void TaskManager::DetachAffinityQueue(Worker* worker)
+{
+    std::deque<std::pair<uint32_t, Priority>> affinityQueue {};
+    {
+        std::lock_guard<std::mutex> lock(worker->affinityMutex_);
+        worker->isAffinityClosed_ = true;
+        affinityQueue.swap(worker->affinityQueue_);
+        worker->affinityTaskNum_ = 0;
+    }
+    if (affinityQueue.empty()) {
+        return;
+    }
+    for (const auto& [taskId, priority] : affinityQueue) {
+        MoveToGlobalQueue(taskId, priority);
+    }
+    TryTriggerExpand();
+}
+
+bool TaskManager::HasHigherPriorityTask(Priority priority) const
+{
+    uint64_t firstDeadline = firstDeadline_;
+    if (firstDeadline <= ConcurrentHelper::GetMilliseconds() + DEADLINE_BOOST_WINDOW) {
+        return true;
+    }
+    for (Priority band : PRIORITY_BAND_ORDER) {
+        if (band == priority) {
+            return false;
+        }
+        // the deadline tasks are served in the DEADLINE_REQUEST band
+        if (globalTaskNum_[band] != 0 || (band == Priority::DEADLINE_REQUEST && firstDeadline != UINT64_MAX)) {
+            return true;
+        }
+    }
+    return false;
+}
+// ---------------------------------- WorkStealing ---------------------------------------
+
 void TaskManager::NotifyExecuteTask()
 {
     std::lock_guard<std::recursive_mutex> lock(workersMutex_);
@@ -1036,11 +1675,49 @@ void TaskManager::NotifyExecuteTask()
         return;
     }
 
+    // wake one idle worker for each runnable task which is not yet covered by a worker being woken up
+    uint32_t taskNum = GetTotalTaskNum();
+    if (GetNonIdleTaskNum() == 0) {
+        // idle tasks are executed one at a time
+        taskNum = std::min(taskNum, 1U);
+    }
+    uint32_t wakingNum = wakingCount_;
+    if (taskNum <= wakingNum) {
+        HILOG_DEBUG("taskpool:: enough workers are waking up");
+        return;
+    }
+    std::vector<Worker*> candidates;
+    candidates.reserve(idleWorkers_.size());
     for (auto& worker : idleWorkers_) {
-        worker->NotifyExecuteTask();
+        if (!worker->isWaking_) {
+            candidates.push_back(worker);
+        }
+    }
+    size_t wakeupNum = std::min(static_cast<size_t>(taskNum - wakingNum), candidates.size());
+    // prefer the workers which became idle most recently, their caches are still warm
+    std::partial_sort(candidates.begin(), candidates.begin() + wakeupNum, candidates.end(),
+        [](const Worker* lhs, const Worker* rhs) { return lhs->idleSeq_ > rhs->idleSeq_; });
+    for (size_t i = 0; i < wakeupNum; i++) {
+        WakeupWorker(candidates[i]);
     }
 }
 
+void TaskManager::WakeupWorker(Worker* worker)
+{
+    if (worker->isWaking_.exchange(true)) {
+        return;
+    }
+    wakingCount_++;
+    if (!worker->NotifyExecuteTask()) {
+        // PerformTask will not run for this signal
+        worker->isWaking_ = false;
+        wakingCount_--;
+        return;
+    }
+    uint64_t wakeupCount = ++wakeupCount_;
+    HITRACE_HELPER_COUNT_TRACE("wakeupNum", static_cast<int64_t>(wakeupCount));
+}
+
 void TaskManager::InitTaskManager(napi_env env)
 {
     HITRACE_HELPER_METER_NAME("InitTaskManager");
@@ -1077,6 +1754,28 @@ void TaskManager::InitTaskManager(napi_env env)
 
         // Add a reserved thread for taskpool
         TryCreateWorkerForPerformance();
+#if defined(ENABLE_TASKPOOL_FFRT)
+        // the workers and modules to prewarm at launch, as taskpool.prewarm does
+        int prewarmNum = OHOS::system::GetIntParameter<int>("persist.commonlibrary.taskpoolprewarmworkers", 0);
+        // the modules are separated by ','
+        std::string moduleList = OHOS::system::GetParameter("persist.commonlibrary.taskpoolprewarmmodules", "");
+        std::vector<std::string> modules {};
+        for (size_t begin = 0; begin < moduleList.size();) {
+            size_t end = std::min(moduleList.find(',', begin), moduleList.size());
+            modules.emplace_back(moduleList.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        if (prewarmNum > 0 || !modules.empty()) {
+            Prewarm(static_cast<uint32_t>(std::max(prewarmNum, 0)), modules);
+        }
+        // the policy sizing the pool, "latency" keeps the queueing delay under the SLO in ms, 0 is the default SLO
+        std::string policyName = OHOS::system::GetParameter("persist.commonlibrary.taskpoolthreadcountpolicy", "");
+        if (!policyName.empty()) {
+            int slo = OHOS::system::GetIntParameter<int>("persist.commonlibrary.taskpoollatencyslo", 0);
+            SetThreadCountPolicy(ThreadCountPolicy::Create(policyName, static_cast<uint64_t>(std::max(slo, 0))));
+            HILOG_INFO("taskpool:: thread count policy %{public}s", GetThreadCountPolicy()->GetName());
+        }
+#endif
         // Create a timer to manage worker threads
         std::thread workerManager([this] {this->RunTaskManager();});
         workerManager.detach();
@@ -1100,6 +1799,9 @@ void TaskManager::RemoveWorker(Worker* worker)
     idleWorkers_.erase(worker);
     timeoutWorkers_.erase(worker);
     workers_.erase(worker);
+    if (worker->isWaking_.exchange(false)) {
+        wakingCount_--;
+    }
 }
 
 void TaskManager::RestoreWorker(Worker* worker)
@@ -1118,6 +1820,7 @@ void TaskManager::RestoreWorker(Worker* worker)
     // worker sets and call the 'NotifyWorkerIdle', which can still execute some tasks in its own thread.
     HILOG_DEBUG("taskpool:: worker has been restored and the current num is: %{public}zu", workers_.size());
     idleWorkers_.emplace_hint(idleWorkers_.end(), worker);
+    worker->idleSeq_ = ++idleSeq_;
     if (GetTaskNum() != 0) {
         NotifyExecuteTask();
     }
@@ -1174,10 +1877,12 @@ void TaskManager::DecreaseSendDataRefCount(napi_env env, uint32_t taskId, Task*
     }
 }
 
-void TaskManager::ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint32_t taskId, Task* task)
+void TaskManager::ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint32_t taskId, Task* task,
+    bool throwError)
 {
     auto [hostEnv, priority] = GetTaskEnvAndPriority(taskId);
     if (hostEnv == nullptr) {
+        resultInfo->DeleteSerializationArgs(env);
         delete resultInfo;
         return;
     }
@@ -1185,7 +1890,10 @@ void TaskManager::ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint
     auto iter = callbackTable_.find(taskId);
     if (iter == callbackTable_.end() || iter->second == nullptr) {
         HILOG_ERROR("taskpool:: the callback in SendData is not registered on the host side");
-        ErrorHelper::ThrowError(env, ErrorHelper::ERR_NOT_REGISTERED);
+        if (throwError) {
+            ErrorHelper::ThrowError(env, ErrorHelper::ERR_NOT_REGISTERED);
+        }
+        resultInfo->DeleteSerializationArgs(env);
         delete resultInfo;
         return;
     }
@@ -1204,213 +1912,74 @@ void TaskManager::ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint
         HILOG_ERROR("taskpool:: failed to send event to the host side");
         --callbackInfo->refCount;
         workerEngine->DecreaseListeningCounter();
+        resultInfo->DeleteSerializationArgs(env);
         delete resultInfo;
     }
 }
+
+bool TaskManager::HasSendDataCallback(uint32_t taskId)
+{
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    auto iter = callbackTable_.find(taskId);
+    return iter != callbackTable_.end() && iter->second != nullptr;
+}
 // ---------------------------------- SendData ---------------------------------------
 
 void TaskManager::NotifyDependencyTaskInfo(uint32_t taskId)
 {
     HILOG_DEBUG("taskpool:: task:%{public}s NotifyDependencyTaskInfo", std::to_string(taskId).c_str());
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
-    std::unique_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
-    auto iter = dependentTaskInfos_.find(taskId);
-    if (iter == dependentTaskInfos_.end() || iter->second.empty()) {
-        HILOG_DEBUG("taskpool:: dependentTaskInfo empty");
+    auto readyTasks = dependencyGraph_.Complete(taskId);
+    if (readyTasks.empty()) {
+        HILOG_DEBUG("taskpool:: no pending dependent task is ready");
         return;
     }
-    for (auto taskIdIter = iter->second.begin(); taskIdIter != iter->second.end();) {
-        uint32_t dependentTaskId = *taskIdIter;
-        RemoveDependencyById(taskId, dependentTaskId);
-        taskIdIter = iter->second.erase(taskIdIter);
-        if (!IsDependendByTaskId(dependentTaskId)) {
-            auto taskInfo = DequeuePendingTaskInfo(dependentTaskId);
-            if (taskInfo.first != 0) {
-                EnqueueTaskId(taskInfo.first, taskInfo.second);
-            }
-        }
-    }
-}
-
-void TaskManager::RemoveDependencyById(uint32_t dependentTaskId, uint32_t taskId)
-{
-    HILOG_DEBUG("taskpool::task:%{public}s RemoveDependencyById", std::to_string(taskId).c_str());
-    // remove dependency after task execute
-    std::unique_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    auto dependTaskIter = dependTaskInfos_.find(taskId);
-    if (dependTaskIter != dependTaskInfos_.end()) {
-        auto dependTaskInnerIter = dependTaskIter->second.find(dependentTaskId);
-        if (dependTaskInnerIter != dependTaskIter->second.end()) {
-            dependTaskIter->second.erase(dependTaskInnerIter);
-        }
+    for (const auto& [readyTaskId, priority] : readyTasks) {
+        EnqueueTaskId(readyTaskId, priority);
     }
 }
 
 bool TaskManager::IsDependendByTaskId(uint32_t taskId)
 {
-    std::shared_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    auto iter = dependTaskInfos_.find(taskId);
-    if (iter == dependTaskInfos_.end() || iter->second.empty()) {
-        return false;
-    }
-    return true;
+    return dependencyGraph_.HasPredecessor(taskId);
 }
 
 bool TaskManager::IsDependentByTaskId(uint32_t dependentTaskId)
 {
-    std::shared_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
-    auto iter = dependentTaskInfos_.find(dependentTaskId);
-    if (iter == dependentTaskInfos_.end() || iter->second.empty()) {
-        return false;
-    }
-    return true;
+    return dependencyGraph_.HasSuccessor(dependentTaskId);
 }
 
-bool TaskManager::StoreTaskDependency(uint32_t taskId, std::set<uint32_t> taskIdSet)
+bool TaskManager::StoreTaskDependency(uint32_t taskId, const std::set<uint32_t>& taskIdSet)
 {
     HILOG_DEBUG("taskpool:: task:%{public}s StoreTaskDependency", std::to_string(taskId).c_str());
-    StoreDependentTaskInfo(taskIdSet, taskId);
-    std::unique_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    auto iter = dependTaskInfos_.find(taskId);
-    if (iter == dependTaskInfos_.end()) {
-        for (const auto& dependentId : taskIdSet) {
-            auto idIter = dependTaskInfos_.find(dependentId);
-            if (idIter == dependTaskInfos_.end()) {
-                continue;
-            }
-            if (!CheckCircularDependency(taskIdSet, idIter->second, taskId)) {
-                return false;
-            }
-        }
-        dependTaskInfos_.emplace(taskId, std::move(taskIdSet));
-        return true;
-    }
-
-    for (const auto& dependentId : iter->second) {
-        auto idIter = dependTaskInfos_.find(dependentId);
-        if (idIter == dependTaskInfos_.end()) {
-            continue;
-        }
-        if (!CheckCircularDependency(iter->second, idIter->second, taskId)) {
-            return false;
-        }
-    }
-    iter->second.insert(taskIdSet.begin(), taskIdSet.end());
-    return true;
-}
-
-bool TaskManager::CheckCircularDependency(std::set<uint32_t> dependentIdSet, std::set<uint32_t> idSet, uint32_t taskId)
-{
-    for (const auto& id : idSet) {
-        if (id == taskId) {
-            return false;
-        }
-        auto iter = dependentIdSet.find(id);
-        if (iter != dependentIdSet.end()) {
-            continue;
-        }
-        auto dIter = dependTaskInfos_.find(id);
-        if (dIter == dependTaskInfos_.end()) {
-            continue;
-        }
-        if (!CheckCircularDependency(dependentIdSet, dIter->second, taskId)) {
-            return false;
-        }
-    }
-    return true;
+    return dependencyGraph_.AddDependencies(taskId, taskIdSet);
 }
 
 bool TaskManager::RemoveTaskDependency(uint32_t taskId, uint32_t dependentId)
 {
     HILOG_DEBUG("taskpool:: task:%{public}s RemoveTaskDependency", std::to_string(taskId).c_str());
-    RemoveDependentTaskInfo(dependentId, taskId);
-    std::unique_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    auto iter = dependTaskInfos_.find(taskId);
-    if (iter == dependTaskInfos_.end()) {
-        return false;
-    }
-    auto dependIter = iter->second.find(dependentId);
-    if (dependIter ==  iter->second.end()) {
-        return false;
-    }
-    iter->second.erase(dependIter);
-    return true;
+    return dependencyGraph_.RemoveDependency(taskId, dependentId);
 }
 
 void TaskManager::EnqueuePendingTaskInfo(uint32_t taskId, Priority priority)
 {
-    if (taskId == 0) {
-        return;
-    }
-    std::unique_lock<std::shared_mutex> lock(pendingTaskInfosMutex_);
-    pendingTaskInfos_.emplace(taskId, priority);
+    dependencyGraph_.Park(taskId, priority);
 }
 
 std::pair<uint32_t, Priority> TaskManager::DequeuePendingTaskInfo(uint32_t taskId)
 {
-    std::unique_lock<std::shared_mutex> lock(pendingTaskInfosMutex_);
-    if (pendingTaskInfos_.empty()) {
-        return std::make_pair(0, Priority::DEFAULT);
-    }
-    std::pair<uint32_t, Priority> result;
-    for (auto it = pendingTaskInfos_.begin(); it != pendingTaskInfos_.end(); ++it) {
-        if (it->first == taskId) {
-            result = std::make_pair(it->first, it->second);
-            it = pendingTaskInfos_.erase(it);
-            break;
-        }
-    }
-    return result;
+    return dependencyGraph_.Unpark(taskId);
 }
 
 void TaskManager::RemovePendingTaskInfo(uint32_t taskId)
 {
     HILOG_DEBUG("taskpool:: task:%{public}s RemovePendingTaskInfo", std::to_string(taskId).c_str());
-    std::unique_lock<std::shared_mutex> lock(pendingTaskInfosMutex_);
-    pendingTaskInfos_.erase(taskId);
-}
-
-void TaskManager::StoreDependentTaskInfo(std::set<uint32_t> dependentTaskIdSet, uint32_t taskId)
-{
-    HILOG_DEBUG("taskpool:: task:%{public}s StoreDependentTaskInfo", std::to_string(taskId).c_str());
-    std::unique_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
-    for (const auto& id : dependentTaskIdSet) {
-        auto iter = dependentTaskInfos_.find(id);
-        if (iter == dependentTaskInfos_.end()) {
-            std::set<uint32_t> set{taskId};
-            dependentTaskInfos_.emplace(id, std::move(set));
-        } else {
-            iter->second.emplace(taskId);
-        }
-    }
-}
-
-void TaskManager::RemoveDependentTaskInfo(uint32_t dependentTaskId, uint32_t taskId)
-{
-    HILOG_DEBUG("taskpool:: task:%{public}s RemoveDependentTaskInfo", std::to_string(taskId).c_str());
-    std::unique_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
-    auto iter = dependentTaskInfos_.find(dependentTaskId);
-    if (iter == dependentTaskInfos_.end()) {
-        return;
-    }
-    auto taskIter = iter->second.find(taskId);
-    if (taskIter == iter->second.end()) {
-        return;
-    }
-    iter->second.erase(taskIter);
+    dependencyGraph_.Unpark(taskId);
 }
 
 std::string TaskManager::GetTaskDependInfoToString(uint32_t taskId)
 {
-    std::shared_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    std::string str = "TaskInfos: taskId: " + std::to_string(taskId) + ", dependTaskId:";
-    auto iter = dependTaskInfos_.find(taskId);
-    if (iter != dependTaskInfos_.end()) {
-        for (const auto& id : iter->second) {
-            str += " " + std::to_string(id);
-        }
-    }
-    return str;
+    return "TaskInfos: taskId: " + std::to_string(taskId) + ", dependTaskId:" + dependencyGraph_.GetDependInfo(taskId);
 }
 
 void TaskManager::StoreTaskDuration(uint32_t taskId, uint64_t totalDuration, uint64_t cpuDuration)
@@ -1480,7 +2049,8 @@ Worker* TaskManager::GetLongTaskInfo(uint32_t taskId)
 void TaskManager::StoreTaskEnqueueTime(uint32_t taskId, std::string enqueueTimeStamp)
 {
     std::lock_guard<std::mutex> lock(taskEnqueueTimeMutex_);
-    taskEnqueueTimeMap_.emplace(taskId, enqueueTimeStamp);
+    uint64_t enqueueTime = ConcurrentHelper::GetMilliseconds();
+    taskEnqueueTimeMap_.emplace(taskId, std::make_pair(std::move(enqueueTimeStamp), enqueueTime));
 }
 
 void TaskManager::RemoveTaskEnqueueTime(uint32_t taskId)
@@ -1493,7 +2063,24 @@ std::string TaskManager::GetTaskEnqueueTime(uint32_t taskId)
 {
     std::lock_guard<std::mutex> lock(taskEnqueueTimeMutex_);
     auto iter = taskEnqueueTimeMap_.find(taskId);
-    return iter != taskEnqueueTimeMap_.end() ? iter->second : "";
+    return iter != taskEnqueueTimeMap_.end() ? iter->second.first : "";
+}
+
+void TaskManager::NotifyTaskDequeued(uint32_t taskId, Priority priority)
+{
+    uint64_t enqueueTime = 0;
+    {
+        std::lock_guard<std::mutex> lock(taskEnqueueTimeMutex_);
+        auto iter = taskEnqueueTimeMap_.find(taskId);
+        if (iter == taskEnqueueTimeMap_.end()) {
+            return;
+        }
+        enqueueTime = iter->second.second;
+        taskEnqueueTimeMap_.erase(iter);
+    }
+    uint64_t currTime = ConcurrentHelper::GetMilliseconds();
+    uint64_t waitTime = currTime > enqueueTime ? currTime - enqueueTime : 0;
+    GetThreadCountPolicy()->OnTaskDequeued(priority, waitTime);
 }
 
 void TaskManager::TerminateTask(uint32_t taskId)
@@ -1523,23 +2110,8 @@ void TaskManager::ReleaseTaskData(napi_env env, Task* task, bool shouldDeleteTas
     uint32_t taskId = task->taskId_;
     DecreaseSendDataRefCount(env, taskId, task);
     RemoveTaskDuration(taskId);
-    RemovePendingTaskInfo(taskId);
     ReleaseCallBackInfo(task);
-    {
-        std::unique_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
-        for (auto dependentTaskIter = dependentTaskInfos_.begin(); dependentTaskIter != dependentTaskInfos_.end();) {
-            if (dependentTaskIter->second.find(taskId) != dependentTaskIter->second.end()) {
-                dependentTaskIter = dependentTaskInfos_.erase(dependentTaskIter);
-            } else {
-                ++dependentTaskIter;
-            }
-        }
-    }
-    std::unique_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-    auto dependTaskIter = dependTaskInfos_.find(taskId);
-    if (dependTaskIter != dependTaskInfos_.end()) {
-        dependTaskInfos_.erase(dependTaskIter);
-    }
+    dependencyGraph_.RemoveTask(taskId);
 }
 
 void TaskManager::ReleaseCallBackInfo(Task* task)
@@ -1569,70 +2141,59 @@ void TaskManager::ReleaseCallBackInfo(Task* task)
 
 void TaskManager::StoreTask(Task* task)
 {
-    uint64_t id = reinterpret_cast<uint64_t>(task);
-    {
-        std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-        uint32_t taskId = CalculateTaskId(id);
-        while (tasks_.find(taskId) != tasks_.end()) {
-            id++;
-            taskId = CalculateTaskId(id);
-        }
-        task->SetTaskId(taskId);
-        tasks_.emplace(taskId, task);
+    uint32_t taskId = tasks_.Insert(task);
+    if (UNLIKELY(taskId == 0)) {
+        taskId = StoreOverflowTask(task);
     }
-    std::lock_guard<std::recursive_mutex> lock(tasksPtrSetMutex_);
-    tasksPtrSet_.insert(task);
+    task->SetTaskId(taskId);
 }
 
-bool TaskManager::RemoveTask(uint32_t taskId)
+void TaskManager::StoreTasks(const std::vector<Task*>& tasks)
 {
-    bool res = true;
-    Task* task = nullptr;
-    {
-        std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-        auto runningIter = runningTasks_.find(taskId);
-        if (runningIter != runningTasks_.end()) {
-            res = false;
-        }
-        auto taskIter = tasks_.find(taskId);
-        if (taskIter != tasks_.end()) {
-            task = taskIter->second;
-        }
-        runningTasks_.erase(taskId);
-        tasks_.erase(taskId);
+    for (Task* task : tasks) {
+        StoreTask(task);
     }
-    if (task != nullptr) {
-        std::lock_guard<std::recursive_mutex> lock(tasksPtrSetMutex_);
-        tasksPtrSet_.erase(task);
+}
+
+uint32_t TaskManager::StoreOverflowTask(Task* task)
+{
+    // the slots of the task table are in use or retired
+    HILOG_DEBUG("taskpool:: no free slot in the task table, taskNum:%{public}u", tasks_.GetTaskNum());
+    uint32_t taskId = tasks_.NextOverflowId();
+    while (!tasks_.InsertOverflow(taskId, task)) {
+        taskId = tasks_.NextOverflowId();
     }
+    return taskId;
+}
+
+bool TaskManager::RemoveTask(uint32_t taskId)
+{
+    std::lock_guard<std::mutex> lock(runningTasksMutex_);
+    bool res = runningTasks_.erase(taskId) == 0;
+    tasks_.Erase(taskId);
     return res;
 }
 
 void TaskManager::RemoveRunningTask(uint32_t taskId)
 {
-    std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
+    std::lock_guard<std::mutex> lock(runningTasksMutex_);
     runningTasks_.erase(taskId);
 }
 
 Task* TaskManager::GetTask(uint32_t taskId)
 {
-    std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-    auto iter = tasks_.find(taskId);
-    if (iter == tasks_.end()) {
-        return nullptr;
-    }
-    return iter->second;
+    return tasks_.Find(taskId);
 }
 
 Task* TaskManager::GetTaskForPerform(uint32_t taskId)
 {
-    std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
-    auto iter = tasks_.find(taskId);
-    if (iter == tasks_.end()) {
+    std::lock_guard<std::mutex> lock(runningTasksMutex_);
+    Task* task = tasks_.Find(taskId);
+    if (task == nullptr) {
         return nullptr;
     }
-    runningTasks_.emplace(taskId, iter->second);
-    return iter->second;
+    runningTasks_.emplace(taskId, task);
+    return task;
 }
 
 #if defined(ENABLE_TASKPOOL_FFRT)
@@ -1699,42 +2260,21 @@ uint32_t TaskManager::CalculateTaskId(uint64_t id)
 std::pair<uint32_t, Priority> TaskManager::ClearDependentTask(uint32_t taskId)
 {
     HILOG_DEBUG("taskpool:: task:%{public}s ClearDependentTask", std::to_string(taskId).c_str());
-    RemoveDependTaskByTaskId(taskId);
+    dependencyGraph_.RemovePredecessors(taskId);
     auto pendingInfo = DequeuePendingTaskInfo(taskId);
-    std::unique_lock<std::shared_mutex> lock(dependentTaskInfosMutex_);
     RemoveDependentTaskByTaskId(taskId);
     return pendingInfo;
 }
 
-void TaskManager::RemoveDependTaskByTaskId(uint32_t taskId)
-{
-    std::set<uint32_t> dependTaskIds;
-    {
-        std::unique_lock<std::shared_mutex> lock(dependTaskInfosMutex_);
-        auto iter = dependTaskInfos_.find(taskId);
-        if (iter == dependTaskInfos_.end()) {
-            return;
-        }
-        dependTaskIds.insert(iter->second.begin(), iter->second.end());
-        dependTaskInfos_.erase(iter);
-    }
-    for (auto dependTaskId : dependTaskIds) {
-        RemoveDependentTaskInfo(dependTaskId, taskId);
-    }
-}
-
 void TaskManager::RemoveDependentTaskByTaskId(uint32_t taskId)
 {
-    auto iter = dependentTaskInfos_.find(taskId);
-    if (iter == dependentTaskInfos_.end() || iter->second.empty()) {
+    std::vector<uint32_t> dependentTaskIds = dependencyGraph_.RemoveSuccessors(taskId);
+    if (dependentTaskIds.empty()) {
         HILOG_DEBUG("taskpool:: dependentTaskInfo empty");
         return;
     }
-    for (auto taskIdIter = iter->second.begin(); taskIdIter != iter->second.end();) {
-        auto pendingInfo = DequeuePendingTaskInfo(*taskIdIter);
-        RemoveDependencyById(taskId, *taskIdIter);
-        auto id = *taskIdIter;
-        taskIdIter = iter->second.erase(taskIdIter);
+    for (auto id : dependentTaskIds) {
+        auto pendingInfo = DequeuePendingTaskInfo(id);
         auto task = GetTask(id);
         if (task == nullptr) {
             continue;
@@ -2033,25 +2573,23 @@ CallbackInfo* TaskManager::GetSenddataCallback(uint32_t taskId)
 std::string TaskManager::GetFuncNameFromData(void* data)
 {
     std::string name = "Taskpool Thread";
-    if (data == nullptr) {
-        return name;
-    }
-    Task* task = static_cast<Task*>(data);
-    if (!IsValidTask(task)) {
+    Task* task = GetValidTask(data);
+    if (task == nullptr) {
         return name;
     }
     return name + " " + task->name_;
 }
 
-bool TaskManager::IsValidTask(Task* task)
+void* TaskManager::GetTaskInfoData(uint32_t taskId)
 {
-    if (task == nullptr) {
-        return false;
-    }
-    bool flag = false;
-    std::lock_guard<std::recursive_mutex> lock(tasksPtrSetMutex_);
-    flag = tasksPtrSet_.count(task) > 0;
-    return flag && task->IsValid();
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(taskId));
+}
+
+Task* TaskManager::GetValidTask(void* data)
+{
+    // a stale taskId does not match the generation of its slot any more, the task is only read once it is found
+    Task* task = tasks_.Find(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)));
+    return task != nullptr && task->IsValid() ? task : nullptr;
 }
 
 void TaskManager::IncreaseTaskIdSalt()
@@ -2096,7 +2634,7 @@ void TaskManager::PushRunningTaskLog()
     std::string msg = "";
     uint64_t diffTime = 0;
     {
-        std::lock_guard<std::recursive_mutex> lock(tasksMutex_);
+        std::lock_guard<std::mutex> lock(runningTasksMutex_);
         for (auto& [_, task] : runningTasks_) {
             if (task == nullptr || !task->IsValid()) {
                 continue;
@@ -2105,7 +2643,8 @@ void TaskManager::PushRunningTaskLog()
             if (IsNeedPrint(now, task->startTime_, task->runningPrintCount_, diffTime)) {
                 task->runningPrintCount_++;
                 msg = "Task is running, " + std::to_string(task->taskId_) + ", " + task->name_ +
-                    ", runT: " + task->runningTime_ + ", duration: " + std::to_string(diffTime / RATIO) + "s";
+                    ", runT: " + ConcurrentHelper::GetTimeStampWithMS(task->startTime_) +
+                    ", duration: " + std::to_string(diffTime / RATIO) + "s";
                 logs.push_back(msg);
             }
         }
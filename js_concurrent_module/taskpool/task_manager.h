@@ -22,11 +22,13 @@
 #include <mutex>
 #include <set>
 #include <shared_mutex>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "dependency_graph.h"
 #include "dfx_hisys_event.h"
 #include "log_manager.h"
 #include "napi/native_api.h"
@@ -34,6 +36,9 @@
 #include "task.h"
 #include "task_queue.h"
 #include "task_group.h"
+#include "task_table.h"
+#include "thread_count_policy.h"
+#include "work_stealing_queue.h"
 #include "worker.h"
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common;
@@ -53,6 +58,7 @@ static constexpr char TASK_IO_TIME[] = "ioDuration";
 static constexpr char TASK_TOTAL_TIME[] = "totalDuration";
 static constexpr char DEFAULT_TRANSFER_STR[] = "defaultTransfer";
 static constexpr char DEFAULT_CLONE_SENDABLE_STR[] = "defaultCloneSendable";
+static constexpr uint32_t MAX_LOCAL_QUEUE_NUM = 64; // 64: max number of workers owning a local run queue
 
 class TaskGroup;
 
@@ -61,13 +67,17 @@ public:
     static TaskManager& GetInstance();
 
     void StoreTask(Task* task);
+    void StoreTasks(const std::vector<Task*>& tasks);
     bool RemoveTask(uint32_t taskId);
     void RemoveRunningTask(uint32_t taskId);
     Task* GetTask(uint32_t taskId);
     Task* GetTaskForPerform(uint32_t taskId);
-    void EnqueueTaskId(uint32_t taskId, Priority priority = Priority::DEFAULT);
+    // affinityWorker is the worker preferred by a SequenceRunner, the task goes to it only while it is idle
+    void EnqueueTaskId(uint32_t taskId, Priority priority = Priority::DEFAULT, Worker* affinityWorker = nullptr);
+    // enqueue a batch of common or function tasks with one lock and one dispatch
+    void EnqueueTaskIds(const std::vector<Task*>& tasks, Priority priority = Priority::DEFAULT);
     bool EraseWaitingTaskId(uint32_t taskId, Priority priority);
-    std::pair<uint32_t, Priority> DequeueTaskId();
+    std::pair<uint32_t, Priority> DequeueTaskId(Worker* worker = nullptr);
     void CancelTask(napi_env env, uint32_t taskId);
     void CancelSeqRunnerTask(napi_env env, Task* task);
     void ReleaseTaskData(napi_env env, Task* task, bool shouldDeleteTask = true);
@@ -76,13 +86,25 @@ public:
     void NotifyWorkerIdle(Worker* worker);
     void NotifyWorkerCreated(Worker* worker);
     void NotifyWorkerRunning(Worker* worker);
+    // called by a woken worker before dequeuing, returns false if the worker was not being woken up
+    bool NotifyWorkerWokenUp(Worker* worker);
+    void CountSpuriousWakeup();
     void RemoveWorker(Worker* worker);
     void RestoreWorker(Worker* worker);
 
+    // for work stealing
+    void AttachLocalQueue(Worker* worker);
+    void DetachLocalQueue(Worker* worker);
+    // hands the tasks bound to the worker over to the global queues, no task is bound to it afterwards
+    void DetachAffinityQueue(Worker* worker);
+
     // for load balance
     void InitTaskManager(napi_env env);
     void UpdateExecutedInfo(uint64_t duration);
     void TryTriggerExpand();
+    // nullptr restores the default HeuristicThreadCountPolicy
+    void SetThreadCountPolicy(std::shared_ptr<ThreadCountPolicy> policy);
+    std::shared_ptr<ThreadCountPolicy> GetThreadCountPolicy();
 
     // for taskpool state
     uint32_t GetTaskNum();
@@ -99,6 +121,30 @@ public:
     // for get task info
     napi_value GetTaskInfos(napi_env env);
 
+    // for deadline scheduling
+    napi_value GetDeadlineInfo(napi_env env);
+    // counts a task with a deadline that has come back, the deadline is met if it finished in time
+    void RecordDeadlineResult(uint64_t deadline);
+
+    // for the result transfer
+    void SetResultTransfer(bool isResultTransfer);
+    bool IsResultTransfer() const;
+    void RecordResultBytes(uint64_t transferredBytes, uint64_t copiedBytes);
+    napi_value GetResultTransferInfo(napi_env env);
+
+    // for prewarm, the workers are created ahead and the modules are loaded in every worker env
+    void Prewarm(uint32_t workerNum, const std::vector<std::string>& modules);
+    uint32_t GetPreloadModuleNum() const;
+    // the modules added after the first from of them
+    std::vector<std::string> GetPreloadModules(uint32_t from);
+    void RecordWorkerStartupTime(uint64_t startupTime);
+    napi_value GetPrewarmInfo(napi_env env);
+
+    // for the workloads, once a task has a workload a worker is bound to the performance or efficiency cores
+    // while it runs a COMPUTE or BACKGROUND task, and to all the cores while it runs any other task
+    void EnableCoreAffinity();
+    bool IsCoreAffinityEnabled() const;
+
     // for countTrace for worker
     void CountTraceForWorker(bool needLog = false);
     void CountTraceForWorkerWithoutLock(bool needLog = false);
@@ -107,21 +153,20 @@ public:
         const std::string& type);
     void IncreaseSendDataRefCount(uint32_t taskId);
     void DecreaseSendDataRefCount(napi_env env, uint32_t taskId, Task* task = nullptr);
-    void ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint32_t taskId, Task* task);
+    // throwError is false for a batch posted outside the sendData call
+    void ExecuteSendData(napi_env env, TaskResultInfo* resultInfo, uint32_t taskId, Task* task,
+        bool throwError = true);
+    bool HasSendDataCallback(uint32_t taskId);
 
     // for task dependency
     bool IsDependendByTaskId(uint32_t taskId);
     bool IsDependentByTaskId(uint32_t dependentTaskId);
     void NotifyDependencyTaskInfo(uint32_t taskId);
-    void RemoveDependencyById(uint32_t dependentTaskId, uint32_t taskId);
-    bool StoreTaskDependency(uint32_t taskId, std::set<uint32_t> taskIdSet);
+    bool StoreTaskDependency(uint32_t taskId, const std::set<uint32_t>& taskIdSet);
     bool RemoveTaskDependency(uint32_t taskId, uint32_t dependentId);
-    bool CheckCircularDependency(std::set<uint32_t> dependentIdSet, std::set<uint32_t> idSet, uint32_t taskId);
     void EnqueuePendingTaskInfo(uint32_t taskId, Priority priority);
     std::pair<uint32_t, Priority> DequeuePendingTaskInfo(uint32_t taskId);
     void RemovePendingTaskInfo(uint32_t taskId);
-    void StoreDependentTaskInfo(std::set<uint32_t> dependTaskIdSet, uint32_t taskId);
-    void RemoveDependentTaskInfo(uint32_t dependentTaskId, uint32_t taskId);
     std::string GetTaskDependInfoToString(uint32_t taskId);
 
     bool PostTask(std::function<void()> task, const char* taskName, Priority priority = Priority::DEFAULT);
@@ -138,6 +183,8 @@ public:
     void StoreTaskEnqueueTime(uint32_t taskId, std::string enqueueTimeStamp);
     void RemoveTaskEnqueueTime(uint32_t taskId);
     std::string GetTaskEnqueueTime(uint32_t taskId);
+    // removes the enqueue time and reports the queueing delay to the thread count policy
+    void NotifyTaskDequeued(uint32_t taskId, Priority priority);
 
     // for callback
     void ReleaseCallBackInfo(Task* task);
@@ -173,7 +220,10 @@ public:
     bool ExecuteTaskStartExecution(uint32_t taskId, Priority priority);
     CallbackInfo* GetSenddataCallback(uint32_t taskId);
     std::string GetFuncNameFromData(void* data);
-    bool IsValidTask(Task* task);
+    // the engine keeps the taskId of the running task as its task info, so a stale one is never dereferenced
+    static void* GetTaskInfoData(uint32_t taskId);
+    // the task of the task info, nullptr if it has been removed or is invalid
+    Task* GetValidTask(void* data);
 
     void PushLog(const std::string& msg)
     {
@@ -186,6 +236,13 @@ public:
         logManager_.PushLogFront(msg);
     }
 
+    void RecordTaskEvent(TaskEventRing* ring, TaskEventType type, uint32_t taskId, Priority priority,
+                         uint32_t workerId)
+    {
+        bool ret = logManager_.RecordTaskEvent(ring, type, taskId, static_cast<uint8_t>(priority), workerId);
+        DealLogs(ret);
+    }
+
     LogManager logManager_ {};
 
     void NotifyShrinkByInBackground(bool inBackground);
@@ -200,6 +257,7 @@ private:
 
     void CreateWorkers(napi_env env, uint32_t num = 1);
     void NotifyExecuteTask();
+    void WakeupWorker(Worker* worker);
     void NotifyWorkerAdded(Worker* worker);
 
     // for load balance
@@ -221,9 +279,28 @@ private:
 
     bool IsChooseIdle();
     std::pair<uint32_t, Priority> GetTaskByPriority(const std::unique_ptr<ExecuteQueue>& taskQueue, Priority priority);
+    std::pair<uint32_t, Priority> PrepareDequeuedTask(uint32_t taskId, Priority priority);
+    std::pair<uint32_t, Priority> DequeueGlobalTaskId();
+    std::pair<uint32_t, Priority> DequeueGlobalTaskIdInner(bool isChoose,
+        std::vector<std::pair<uint32_t, Priority>>& expiredTasks);
+    bool EnqueueLocalTaskId(Task* task, Priority priority);
+    bool EnqueueAffinityTaskId(Task* task, Priority priority, Worker* worker);
+    // an idle worker on the cores for the workload of the task, nullptr if there is none
+    Worker* GetCoreClassWorker(Task* task);
+    std::pair<uint32_t, Priority> DequeueAffinityTaskId(Worker* worker);
+    bool EnqueueDeadlineTaskId(Task* task, Priority priority);
+    // drops the tasks whose deadline has passed into expiredTasks, then returns the earliest deadline task
+    // if it is due within window, must be called with taskQueuesMutex_ held
+    std::pair<uint32_t, Priority> DequeueDeadlineTaskId(uint64_t window,
+        std::vector<std::pair<uint32_t, Priority>>& expiredTasks);
+    void RejectExpiredTasks(const std::vector<std::pair<uint32_t, Priority>>& expiredTasks);
+    std::pair<uint32_t, Priority> DequeueLocalTaskId(Worker* worker);
+    std::pair<uint32_t, Priority> StealTaskId(Worker* worker);
+    bool ClaimLocalTaskId(uint32_t taskId);
+    void MoveToGlobalQueue(uint32_t taskId, Priority priority);
+    bool HasHigherPriorityTask(Priority priority) const;
     void IncreaseTaskNum(Priority priority);
     void DecreaseTaskNum(Priority priority);
-    void RemoveDependTaskByTaskId(uint32_t taskId);
     void RemoveDependentTaskByTaskId(uint32_t taskId);
     void CheckTasksAndReportHisysEvent();
     void WorkerAliveAndReport(Worker* worker);
@@ -231,6 +308,7 @@ private:
     void AddCountTraceForWorkerLog(bool needLog, int64_t threadNum, int64_t idleThreadNum, int64_t timeoutThreadNum);
     std::tuple<napi_env, napi_event_priority> GetTaskEnvAndPriority(uint32_t taskId);
     void IncreaseTaskIdSalt();
+    uint32_t StoreOverflowTask(Task* task);
     void TimerStop(uv_timer_t*& timer, const char* errMessage);
     void TimerInit(uv_timer_t*& timer, bool startFlag, uv_timer_cb cb, uint64_t repeat);
     bool IsNeedPrint(uint64_t nowTime, uint64_t startTime, uint32_t printCount, uint64_t& diffTime);
@@ -239,23 +317,13 @@ private:
     std::string GetPendingMessage(Priority priority, std::string tag);
 
     // <taskId, Task>
-    std::unordered_map<uint32_t, Task*> tasks_ {};
-    std::unordered_set<Task*> tasksPtrSet_ {};
+    TaskTable tasks_ {};
+    // RemoveTask and GetTaskForPerform update runningTasks_ and tasks_ together under runningTasksMutex_
     std::unordered_map<uint32_t, Task*> runningTasks_ {};
-    std::recursive_mutex tasksMutex_;
-    std::recursive_mutex tasksPtrSetMutex_;
-
-    // <taskId, <dependent taskId1, dependent taskId2, ...>>, update when removeDependency or executeTask
-    std::unordered_map<uint32_t, std::set<uint32_t>> dependTaskInfos_ {};
-    std::shared_mutex dependTaskInfosMutex_;
+    std::mutex runningTasksMutex_;
 
-    // <dependent taskId, <taskId1, taskId2, ...>>, update when removeDependency or executeTask
-    std::unordered_map<uint32_t, std::set<uint32_t>> dependentTaskInfos_ {};
-    std::shared_mutex dependentTaskInfosMutex_;
-
-    // <<pendingTaskId1, priority>, <pendingTaskId2, priority>, ...>
-    std::unordered_map<uint32_t, Priority> pendingTaskInfos_ {};
-    std::shared_mutex pendingTaskInfosMutex_;
+    // the task dependencies and the tasks pending on them, update when add/removeDependency or executeTask
+    DependencyGraph dependencyGraph_ {};
 
     // <<taskId1, <totalDuration1, cpuDuration1>>, <taskId2, <totalDuration2, cpuDuration2>>, ...>
     std::unordered_map<uint32_t, std::pair<uint64_t, uint64_t>> taskDurationInfos_ {};
@@ -269,8 +337,14 @@ private:
     std::unordered_set<Worker*> idleWorkers_ {};
     std::unordered_set<Worker*> timeoutWorkers_ {};
     std::recursive_mutex workersMutex_;
-
-    std::unordered_map<uint32_t, std::string> taskEnqueueTimeMap_ {};
+    // for targeted wakeup, idleSeq_ is written under workersMutex_
+    uint64_t idleSeq_ = 0;
+    std::atomic<uint32_t> wakingCount_ = 0;
+    std::atomic<uint64_t> wakeupCount_ = 0;
+    std::atomic<uint64_t> spuriousWakeupCount_ = 0;
+
+    // <taskId, <enqueueTimeStamp, enqueueTime in ms>>
+    std::unordered_map<uint32_t, std::pair<std::string, uint64_t>> taskEnqueueTimeMap_ {};
     std::mutex taskEnqueueTimeMutex_;
 
     // for load balance
@@ -286,6 +360,8 @@ private:
     std::atomic<uint32_t> totalTaskNum_ = 0;
     std::atomic<uint32_t> totalExecCount_ = 0;
     std::atomic<uint64_t> totalExecTime_ = 0;
+    std::shared_ptr<ThreadCountPolicy> threadCountPolicy_ = std::make_shared<HeuristicThreadCountPolicy>();
+    std::shared_mutex threadCountPolicyMutex_;
     std::atomic<bool> needChecking_ = false;
     std::atomic<bool> isHandleInited_ = false;
     std::atomic<uint32_t> timerTriggered_ = false;
@@ -299,6 +375,37 @@ private:
     uint32_t mediumPrioExecuteCount_ = 0;
     std::array<std::unique_ptr<ExecuteQueue>, Priority::NUMBER> taskQueues_ {};
     std::mutex taskQueuesMutex_;
+    // written under taskQueuesMutex_, read without lock to check the bands before taking local work
+    std::array<std::atomic<uint32_t>, Priority::NUMBER> globalTaskNum_ {};
+
+    // for deadline scheduling, the common tasks executed with a deadline wait here instead of taskQueues_
+    DeadlineQueue deadlineQueue_ {};
+    // written under taskQueuesMutex_, UINT64_MAX if deadlineQueue_ is empty
+    std::atomic<uint64_t> firstDeadline_ = UINT64_MAX;
+    std::atomic<uint64_t> deadlineMetCount_ = 0;
+    std::atomic<uint64_t> deadlineLateCount_ = 0; // started in time but finished after the deadline
+    std::atomic<uint64_t> deadlineDropCount_ = 0; // the deadline passed before the task started
+    std::atomic<uint64_t> deadlineBoostCount_ = 0; // dequeued ahead of the bands as the deadline was near
+
+    // for the result transfer, the ArrayBuffers of a result are moved back unless setResultTransferMode(false)
+    std::atomic<bool> isResultTransfer_ = true;
+    std::atomic<uint64_t> resultTransferredBytes_ = 0;
+    std::atomic<uint64_t> resultCopiedBytes_ = 0;
+
+    // for prewarm, preloadModules_ only grows and a worker loads the ones after those it has loaded
+    std::mutex preloadMutex_;
+    std::vector<std::string> preloadModules_ {};
+    std::atomic<uint32_t> preloadModuleNum_ = 0;
+    std::atomic<uint32_t> prewarmNum_ = 0; // the workers kept when the pool is idle
+    std::atomic<uint64_t> workerStartupTime_ = 0; // ms from the constructor until the last worker became idle
+
+    // for the workloads, never turned off once a task has a workload on a device with two classes of cores
+    std::atomic<bool> isCoreAffinityEnabled_ = false;
+
+    // for work stealing, the queues are never freed before ~TaskManager so that thieves can always access them
+    std::array<std::atomic<WorkStealingQueue*>, MAX_LOCAL_QUEUE_NUM> localQueues_ {};
+    std::array<std::atomic<bool>, MAX_LOCAL_QUEUE_NUM> localQueueUsed_ {};
+    std::atomic<uint32_t> localTaskNum_ = 0;
 
     std::atomic<bool> isInitialized_ = false;
     std::atomic<bool> isSystemApp_ = false;
@@ -16,46 +16,259 @@
 #include "task_queue.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Platform;
+
+static constexpr uint32_t MIN_INDEX_CAPACITY = 16; // 16: initial capacity of the taskId index, power of 2
+static constexpr uint32_t HASH_MULTIPLIER = 2654435761U; // 2654435761: Knuth multiplicative hash
+
+static inline uint32_t HashTaskId(uint32_t taskId)
+{
+    return taskId * HASH_MULTIPLIER;
+}
+
 void ExecuteQueue::EnqueueTaskId(uint32_t taskId)
 {
-    tasks_.emplace_back(taskId);
+    uint32_t slot = AllocSlot(taskId);
+    slots_[slot].prev = tail_;
+    if (tail_ != INVALID_SLOT) {
+        slots_[tail_].next = slot;
+    } else {
+        head_ = slot;
+    }
+    tail_ = slot;
+    size_++;
+
+    uint32_t pos = FindIndex(taskId);
+    if (pos == INVALID_SLOT) {
+        slots_[slot].sameTail = slot;
+        InsertIndex(taskId, slot);
+        return;
+    }
+    uint32_t first = index_[pos];
+    slots_[slots_[first].sameTail].sameNext = slot;
+    slots_[first].sameTail = slot;
 }
 
 bool ExecuteQueue::EraseWaitingTaskId(uint32_t taskId)
 {
-    auto it = std::find(tasks_.begin(), tasks_.end(), taskId);
-    if (it != tasks_.end()) {
-        tasks_.erase(it);
-        return true;
+    uint32_t pos = FindIndex(taskId);
+    if (pos == INVALID_SLOT) {
+        return false;
     }
-    return false;
+    EraseSlot(pos, index_[pos]);
+    return true;
 }
 
 uint32_t ExecuteQueue::DequeueTaskId()
 {
-    if (!tasks_.empty()) {
-        uint32_t taskId = tasks_.front();
-        tasks_.pop_front();
-        return taskId;
+    if (head_ == INVALID_SLOT) {
+        return 0;
     }
-    return 0;
+    uint32_t taskId = slots_[head_].taskId;
+    // the head is always the first occurrence of its taskId
+    EraseSlot(FindIndex(taskId), head_);
+    return taskId;
 }
 
 bool ExecuteQueue::IsEmpty() const
 {
-    return tasks_.empty();
+    return size_ == 0;
 }
 
 uint32_t ExecuteQueue::GetTaskNum() const
 {
-    return tasks_.size();
+    return size_;
 }
 
 uint32_t ExecuteQueue::GetHead() const
 {
-    if (tasks_.empty()) {
+    if (head_ == INVALID_SLOT) {
         return 0;
     }
-    return tasks_.front();
+    return slots_[head_].taskId;
+}
+
+uint32_t ExecuteQueue::AllocSlot(uint32_t taskId)
+{
+    uint32_t slot = freeHead_;
+    if (slot != INVALID_SLOT) {
+        freeHead_ = slots_[slot].next;
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& node = slots_[slot];
+    node.taskId = taskId;
+    node.prev = INVALID_SLOT;
+    node.next = INVALID_SLOT;
+    node.sameNext = INVALID_SLOT;
+    node.sameTail = INVALID_SLOT;
+    return slot;
+}
+
+void ExecuteQueue::FreeSlot(uint32_t slot)
+{
+    if (size_ == 0) {
+        // the queue is drained, reset the slab so that it stays compact, the capacity is kept
+        slots_.clear();
+        freeHead_ = INVALID_SLOT;
+        return;
+    }
+    slots_[slot].next = freeHead_;
+    freeHead_ = slot;
+}
+
+void ExecuteQueue::Unlink(uint32_t slot)
+{
+    Slot& node = slots_[slot];
+    if (node.prev != INVALID_SLOT) {
+        slots_[node.prev].next = node.next;
+    } else {
+        head_ = node.next;
+    }
+    if (node.next != INVALID_SLOT) {
+        slots_[node.next].prev = node.prev;
+    } else {
+        tail_ = node.prev;
+    }
+    size_--;
+}
+
+// remove the first occurrence 'slot' stored at index position 'pos' from both the index and the queue
+void ExecuteQueue::EraseSlot(uint32_t pos, uint32_t slot)
+{
+    uint32_t sameNext = slots_[slot].sameNext;
+    if (sameNext == INVALID_SLOT) {
+        RemoveIndex(pos);
+    } else {
+        slots_[sameNext].sameTail = slots_[slot].sameTail;
+        index_[pos] = sameNext;
+    }
+    Unlink(slot);
+    FreeSlot(slot);
+}
+
+uint32_t ExecuteQueue::FindIndex(uint32_t taskId) const
+{
+    if (indexSize_ == 0) {
+        return INVALID_SLOT;
+    }
+    uint32_t mask = static_cast<uint32_t>(index_.size()) - 1;
+    uint32_t pos = HashTaskId(taskId) & mask;
+    while (index_[pos] != INVALID_SLOT) {
+        if (slots_[index_[pos]].taskId == taskId) {
+            return pos;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return INVALID_SLOT;
+}
+
+void ExecuteQueue::InsertIndex(uint32_t taskId, uint32_t slot)
+{
+    // keep the load factor below 1/2 so that the probe sequences stay short
+    if ((indexSize_ + 1) * 2 > index_.size()) {
+        GrowIndex();
+    }
+    uint32_t mask = static_cast<uint32_t>(index_.size()) - 1;
+    uint32_t pos = HashTaskId(taskId) & mask;
+    while (index_[pos] != INVALID_SLOT) {
+        pos = (pos + 1) & mask;
+    }
+    index_[pos] = slot;
+    indexSize_++;
+}
+
+void ExecuteQueue::RemoveIndex(uint32_t pos)
+{
+    // backward shift deletion, no tombstones are left behind
+    uint32_t mask = static_cast<uint32_t>(index_.size()) - 1;
+    index_[pos] = INVALID_SLOT;
+    indexSize_--;
+    uint32_t next = (pos + 1) & mask;
+    while (index_[next] != INVALID_SLOT) {
+        uint32_t ideal = HashTaskId(slots_[index_[next]].taskId) & mask;
+        if (((next - ideal) & mask) >= ((next - pos) & mask)) {
+            index_[pos] = index_[next];
+            index_[next] = INVALID_SLOT;
+            pos = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+void ExecuteQueue::GrowIndex()
+{
+    uint32_t capacity = index_.empty() ? MIN_INDEX_CAPACITY : static_cast<uint32_t>(index_.size()) * 2;
+    std::vector<uint32_t> oldIndex(capacity, INVALID_SLOT);
+    oldIndex.swap(index_);
+    uint32_t mask = capacity - 1;
+    for (uint32_t slot : oldIndex) {
+        if (slot == INVALID_SLOT) {
+            continue;
+        }
+        uint32_t pos = HashTaskId(slots_[slot].taskId) & mask;
+        while (index_[pos] != INVALID_SLOT) {
+            pos = (pos + 1) & mask;
+        }
+        index_[pos] = slot;
+    }
+}
+
+void DeadlineQueue::EnqueueTaskId(uint32_t taskId, Priority priority, uint64_t deadline)
+{
+    auto iter = entries_.insert(Entry {deadline, sequence_++, taskId, priority}).first;
+    index_.emplace(taskId, iter);
+}
+
+bool DeadlineQueue::EraseWaitingTaskId(uint32_t taskId)
+{
+    // the earliest entry of the task goes first, like the FIFO queues
+    auto [begin, end] = index_.equal_range(taskId);
+    if (begin == end) {
+        return false;
+    }
+    auto first = begin;
+    for (auto iter = begin; iter != end; ++iter) {
+        if (*iter->second < *first->second) {
+            first = iter;
+        }
+    }
+    entries_.erase(first->second);
+    index_.erase(first);
+    return true;
+}
+
+std::pair<uint32_t, Priority> DeadlineQueue::DequeueTaskId()
+{
+    if (entries_.empty()) {
+        return std::make_pair(0, Priority::LOW);
+    }
+    auto head = entries_.begin();
+    auto [begin, end] = index_.equal_range(head->taskId);
+    for (auto iter = begin; iter != end; ++iter) {
+        if (iter->second == head) {
+            index_.erase(iter);
+            break;
+        }
+    }
+    auto taskInfo = std::make_pair(head->taskId, head->priority);
+    entries_.erase(head);
+    return taskInfo;
+}
+
+bool DeadlineQueue::IsEmpty() const
+{
+    return entries_.empty();
+}
+
+uint32_t DeadlineQueue::GetTaskNum() const
+{
+    return static_cast<uint32_t>(entries_.size());
+}
+
+uint64_t DeadlineQueue::GetFirstDeadline() const
+{
+    return entries_.empty() ? UINT64_MAX : entries_.begin()->deadline;
 }
-} // namespace Commonlibrary::Concurrent::TaskPoolModule
\ No newline at end of file
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
@@ -16,9 +16,18 @@
 #ifndef JS_CONCURRENT_MODULE_TASKPOOL_TASK_QUEUE_H
 #define JS_CONCURRENT_MODULE_TASKPOOL_TASK_QUEUE_H
 
-#include <list>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
+// A FIFO queue of task ids with O(1) enqueue, dequeue and erase.
+// Nodes live in a slab (slots_) and are linked by index, freed slots are recycled through a free list,
+// and an open-addressing table (index_) maps a taskId to the slot of its first occurrence in the queue.
 class ExecuteQueue {
 public:
     ExecuteQueue() = default;
@@ -33,7 +42,70 @@ public:
     uint32_t GetHead() const;
 
 private:
-    std::list<uint32_t> tasks_ {};
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    struct Slot {
+        uint32_t taskId = 0;
+        uint32_t prev = INVALID_SLOT;
+        uint32_t next = INVALID_SLOT;
+        // the same taskId may be enqueued more than once, the occurrences are chained in FIFO order
+        uint32_t sameNext = INVALID_SLOT;
+        uint32_t sameTail = INVALID_SLOT; // only valid on the first occurrence
+    };
+
+    uint32_t AllocSlot(uint32_t taskId);
+    void FreeSlot(uint32_t slot);
+    void Unlink(uint32_t slot);
+
+    uint32_t FindIndex(uint32_t taskId) const;
+    void InsertIndex(uint32_t taskId, uint32_t slot);
+    void EraseSlot(uint32_t pos, uint32_t slot);
+    void RemoveIndex(uint32_t pos);
+    void GrowIndex();
+
+    std::vector<Slot> slots_ {};
+    std::vector<uint32_t> index_ {};
+    uint32_t head_ = INVALID_SLOT;
+    uint32_t tail_ = INVALID_SLOT;
+    uint32_t freeHead_ = INVALID_SLOT;
+    uint32_t size_ = 0;
+    uint32_t indexSize_ = 0;
+};
+
+// The tasks executed with a deadline, ordered by the deadline and then by the enqueue order (earliest deadline first).
+// A task keeps the priority it was executed with, which is reported when it is dequeued.
+class DeadlineQueue {
+public:
+    DeadlineQueue() = default;
+    ~DeadlineQueue() = default;
+
+    void EnqueueTaskId(uint32_t taskId, Commonlibrary::Platform::Priority priority, uint64_t deadline);
+    bool EraseWaitingTaskId(uint32_t taskId);
+    // returns <0, LOW> if the queue is empty
+    std::pair<uint32_t, Commonlibrary::Platform::Priority> DequeueTaskId();
+
+    bool IsEmpty() const;
+    uint32_t GetTaskNum() const;
+    // returns UINT64_MAX if the queue is empty
+    uint64_t GetFirstDeadline() const;
+
+private:
+    struct Entry {
+        uint64_t deadline;
+        uint64_t sequence;
+        uint32_t taskId;
+        Commonlibrary::Platform::Priority priority;
+
+        bool operator<(const Entry& other) const
+        {
+            return deadline != other.deadline ? deadline < other.deadline : sequence < other.sequence;
+        }
+    };
+
+    std::set<Entry> entries_ {};
+    // <taskId, entry>, the same taskId may be enqueued more than once
+    std::unordered_multimap<uint32_t, std::set<Entry>::const_iterator> index_ {};
+    uint64_t sequence_ = 0;
 };
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
-#endif // JS_CONCURRENT_MODULE_TASKPOOL_TASK_QUEUE_H
\ No newline at end of file
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_TASK_QUEUE_H
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "task_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+static constexpr uint32_t TAG_SHIFT = 32; // 32: the tag lives in the high half of freeHead_
+static constexpr uint64_t INDEX_PART = 0xFFFFFFFF; // 0xFFFFFFFF: the low half of freeHead_
+
+TaskTable::TaskTable()
+{
+    // the start time and the address of the table differ from one process to the next
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    generationSalt_ = static_cast<uint64_t>(now) ^ reinterpret_cast<uintptr_t>(this);
+}
+
+TaskTable::~TaskTable()
+{
+    Clear();
+}
+
+uint32_t TaskTable::Insert(Task* task)
+{
+    uint32_t index = 0;
+    if (!PopFreeIndex(index)) {
+        index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= CAPACITY) {
+            nextIndex_.store(CAPACITY, std::memory_order_relaxed);
+            return 0;
+        }
+    }
+    Slot* slot = AcquireSlot(index);
+    if (slot->generation == 0) {
+        slot->generation = GetFirstGeneration(index);
+    }
+    uint32_t taskId = (slot->generation << INDEX_BITS) | index;
+    // publish the task before the taskId, Find checks the taskId on both sides of reading the task
+    slot->task.store(task, std::memory_order_release);
+    slot->taskId.store(taskId, std::memory_order_release);
+    taskNum_.fetch_add(1, std::memory_order_relaxed);
+    return taskId;
+}
+
+bool TaskTable::InsertOverflow(uint32_t taskId, Task* task)
+{
+    std::unique_lock<std::shared_mutex> lock(overflowMutex_);
+    if (!overflowTasks_.emplace(taskId | OVERFLOW_FLAG, task).second) {
+        return false;
+    }
+    taskNum_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t TaskTable::NextOverflowId()
+{
+    return nextOverflowId_.fetch_add(1, std::memory_order_relaxed) | OVERFLOW_FLAG;
+}
+
+Task* TaskTable::Find(uint32_t taskId) const
+{
+    if (taskId & OVERFLOW_FLAG) {
+        std::shared_lock<std::shared_mutex> lock(overflowMutex_);
+        auto iter = overflowTasks_.find(taskId);
+        return iter != overflowTasks_.end() ? iter->second : nullptr;
+    }
+    if ((taskId >> INDEX_BITS) == 0) {
+        // the generation of a used slot is never 0
+        return nullptr;
+    }
+    Slot* slot = GetSlot(taskId & INDEX_MASK);
+    if (slot == nullptr || slot->taskId.load(std::memory_order_acquire) != taskId) {
+        return nullptr;
+    }
+    Task* task = slot->task.load(std::memory_order_acquire);
+    // the slot may have been freed and reused while reading the task
+    if (slot->taskId.load(std::memory_order_relaxed) != taskId) {
+        return nullptr;
+    }
+    return task;
+}
+
+Task* TaskTable::Erase(uint32_t taskId)
+{
+    std::shared_lock<std::shared_mutex> eraseLock(eraseMutex_);
+    if (taskId & OVERFLOW_FLAG) {
+        std::unique_lock<std::shared_mutex> lock(overflowMutex_);
+        auto iter = overflowTasks_.find(taskId);
+        if (iter == overflowTasks_.end()) {
+            return nullptr;
+        }
+        Task* task = iter->second;
+        overflowTasks_.erase(iter);
+        taskNum_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+    if ((taskId >> INDEX_BITS) == 0) {
+        return nullptr;
+    }
+    uint32_t index = taskId & INDEX_MASK;
+    Slot* slot = GetSlot(index);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    uint32_t expected = taskId;
+    // only one of the racing Erase calls wins the slot
+    if (!slot->taskId.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+        return nullptr;
+    }
+    Task* task = slot->task.exchange(nullptr, std::memory_order_acq_rel);
+    taskNum_.fetch_sub(1, std::memory_order_relaxed);
+    slot->generation = slot->generation == MAX_GENERATION ? 1 : slot->generation + 1;
+    PushFreeIndex(index);
+    return task;
+}
+
+void TaskTable::ForEach(const std::function<void(Task*)>& func)
+{
+    std::unique_lock<std::shared_mutex> eraseLock(eraseMutex_);
+    uint32_t indexNum = std::min(nextIndex_.load(std::memory_order_acquire), CAPACITY);
+    for (uint32_t index = 0; index < indexNum; index++) {
+        Slot* slot = GetSlot(index);
+        if (slot == nullptr || slot->taskId.load(std::memory_order_acquire) == 0) {
+            continue;
+        }
+        Task* task = slot->task.load(std::memory_order_acquire);
+        if (task != nullptr) {
+            func(task);
+        }
+    }
+    std::shared_lock<std::shared_mutex> lock(overflowMutex_);
+    for (const auto& [_, task] : overflowTasks_) {
+        func(task);
+    }
+}
+
+void TaskTable::Clear()
+{
+    for (auto& page : pages_) {
+        delete[] page.exchange(nullptr);
+    }
+    freeHead_ = 0;
+    nextIndex_ = 0;
+    taskNum_ = 0;
+    std::unique_lock<std::shared_mutex> lock(overflowMutex_);
+    overflowTasks_.clear();
+}
+
+uint32_t TaskTable::GetTaskNum() const
+{
+    return taskNum_.load(std::memory_order_relaxed);
+}
+
+uint32_t TaskTable::GetFirstGeneration(uint32_t index) const
+{
+    // the finalizer of splitmix64 spreads the salted index over all bits
+    uint64_t value = generationSalt_ + index;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL; // 30: the shifts and multipliers of splitmix64
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL; // 27: the shifts and multipliers of splitmix64
+    value ^= value >> 31; // 31: the shifts and multipliers of splitmix64
+    return static_cast<uint32_t>(value % MAX_GENERATION) + 1;
+}
+
+TaskTable::Slot* TaskTable::GetSlot(uint32_t index) const
+{
+    Slot* page = pages_[index >> PAGE_BITS].load(std::memory_order_acquire);
+    return page == nullptr ? nullptr : &page[index & (PAGE_SIZE - 1)];
+}
+
+TaskTable::Slot* TaskTable::AcquireSlot(uint32_t index)
+{
+    auto& page = pages_[index >> PAGE_BITS];
+    Slot* slots = page.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        Slot* newSlots = new Slot[PAGE_SIZE];
+        if (page.compare_exchange_strong(slots, newSlots, std::memory_order_acq_rel)) {
+            slots = newSlots;
+        } else {
+            // another thread has installed the page
+            delete[] newSlots;
+        }
+    }
+    return &slots[index & (PAGE_SIZE - 1)];
+}
+
+bool TaskTable::PopFreeIndex(uint32_t& index)
+{
+    uint64_t head = freeHead_.load(std::memory_order_acquire);
+    while ((head & INDEX_PART) != 0) {
+        uint32_t headIndex = static_cast<uint32_t>(head & INDEX_PART) - 1;
+        // the slot may be popped and reused meanwhile, then the tag differs and the CAS fails
+        uint32_t next = GetSlot(headIndex)->next.load(std::memory_order_relaxed);
+        uint64_t newHead = (((head >> TAG_SHIFT) + 1) << TAG_SHIFT) | next;
+        if (freeHead_.compare_exchange_weak(head, newHead, std::memory_order_acq_rel)) {
+            index = headIndex;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskTable::PushFreeIndex(uint32_t index)
+{
+    Slot* slot = GetSlot(index);
+    uint64_t head = freeHead_.load(std::memory_order_relaxed);
+    uint64_t newHead = 0;
+    do {
+        slot->next.store(static_cast<uint32_t>(head & INDEX_PART), std::memory_order_relaxed);
+        newHead = (((head >> TAG_SHIFT) + 1) << TAG_SHIFT) | (index + 1);
+    } while (!freeHead_.compare_exchange_weak(head, newHead, std::memory_order_acq_rel));
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
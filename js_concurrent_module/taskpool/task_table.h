@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_TASK_TABLE_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_TASK_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+class Task;
+
+// A concurrent <taskId, Task*> table.
+// A taskId holds a slot index in the low INDEX_BITS and the generation of the slot above it, the generation is
+// bumped every time the slot is freed so that a stale taskId does not match the slot again. It wraps after
+// MAX_GENERATION reuses of the slot. The first generation of a slot is salted, so the taskIds are not a sequence.
+// Find is wait-free and checks a taskId, which may be stale, by the generation of its slot without reading the
+// task. Insert and Erase are lock-free with respect to each other, Erase only waits for ForEach.
+// The slots live in pages which are not freed before Clear, so a racing Find never reads freed memory.
+// When no slot is free, the tasks are stored in an overflow map with ids that have OVERFLOW_FLAG set, they come
+// from a sequence and repeat only after 2^31 overflow tasks.
+class TaskTable {
+public:
+    static constexpr uint32_t INDEX_BITS = 18; // 18: at most 262144 tasks in the slots
+    static constexpr uint32_t PAGE_BITS = 10; // 10: 1024 slots per page
+    static constexpr uint32_t OVERFLOW_FLAG = 1U << 31; // 31: the highest bit of the taskId
+
+    TaskTable();
+    ~TaskTable();
+    TaskTable(const TaskTable&) = delete;
+    TaskTable& operator=(const TaskTable&) = delete;
+
+    // returns the taskId of the task, or 0 if all slots are in use
+    uint32_t Insert(Task* task);
+    // for the ids produced when Insert returns 0, returns false if the id is in use
+    bool InsertOverflow(uint32_t taskId, Task* task);
+    uint32_t NextOverflowId();
+    Task* Find(uint32_t taskId) const;
+    // returns the erased task, nullptr if the taskId is not in the table
+    Task* Erase(uint32_t taskId);
+    // the tasks are not erased while func runs, func must not call Erase
+    void ForEach(const std::function<void(Task*)>& func);
+    // not thread safe, for the destruction of the TaskManager
+    void Clear();
+    uint32_t GetTaskNum() const;
+
+private:
+    static constexpr uint32_t PAGE_SIZE = 1U << PAGE_BITS;
+    static constexpr uint32_t PAGE_NUM = 1U << (INDEX_BITS - PAGE_BITS);
+    static constexpr uint32_t CAPACITY = 1U << INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = CAPACITY - 1;
+    static constexpr uint32_t MAX_GENERATION = (OVERFLOW_FLAG >> INDEX_BITS) - 1;
+
+    struct Slot {
+        std::atomic<uint32_t> taskId {0}; // 0 while the slot is free
+        std::atomic<Task*> task {nullptr};
+        std::atomic<uint32_t> next {0}; // the next free index + 1
+        uint32_t generation = 0; // only accessed by the thread which owns the free slot, never 0 once it is used
+    };
+
+    uint32_t GetFirstGeneration(uint32_t index) const;
+    Slot* GetSlot(uint32_t index) const;
+    Slot* AcquireSlot(uint32_t index);
+    bool PopFreeIndex(uint32_t& index);
+    void PushFreeIndex(uint32_t index);
+
+    std::array<std::atomic<Slot*>, PAGE_NUM> pages_ {};
+    // <tag, free index + 1>, the tag is bumped on every update to avoid ABA
+    std::atomic<uint64_t> freeHead_ {0};
+    std::atomic<uint32_t> nextIndex_ {0};
+    std::atomic<uint32_t> nextOverflowId_ {0};
+    std::atomic<uint32_t> taskNum_ {0};
+    uint64_t generationSalt_ = 0;
+    // held shared by Erase and exclusively by ForEach, so that the visited tasks are not erased and deleted
+    std::shared_mutex eraseMutex_;
+
+    std::unordered_map<uint32_t, Task*> overflowTasks_ {};
+    mutable std::shared_mutex overflowMutex_;
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_TASK_TABLE_H
@@ -15,11 +15,15 @@
 
 #include "taskpool.h"
 
+#include <algorithm>
+
 #include "async_runner_manager.h"
+#include "function_cache.h"
 #include "helper/async_stack_helper.h"
 #include "helper/hitrace_helper.h"
 #include "sequence_runner_manager.h"
 #include "task_group_manager.h"
+#include "timer_wheel.h"
 #if defined(ENABLE_CONCURRENCY_INTEROP)
 #include "napi/native_node_hybrid_api.h"
 #endif
@@ -88,6 +92,18 @@ napi_value TaskPool::InitTaskPool(napi_env env, napi_value exports)
     };
     napi_define_properties(env, stateObj, sizeof(exportState) / sizeof(exportState[0]), exportState);
 
+    // define Workload
+    napi_value workloadObj = NapiHelper::CreateObject(env);
+    napi_value defaultWorkload = NapiHelper::CreateUint32(env, static_cast<uint32_t>(Workload::DEFAULT));
+    napi_value computeWorkload = NapiHelper::CreateUint32(env, static_cast<uint32_t>(Workload::COMPUTE));
+    napi_value backgroundWorkload = NapiHelper::CreateUint32(env, static_cast<uint32_t>(Workload::BACKGROUND));
+    napi_property_descriptor exportWorkload[] = {
+        DECLARE_NAPI_PROPERTY("DEFAULT", defaultWorkload),
+        DECLARE_NAPI_PROPERTY("COMPUTE", computeWorkload),
+        DECLARE_NAPI_PROPERTY("BACKGROUND", backgroundWorkload),
+    };
+    napi_define_properties(env, workloadObj, sizeof(exportWorkload) / sizeof(exportWorkload[0]), exportWorkload);
+
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_PROPERTY("Task", taskClass),
         DECLARE_NAPI_PROPERTY("LongTask", longTaskClass),
@@ -97,6 +113,7 @@ napi_value TaskPool::InitTaskPool(napi_env env, napi_value exports)
         DECLARE_NAPI_PROPERTY("AsyncRunner", asyncRunnerClass),
         DECLARE_NAPI_PROPERTY("Priority", priorityObj),
         DECLARE_NAPI_PROPERTY("State", stateObj),
+        DECLARE_NAPI_PROPERTY("Workload", workloadObj),
         DECLARE_NAPI_FUNCTION("execute", Execute),
         DECLARE_NAPI_FUNCTION("executeDelayed", ExecuteDelayed),
         DECLARE_NAPI_FUNCTION("cancel", Cancel),
@@ -105,6 +122,11 @@ napi_value TaskPool::InitTaskPool(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION("isConcurrent", IsConcurrent),
         DECLARE_NAPI_FUNCTION("executePeriodically", ExecutePeriodically),
         DECLARE_NAPI_FUNCTION("getTask", GetTask),
+        DECLARE_NAPI_FUNCTION("executeBatch", ExecuteBatch),
+        DECLARE_NAPI_FUNCTION("parallelFor", ParallelFor),
+        DECLARE_NAPI_FUNCTION("mapReduce", MapReduce),
+        DECLARE_NAPI_FUNCTION("setResultTransferMode", SetResultTransferMode),
+        DECLARE_NAPI_FUNCTION("prewarm", Prewarm),
     };
     napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties);
 
@@ -118,6 +140,8 @@ void TaskPool::ExecuteOnReceiveDataCallback(TaskResultInfo* resultInfo)
     CallbackInfo* callbackInfo = TaskManager::GetInstance().GetSenddataCallback(resultInfo->taskId);
     if (callbackInfo == nullptr) {
         HILOG_ERROR("taskpool:: ExecuteOnReceiveDataCallback callbackInfo is nullptr");
+        resultInfo->DeleteSerializationArgs(resultInfo->workerEnv);
+        delete resultInfo;
         return;
     }
     ObjectScope<TaskResultInfo> resultInfoScope(resultInfo, false);
@@ -132,31 +156,71 @@ void TaskPool::ExecuteOnReceiveDataCallback(TaskResultInfo* resultInfo)
         return;
     }
     auto func = NapiHelper::GetReferenceValue(env, callbackInfo->callbackRef);
-    napi_value args;
-    napi_value result;
-#if defined(ENABLE_CONCURRENCY_INTEROP)
-    bool isHybridVM = ANIHelper::IsHybridVM(env);
-    if (isHybridVM) {
-        status = napi_deserialize_hybrid(env, resultInfo->serializationArgs, &args);
-    } else {
-        status = napi_deserialize(env, resultInfo->serializationArgs, &args);
+    // the messages of a batch are delivered in the order they were sent, a message which fails to deserialize
+    // drops the rest of the batch
+    std::vector<void*>& messages = resultInfo->serializationArgs;
+    if (messages.empty()) {
+        // the flush of an open batch, a task which has been removed released its messages
+        Task* task = TaskManager::GetInstance().GetTask(resultInfo->taskId);
+        if (task != nullptr) {
+            messages = task->TakeSendData();
+        }
     }
+    std::vector<napi_value> batchArgs {};
+    bool isDeserialized = true;
+    for (size_t i = 0; i < messages.size(); i++) {
+        napi_value args = nullptr;
+#if defined(ENABLE_CONCURRENCY_INTEROP)
+        bool isHybridVM = ANIHelper::IsHybridVM(env);
+        if (isHybridVM) {
+            status = napi_deserialize_hybrid(env, messages[i], &args);
+        } else {
+            status = napi_deserialize(env, messages[i], &args);
+        }
 #else
-    status = napi_deserialize(env, resultInfo->serializationArgs, &args);
+        status = napi_deserialize(env, messages[i], &args);
 #endif
-    napi_delete_serialization_data(env, resultInfo->serializationArgs);
-    if (status != napi_ok || args == nullptr) {
+        napi_delete_serialization_data(env, messages[i]);
+        messages[i] = nullptr;
+        if (status != napi_ok || args == nullptr) {
+            for (size_t j = i + 1; j < messages.size(); j++) {
+                napi_delete_serialization_data(env, messages[j]);
+                messages[j] = nullptr;
+            }
+            isDeserialized = false;
+            break;
+        }
+        if (callbackInfo->isBatch) {
+            batchArgs.push_back(args);
+            continue;
+        }
+        uint32_t argsNum = NapiHelper::GetArrayLength(env, args);
+        std::vector<napi_value> argsArray(argsNum);
+        for (size_t k = 0; k < argsNum; k++) {
+            argsArray[k] = NapiHelper::GetElement(env, args, k);
+        }
+        CallReceiveDataCallback(env, func, argsNum, argsArray.data());
+    }
+    messages.clear();
+    if (!batchArgs.empty()) {
+        napi_value batch = nullptr;
+        napi_create_array_with_length(env, batchArgs.size(), &batch);
+        for (size_t i = 0; i < batchArgs.size(); i++) {
+            napi_set_element(env, batch, i, batchArgs[i]);
+        }
+        CallReceiveDataCallback(env, func, 1, &batch);
+    }
+    if (!isDeserialized) {
         std::string errMessage = "taskpool:: failed to serialize function";
         HILOG_ERROR("%{public}s in SendData", errMessage.c_str());
         ErrorHelper::ThrowError(env, ErrorHelper::ERR_WORKER_SERIALIZATION, errMessage.c_str());
-        return;
-    }
-    uint32_t argsNum = NapiHelper::GetArrayLength(env, args);
-    napi_value argsArray[argsNum];
-    for (size_t i = 0; i < argsNum; i++) {
-        argsArray[i] = NapiHelper::GetElement(env, args, i);
     }
-    napi_call_function(env, NapiHelper::GetGlobalObject(env), func, argsNum, argsArray, &result);
+}
+
+void TaskPool::CallReceiveDataCallback(napi_env env, napi_value func, size_t argc, const napi_value* argv)
+{
+    napi_value result = nullptr;
+    napi_call_function(env, NapiHelper::GetGlobalObject(env), func, argc, argv, &result);
     if (NapiHelper::IsExceptionPending(env)) {
         napi_value exception = nullptr;
         napi_get_and_clear_last_exception(env, &exception);
@@ -173,9 +237,80 @@ napi_value TaskPool::GetTaskPoolInfo(napi_env env, [[maybe_unused]] napi_callbac
     napi_value taskInfos = TaskManager::GetInstance().GetTaskInfos(env);
     napi_set_named_property(env, result, "threadInfos", threadInfos);
     napi_set_named_property(env, result, "taskInfos", taskInfos);
+    napi_value functionCacheInfo = FunctionCache::GetInstance().GetCacheInfo(env);
+    napi_set_named_property(env, result, "functionCacheInfo", functionCacheInfo);
+    napi_value deadlineInfo = TaskManager::GetInstance().GetDeadlineInfo(env);
+    napi_set_named_property(env, result, "deadlineInfo", deadlineInfo);
+    napi_value resultTransferInfo = TaskManager::GetInstance().GetResultTransferInfo(env);
+    napi_set_named_property(env, result, "resultTransferInfo", resultTransferInfo);
+    napi_value prewarmInfo = TaskManager::GetInstance().GetPrewarmInfo(env);
+    napi_set_named_property(env, result, "prewarmInfo", prewarmInfo);
+    napi_value asyncRunnerInfos = AsyncRunnerManager::GetInstance().GetAsyncRunnerInfos(env);
+    napi_set_named_property(env, result, "asyncRunnerInfos", asyncRunnerInfos);
     return result;
 }
 
+napi_value TaskPool::SetResultTransferMode(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, cbinfo, &argc, args, nullptr, nullptr);
+    if (argc != 1 || !NapiHelper::IsTypeForNapiValue(env, args[0], napi_boolean)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the param of setResultTransferMode must be boolean.");
+        return nullptr;
+    }
+    // the tasks with a result transfer list keep their own list
+    TaskManager::GetInstance().SetResultTransfer(NapiHelper::GetBooleanValue(env, args[0]));
+    return nullptr;
+}
+
+napi_value TaskPool::Prewarm(napi_env env, napi_callback_info cbinfo)
+{
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, cbinfo, &argc, args, nullptr, nullptr);
+    // prewarm() or prewarm({workers?: number, modules?: string[]})
+    uint32_t workerNum = 0;
+    std::vector<std::string> modules {};
+    if (argc == 0 || !NapiHelper::IsNotUndefined(env, args[0])) {
+        TaskManager::GetInstance().Prewarm(workerNum, modules);
+        return nullptr;
+    }
+    if (!NapiHelper::IsObject(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the param of prewarm must be object.");
+        return nullptr;
+    }
+    napi_value workers = NapiHelper::GetNameProperty(env, args[0], "workers");
+    if (NapiHelper::IsNotUndefined(env, workers)) {
+        if (!NapiHelper::IsNumber(env, workers) || NapiHelper::GetInt32Value(env, workers) < 0) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the workers of prewarm must be a non-negative number.");
+            return nullptr;
+        }
+        workerNum = NapiHelper::GetUint32Value(env, workers);
+    }
+    napi_value moduleArr = NapiHelper::GetNameProperty(env, args[0], "modules");
+    if (NapiHelper::IsNotUndefined(env, moduleArr)) {
+        if (!NapiHelper::IsArray(env, moduleArr)) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the modules of prewarm must be string array.");
+            return nullptr;
+        }
+        uint32_t moduleNum = NapiHelper::GetArrayLength(env, moduleArr);
+        for (uint32_t i = 0; i < moduleNum; i++) {
+            napi_value module = NapiHelper::GetElement(env, moduleArr, i);
+            if (!NapiHelper::IsString(env, module)) {
+                ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                    "the modules of prewarm must be string array.");
+                return nullptr;
+            }
+            modules.emplace_back(NapiHelper::GetString(env, module));
+        }
+    }
+    TaskManager::GetInstance().Prewarm(workerNum, modules);
+    return nullptr;
+}
+
 napi_value TaskPool::TerminateTask(napi_env env, napi_callback_info cbinfo)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
@@ -218,9 +353,10 @@ napi_value TaskPool::Execute(napi_env env, napi_callback_info cbinfo)
     if (type == napi_object) {
         uint32_t priority = Priority::DEFAULT; // DEFAULT priority is MEDIUM
         uint32_t timeout = 0;
+        uint32_t deadline = 0;
         if (argc > 1) {
             auto result = GetExecuteParams(env, args[1]);
-            if (result.first > Priority::MAX) {
+            if (result.first > Priority::MAX || !GetExecuteDeadline(env, args[1], deadline)) {
                 return nullptr;
             }
             priority = result.first;
@@ -244,6 +380,7 @@ napi_value TaskPool::Execute(napi_env env, napi_callback_info cbinfo)
             return nullptr;
         }
         task->SetTimeout(timeout);
+        task->SetDeadline(deadline);
         ExecuteTask(env, task, static_cast<Priority>(priority));
         return promise;
     }
@@ -274,9 +411,376 @@ napi_value TaskPool::Execute(napi_env env, napi_callback_info cbinfo)
     return promise;
 }
 
-void TaskPool::DelayTask(uv_timer_t* handle)
+napi_value TaskPool::ExecuteBatch(napi_env env, napi_callback_info cbinfo)
+{
+    // executeBatch(tasks, priority?) or executeBatch(func, argsLists, priority?), returns one promise per task
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
+    if (argc < 1) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the number of executeBatch's params must be at least one.");
+        return nullptr;
+    }
+    napi_value* args = new napi_value[argc];
+    ObjectScope<napi_value> scope(args, true);
+    napi_get_cb_info(env, cbinfo, &argc, args, nullptr, nullptr);
+    bool isFunction = NapiHelper::IsFunction(env, args[0]);
+    size_t paramIndex = isFunction ? 2 : 1; // 2: the params follow the argument lists
+    uint32_t priority = Priority::DEFAULT; // DEFAULT priority is MEDIUM
+    uint32_t timeout = 0;
+    uint32_t deadline = 0;
+    if (argc > paramIndex) {
+        auto result = GetExecuteParams(env, args[paramIndex]);
+        if (result.first > Priority::MAX || !GetExecuteDeadline(env, args[paramIndex], deadline)) {
+            return nullptr;
+        }
+        priority = result.first;
+        timeout = result.second;
+    }
+    if (isFunction) {
+        if (argc < 2 || !NapiHelper::IsArray(env, args[1])) { // 2: the argument lists are required
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the type of executeBatch's second param must be array.");
+            return nullptr;
+        }
+        return ExecuteFunctionBatch(env, args[0], args[1], static_cast<Priority>(priority));
+    }
+    if (!NapiHelper::IsArray(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the type of executeBatch's first param must be array or function.");
+        return nullptr;
+    }
+    return ExecuteTaskBatch(env, args[0], static_cast<Priority>(priority), timeout, deadline);
+}
+
+napi_value TaskPool::ExecuteTaskBatch(napi_env env, napi_value napiTasks, Priority priority, uint32_t timeout,
+                                      uint32_t deadline)
+{
+    uint32_t taskNum = NapiHelper::GetArrayLength(env, napiTasks);
+    napi_value promises = NapiHelper::CreateArrayWithLength(env, taskNum);
+    std::vector<Task*> tasks;
+    tasks.reserve(taskNum);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        napi_value napiTask = NapiHelper::GetElement(env, napiTasks, i);
+        Task* task = nullptr;
+        if (NapiHelper::IsObject(env, napiTask) && !NapiHelper::HasNameProperty(env, napiTask, GROUP_ID_STR)) {
+            napi_unwrap(env, napiTask, reinterpret_cast<void**>(&task));
+        }
+        napi_value promise = nullptr;
+        if (task == nullptr) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of executeBatch's tasks must be task.");
+        } else if (task->CanExecute(env, timeout)) {
+            promise = task->GetTaskInfoPromise(env, napiTask, TaskType::COMMON_TASK, priority);
+        }
+        if (promise == nullptr) {
+            napi_set_element(env, promises, i, CreateRejectedPromise(env));
+            continue;
+        }
+        task->SetTimeout(timeout);
+        task->SetDeadline(deadline);
+        tasks.push_back(task);
+        napi_set_element(env, promises, i, promise);
+    }
+    ExecuteTasks(env, tasks, priority);
+    return promises;
+}
+
+napi_value TaskPool::ExecuteFunctionBatch(napi_env env, napi_value func, napi_value argsLists, Priority priority)
+{
+    uint32_t taskNum = NapiHelper::GetArrayLength(env, argsLists);
+    napi_value promises = NapiHelper::CreateArrayWithLength(env, taskNum);
+    if (taskNum == 0) {
+        return promises;
+    }
+    // the function is serialized once and shared by all tasks of the batch
+    auto function = FunctionCache::GetInstance().GetSerialization(env, func);
+    if (function == nullptr) {
+        return nullptr;
+    }
+    napi_value napiFuncName = NapiHelper::GetNameProperty(env, func, NAME);
+    std::string name = NapiHelper::GetString(env, napiFuncName);
+    std::vector<Task*> tasks;
+    tasks.reserve(taskNum);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        napi_value argsList = NapiHelper::GetElement(env, argsLists, i);
+        Task* task = nullptr;
+        if (!NapiHelper::IsArray(env, argsList)) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the type of executeBatch's argument lists must be array.");
+        } else {
+            task = Task::GenerateBatchFunctionTask(env, name, function, argsList, priority);
+        }
+        if (task == nullptr) {
+            napi_set_element(env, promises, i, CreateRejectedPromise(env));
+            continue;
+        }
+        napi_value promise = NapiHelper::CreatePromise(env, &task->currentTaskInfo_->deferred);
+        if (promise == nullptr) { // LOCV_EXCL_BR_LINE
+            if (!task->IsMainThreadTask()) {
+                napi_remove_env_cleanup_hook(env, Task::CleanupHookFunc, task);
+            }
+            task->ReleaseData();
+            delete task;
+            napi_set_element(env, promises, i, CreateRejectedPromise(env));
+            continue;
+        }
+        tasks.push_back(task);
+        napi_set_element(env, promises, i, promise);
+    }
+    TaskManager::GetInstance().StoreTasks(tasks);
+    ExecuteTasks(env, tasks, priority);
+    return promises;
+}
+
+napi_value TaskPool::CreateRejectedPromise(napi_env env)
+{
+    // a failed element does not fail the whole batch, its pending exception rejects its own promise
+    napi_value error = nullptr;
+    napi_get_and_clear_last_exception(env, &error);
+    napi_deferred deferred = nullptr;
+    napi_value promise = NapiHelper::CreatePromise(env, &deferred);
+    if (deferred != nullptr) {
+        napi_reject_deferred(env, deferred, error);
+    }
+    return promise;
+}
+
+napi_value TaskPool::ParallelFor(napi_env env, napi_callback_info cbinfo)
 {
-    TaskMessage* taskMessage = static_cast<TaskMessage*>(handle->data);
+    // parallelFor(range, chunkSize, func, priority?), func(start, end) is called once for every chunk of the range
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    size_t argc = 4; // 4: range, chunkSize, func and priority
+    napi_value args[4]; // 4: range, chunkSize, func and priority
+    napi_get_cb_info(env, cbinfo, &argc, args, nullptr, nullptr);
+    if (argc < 3) { // 3: the priority is optional
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the number of parallelFor's params must be at least three.");
+        return nullptr;
+    }
+    int32_t start = 0;
+    int32_t end = 0;
+    if (NapiHelper::IsNumber(env, args[0])) {
+        end = NapiHelper::GetInt32Value(env, args[0]);
+    } else if (NapiHelper::IsObject(env, args[0])) {
+        napi_value startValue = NapiHelper::GetNameProperty(env, args[0], "start");
+        napi_value endValue = NapiHelper::GetNameProperty(env, args[0], "end");
+        if (!NapiHelper::IsNumber(env, startValue) || !NapiHelper::IsNumber(env, endValue)) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+                "the start and end of parallelFor's range must be number.");
+            return nullptr;
+        }
+        start = NapiHelper::GetInt32Value(env, startValue);
+        end = NapiHelper::GetInt32Value(env, endValue);
+    } else {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the type of parallelFor's range must be number or object.");
+        return nullptr;
+    }
+    if (start < 0 || start > end) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the range of parallelFor is invalid.");
+        return nullptr;
+    }
+    if (!NapiHelper::IsFunction(env, args[2])) { // 2: the index of func
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the type of parallelFor's third param must be function.");
+        return nullptr;
+    }
+    uint32_t chunkSize = 0;
+    uint32_t priority = Priority::DEFAULT; // DEFAULT priority is MEDIUM
+    if (!GetParallelParams(env, args, argc, 1, chunkSize, priority)) {
+        return nullptr;
+    }
+    uint32_t length = static_cast<uint32_t>(end - start);
+    chunkSize = ParallelGroup::GetChunkSize(length, chunkSize, ConcurrentHelper::GetMaxThreads());
+    uint32_t chunkNum = ParallelGroup::GetChunkNum(length, chunkSize);
+    ParallelGroup* group = new ParallelGroup(env, chunkNum, static_cast<Priority>(priority));
+    return ExecuteParallelGroup(env, group, args[2], nullptr, // 2: the index of func
+                                std::make_pair(static_cast<uint32_t>(start), length), chunkSize);
+}
+
+napi_value TaskPool::MapReduce(napi_env env, napi_callback_info cbinfo)
+{
+    // mapReduce(array, mapFn, reduceFn, chunkSize?, priority?), mapFn(chunk, start) is called once for every
+    // chunk of the array, and the results of the chunks are reduced in order by reduceFn(left, right)
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    size_t argc = 5; // 5: array, mapFn, reduceFn, chunkSize and priority
+    napi_value args[5]; // 5: array, mapFn, reduceFn, chunkSize and priority
+    napi_get_cb_info(env, cbinfo, &argc, args, nullptr, nullptr);
+    if (argc < 3) { // 3: the chunkSize and priority are optional
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the number of mapReduce's params must be at least three.");
+        return nullptr;
+    }
+    if (!NapiHelper::IsArray(env, args[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of mapReduce's first param must be array.");
+        return nullptr;
+    }
+    if (!NapiHelper::IsFunction(env, args[1]) || !NapiHelper::IsFunction(env, args[2])) { // 2: the index of reduceFn
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR,
+            "the type of mapReduce's mapFn and reduceFn must be function.");
+        return nullptr;
+    }
+    uint32_t chunkSize = 0;
+    uint32_t priority = Priority::DEFAULT; // DEFAULT priority is MEDIUM
+    if (argc > 3 && !GetParallelParams(env, args, argc, 3, chunkSize, priority)) { // 3: the index of chunkSize
+        return nullptr;
+    }
+    uint32_t length = NapiHelper::GetArrayLength(env, args[0]);
+    chunkSize = ParallelGroup::GetChunkSize(length, chunkSize, ConcurrentHelper::GetMaxThreads());
+    uint32_t chunkNum = ParallelGroup::GetChunkNum(length, chunkSize);
+    // the reduceFn is serialized once and shared by all reductions
+    auto reduceFunction = FunctionCache::GetInstance().GetSerialization(env, args[2]); // 2: the index of reduceFn
+    if (reduceFunction == nullptr) {
+        return nullptr;
+    }
+    napi_value napiReduceName = NapiHelper::GetNameProperty(env, args[2], NAME); // 2: the index of reduceFn
+    ParallelGroup* group = new ParallelGroup(env, chunkNum, static_cast<Priority>(priority));
+    group->SetReduceFunction(NapiHelper::GetString(env, napiReduceName), reduceFunction);
+    return ExecuteParallelGroup(env, group, args[1], args[0], std::make_pair(0, length), chunkSize);
+}
+
+bool TaskPool::GetParallelParams(napi_env env, napi_value* args, size_t argc, size_t index, uint32_t& chunkSize,
+                                 uint32_t& priority)
+{
+    // args[index] is the chunkSize and args[index + 1] is the priority, 0 or undefined chunkSize means automatic
+    if (argc > index && NapiHelper::IsNotUndefined(env, args[index])) {
+        if (!NapiHelper::IsNumber(env, args[index]) || NapiHelper::GetInt32Value(env, args[index]) < 0) {
+            ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the chunkSize must be a non-negative number.");
+            return false;
+        }
+        chunkSize = NapiHelper::GetUint32Value(env, args[index]);
+    }
+    if (argc > index + 1) {
+        auto result = GetExecuteParams(env, args[index + 1]);
+        if (result.first > Priority::MAX) {
+            return false;
+        }
+        priority = result.first;
+    }
+    return true;
+}
+
+napi_value TaskPool::ExecuteParallelGroup(napi_env env, ParallelGroup* group, napi_value func, napi_value array,
+                                          std::pair<uint32_t, uint32_t> range, uint32_t chunkSize)
+{
+    // the function is serialized once and shared by all chunks
+    auto function = FunctionCache::GetInstance().GetSerialization(env, func);
+    napi_value promise = nullptr;
+    if (function != nullptr) {
+        promise = NapiHelper::CreatePromise(env, &group->deferred_);
+    }
+    if (promise == nullptr) { // LOCV_EXCL_BR_LINE
+        group->ReleaseData(env);
+        delete group;
+        return nullptr;
+    }
+    std::string strTrace = "Parallel Allocation: chunkNum : " + std::to_string(group->chunkNum_)
+        + ", chunkSize : " + std::to_string(chunkSize) + ", priority : " + std::to_string(group->priority_);
+    HITRACE_HELPER_METER_NAME(strTrace);
+    HILOG_DEBUG("taskpool:: %{public}s", strTrace.c_str());
+    if (!group->IsMapReduce()) {
+        napi_value resArr = NapiHelper::CreateArrayWithLength(env, group->chunkNum_);
+        group->resArr_ = NapiHelper::CreateReference(env, resArr, 1);
+        if (group->chunkNum_ == 0) {
+            group->Resolve(env, resArr);
+        }
+    } else if (group->chunkNum_ == 0) {
+        group->Resolve(env, NapiHelper::GetUndefinedValue(env));
+    }
+    napi_value napiFuncName = NapiHelper::GetNameProperty(env, func, NAME);
+    std::string name = NapiHelper::GetString(env, napiFuncName);
+    auto [start, length] = range;
+    std::vector<Task*> tasks;
+    tasks.reserve(group->chunkNum_);
+    for (uint32_t i = 0; i < group->chunkNum_; i++) {
+        uint32_t chunkStart = start + i * chunkSize;
+        uint32_t chunkLength = std::min(chunkSize, length - i * chunkSize);
+        napi_value argsList = NapiHelper::CreateArrayWithLength(env, 2); // 2: a chunk has two arguments
+        if (array == nullptr) {
+            napi_set_element(env, argsList, 0, NapiHelper::CreateUint32(env, chunkStart));
+            napi_set_element(env, argsList, 1, NapiHelper::CreateUint32(env, chunkStart + chunkLength));
+        } else {
+            napi_value chunk = NapiHelper::CreateArrayWithLength(env, chunkLength);
+            for (uint32_t j = 0; j < chunkLength; j++) {
+                napi_set_element(env, chunk, j, NapiHelper::GetElement(env, array, chunkStart + j));
+            }
+            napi_set_element(env, argsList, 0, chunk);
+            napi_set_element(env, argsList, 1, NapiHelper::CreateUint32(env, chunkStart));
+        }
+        Task* task = Task::GenerateBatchFunctionTask(env, name, function, argsList, group->priority_);
+        if (task == nullptr) {
+            // the chunks created so far still run, their results are dropped
+            napi_value error = nullptr;
+            napi_get_and_clear_last_exception(env, &error);
+            group->Reject(env, error);
+            break;
+        }
+        TaskManager::GetInstance().StoreTask(task);
+        task->parallelId_ = group->groupId_;
+        group->StoreTaskSlot(task->taskId_, std::make_pair(0, i));
+        tasks.push_back(task);
+    }
+    if (group->IsFinished()) {
+        group->ReleaseData(env);
+        delete group;
+        return promise;
+    }
+    TaskGroupManager::GetInstance().StoreParallelGroup(group);
+    napi_add_env_cleanup_hook(env, ParallelGroup::HostEnvCleanupHook, group);
+    ExecuteTasks(env, tasks, group->priority_);
+    return promise;
+}
+
+void TaskPool::UpdateParallelInfoByResult(napi_env env, Task* task, napi_value res, bool success)
+{
+    HILOG_DEBUG("taskpool:: task:%{public}s UpdateParallelInfoByResult", std::to_string(task->taskId_).c_str());
+    ParallelGroup* group = TaskGroupManager::GetInstance().GetParallelGroup(task->parallelId_);
+    if (group == nullptr) {
+        HILOG_DEBUG("taskpool:: parallelGroup may have been released");
+        return;
+    }
+    ParallelGroup::Slot slot = group->TakeTaskSlot(task->taskId_);
+    if (!success) {
+        group->Reject(env, res);
+    } else if (!group->IsSettled()) {
+        auto [left, right] = group->UpdateSlot(env, slot, res);
+        if (left != nullptr) {
+            ExecuteReduceTask(env, group, slot, left, right);
+        }
+    }
+    if (!group->IsFinished()) {
+        return;
+    }
+    HILOG_DEBUG("taskpool:: parallelGroup %{public}s perform end", std::to_string(group->groupId_).c_str());
+    TaskGroupManager::GetInstance().RemoveParallelGroup(group->groupId_);
+    napi_remove_env_cleanup_hook(env, ParallelGroup::HostEnvCleanupHook, group);
+    group->ReleaseData(env);
+    delete group;
+}
+
+void TaskPool::ExecuteReduceTask(napi_env env, ParallelGroup* group, ParallelGroup::Slot slot, napi_value left,
+                                 napi_value right)
+{
+    napi_value argsList = NapiHelper::CreateArrayWithLength(env, 2); // 2: reduceFn(left, right)
+    napi_set_element(env, argsList, 0, left);
+    napi_set_element(env, argsList, 1, right);
+    Task* task = Task::GenerateBatchFunctionTask(env, group->reduceName_, group->reduceFunction_, argsList,
+                                                 group->priority_);
+    if (task == nullptr) {
+        napi_value error = nullptr;
+        napi_get_and_clear_last_exception(env, &error);
+        group->Reject(env, error);
+        return;
+    }
+    TaskManager::GetInstance().StoreTask(task);
+    task->parallelId_ = group->groupId_;
+    group->StoreTaskSlot(task->taskId_, slot);
+    ExecuteTask(env, task, group->priority_);
+}
+
+void TaskPool::DelayTask(void* data)
+{
+    TaskMessage* taskMessage = static_cast<TaskMessage*>(data);
     auto task = TaskManager::GetInstance().GetTask(taskMessage->taskId);
     napi_status status = napi_ok;
     if (task == nullptr) {
@@ -318,10 +822,8 @@ void TaskPool::DelayTask(uv_timer_t* handle)
     }
     if (task != nullptr) {
         std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
-        task->delayedTimers_.erase(handle);
+        task->delayedTimers_.erase(taskMessage->timerId);
     }
-    uv_timer_stop(handle);
-    ConcurrentHelper::UvHandleClose(handle);
     delete taskMessage;
     taskMessage = nullptr;
 }
@@ -338,6 +840,7 @@ napi_value TaskPool::ExecuteDelayed(napi_env env, napi_callback_info cbinfo)
 
     task->UpdateTaskStateToDelayed();
     task->UpdateTaskType(TaskType::COMMON_TASK);
+    task->SetDeadline(0);
 
     TaskMessage* taskMessage = new TaskMessage();
     taskMessage->priority = static_cast<Priority>(priority);
@@ -351,12 +854,6 @@ napi_value TaskPool::ExecuteDelayed(napi_env env, napi_callback_info cbinfo)
         HILOG_ERROR("taskpool:: %{public}s", err.c_str());
         return nullptr;
     }
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    uv_timer_t* timer = new uv_timer_t;
-    uv_timer_init(loop, timer);
-    timer->data = taskMessage;
-
     std::string strTrace = "ExecuteDelayed: taskId: " + std::to_string(task->taskId_);
     strTrace += ", priority: " + std::to_string(priority);
     strTrace += ", delayTime " + std::to_string(delayTime);
@@ -365,14 +862,22 @@ napi_value TaskPool::ExecuteDelayed(napi_env env, napi_callback_info cbinfo)
     strTrace += ", " + ConcurrentHelper::GetCurrentTimeStampWithMS();
     TaskManager::GetInstance().PushLog(strTrace);
 
-    uv_timer_start(timer, reinterpret_cast<uv_timer_cb>(DelayTask), delayTime, 0);
+    taskMessage->timerId = TimerWheel::AddTimer(env, static_cast<uint64_t>(delayTime), 0, DelayTask, taskMessage);
+    if (taskMessage->timerId == 0) {
+        std::string err = "executeDelayed start timer failed.";
+        HILOG_ERROR("taskpool:: %{public}s", err.c_str());
+        napi_value error = ErrorHelper::NewError(env, ErrorHelper::TYPE_ERROR, err.c_str());
+        napi_reject_deferred(env, taskMessage->deferred, error);
+        delete taskMessage;
+        return promise;
+    }
     {
         std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
-        task->delayedTimers_.insert(timer);
+        task->delayedTimers_.emplace(taskMessage->timerId, taskMessage);
     }
     NativeEngine* engine = reinterpret_cast<NativeEngine*>(env);
     if (engine->IsMainThread()) {
-        uv_async_send(&loop->wq_async);
+        uv_async_send(&NapiHelper::GetLibUV(env)->wq_async);
     }
     return promise;
 }
@@ -458,6 +963,9 @@ void TaskPool::HandleTaskResult(Task* task)
     HILOG_DEBUG("taskpool:: HandleTaskResult task");
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
     TaskManager::GetInstance().RemoveRunningTask(task->taskId_); // update task execution info
+    if (task->IsCommonTask() && task->HasDeadline()) {
+        TaskManager::GetInstance().RecordDeadlineResult(task->GetDeadline());
+    }
     if (!task->IsMainThreadTask()) {
         if (task->ShouldDeleteTask(false)) {
             delete task;
@@ -507,6 +1015,8 @@ void TaskPool::HandleTaskResultInner(Task* task)
         task->isCancelToFinish_ = false;
         if (task->IsGroupTask()) {
             UpdateGroupInfoByResult(task->env_, task, napiTaskResult, success);
+        } else if (task->IsParallelTask()) {
+            UpdateParallelInfoByResult(task->env_, task, napiTaskResult, success);
         } else if (!task->IsPeriodicTask() && !task->IsTimeoutState()) {
             if (success) {
                 napi_resolve_deferred(task->env_, task->currentTaskInfo_->deferred, napiTaskResult);
@@ -661,6 +1171,72 @@ void TaskPool::ExecuteTask(napi_env env, Task* task, Priority priority)
     }
 }
 
+void TaskPool::ExecuteTasks(napi_env env, const std::vector<Task*>& tasks, Priority priority)
+{
+    std::string strTrace = "Task Batch Allocation: taskNum : " + std::to_string(tasks.size())
+        + ", priority : " + std::to_string(priority);
+    HITRACE_HELPER_METER_NAME(strTrace);
+    std::vector<Task*> waitingTasks;
+    waitingTasks.reserve(tasks.size());
+    for (Task* task : tasks) {
+        task->IncreaseRefCount();
+        TaskManager::GetInstance().IncreaseSendDataRefCount(task->taskId_);
+        if (!task->UpdateTaskStateToWaiting()) {
+            HILOG_WARN("taskpool:: Task Allocation: %{public}s, not enqueue", std::to_string(task->taskId_).c_str());
+            continue;
+        }
+        task->StoreEnqueueTime();
+        task->isCancelToFinish_ = false;
+        waitingTasks.push_back(task);
+    }
+    if (waitingTasks.empty()) {
+        return;
+    }
+    TaskManager::GetInstance().PushLog("Task Batch Allocation: " + std::to_string(waitingTasks.front()->taskId_) +
+        ", " + std::to_string(waitingTasks.size()) + ", " + std::to_string(priority));
+    TaskManager::GetInstance().EnqueueTaskIds(waitingTasks, priority);
+    for (Task* task : waitingTasks) {
+        TriggerTaskTimeoutTimer(env, task);
+    }
+}
+
+void TaskPool::RejectExpiredTask(Task* task)
+{
+    // the deadline passed while the task was waiting, it finishes without running like a canceled task
+    napi_status status = napi_ok;
+    HandleScope scope(task->env_, status);
+    if (status != napi_ok) {
+        HILOG_ERROR("taskpool:: napi_open_handle_scope failed");
+        return;
+    }
+    task->ClearTimeoutTimer();
+    napi_deferred deferred = nullptr;
+    {
+        std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
+        // a canceled task is dropped too, the cancel has not found it in the queues
+        if (task->currentTaskInfo_ == nullptr ||
+            (!task->IsWaitingState() && !task->IsCanceledState())) {
+            return;
+        }
+        deferred = task->currentTaskInfo_->deferred;
+        reinterpret_cast<NativeEngine*>(task->env_)->DecreaseSubEnvCounter();
+        task->DecreaseTaskLifecycleCount();
+        napi_reference_unref(task->env_, task->taskRef_, nullptr);
+        task->taskState_ = ExecuteState::ENDING;
+        task->isCancelToFinish_ = true;
+    }
+    HILOG_INFO("taskpool:: task:%{public}s is rejected as its deadline has passed",
+               std::to_string(task->taskId_).c_str());
+    napi_value error = ErrorHelper::NewError(task->env_, ErrorHelper::ERR_TASK_DEADLINE_EXCEEDED);
+    napi_reject_deferred(task->env_, deferred, error);
+    if (task->HasDependency()) {
+        TaskManager::GetInstance().ClearDependentTask(task->taskId_);
+    }
+    TaskManager::GetInstance().DecreaseSendDataRefCount(task->env_, task->taskId_);
+    task->UpdateTaskStateToFinished();
+    task->NotifyPendingTask();
+}
+
 napi_value TaskPool::Cancel(napi_env env, napi_callback_info cbinfo)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
@@ -723,9 +1299,9 @@ napi_value TaskPool::IsConcurrent(napi_env env, napi_callback_info cbinfo)
     return NapiHelper::CreateBooleanValue(env, isConcurrent);
 }
 
-void TaskPool::PeriodicTaskCallback(uv_timer_t* handle)
+void TaskPool::PeriodicTaskCallback(void* data)
 {
-    Task* task = reinterpret_cast<Task*>(handle->data);
+    Task* task = reinterpret_cast<Task*>(data);
     if (task == nullptr) {
         HILOG_DEBUG("taskpool:: the task is nullptr");
         return;
@@ -737,8 +1313,8 @@ void TaskPool::PeriodicTaskCallback(uv_timer_t* handle)
             HILOG_DEBUG("taskpool:: the periodic task has been canceled");
             napi_reference_unref(task->env_, task->taskRef_, nullptr);
             task->CancelPendingTask(task->env_);
-            uv_timer_stop(task->timer_);
-            ConcurrentHelper::UvHandleClose(task->timer_);
+            TimerWheel::CancelTimer(task->env_, task->timerId_);
+            task->timerId_ = 0;
         }
         return;
     }
@@ -781,6 +1357,7 @@ napi_value TaskPool::ExecutePeriodically(napi_env env, napi_callback_info cbinfo
         return nullptr;
     }
     periodicTask->UpdatePeriodicTask();
+    periodicTask->SetDeadline(0);
 
     periodicTask->periodicTaskPriority_ = static_cast<Priority>(priority);
     napi_value napiTask = NapiHelper::GetReferenceValue(env, periodicTask->taskRef_);
@@ -803,15 +1380,11 @@ napi_value TaskPool::ExecutePeriodically(napi_env env, napi_callback_info cbinfo
 void TaskPool::TriggerTimer(napi_env env, Task* task, int32_t period)
 {
     HILOG_DEBUG("taskpool::TriggerTimer tId %{public}s", std::to_string(task->taskId_).c_str());
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    task->timer_ = new uv_timer_t;
-    uv_timer_init(loop, task->timer_);
-    task->timer_->data = task;
-    uv_update_time(loop);
-    uv_timer_start(task->timer_, PeriodicTaskCallback, period, period);
+    task->timerId_ = TimerWheel::AddTimer(env, static_cast<uint64_t>(period), static_cast<uint64_t>(period),
+        PeriodicTaskCallback, task);
     NativeEngine* engine = reinterpret_cast<NativeEngine*>(env);
     if (engine->IsMainThread()) {
-        uv_async_send(&loop->wq_async);
+        uv_async_send(&NapiHelper::GetLibUV(env)->wq_async);
     }
 }
 
@@ -995,27 +1568,26 @@ napi_value TaskPool::GetTask(napi_env env, napi_callback_info cbinfo)
 
 void TaskPool::TriggerTaskTimeoutTimer(napi_env env, Task* task)
 {
-    if (!task->IsTimeoutTask() || task->timer_ != nullptr) {
+    if (!task->IsTimeoutTask() || task->timerId_ != 0) {
         return;
     }
     TaskTimeoutMessage* message = new TaskTimeoutMessage();
     message->taskId = task->taskId_;
     message->env = env;
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    task->timer_ = new uv_timer_t;
-    uv_timer_init(loop, task->timer_);
-    task->timer_->data = message;
-    uv_timer_start(task->timer_, reinterpret_cast<uv_timer_cb>(TaskTimeoutCallback), task->timeout_, 0);
+    task->timerId_ = TimerWheel::AddTimer(env, task->timeout_, 0, TaskTimeoutCallback, message);
+    if (task->timerId_ == 0) {
+        delete message;
+        return;
+    }
     NativeEngine* engine = reinterpret_cast<NativeEngine*>(env);
     if (engine->IsMainThread()) {
-        uv_async_send(&loop->wq_async);
+        uv_async_send(&NapiHelper::GetLibUV(env)->wq_async);
     }
 }
 
-void TaskPool::TaskTimeoutCallback(uv_timer_t* handle)
+void TaskPool::TaskTimeoutCallback(void* data)
 {
-    TaskTimeoutMessage* message = reinterpret_cast<TaskTimeoutMessage*>(handle->data);
+    TaskTimeoutMessage* message = reinterpret_cast<TaskTimeoutMessage*>(data);
     auto task = TaskManager::GetInstance().GetTask(message->taskId);
     if (task == nullptr || !task->IsValid() || message->env != task->GetEnv()) {
         HILOG_ERROR("taskpool:: the task is nullptr or invalid");
@@ -1098,29 +1670,48 @@ std::pair<uint32_t, uint32_t> TaskPool::GetExecuteParams(napi_env env, napi_valu
     return std::make_pair(priority, static_cast<uint32_t>(timeout));
 }
 
+bool TaskPool::GetExecuteDeadline(napi_env env, napi_value arg, uint32_t& deadline)
+{
+    // the deadline is relative to now in milliseconds, 0 means no deadline
+    deadline = 0;
+    if (!NapiHelper::IsObject(env, arg)) {
+        return true;
+    }
+    napi_value deadlineValue = NapiHelper::GetNameProperty(env, arg, "deadline");
+    if (!NapiHelper::IsNotUndefined(env, deadlineValue)) {
+        return true;
+    }
+    if (!NapiHelper::IsNumber(env, deadlineValue)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of execute's deadline must be number.");
+        return false;
+    }
+    int32_t value = NapiHelper::GetInt32Value(env, deadlineValue);
+    deadline = value < 0 ? 0 : static_cast<uint32_t>(value);
+    return true;
+}
+
 void TaskPool::TriggerTaskGroupTimeoutTimer(napi_env env, TaskGroup* taskGroup)
 {
-    if (!taskGroup->IsTimeoutTaskGroup() || taskGroup->timer_ != nullptr) {
+    if (!taskGroup->IsTimeoutTaskGroup() || taskGroup->timerId_ != 0) {
         return;
     }
     TaskTimeoutMessage* message = new TaskTimeoutMessage();
     message->groupId = taskGroup->groupId_;
     message->env = env;
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    taskGroup->timer_ = new uv_timer_t;
-    uv_timer_init(loop, taskGroup->timer_);
-    taskGroup->timer_->data = message;
-    uv_timer_start(taskGroup->timer_, reinterpret_cast<uv_timer_cb>(TaskGroupTimeoutCallback), taskGroup->timeout_, 0);
+    taskGroup->timerId_ = TimerWheel::AddTimer(env, taskGroup->timeout_, 0, TaskGroupTimeoutCallback, message);
+    if (taskGroup->timerId_ == 0) {
+        delete message;
+        return;
+    }
     NativeEngine* engine = reinterpret_cast<NativeEngine*>(env);
     if (engine->IsMainThread()) {
-        uv_async_send(&loop->wq_async);
+        uv_async_send(&NapiHelper::GetLibUV(env)->wq_async);
     }
 }
 
-void TaskPool::TaskGroupTimeoutCallback(uv_timer_t* handle)
+void TaskPool::TaskGroupTimeoutCallback(void* data)
 {
-    TaskTimeoutMessage* message = reinterpret_cast<TaskTimeoutMessage*>(handle->data);
+    TaskTimeoutMessage* message = reinterpret_cast<TaskTimeoutMessage*>(data);
     TaskGroup* taskGroup = TaskGroupManager::GetInstance().GetTaskGroup(message->groupId);
     if (taskGroup == nullptr) {
         delete message;
@@ -19,6 +19,7 @@
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 #include "native_engine/native_engine.h"
+#include "parallel_group.h"
 #include "task.h"
 #include "task_group.h"
 
@@ -29,6 +30,7 @@ struct TaskMessage {
     napi_deferred deferred = nullptr;
     Priority priority {Priority::DEFAULT};
     uint32_t taskId {};
+    uint64_t timerId {};
 };
 
 struct TaskTimeoutMessage {
@@ -51,34 +53,55 @@ private:
     TaskPool& operator=(TaskPool &&) = delete;
 
     static napi_value Execute(napi_env env, napi_callback_info cbinfo);
+    static napi_value ExecuteBatch(napi_env env, napi_callback_info cbinfo);
+    static napi_value ParallelFor(napi_env env, napi_callback_info cbinfo);
+    static napi_value MapReduce(napi_env env, napi_callback_info cbinfo);
     static napi_value ExecuteDelayed(napi_env env, napi_callback_info cbinfo);
-    static void DelayTask(uv_timer_t* handle);
+    static void DelayTask(void* data);
     static napi_value Cancel(napi_env env, napi_callback_info cbinfo);
     static napi_value GetTaskPoolInfo(napi_env env, [[maybe_unused]] napi_callback_info cbinfo);
+    static napi_value SetResultTransferMode(napi_env env, napi_callback_info cbinfo);
+    static napi_value Prewarm(napi_env env, napi_callback_info cbinfo);
     static napi_value TerminateTask(napi_env env, napi_callback_info cbinfo);
     static napi_value IsConcurrent(napi_env env, napi_callback_info cbinfo);
     static napi_value ExecutePeriodically(napi_env env, napi_callback_info cbinfo);
-    static void PeriodicTaskCallback(uv_timer_t* handle);
+    static void PeriodicTaskCallback(void* data);
 
     static void HandleTaskResultInner(Task* task);
     static void UpdateGroupInfoByResult(napi_env env, Task* task, napi_value res, bool success);
     static void ExecuteTask(napi_env env, Task* task, Priority priority = Priority::DEFAULT);
+    static void ExecuteTasks(napi_env env, const std::vector<Task*>& tasks, Priority priority);
+    static napi_value ExecuteTaskBatch(napi_env env, napi_value napiTasks, Priority priority, uint32_t timeout,
+                                       uint32_t deadline = 0);
+    static napi_value ExecuteFunctionBatch(napi_env env, napi_value func, napi_value argsLists, Priority priority);
+    static napi_value CreateRejectedPromise(napi_env env);
     static napi_value ExecuteGroup(napi_env env, napi_value taskGroup, Priority priority, uint32_t timeout = 0);
+    static napi_value ExecuteParallelGroup(napi_env env, ParallelGroup* group, napi_value func, napi_value array,
+                                           std::pair<uint32_t, uint32_t> range, uint32_t chunkSize);
+    static void UpdateParallelInfoByResult(napi_env env, Task* task, napi_value res, bool success);
+    static void ExecuteReduceTask(napi_env env, ParallelGroup* group, ParallelGroup::Slot slot, napi_value left,
+                                  napi_value right);
+    static bool GetParallelParams(napi_env env, napi_value* args, size_t argc, size_t index, uint32_t& chunkSize,
+                                  uint32_t& priority);
 
     static void TriggerTask(Task* task, bool isCancel);
+    static void RejectExpiredTask(Task* task);
     static void TriggerTimer(napi_env env, Task* task, int32_t period);
     static bool CheckDelayedParams(napi_env env, napi_callback_info cbinfo, uint32_t& priority, int32_t& delayTime,
                                    Task*& task);
     static bool CheckPeriodicallyParams(napi_env env, napi_callback_info cbinfo, int32_t& period, uint32_t& priority,
                                         Task*& task);
     static void ExecuteOnReceiveDataCallback(TaskResultInfo* resultInfo);
+    static void CallReceiveDataCallback(napi_env env, napi_value func, size_t argc, const napi_value* argv);
     static void RecordTaskResultLog(Task* task, napi_status status, napi_value& napiTaskResult, bool& isCancel);
     static napi_value GetTask(napi_env env, napi_callback_info cbinfo);
     static void TriggerTaskTimeoutTimer(napi_env env, Task* task);
-    static void TaskTimeoutCallback(uv_timer_t* handle);
+    static void TaskTimeoutCallback(void* data);
     static std::pair<uint32_t, uint32_t> GetExecuteParams(napi_env env, napi_value arg);
+    // only execute takes a deadline, a delayed or periodic execution is queued by its timer without one
+    static bool GetExecuteDeadline(napi_env env, napi_value arg, uint32_t& deadline);
     static void TriggerTaskGroupTimeoutTimer(napi_env env, TaskGroup* taskGroup);
-    static void TaskGroupTimeoutCallback(uv_timer_t* handle);
+    static void TaskGroupTimeoutCallback(void* data);
 
     friend class TaskManager;
     friend class NativeEngineTest;
@@ -16,8 +16,10 @@
 #include "test.h"
 
 #include "async_runner.h"
+#include "function_cache.h"
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
+#include "parallel_group.h"
 #include "sequence_runner.h"
 #include "sequence_runner_manager.h"
 #include "task.h"
@@ -25,6 +27,7 @@
 #include "task_group_manager.h"
 #include "task_manager.h"
 #include "taskpool.h"
+#include "timer_wheel.h"
 #include "utils.h"
 #include "uv.h"
 #include "worker.h"
@@ -105,6 +108,26 @@ napi_value NativeEngineTest::GetTaskPoolInfo(napi_env env, napi_value argv[], si
     return result;
 }
 
+napi_value NativeEngineTest::SetResultTransferMode(napi_env env, napi_value argv[], size_t argc)
+{
+    std::string funcName = "SetResultTransferMode";
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    napi_create_function(env, funcName.c_str(), funcName.size(), TaskPool::SetResultTransferMode, nullptr, &cb);
+    napi_call_function(env, nullptr, cb, argc, argv, &result);
+    return result;
+}
+
+napi_value NativeEngineTest::Prewarm(napi_env env, napi_value argv[], size_t argc)
+{
+    std::string funcName = "Prewarm";
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    napi_create_function(env, funcName.c_str(), funcName.size(), TaskPool::Prewarm, nullptr, &cb);
+    napi_call_function(env, nullptr, cb, argc, argv, &result);
+    return result;
+}
+
 napi_value NativeEngineTest::TerminateTask(napi_env env, napi_value argv[], size_t argc)
 {
     std::string funcName = "TerminateTask";
@@ -125,6 +148,36 @@ napi_value NativeEngineTest::Execute(napi_env env, napi_value argv[], size_t arg
     return result;
 }
 
+napi_value NativeEngineTest::ExecuteBatch(napi_env env, napi_value argv[], size_t argc)
+{
+    std::string funcName = "ExecuteBatch";
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    napi_create_function(env, funcName.c_str(), funcName.size(), TaskPool::ExecuteBatch, nullptr, &cb);
+    napi_call_function(env, nullptr, cb, argc, argv, &result);
+    return result;
+}
+
+napi_value NativeEngineTest::ParallelFor(napi_env env, napi_value argv[], size_t argc)
+{
+    std::string funcName = "ParallelFor";
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    napi_create_function(env, funcName.c_str(), funcName.size(), TaskPool::ParallelFor, nullptr, &cb);
+    napi_call_function(env, nullptr, cb, argc, argv, &result);
+    return result;
+}
+
+napi_value NativeEngineTest::MapReduce(napi_env env, napi_value argv[], size_t argc)
+{
+    std::string funcName = "MapReduce";
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    napi_create_function(env, funcName.c_str(), funcName.size(), TaskPool::MapReduce, nullptr, &cb);
+    napi_call_function(env, nullptr, cb, argc, argv, &result);
+    return result;
+}
+
 napi_value NativeEngineTest::ExecuteDelayed(napi_env env, napi_value argv[], size_t argc)
 {
     std::string funcName = "ExecuteDelayed";
@@ -174,12 +227,13 @@ napi_value NativeEngineTest::ExecuteGroup(napi_env env, napi_value taskGroup, ui
 
 void NativeEngineTest::DelayTask(uv_timer_t* handle)
 {
-    TaskPool::DelayTask(handle);
+    TaskPool::DelayTask(handle->data);
+    ConcurrentHelper::UvHandleClose(handle);
 }
 
 void NativeEngineTest::PeriodicTaskCallback(uv_timer_t* handle)
 {
-    TaskPool::PeriodicTaskCallback(handle);
+    TaskPool::PeriodicTaskCallback(handle->data);
 }
 
 void NativeEngineTest::UpdateGroupInfoByResult(napi_env env, uv_timer_t* handle, napi_value res, bool success)
@@ -383,7 +437,7 @@ void NativeEngineTest::CancelTask(napi_env env)
     task->taskState_ = ExecuteState::WAITING;
     task->currentTaskInfo_ = taskInfo;
     taskManager.CancelTask(env, task->taskId_);
-    taskManager.tasks_.clear();
+    taskManager.RemoveTask(task->taskId_);
     delete task;
 }
 
@@ -436,11 +490,11 @@ void NativeEngineTest::GetTaskByPriority(napi_env env)
     auto& mediumTaskQueue = taskManager.taskQueues_[Priority::DEFAULT];
     mediumTaskQueue->EnqueueTaskId(task->taskId_);
     taskManager.IncreaseTaskNum(Priority::DEFAULT);
-    std::set<uint32_t> set{task->taskId_};
-    taskManager.dependTaskInfos_.emplace(task->taskId_, std::move(set));
+    std::set<uint32_t> set{task->taskId_ + MAX_TIMEOUT_TIME};
+    taskManager.StoreTaskDependency(task->taskId_, set);
     taskManager.GetTaskByPriority(mediumTaskQueue, Priority::DEFAULT);
-    taskManager.dependTaskInfos_.clear();
-    taskManager.tasks_.clear();
+    taskManager.dependencyGraph_.Clear();
+    taskManager.RemoveTask(task->taskId_);
     delete task;
 }
 
@@ -467,14 +521,14 @@ void NativeEngineTest::StoreDependentId(uint32_t taskId, uint32_t dependentId)
 {
     TaskManager& taskManager = TaskManager::GetInstance();
     std::set<uint32_t> set{ dependentId };
-    taskManager.dependTaskInfos_.emplace(taskId, std::move(set));
+    taskManager.StoreTaskDependency(taskId, set);
 }
 
 void NativeEngineTest::StoreDependentTaskId(uint32_t taskId, uint32_t dependentId)
 {
     TaskManager& taskManager = TaskManager::GetInstance();
-    std::set<uint32_t> set{ dependentId };
-    taskManager.dependentTaskInfos_.emplace(taskId, std::move(set));
+    std::set<uint32_t> set{ taskId };
+    taskManager.StoreTaskDependency(dependentId, set);
 }
 
 void NativeEngineTest::StoreTaskDuration(uint32_t taskId)
@@ -509,17 +563,16 @@ void NativeEngineTest::NotifyDependencyTaskInfo(napi_env env)
     worker->workerEnv_ = env;
     task->worker_ = worker;
     uint32_t id = task->taskId_ + MAX_TIMEOUT_TIME;
-    std::set<uint32_t> set{ task->taskId_, id };
-    taskManager.dependentTaskInfos_.emplace(task->taskId_, std::move(set));
+    std::set<uint32_t> set{ task->taskId_ };
+    taskManager.StoreTaskDependency(id, set);
     taskManager.NotifyDependencyTaskInfo(task->taskId_);
-    std::set<uint32_t> set1{ task->taskId_, id };
-    taskManager.dependentTaskInfos_.emplace(task->taskId_, std::move(set1));
+    taskManager.StoreTaskDependency(id, set);
     taskManager.EnqueuePendingTaskInfo(0, Priority::DEFAULT);
     taskManager.EnqueuePendingTaskInfo(id, Priority::DEFAULT);
     taskManager.EnqueuePendingTaskInfo(task->taskId_, Priority::DEFAULT);
     taskManager.NotifyDependencyTaskInfo(task->taskId_);
-    std::set<uint32_t> set2{ task->taskId_, id };
-    taskManager.dependentTaskInfos_.emplace(task->taskId_, std::move(set2));
+    taskManager.DequeuePendingTaskInfo(task->taskId_);
+    taskManager.StoreTaskDependency(id, set);
     taskManager.IsDependentByTaskId(task->taskId_);
 }
 
@@ -535,7 +588,7 @@ void NativeEngineTest::StoreTaskDependency(napi_env env)
     Task* task2 = new Task();
     task2->taskId_ = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task2));
     task2->env_ = env;
-    taskManager.dependTaskInfos_.clear();
+    taskManager.dependencyGraph_.Clear();
     uint32_t id1 = task->taskId_;
     uint32_t id2 = task->taskId_ + MAX_TIMEOUT_TIME;
     uint32_t id3 = task1->taskId_;
@@ -543,20 +596,20 @@ void NativeEngineTest::StoreTaskDependency(napi_env env)
     uint32_t id5 = task2->taskId_;
     uint32_t id6 = task2->taskId_ + MAX_TIMEOUT_TIME;
     std::set<uint32_t> set{ id2, id3 };
-    taskManager.dependTaskInfos_.emplace(id1, std::move(set));
+    taskManager.StoreTaskDependency(id1, set);
     std::set<uint32_t> taskId{ id1, id2 };
     taskManager.StoreTaskDependency(id3, taskId);
     taskManager.StoreTaskDependency(id5, taskId);
     std::set<uint32_t> set1{ id4, id5 };
-    taskManager.dependTaskInfos_.emplace(id3, std::move(set1));
+    taskManager.StoreTaskDependency(id3, set1);
     taskManager.StoreTaskDependency(id1, taskId);
     std::set<uint32_t> set2{ id6 };
     std::set<uint32_t> set3{ id1 };
-    taskManager.dependTaskInfos_.emplace(id5, std::move(set3));
+    taskManager.StoreTaskDependency(id5, set3);
     taskManager.StoreTaskDependency(id1, taskId);
-    taskManager.dependTaskInfos_.emplace(id5, std::move(set2));
+    taskManager.StoreTaskDependency(id5, set2);
     taskManager.StoreTaskDependency(id1, taskId);
-    taskManager.dependTaskInfos_.clear();
+    taskManager.dependencyGraph_.Clear();
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
 }
@@ -570,17 +623,16 @@ void NativeEngineTest::RemoveTaskDependency(napi_env env)
     Task* task1 = new Task();
     task1->taskId_ = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task1));
     uint32_t id2 = task1->taskId_ + MAX_TIMEOUT_TIME;
-    taskManager.dependTaskInfos_.clear();
+    taskManager.dependencyGraph_.Clear();
     std::set<uint32_t> set{ id };
-    taskManager.dependTaskInfos_.emplace(task->taskId_, std::move(set));
+    taskManager.StoreTaskDependency(task->taskId_, set);
     taskManager.RemoveTaskDependency(task->taskId_, task1->taskId_);
     taskManager.RemoveTaskDependency(task->taskId_, id);
-    std::set<uint32_t> set2{ id };
-    taskManager.dependentTaskInfos_.emplace(task->taskId_, std::move(set2));
-    std::set<uint32_t> dependentTaskIdSet{ task->taskId_ };
-    taskManager.StoreDependentTaskInfo(dependentTaskIdSet, task1->taskId_);
-    taskManager.RemoveDependentTaskInfo(task->taskId_, id2);
-    taskManager.RemoveDependentTaskInfo(task->taskId_, id);
+    std::set<uint32_t> set2{ task->taskId_ };
+    taskManager.StoreTaskDependency(id, set2);
+    taskManager.StoreTaskDependency(task1->taskId_, set2);
+    taskManager.RemoveTaskDependency(id2, task->taskId_);
+    taskManager.RemoveTaskDependency(id, task->taskId_);
     taskManager.GetTaskDependInfoToString(task1->taskId_);
     taskManager.taskDurationInfos_.emplace(task->taskId_, std::make_pair(UINT64_ZERO, task1->taskId_));
     taskManager.StoreTaskDuration(task->taskId_, UINT64_ZERO, UINT64_ZERO);
@@ -598,10 +650,10 @@ void NativeEngineTest::ReleaseTaskData(napi_env env)
     task->taskType_ = TaskType::GROUP_FUNCTION_TASK;
     taskManager.StoreTask(task);
     taskManager.ReleaseTaskData(env, task);
-    std::set<uint32_t> set{ task->taskId_ };
-    taskManager.dependTaskInfos_.emplace(task->taskId_, std::move(set));
     task->taskType_ = TaskType::COMMON_TASK;
     taskManager.StoreTask(task);
+    std::set<uint32_t> set{ task->taskId_ + MAX_TIMEOUT_TIME };
+    taskManager.StoreTaskDependency(task->taskId_, set);
     taskManager.ReleaseTaskData(env, task);
     Task* task1 = new Task();
     task1->taskId_ = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task1));
@@ -871,15 +923,15 @@ void NativeEngineTest::TaskResultCallback(napi_env env)
     ExceptionScope scope(env);
     Worker* worker = reinterpret_cast<Worker*>(WorkerConstructor(env));
     Task* task = new Task();
-    task->taskId_ = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task));
+    TaskManager::GetInstance().StoreTask(task);
     task->env_ = env;
     task->taskRefCount_.fetch_add(1);
     task->worker_ = worker;
     task->cpuTime_ = UINT64_ZERO;
-    Worker::TaskResultCallback(worker->workerEnv_, nullptr, false, reinterpret_cast<void*>(task));
+    Worker::TaskResultCallback(worker->workerEnv_, nullptr, false, TaskManager::GetTaskInfoData(task->taskId_));
     task->taskRefCount_.fetch_add(1);
     task->cpuTime_ = task->taskId_;
-    Worker::TaskResultCallback(worker->workerEnv_, nullptr, true, reinterpret_cast<void*>(task));
+    Worker::TaskResultCallback(worker->workerEnv_, nullptr, true, TaskManager::GetTaskInfoData(task->taskId_));
 
     worker->priority_ = Priority::LOW;
     worker->ResetWorkerPriority();
@@ -1054,7 +1106,6 @@ void NativeEngineTest::GetIdleTaskByPriority(napi_env env)
     taskManager.GetTaskByPriority(taskQueue, Priority::IDLE);
     taskManager.SetIsPerformIdle(false);
     taskManager.RemoveTask(task->taskId_);
-    taskManager.tasks_.clear();
     delete task;
 }
 
@@ -1146,7 +1197,6 @@ std::string NativeEngineTest::GetFuncNameFromError(napi_env env, napi_value erro
 uint32_t NativeEngineTest::GetTaskIdSalt()
 {
     TaskManager& taskManager = TaskManager::GetInstance();
-    std::lock_guard<std::recursive_mutex> lock(taskManager.tasksMutex_);
     taskManager.taskIdSalt_ = MAX_UINT32_T;
     taskManager.IncreaseTaskIdSalt();
     return taskManager.taskIdSalt_;
@@ -1155,7 +1205,6 @@ uint32_t NativeEngineTest::GetTaskIdSalt()
 uint64_t NativeEngineTest::CalculateTaskId(uint64_t taskId, uint32_t salt)
 {
     TaskManager& taskManager = TaskManager::GetInstance();
-    std::lock_guard<std::recursive_mutex> lock(taskManager.tasksMutex_);
     taskManager.taskIdSalt_ = salt;
     return taskManager.CalculateTaskId(taskId);
 }
@@ -1187,7 +1236,7 @@ bool NativeEngineTest::TriggerTaskTimeoutTimer(napi_env env, void* data)
 
 bool NativeEngineTest::TaskTimeoutCallback(uv_timer_t* handle)
 {
-    TaskPool::TaskTimeoutCallback(handle);
+    TaskPool::TaskTimeoutCallback(handle->data);
     return true;
 }
 
@@ -1200,7 +1249,7 @@ bool NativeEngineTest::TriggerTaskGroupTimeoutTimer(napi_env env, void* data)
 
 bool NativeEngineTest::TaskGroupTimeoutCallback(uv_timer_t* handle)
 {
-    TaskPool::TaskGroupTimeoutCallback(handle);
+    TaskPool::TaskGroupTimeoutCallback(handle->data);
     return true;
 }
 
@@ -1321,16 +1370,14 @@ uint32_t NativeEngineTest::NotifyDependencyTaskInfoWithRemainingDependency(napi_
     uint32_t taskCId = taskA->taskId_ + MAX_TIMEOUT_TIME + 1;
 
     std::set<uint32_t> dependSet{taskBId, taskCId};
-    taskManager.dependTaskInfos_.emplace(taskA->taskId_, std::move(dependSet));
-    std::set<uint32_t> dependentSet{taskA->taskId_};
-    taskManager.dependentTaskInfos_.emplace(taskBId, std::move(dependentSet));
+    taskManager.StoreTaskDependency(taskA->taskId_, dependSet);
     taskManager.EnqueuePendingTaskInfo(taskA->taskId_, Priority::DEFAULT);
 
     taskManager.NotifyDependencyTaskInfo(taskBId);
 
     auto taskInfo = taskManager.DequeuePendingTaskInfo(taskA->taskId_);
 
-    taskManager.dependTaskInfos_.erase(taskA->taskId_);
+    taskManager.dependencyGraph_.RemoveTask(taskA->taskId_);
     delete taskA;
     return taskInfo.first;
 }
@@ -1345,18 +1392,345 @@ uint32_t NativeEngineTest::NotifyDependencyTaskInfoWithNoDependency(napi_env env
     uint32_t taskBId = taskA->taskId_ + MAX_TIMEOUT_TIME;
 
     std::set<uint32_t> dependSet{taskBId};
-    taskManager.dependTaskInfos_.emplace(taskA->taskId_, std::move(dependSet));
-    std::set<uint32_t> dependentSet{taskA->taskId_};
-    taskManager.dependentTaskInfos_.emplace(taskBId, std::move(dependentSet));
+    taskManager.StoreTaskDependency(taskA->taskId_, dependSet);
     taskManager.EnqueuePendingTaskInfo(taskA->taskId_, Priority::DEFAULT);
 
     taskManager.NotifyDependencyTaskInfo(taskBId);
 
     auto taskInfo = taskManager.DequeuePendingTaskInfo(taskA->taskId_);
 
-    taskManager.dependTaskInfos_.erase(taskA->taskId_);
+    taskManager.dependencyGraph_.RemoveTask(taskA->taskId_);
     delete taskA;
     ClearTaskQueue();
     return taskInfo.first;
 }
+
+uint32_t NativeEngineTest::WakeupIdleWorkers(napi_env env, uint32_t taskNum)
+{
+    // returns the number of woken workers, or UINT32_MAX if they are not the most recently idle ones
+    constexpr uint32_t workerNum = 4; // 4: idle workers
+    TaskManager& taskManager = TaskManager::GetInstance();
+    ResetTaskManager();
+    ClearTaskQueue();
+    uv_loop_t loop;
+    uv_loop_init(&loop);
+    std::vector<Worker*> workers;
+    for (uint32_t i = 0; i < workerNum; i++) {
+        Worker* worker = new Worker(env);
+        ConcurrentHelper::UvHandleInit(&loop, worker->performTaskSignal_, NativeEngineTest::foo, worker);
+        taskManager.workers_.insert(worker);
+        taskManager.NotifyWorkerIdle(worker);
+        workers.push_back(worker);
+    }
+    taskManager.nonIdleTaskNum_ = taskNum;
+    taskManager.totalTaskNum_ = taskNum;
+    taskManager.NotifyExecuteTask();
+    // the tasks are already covered by the woken workers, nothing more should be woken up
+    taskManager.NotifyExecuteTask();
+    uint32_t wakingNum = taskManager.wakingCount_;
+    bool isLifo = true;
+    for (uint32_t i = 0; i < workerNum; i++) {
+        bool shouldWake = i + std::min(taskNum, workerNum) >= workerNum;
+        isLifo = isLifo && (workers[i]->isWaking_ == shouldWake);
+    }
+    for (auto worker : workers) {
+        taskManager.NotifyWorkerWokenUp(worker);
+        taskManager.RemoveWorker(worker);
+        ConcurrentHelper::UvHandleClose(worker->performTaskSignal_);
+    }
+    uv_run(&loop, UV_RUN_DEFAULT);
+    uv_loop_close(&loop);
+    for (auto worker : workers) {
+        delete worker;
+    }
+    taskManager.nonIdleTaskNum_ = 0;
+    taskManager.totalTaskNum_ = 0;
+    ResetTaskManager();
+    return isLifo ? wakingNum : UINT32_MAX;
+}
+
+std::vector<uint32_t> NativeEngineTest::DequeueDeadlineTasks(napi_env env)
+{
+    // returns the dequeued taskIds, the expired task is dropped and the urgent task is boosted
+    TaskManager& taskManager = TaskManager::GetInstance();
+    ResetTaskManager();
+    ClearTaskQueue();
+    taskManager.deadlinePrioExecuteCount_ = 0;
+    uint64_t now = ConcurrentHelper::GetMilliseconds();
+    std::vector<Task*> tasks;
+    auto createTask = [env, &tasks](uint32_t taskId, uint64_t deadline) {
+        Task* task = new Task(env, TaskType::COMMON_TASK, "deadline");
+        task->taskId_ = taskId;
+        task->deadline_ = deadline;
+        tasks.push_back(task);
+        return task;
+    };
+    uint32_t baseId = UINT32_MAX - 10; // 10: the ids are not stored in the task table
+    taskManager.EnqueueDeadlineTaskId(createTask(baseId, 1), Priority::MEDIUM); // 1: already expired
+    taskManager.EnqueueDeadlineTaskId(createTask(baseId + 1, now + 60000), Priority::MEDIUM); // 60000: 1min
+    taskManager.EnqueueDeadlineTaskId(createTask(baseId + 2, now + 30000), Priority::MEDIUM); // 30000: 30s
+    taskManager.EnqueueDeadlineTaskId(createTask(baseId + 3, now + 30000), Priority::MEDIUM); // 30000: 30s
+    // the erased task is never dequeued
+    taskManager.EraseWaitingTaskId(baseId + 3, Priority::MEDIUM);
+    {
+        std::lock_guard<std::mutex> lock(taskManager.taskQueuesMutex_);
+        taskManager.IncreaseTaskNum(Priority::HIGH);
+        taskManager.taskQueues_[Priority::HIGH]->EnqueueTaskId(baseId + 4);
+        taskManager.globalTaskNum_[Priority::HIGH]++;
+    }
+    std::vector<uint32_t> taskIds;
+    taskIds.push_back(taskManager.DequeueGlobalTaskId().first);
+    // the deadline is near, the task goes before the band ratio
+    uint64_t urgentDeadline = ConcurrentHelper::GetMilliseconds() + 4; // 4: within the boost window
+    taskManager.EnqueueDeadlineTaskId(createTask(baseId + 5, urgentDeadline), Priority::MEDIUM);
+    taskManager.deadlinePrioExecuteCount_ = 5; // 5: the deadline band has used up its turns
+    for (uint32_t i = 0; i < 3; i++) { // 3: the boosted task, the high task and the last deadline task
+        taskIds.push_back(taskManager.DequeueGlobalTaskId().first);
+    }
+    for (Task* task : tasks) {
+        delete task;
+    }
+    ResetTaskManager();
+    return taskIds;
+}
+
+bool NativeEngineTest::RejectExpiredTask(napi_env env)
+{
+    // returns whether the expired task has cleared its timeout timer and finished like a canceled task
+    Task* task = new Task(env, TaskType::COMMON_TASK, "expired");
+    TaskManager::GetInstance().StoreTask(task);
+    napi_value thisValue = NapiHelper::CreateObject(env);
+    task->taskRef_ = NapiHelper::CreateReference(env, thisValue, 1);
+    task->currentTaskInfo_ = new TaskInfo(env);
+    NapiHelper::CreatePromise(env, &task->currentTaskInfo_->deferred);
+    task->taskState_ = ExecuteState::WAITING;
+    task->timeout_ = 60000; // 60000: 1min, the timer does not fire during the test
+    task->IncreaseTaskLifecycleCount();
+    reinterpret_cast<NativeEngine*>(env)->IncreaseSubEnvCounter();
+    TaskPool::TriggerTaskTimeoutTimer(env, task);
+    uint32_t timerNum = TimerWheel::GetTimerNum(env);
+    bool hasTimer = task->timerId_ != 0;
+    TaskPool::RejectExpiredTask(task);
+    bool isCleared = hasTimer && task->timerId_ == 0 && TimerWheel::GetTimerNum(env) + 1 == timerNum;
+    bool isFinished = task->isCancelToFinish_;
+    TaskManager::GetInstance().RemoveTask(task->taskId_);
+    delete task->currentTaskInfo_;
+    task->currentTaskInfo_ = nullptr;
+    delete task;
+    return isCleared && isFinished;
+}
+
+size_t NativeEngineTest::CollectResultBuffers(napi_env env, napi_value result, size_t& byteLength)
+{
+    Worker::ResultBuffers buffers {};
+    Worker::CollectResultBuffers(env, result, buffers);
+    byteLength = 0;
+    for (const auto& buffer : buffers) {
+        byteLength += buffer.second;
+    }
+    return buffers.size();
+}
+
+uint32_t NativeEngineTest::GetResultTransferNum(napi_env env, void* data, napi_value result)
+{
+    Task* task = static_cast<Task*>(data);
+    napi_value transferList = Worker::GetResultTransferList(env, task, result);
+    if (!NapiHelper::IsArray(env, transferList)) {
+        return 0;
+    }
+    return NapiHelper::GetArrayLength(env, transferList);
+}
+
+void NativeEngineTest::RecordResultBytes(napi_env env, napi_value result)
+{
+    Worker::ResultBuffers buffers {};
+    Worker::CollectResultBuffers(env, result, buffers);
+    Worker::RecordResultBytes(env, buffers);
+}
+
+uint32_t NativeEngineTest::PreloadModules(napi_env env)
+{
+    // the worker has loaded every module already, nothing is loaded again
+    Worker* worker = new Worker(env);
+    worker->workerEnv_ = env;
+    worker->preloadedModuleNum_ = TaskManager::GetInstance().GetPreloadModuleNum();
+    worker->PreloadModules();
+    uint32_t preloadedModuleNum = worker->preloadedModuleNum_;
+    delete worker;
+    return preloadedModuleNum;
+}
+
+std::vector<uint32_t> NativeEngineTest::EnqueueAffinityTasks(napi_env env)
+{
+    // returns the bound tasks of the worker and whether it dequeued the task, when it is idle, when it is busy,
+    // and after the affinity queue is detached
+    TaskManager& taskManager = TaskManager::GetInstance();
+    ResetTaskManager();
+    ClearTaskQueue();
+    Worker* worker = new Worker(env);
+    taskManager.workers_.insert(worker);
+    taskManager.NotifyWorkerIdle(worker);
+    Task* task = new Task();
+    taskManager.StoreTask(task);
+    std::vector<uint32_t> result {};
+    taskManager.EnqueueTaskId(task->taskId_, Priority::DEFAULT, worker);
+    result.push_back(worker->affinityTaskNum_);
+    result.push_back(taskManager.DequeueTaskId(worker).first == task->taskId_ ? 1 : 0);
+
+    taskManager.NotifyWorkerRunning(worker);
+    taskManager.EnqueueTaskId(task->taskId_, Priority::DEFAULT, worker);
+    result.push_back(worker->affinityTaskNum_);
+    result.push_back(taskManager.DequeueTaskId(worker).first == task->taskId_ ? 1 : 0);
+
+    taskManager.NotifyWorkerIdle(worker);
+    taskManager.EnqueueTaskId(task->taskId_, Priority::DEFAULT, worker);
+    taskManager.DetachAffinityQueue(worker);
+    result.push_back(worker->affinityTaskNum_);
+    result.push_back(taskManager.DequeueTaskId(worker).first == task->taskId_ ? 1 : 0);
+    taskManager.EnqueueTaskId(task->taskId_, Priority::DEFAULT, worker);
+    result.push_back(worker->affinityTaskNum_);
+    result.push_back(taskManager.DequeueTaskId(worker).first == task->taskId_ ? 1 : 0);
+
+    taskManager.RemoveWorker(worker);
+    delete worker;
+    taskManager.RemoveTask(task->taskId_);
+    delete task;
+    ResetTaskManager();
+    return result;
+}
+
+bool NativeEngineTest::TakeRateToken(void* asyncData, uint64_t now)
+{
+    AsyncRunner* asyncRunner = reinterpret_cast<AsyncRunner*>(asyncData);
+    return asyncRunner->TakeRateToken(now);
+}
+
+void NativeEngineTest::DispatchWaitingTasks(void* asyncData, napi_env env)
+{
+    AsyncRunner* asyncRunner = reinterpret_cast<AsyncRunner*>(asyncData);
+    AsyncRunner::WatermarkSignal signal;
+    std::unique_lock<std::shared_mutex> lock(asyncRunner->taskMutex_);
+    asyncRunner->DispatchWaitingTasks(env, signal);
+}
+
+void NativeEngineTest::ReleaseRunnerEnvData(void* asyncData, napi_env env)
+{
+    AsyncRunner* asyncRunner = reinterpret_cast<AsyncRunner*>(asyncData);
+    asyncRunner->ReleaseEnvData(env);
+}
+
+std::vector<uint32_t> NativeEngineTest::GetCoreClassWorkers(napi_env env)
+{
+    // returns whether the idle worker is found for a COMPUTE, a BACKGROUND and a DEFAULT task while it is on the
+    // performance cores, for a COMPUTE and a BACKGROUND task on the efficiency cores, when it is busy,
+    // and when the workloads are disabled
+    TaskManager& taskManager = TaskManager::GetInstance();
+    ResetTaskManager();
+    Worker* worker = new Worker(env);
+    taskManager.workers_.insert(worker);
+    taskManager.NotifyWorkerIdle(worker);
+    Task* task = new Task();
+    std::vector<uint32_t> result {};
+    auto findWorker = [&taskManager, worker, task, &result](Workload workload) {
+        task->workload_ = workload;
+        result.push_back(taskManager.GetCoreClassWorker(task) == worker ? 1 : 0);
+    };
+    taskManager.isCoreAffinityEnabled_ = true;
+    worker->coreClass_ = CoreClass::PERFORMANCE;
+    findWorker(Workload::COMPUTE);
+    findWorker(Workload::BACKGROUND);
+    findWorker(Workload::DEFAULT);
+    worker->coreClass_ = CoreClass::EFFICIENCY;
+    findWorker(Workload::COMPUTE);
+    findWorker(Workload::BACKGROUND);
+    taskManager.NotifyWorkerRunning(worker);
+    findWorker(Workload::BACKGROUND);
+    taskManager.NotifyWorkerIdle(worker);
+    // the workloads stay disabled for the other tests
+    taskManager.isCoreAffinityEnabled_ = false;
+    findWorker(Workload::BACKGROUND);
+
+    taskManager.RemoveWorker(worker);
+    delete worker;
+    delete task;
+    ResetTaskManager();
+    return result;
+}
+
+std::vector<uint32_t> NativeEngineTest::BindCoreClass(napi_env env)
+{
+    // returns the class of the worker after it runs a COMPUTE, a DEFAULT and a BACKGROUND task, and a COMPUTE task
+    // when the workloads are disabled
+    TaskManager& taskManager = TaskManager::GetInstance();
+    Worker* worker = new Worker(env);
+    Task* task = new Task();
+    std::vector<uint32_t> result {};
+    auto runTask = [worker, task, &result](Workload workload) {
+        task->workload_ = workload;
+        worker->BindCoreClass(task);
+        result.push_back(static_cast<uint32_t>(worker->coreClass_.load()));
+    };
+    taskManager.isCoreAffinityEnabled_ = true;
+    runTask(Workload::COMPUTE);
+    runTask(Workload::DEFAULT);
+    runTask(Workload::BACKGROUND);
+    // the thread of the test runs on all the cores again
+    task->workload_ = Workload::DEFAULT;
+    worker->BindCoreClass(task);
+    taskManager.isCoreAffinityEnabled_ = false;
+    runTask(Workload::COMPUTE);
+    delete worker;
+    delete task;
+    return result;
+}
+
+void NativeEngineTest::RemoveFunctionCacheEnv(napi_env env)
+{
+    // what the env cleanup hook does on teardown
+    FunctionCache::GetInstance().RemoveEnv(env);
+}
+
+bool NativeEngineTest::RetireFunctionCacheEntry(napi_env env, napi_value func)
+{
+    // what dropping the entry in LRU order does
+    FunctionCache& functionCache = FunctionCache::GetInstance();
+    auto serialization = functionCache.GetSerialization(env, func);
+    if (serialization == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(functionCache.entriesMutex_);
+    auto& entries = functionCache.entries_[env];
+    for (auto iter = entries.begin(); iter != entries.end(); ++iter) {
+        if (iter->serialization == serialization) {
+            NapiHelper::DeleteReference(env, iter->funcRef);
+            functionCache.RetireUnsafe(env, std::move(iter->serialization));
+            entries.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t NativeEngineTest::GetRetiredFunctionNum(napi_env env)
+{
+    FunctionCache& functionCache = FunctionCache::GetInstance();
+    std::lock_guard<std::mutex> lock(functionCache.entriesMutex_);
+    auto iter = functionCache.retired_.find(env);
+    return iter == functionCache.retired_.end() ? 0 : iter->second.size();
+}
+
+size_t NativeEngineTest::GetParallelGroupLevelNum(ParallelGroup& group)
+{
+    return group.levels_.size();
+}
+
+napi_ref NativeEngineTest::GetParallelGroupValue(ParallelGroup& group, uint32_t level, uint32_t index)
+{
+    return group.levels_[level][index];
+}
+
+napi_deferred* NativeEngineTest::GetParallelGroupDeferred(ParallelGroup& group)
+{
+    return &group.deferred_;
+}
 } // namespace Commonlibrary::Concurrent::TaskPoolModule
@@ -29,6 +29,7 @@
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 class Worker;
+class ParallelGroup;
 class NativeEngineTest : public testing::Test {
 public:
     NativeEngineTest();
@@ -38,8 +39,13 @@ public:
 
     static napi_value IsConcurrent(napi_env env, napi_value argv[], size_t argc);
     static napi_value GetTaskPoolInfo(napi_env env, napi_value argv[], size_t argc);
+    static napi_value SetResultTransferMode(napi_env env, napi_value argv[], size_t argc);
+    static napi_value Prewarm(napi_env env, napi_value argv[], size_t argc);
     static napi_value TerminateTask(napi_env env, napi_value argv[], size_t argc);
     static napi_value Execute(napi_env env, napi_value argv[], size_t argc);
+    static napi_value ExecuteBatch(napi_env env, napi_value argv[], size_t argc);
+    static napi_value ParallelFor(napi_env env, napi_value argv[], size_t argc);
+    static napi_value MapReduce(napi_env env, napi_value argv[], size_t argc);
     static napi_value ExecuteDelayed(napi_env env, napi_value argv[], size_t argc);
     static napi_value Cancel(napi_env env, napi_value argv[], size_t argc);
     static void DelayTask(uv_timer_t* handle);
@@ -123,6 +129,25 @@ public:
     static void EnqueueTask(void* data);
     static uint32_t NotifyDependencyTaskInfoWithRemainingDependency(napi_env env);
     static uint32_t NotifyDependencyTaskInfoWithNoDependency(napi_env env);
+    static uint32_t WakeupIdleWorkers(napi_env env, uint32_t taskNum);
+    static std::vector<uint32_t> DequeueDeadlineTasks(napi_env env);
+    static bool RejectExpiredTask(napi_env env);
+    static size_t CollectResultBuffers(napi_env env, napi_value result, size_t& byteLength);
+    static uint32_t GetResultTransferNum(napi_env env, void* data, napi_value result);
+    static void RecordResultBytes(napi_env env, napi_value result);
+    static uint32_t PreloadModules(napi_env env);
+    static std::vector<uint32_t> EnqueueAffinityTasks(napi_env env);
+    static bool TakeRateToken(void* asyncData, uint64_t now);
+    static void DispatchWaitingTasks(void* asyncData, napi_env env);
+    static void ReleaseRunnerEnvData(void* asyncData, napi_env env);
+    static std::vector<uint32_t> GetCoreClassWorkers(napi_env env);
+    static std::vector<uint32_t> BindCoreClass(napi_env env);
+    static void RemoveFunctionCacheEnv(napi_env env);
+    static bool RetireFunctionCacheEntry(napi_env env, napi_value func);
+    static size_t GetRetiredFunctionNum(napi_env env);
+    static size_t GetParallelGroupLevelNum(ParallelGroup& group);
+    static napi_ref GetParallelGroupValue(ParallelGroup& group, uint32_t level, uint32_t index);
+    static napi_deferred* GetParallelGroupDeferred(ParallelGroup& group);
 
     class ExceptionScope {
     public:
@@ -15,11 +15,22 @@
 
 #include "test.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
+#include <unordered_set>
+#include <vector>
 
 #include "async_runner.h"
 #include "async_runner_manager.h"
+#include "cpu_topology.h"
+#include "dependency_graph.h"
+#include "function_cache.h"
 #include "helper/napi_helper.h"
+#include "parallel_group.h"
 #if defined(ENABLE_CONCURRENCY_INTEROP)
 #include "helper/hybrid_concurrent_helper.h"
 #endif
@@ -30,9 +41,13 @@
 #include "task_group_manager.h"
 #include "task_manager.h"
 #include "task_runner.h"
+#include "task_table.h"
 #include "thread.h"
+#include "thread_count_policy.h"
+#include "timer_wheel.h"
 #include "tools/log.h"
 #include "uv.h"
+#include "work_stealing_queue.h"
 #include "worker.h"
 
 using namespace Commonlibrary::Concurrent::TaskPoolModule;
@@ -81,6 +96,30 @@ napi_value GeneratorTaskGroupWithName(napi_env env, napi_value thisVar, const ch
     return group;
 }
 
+// a sysfs cpu directory with the cpu_capacity and cpuinfo_max_freq of the cores, 0 leaves the file out
+std::string CreateFakeCpuRoot(const std::string& name, const std::vector<uint64_t>& capacities,
+    const std::vector<uint64_t>& maxFreqs)
+{
+    // only /data/local/tmp is writable on the device
+    std::string root = access("/data/local/tmp", W_OK) == 0 ? "/data/local/tmp/" : "/tmp/";
+    root += name;
+    mkdir(root.c_str(), S_IRWXU);
+    size_t cpuNum = std::max(capacities.size(), maxFreqs.size());
+    std::ofstream(root + "/online") << "0-" << (cpuNum - 1) << "\n";
+    for (size_t i = 0; i < cpuNum; i++) {
+        std::string cpuDir = root + "/cpu" + std::to_string(i);
+        mkdir(cpuDir.c_str(), S_IRWXU);
+        mkdir((cpuDir + "/cpufreq").c_str(), S_IRWXU);
+        if (i < capacities.size() && capacities[i] != 0) {
+            std::ofstream(cpuDir + "/cpu_capacity") << capacities[i] << "\n";
+        }
+        if (i < maxFreqs.size() && maxFreqs[i] != 0) {
+            std::ofstream(cpuDir + "/cpufreq/cpuinfo_max_freq") << maxFreqs[i] << "\n";
+        }
+    }
+    return root;
+}
+
 napi_value CreateTaskObject(napi_env env, TaskType taskType = TaskType::TASK,
     ExecuteState state = ExecuteState::NOT_FOUND, bool needStoreTask = false)
 {
@@ -681,10 +720,13 @@ HWTEST_F(NativeEngineTest, TaskpoolTest045, testing::ext::TestSize.Level0)
     uint32_t taskId = 23;
     std::set<uint32_t> dependentIdSet;
     dependentIdSet.emplace(1);
-    std::set<uint32_t> idSet;
-    idSet.emplace(2);
-    bool res = taskManager.CheckCircularDependency(dependentIdSet, idSet, taskId);
+    bool res = taskManager.StoreTaskDependency(taskId, dependentIdSet);
     ASSERT_EQ(res, true);
+    std::set<uint32_t> idSet;
+    idSet.emplace(taskId);
+    res = taskManager.StoreTaskDependency(1, idSet);
+    ASSERT_EQ(res, false);
+    taskManager.RemoveTaskDependency(taskId, 1);
 }
 
 HWTEST_F(NativeEngineTest, TaskpoolTest046, testing::ext::TestSize.Level0)
@@ -715,7 +757,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest048, testing::ext::TestSize.Level0)
     TaskManager& taskManager = TaskManager::GetInstance();
     uint32_t taskId = 25;
     std::set<uint32_t> dependTaskIdSet;
-    taskManager.StoreDependentTaskInfo(dependTaskIdSet, taskId);
+    taskManager.StoreTaskDependency(taskId, dependTaskIdSet);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
     ASSERT_EQ(exception, nullptr);
@@ -727,7 +769,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest049, testing::ext::TestSize.Level0)
     TaskManager& taskManager = TaskManager::GetInstance();
     uint32_t taskId = 26;
     uint32_t dependentTaskId = 26;
-    taskManager.RemoveDependentTaskInfo(dependentTaskId, taskId);
+    taskManager.RemoveTaskDependency(taskId, dependentTaskId);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
     ASSERT_EQ(exception, nullptr);
@@ -2728,12 +2770,11 @@ HWTEST_F(NativeEngineTest, TaskpoolTest147, testing::ext::TestSize.Level0)
     task->env_ = env;
     napi_value obj = NapiHelper::CreateObject(env);
     task->taskRef_ = NapiHelper::CreateReference(env, obj, 1);
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    task->timer_ = new uv_timer_t;
-    uv_timer_init(loop, task->timer_);
+    task->timerId_ = TimerWheel::AddTimer(env, 1000, 1000, [](void*) {}, nullptr); // 1000: period of the timer
+    ASSERT_NE(task->timerId_, 0);
     handle->data = task;
     NativeEngineTest::PeriodicTaskCallback(handle);
-    ASSERT_TRUE(true);
+    ASSERT_EQ(task->timerId_, 0);
 }
 
 HWTEST_F(NativeEngineTest, TaskpoolTest148, testing::ext::TestSize.Level0)
@@ -4329,18 +4370,15 @@ HWTEST_F(NativeEngineTest, TaskpoolTest212, testing::ext::TestSize.Level0)
     napi_env env = (napi_env)engine_;
     Task* task = new Task();
     task->taskId_ = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task));
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    uv_timer_t* timer = new uv_timer_t;
-    uv_timer_init(loop, timer);
     TaskMessage* taskMessage = new TaskMessage();
     taskMessage->priority = Priority::DEFAULT;
     taskMessage->taskId = task->taskId_;
     napi_value promise = NapiHelper::CreatePromise(env, &taskMessage->deferred);
-    timer->data = taskMessage;
-    task->delayedTimers_.insert(nullptr);
-    task->delayedTimers_.insert(timer);
+    taskMessage->timerId = TimerWheel::AddTimer(env, 1000, 0, [](void*) {}, taskMessage); // 1000: delay of the timer
+    task->delayedTimers_.emplace(0, nullptr);
+    task->delayedTimers_.emplace(taskMessage->timerId, taskMessage);
     task->ClearDelayedTimers();
+    ASSERT_TRUE(task->delayedTimers_.empty());
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
     ASSERT_TRUE(exception == nullptr);
@@ -6453,7 +6491,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest308, testing::ext::TestSize.Level0)
     uint32_t taskId = 308;
     uint32_t taskId2 = 1308;
     std::set<uint32_t> taskIds{taskId2};
-    TaskManager::GetInstance().StoreDependentTaskInfo(taskIds, taskId);
+    TaskManager::GetInstance().StoreTaskDependency(taskId, taskIds);
     TaskManager::GetInstance().ClearDependentTask(taskId2);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
@@ -6471,7 +6509,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest309, testing::ext::TestSize.Level0)
     task->taskRef_ = NapiHelper::CreateReference(env, obj, 1);
     TaskManager::GetInstance().StoreTask(task);
     std::set<uint32_t> taskIds{taskId};
-    TaskManager::GetInstance().StoreDependentTaskInfo(taskIds, task->taskId_);
+    TaskManager::GetInstance().StoreTaskDependency(task->taskId_, taskIds);
     TaskManager::GetInstance().ClearDependentTask(taskId);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
@@ -6491,7 +6529,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest310, testing::ext::TestSize.Level0)
     task->currentTaskInfo_ = new TaskInfo(env);
     TaskManager::GetInstance().StoreTask(task);
     std::set<uint32_t> taskIds{taskId};
-    TaskManager::GetInstance().StoreDependentTaskInfo(taskIds, task->taskId_);
+    TaskManager::GetInstance().StoreTaskDependency(task->taskId_, taskIds);
     TaskManager::GetInstance().ClearDependentTask(taskId);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
@@ -6506,8 +6544,8 @@ HWTEST_F(NativeEngineTest, TaskpoolTest311, testing::ext::TestSize.Level0)
     uint32_t taskId = 311;
     uint32_t taskId2 = 1311;
     std::set<uint32_t> taskIds{taskId2};
-    TaskManager::GetInstance().StoreDependentTaskInfo(taskIds, taskId);
-    TaskManager::GetInstance().RemoveDependentTaskInfo(taskId2, taskId);
+    TaskManager::GetInstance().StoreTaskDependency(taskId, taskIds);
+    TaskManager::GetInstance().RemoveTaskDependency(taskId, taskId2);
     TaskManager::GetInstance().ClearDependentTask(taskId2);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
@@ -7068,7 +7106,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest336, testing::ext::TestSize.Level0)
     task->currentTaskInfo_ = new TaskInfo(env);
     TaskManager::GetInstance().StoreTask(task);
     std::set<uint32_t> taskIds{taskId};
-    TaskManager::GetInstance().StoreDependentTaskInfo(taskIds, task->taskId_);
+    TaskManager::GetInstance().StoreTaskDependency(task->taskId_, taskIds);
     NativeEngineTest::EnqueueTaskIdToQueue(reinterpret_cast<void*>(task));
     TaskManager::GetInstance().ClearDependentTask(taskId);
     napi_value exception = nullptr;
@@ -7295,14 +7333,11 @@ HWTEST_F(NativeEngineTest, TaskpoolTest343_1, testing::ext::TestSize.Level0)
 
     Task* task = new Task();
     task->name_ = "TaskpoolTest343_1";
-    void* data = reinterpret_cast<void*>(task);
-    name = taskManager.GetFuncNameFromData(data);
-    ASSERT_TRUE(name == defaultName);
-
     taskManager.StoreTask(task);
     Task* task2 = taskManager.GetTaskForPerform(task->taskId_);
     ASSERT_TRUE(task == task2);
 
+    void* data = TaskManager::GetTaskInfoData(task->taskId_);
     name = taskManager.GetFuncNameFromData(data);
     ASSERT_TRUE(name == "Taskpool Thread TaskpoolTest343_1");
 
@@ -7310,7 +7345,11 @@ HWTEST_F(NativeEngineTest, TaskpoolTest343_1, testing::ext::TestSize.Level0)
     name = taskManager.GetFuncNameFromData(data);
     ASSERT_TRUE(name == defaultName);
 
+    // the removed task is not read through its stale taskId
+    task->SetValid(true);
     taskManager.RemoveTask(task->taskId_);
+    name = taskManager.GetFuncNameFromData(data);
+    ASSERT_TRUE(name == defaultName);
     delete task;
 }
 
@@ -7528,8 +7567,8 @@ HWTEST_F(NativeEngineTest, TaskpoolTest352, testing::ext::TestSize.Level0)
 {
     napi_env env = (napi_env)engine_;
     ExceptionScope scope(env);
-    bool res = TaskManager::GetInstance().IsValidTask(nullptr);
-    ASSERT_FALSE(res);
+    Task* task = TaskManager::GetInstance().GetValidTask(nullptr);
+    ASSERT_TRUE(task == nullptr);
 }
 
 HWTEST_F(NativeEngineTest, TaskpoolTest353, testing::ext::TestSize.Level0)
@@ -7632,28 +7671,31 @@ HWTEST_F(NativeEngineTest, TaskpoolTest360, testing::ext::TestSize.Level0)
     ExceptionScope scope(env);
     Task* task = new Task();
     task->ClearTimeoutTimer();
-    ASSERT_EQ(task->timer_, nullptr);
+    ASSERT_EQ(task->timerId_, 0);
     task->timeout_ = 1000;
     task->ClearTimeoutTimer();
-    ASSERT_EQ(task->timer_, nullptr);
+    ASSERT_EQ(task->timerId_, 0);
     task->timeout_ = 0;
-    task->timer_ = new uv_timer_t;
+    task->timerId_ = 1;
     task->ClearTimeoutTimer();
-    ASSERT_NE(task->timer_, nullptr);
-    task->timer_ = nullptr;
+    ASSERT_NE(task->timerId_, 0);
+    task->timerId_ = 0;
     task->taskState_ = ExecuteState::TIMEOUT;
     task->ClearTimeoutTimer();
-    ASSERT_EQ(task->timer_, nullptr);
+    ASSERT_EQ(task->timerId_, 0);
 
+    task->env_ = env;
     task->timeout_ = 1000;
-    task->timer_ = new uv_timer_t;
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    uv_timer_init(loop, task->timer_);
+    uint32_t timerNum = TimerWheel::GetTimerNum(env);
+    task->timerId_ = TimerWheel::AddTimer(env, task->timeout_, 0, [](void* data) {
+        delete static_cast<TaskTimeoutMessage*>(data);
+    }, new TaskTimeoutMessage());
     task->ClearTimeoutTimer();
+    ASSERT_EQ(TimerWheel::GetTimerNum(env), timerNum + 1);
     task->taskState_ = ExecuteState::WAITING;
     task->ClearTimeoutTimer();
-    ASSERT_EQ(task->timer_, nullptr);
+    ASSERT_EQ(task->timerId_, 0);
+    ASSERT_EQ(TimerWheel::GetTimerNum(env), timerNum);
     delete task;
 }
 
@@ -7662,15 +7704,15 @@ HWTEST_F(NativeEngineTest, TaskpoolTest361, testing::ext::TestSize.Level0)
     napi_env env = (napi_env)engine_;
     ExceptionScope scope(env);
     Task* task = new Task();
-    task->timer_ = new uv_timer_t;
+    task->timerId_ = 1;
     task->timeout_ = 0;
     task->taskState_ = ExecuteState::TIMEOUT;
     task->ClearTimeoutTimer();
-    ASSERT_NE(task->timer_, nullptr);
-    task->timer_ = nullptr;
+    ASSERT_NE(task->timerId_, 0);
+    task->timerId_ = 0;
     task->timeout_ = 1000;
     task->ClearTimeoutTimer();
-    ASSERT_EQ(task->timer_, nullptr);
+    ASSERT_EQ(task->timerId_, 0);
     delete task;
 }
 
@@ -8047,31 +8089,32 @@ HWTEST_F(NativeEngineTest, TaskpoolTest380, testing::ext::TestSize.Level0)
     ExceptionScope scope(env);
     TaskGroup* group = new TaskGroup();
     group->ClearTimeoutTimer();
-    ASSERT_EQ(group->timer_, nullptr);
+    ASSERT_EQ(group->timerId_, 0);
 
     group->SetTimeout(1000);
     group->ClearTimeoutTimer();
-    ASSERT_EQ(group->timer_, nullptr);
+    ASSERT_EQ(group->timerId_, 0);
 
     group->SetTimeout(0);
-    group->timer_ = new uv_timer_t;
+    group->timerId_ = 1;
     group->ClearTimeoutTimer();
-    ASSERT_NE(group->timer_, nullptr);
-    group->timer_ = nullptr;
+    ASSERT_NE(group->timerId_, 0);
+    group->timerId_ = 0;
 
     group->groupState_ = ExecuteState::TIMEOUT;
     group->ClearTimeoutTimer();
-    ASSERT_EQ(group->timer_, nullptr);
+    ASSERT_EQ(group->timerId_, 0);
 
+    group->env_ = env;
     group->SetTimeout(1000);
     group->groupState_ = ExecuteState::WAITING;
-    group->timer_ = new uv_timer_t;
-    uv_loop_t* loop = NapiHelper::GetLibUV(env);
-    uv_update_time(loop);
-    uv_timer_init(loop, group->timer_);
+    uint32_t timerNum = TimerWheel::GetTimerNum(env);
+    group->timerId_ = TimerWheel::AddTimer(env, 1000, 0, [](void* data) { // 1000: timeout of the group
+        delete static_cast<TaskTimeoutMessage*>(data);
+    }, new TaskTimeoutMessage());
     group->ClearTimeoutTimer();
-    ASSERT_EQ(group->timer_, nullptr);
-    group->timer_ = nullptr;
+    ASSERT_EQ(group->timerId_, 0);
+    ASSERT_EQ(TimerWheel::GetTimerNum(env), timerNum);
     delete group;
 }
 
@@ -8092,13 +8135,14 @@ HWTEST_F(NativeEngineTest, TaskpoolTest381, testing::ext::TestSize.Level0)
     Task* task2 = new Task();
     uint32_t taskId2 = TaskManager::GetInstance().CalculateTaskId(reinterpret_cast<uint64_t>(task2));
     task2->taskId_ = taskId2;
-    task2->timer_ = new uv_timer_t;
+    task2->timerId_ = 1;
     flag = NativeEngineTest::TriggerTaskTimeoutTimer(env, static_cast<void*>(task2));
     ASSERT_TRUE(flag);
     task2->SetTimeout(10);
     flag = NativeEngineTest::TriggerTaskTimeoutTimer(env, static_cast<void*>(task2));
     ASSERT_TRUE(flag);
-    task2->timer_ = nullptr;
+    ASSERT_EQ(task2->timerId_, 1);
+    task2->timerId_ = 0;
     delete task2;
 }
 
@@ -8310,13 +8354,14 @@ HWTEST_F(NativeEngineTest, TaskpoolTest386, testing::ext::TestSize.Level0)
     TaskGroup* group2 = new TaskGroup();
     uint64_t groupId2 = reinterpret_cast<uint64_t>(group2);
     group2->groupId_ = groupId2;
-    group2->timer_ = new uv_timer_t;
+    group2->timerId_ = 1;
     flag = NativeEngineTest::TriggerTaskGroupTimeoutTimer(env, static_cast<void*>(group2));
     ASSERT_TRUE(flag);
     group2->SetTimeout(10);
     flag = NativeEngineTest::TriggerTaskGroupTimeoutTimer(env, static_cast<void*>(group2));
     ASSERT_TRUE(flag);
-    group2->timer_ = nullptr;
+    ASSERT_EQ(group2->timerId_, 1);
+    group2->timerId_ = 0;
     delete group2;
 }
 
@@ -8903,7 +8948,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest407, testing::ext::TestSize.Level0)
     task->currentTaskInfo_ = new TaskInfo(env);
     taskManager.StoreTask(task);
     std::set<uint32_t> taskIds{taskId};
-    taskManager.StoreDependentTaskInfo(taskIds, task->taskId_);
+    taskManager.StoreTaskDependency(task->taskId_, taskIds);
     NativeEngineTest::EnqueueTask(reinterpret_cast<void*>(task));
     taskManager.EnqueuePendingTaskInfo(task->taskId_, Priority::DEFAULT);
     taskManager.ClearDependentTask(taskId);
@@ -8933,7 +8978,7 @@ HWTEST_F(NativeEngineTest, TaskpoolTest408, testing::ext::TestSize.Level0)
     uint32_t parentTaskId = 40801;
     taskManager.EnqueuePendingTaskInfo(task->taskId_, Priority::DEFAULT);
     std::set<uint32_t> taskIds{task->taskId_};
-    taskManager.StoreDependentTaskInfo(taskIds, parentTaskId);
+    taskManager.StoreTaskDependency(parentTaskId, taskIds);
     task->CancelInner(ExecuteState::WAITING);
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
@@ -8988,4 +9033,1447 @@ HWTEST_F(NativeEngineTest, TaskpoolTest411, testing::ext::TestSize.Level0)
     napi_value exception = nullptr;
     napi_get_and_clear_last_exception(env, &exception);
     ASSERT_TRUE(exception == nullptr);
-}
\ No newline at end of file
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest412, testing::ext::TestSize.Level0)
+{
+    ExecuteQueue executeQueue;
+    executeQueue.EnqueueTaskId(1);
+    executeQueue.EnqueueTaskId(2);
+    executeQueue.EnqueueTaskId(3);
+    executeQueue.EnqueueTaskId(2);
+    ASSERT_TRUE(executeQueue.GetTaskNum() == 4);
+    ASSERT_TRUE(executeQueue.EraseWaitingTaskId(2));
+    ASSERT_FALSE(executeQueue.EraseWaitingTaskId(4));
+    ASSERT_TRUE(executeQueue.GetHead() == 1);
+    ASSERT_TRUE(executeQueue.DequeueTaskId() == 1);
+    ASSERT_TRUE(executeQueue.DequeueTaskId() == 3);
+    ASSERT_TRUE(executeQueue.DequeueTaskId() == 2);
+    ASSERT_TRUE(executeQueue.DequeueTaskId() == 0);
+    ASSERT_TRUE(executeQueue.IsEmpty());
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest413, testing::ext::TestSize.Level0)
+{
+    // microbenchmark: 100k enqueue/cancel cycles
+    constexpr uint32_t cycleCount = 100000;
+    ExecuteQueue executeQueue;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 1; i <= cycleCount; i++) {
+        executeQueue.EnqueueTaskId(i);
+    }
+    for (uint32_t i = cycleCount; i > 0; i--) {
+        ASSERT_TRUE(executeQueue.EraseWaitingTaskId(i));
+    }
+    for (uint32_t i = 1; i <= cycleCount; i++) {
+        executeQueue.EnqueueTaskId(i);
+        ASSERT_TRUE(executeQueue.EraseWaitingTaskId(i));
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    HILOG_INFO("taskpool:: 100k enqueue/cancel cycles cost %{public}lld us", static_cast<long long>(cost.count()));
+    ASSERT_TRUE(executeQueue.IsEmpty());
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest414, testing::ext::TestSize.Level0)
+{
+    WorkStealingQueue localQueue;
+    ASSERT_TRUE(localQueue.IsEmpty());
+    ASSERT_TRUE(localQueue.Pop().first == 0);
+    ASSERT_TRUE(localQueue.Steal().first == 0);
+    ASSERT_TRUE(localQueue.Push(1, Priority::HIGH));
+    ASSERT_TRUE(localQueue.Push(2, Priority::MEDIUM));
+    ASSERT_TRUE(localQueue.Push(3, Priority::LOW));
+    ASSERT_TRUE(localQueue.GetSize() == 3);
+    // the owner pops in LIFO order and the thieves steal in FIFO order
+    ASSERT_TRUE(localQueue.PeekBottom().first == 3);
+    auto taskInfo = localQueue.Pop();
+    ASSERT_TRUE(taskInfo.first == 3 && taskInfo.second == Priority::LOW);
+    taskInfo = localQueue.Steal();
+    ASSERT_TRUE(taskInfo.first == 1 && taskInfo.second == Priority::HIGH);
+    taskInfo = localQueue.Pop();
+    ASSERT_TRUE(taskInfo.first == 2 && taskInfo.second == Priority::MEDIUM);
+    ASSERT_TRUE(localQueue.IsEmpty());
+    for (uint32_t i = 1; i <= WorkStealingQueue::CAPACITY; i++) {
+        ASSERT_TRUE(localQueue.Push(i, Priority::DEFAULT));
+    }
+    ASSERT_FALSE(localQueue.Push(WorkStealingQueue::CAPACITY + 1, Priority::DEFAULT));
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest415, testing::ext::TestSize.Level0)
+{
+    // one owner and several thieves, every entry must be taken exactly once
+    constexpr uint32_t taskCount = 100000;
+    constexpr uint32_t thiefCount = 4;
+    WorkStealingQueue localQueue;
+    std::vector<std::atomic<uint32_t>> takenCount(taskCount + 1);
+    std::atomic<bool> finished = false;
+    std::vector<std::thread> thieves;
+    for (uint32_t i = 0; i < thiefCount; i++) {
+        thieves.emplace_back([&localQueue, &takenCount, &finished] {
+            while (!finished || !localQueue.IsEmpty()) {
+                uint32_t taskId = localQueue.Steal().first;
+                if (taskId != 0) {
+                    takenCount[taskId]++;
+                }
+            }
+        });
+    }
+    uint32_t taskId = 1;
+    while (taskId <= taskCount) {
+        if (localQueue.Push(taskId, Priority::DEFAULT)) {
+            taskId++;
+        }
+        if (taskId % 2 == 0) { // 2: pop every other round
+            uint32_t poppedId = localQueue.Pop().first;
+            if (poppedId != 0) {
+                takenCount[poppedId]++;
+            }
+        }
+    }
+    finished = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+    for (uint32_t i = 1; i <= taskCount; i++) {
+        ASSERT_TRUE(takenCount[i] == 1);
+    }
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest416, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ASSERT_TRUE(NativeEngineTest::WakeupIdleWorkers(env, 0) == 0);
+    ASSERT_TRUE(NativeEngineTest::WakeupIdleWorkers(env, 1) == 1);
+    ASSERT_TRUE(NativeEngineTest::WakeupIdleWorkers(env, 3) == 3);
+    ASSERT_TRUE(NativeEngineTest::WakeupIdleWorkers(env, 10) == 4);
+}
+
+static int64_t GetFunctionCacheCount(napi_env env, const char* name)
+{
+    napi_value cacheInfo = FunctionCache::GetInstance().GetCacheInfo(env);
+    int64_t count = 0;
+    napi_get_value_int64(env, NapiHelper::GetNameProperty(env, cacheInfo, name), &count);
+    return count;
+}
+
+static napi_value CreateArgsLists(napi_env env, uint32_t taskNum)
+{
+    napi_value argsLists = NapiHelper::CreateArrayWithLength(env, taskNum);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        napi_value argsList = NapiHelper::CreateArrayWithLength(env, 1);
+        napi_set_element(env, argsList, 0, NapiHelper::CreateUint32(env, i));
+        napi_set_element(env, argsLists, i, argsList);
+    }
+    return argsLists;
+}
+
+// a task holding the shared function with the arguments [arg], like a task of a function batch
+static Task* CreateSharedFunctionTask(napi_env env, const std::shared_ptr<FunctionSerialization>& function,
+                                      uint32_t arg)
+{
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    napi_value args = NapiHelper::CreateArrayWithLength(env, 1);
+    napi_set_element(env, args, 0, NapiHelper::CreateUint32(env, arg));
+    Task* task = new Task();
+    task->taskType_ = TaskType::FUNCTION_TASK;
+    task->currentTaskInfo_ = new TaskInfo(env);
+    task->currentTaskInfo_->sharedFunction = function;
+    task->currentTaskInfo_->serializationArguments =
+        Task::SerializeArguments(env, args, {undefined, undefined, true, false});
+    return task;
+}
+
+static bool DeserializesTo(napi_env env, Task* task, uint32_t arg)
+{
+    napi_value func = nullptr;
+    napi_value args = nullptr;
+    if (task->DeserializeValue(env, &func, &args) != nullptr) {
+        return false;
+    }
+    return NapiHelper::IsFunction(env, func) &&
+        NapiHelper::GetUint32Value(env, NapiHelper::GetElement(env, args, 0)) == arg;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest417, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value func = nullptr;
+    GetSendableFunction(env, "foo", func);
+    constexpr uint32_t taskNum = 3;
+    napi_value argv[] = { func, CreateArgsLists(env, taskNum) };
+    napi_value result = NativeEngineTest::ExecuteBatch(env, argv, 2);
+    ASSERT_TRUE(result != nullptr);
+    ASSERT_TRUE(NapiHelper::GetArrayLength(env, result) == taskNum);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        bool isPromise = false;
+        napi_is_promise(env, NapiHelper::GetElement(env, result, i), &isPromise);
+        ASSERT_TRUE(isPromise);
+    }
+
+    // the next batch of the same function reuses its serialization
+    int64_t hitCount = GetFunctionCacheCount(env, "serializeHits");
+    int64_t missCount = GetFunctionCacheCount(env, "serializeMisses");
+    napi_value argv1[] = { func, CreateArgsLists(env, taskNum) };
+    result = NativeEngineTest::ExecuteBatch(env, argv1, 2);
+    ASSERT_TRUE(NapiHelper::GetArrayLength(env, result) == taskNum);
+    ASSERT_EQ(GetFunctionCacheCount(env, "serializeHits"), hitCount + 1);
+    ASSERT_EQ(GetFunctionCacheCount(env, "serializeMisses"), missCount);
+
+    // the tasks sharing one serialization each get the function and their own arguments
+    auto function = FunctionCache::GetInstance().GetSerialization(env, func);
+    ASSERT_TRUE(function != nullptr);
+    for (uint32_t i = 0; i < taskNum; i++) {
+        Task* task = CreateSharedFunctionTask(env, function, i);
+        ASSERT_TRUE(DeserializesTo(env, task, i));
+        delete task->currentTaskInfo_;
+        delete task;
+    }
+
+    napi_value emptyLists = NapiHelper::CreateArrayWithLength(env, 0);
+    napi_value argv2[] = { func, emptyLists };
+    result = NativeEngineTest::ExecuteBatch(env, argv2, 2);
+    ASSERT_TRUE(result != nullptr);
+    ASSERT_TRUE(NapiHelper::GetArrayLength(env, result) == 0);
+
+    napi_value argv3[] = { func, func };
+    result = NativeEngineTest::ExecuteBatch(env, argv3, 2);
+    ASSERT_TRUE(result == nullptr);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest418, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value func = nullptr;
+    GetSendableFunction(env, "foo", func);
+    auto function = FunctionCache::GetInstance().GetSerialization(env, func);
+    ASSERT_TRUE(function != nullptr);
+    Task* pendingTask = CreateSharedFunctionTask(env, function, 1);
+
+    // the data is released with the env although a task still holds it, the task fails instead of using it
+    NativeEngineTest::RemoveFunctionCacheEnv(env);
+    ASSERT_TRUE(function->data == nullptr);
+    napi_value taskFunc = nullptr;
+    napi_value taskArgs = nullptr;
+    ASSERT_TRUE(pendingTask->DeserializeValue(env, &taskFunc, &taskArgs) != nullptr);
+    delete pendingTask->currentTaskInfo_;
+    delete pendingTask;
+
+    // the function is serialized again and gives the right results
+    int64_t missCount = GetFunctionCacheCount(env, "serializeMisses");
+    auto newFunction = FunctionCache::GetInstance().GetSerialization(env, func);
+    ASSERT_TRUE(newFunction != nullptr && newFunction->data != nullptr);
+    ASSERT_TRUE(newFunction->id != function->id);
+    ASSERT_EQ(GetFunctionCacheCount(env, "serializeMisses"), missCount + 1);
+    Task* task = CreateSharedFunctionTask(env, newFunction, 2); // 2: the argument of the task
+    ASSERT_TRUE(DeserializesTo(env, task, 2)); // 2: the argument of the task
+    delete task->currentTaskInfo_;
+    delete task;
+
+    // an element which is not a task rejects its own promise instead of failing the batch
+    napi_value tasks = NapiHelper::CreateArrayWithLength(env, 1);
+    napi_set_element(env, tasks, 0, NapiHelper::CreateUint32(env, 1));
+    napi_value argv[] = { tasks };
+    napi_value result = NativeEngineTest::ExecuteBatch(env, argv, 1);
+    ASSERT_TRUE(result != nullptr);
+    ASSERT_TRUE(NapiHelper::GetArrayLength(env, result) == 1);
+    bool isPromise = false;
+    napi_is_promise(env, NapiHelper::GetElement(env, result, 0), &isPromise);
+    ASSERT_TRUE(isPromise);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+
+    napi_value argv1[] = { NapiHelper::CreateUint32(env, 1) };
+    result = NativeEngineTest::ExecuteBatch(env, argv1, 1);
+    ASSERT_TRUE(result == nullptr);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest419, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value func = nullptr;
+    GetSendableFunction(env, "foo", func);
+    FunctionCache& functionCache = FunctionCache::GetInstance();
+    auto serialization = functionCache.GetSerialization(env, func);
+    ASSERT_TRUE(serialization != nullptr);
+    // the same function is not serialized again
+    ASSERT_TRUE(functionCache.GetSerialization(env, func) == serialization);
+    // the transfer options are part of the key
+    auto otherSerialization = functionCache.GetSerialization(env, func, false, false);
+    ASSERT_TRUE(otherSerialization != nullptr && otherSerialization != serialization);
+    ASSERT_TRUE(otherSerialization->id != serialization->id);
+
+    napi_value cacheInfo = functionCache.GetCacheInfo(env);
+    napi_value serializeHits = NapiHelper::GetNameProperty(env, cacheInfo, "serializeHits");
+    int64_t hitCount = 0;
+    napi_get_value_int64(env, serializeHits, &hitCount);
+    ASSERT_TRUE(hitCount >= 1);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest420, testing::ext::TestSize.Level0)
+{
+    // the default policy keeps the previous heuristic
+    HeuristicThreadCountPolicy heuristic;
+    ThreadCountLoad load;
+    ASSERT_TRUE(heuristic.ComputeSuitableIdleNum(load) == 1);
+    load.nonIdleTaskNum = 10;
+    ASSERT_TRUE(heuristic.ComputeSuitableIdleNum(load) == 2);
+    load.totalExecCount = 1;
+    load.totalExecTime = 50;
+    ASSERT_TRUE(heuristic.ComputeSuitableIdleNum(load) == 5);
+
+    LatencyThreadCountPolicy latency(10);
+    ASSERT_TRUE(latency.GetSlo() == 10);
+    latency.OnTaskExecuted(5);
+    ASSERT_TRUE(latency.GetRunTimeEstimate() == 5);
+    // 10 tasks of 5ms need 5 workers to start within 10ms
+    ASSERT_TRUE(latency.ComputeSuitableIdleNum(load) == 5);
+    // the observed wait is twice the SLO, so the target grows
+    for (uint32_t i = 0; i < 10; i++) {
+        latency.OnTaskDequeued(Priority::HIGH, 20);
+    }
+    ASSERT_TRUE(latency.GetWaitTimeEstimate(Priority::HIGH) == 20);
+    ASSERT_TRUE(latency.GetWaitTimePercentile(Priority::HIGH, 90) == 31);
+    ASSERT_TRUE(latency.ComputeSuitableIdleNum(load) == 10);
+    // idle tasks do not count against the SLO
+    LatencyThreadCountPolicy idleLatency(10);
+    idleLatency.OnTaskExecuted(5);
+    for (uint32_t i = 0; i < 10; i++) {
+        idleLatency.OnTaskDequeued(Priority::IDLE, 1000);
+    }
+    ASSERT_TRUE(idleLatency.ComputeSuitableIdleNum(load) == 5);
+    idleLatency.OnBalance();
+    ASSERT_TRUE(idleLatency.GetWaitTimePercentile(Priority::IDLE, 50) == 1023);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest421, testing::ext::TestSize.Level0)
+{
+    TaskManager& taskManager = TaskManager::GetInstance();
+    auto policy = std::make_shared<LatencyThreadCountPolicy>(20);
+    taskManager.SetThreadCountPolicy(policy);
+    ASSERT_TRUE(taskManager.GetThreadCountPolicy() == policy);
+    taskManager.StoreTaskEnqueueTime(1, ConcurrentHelper::GetCurrentTimeStampWithMS());
+    taskManager.NotifyTaskDequeued(1, Priority::MEDIUM);
+    ASSERT_TRUE(taskManager.GetTaskEnqueueTime(1) == "");
+    taskManager.SetThreadCountPolicy(nullptr);
+    ASSERT_TRUE(std::string(taskManager.GetThreadCountPolicy()->GetName()) == "heuristic");
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest422, testing::ext::TestSize.Level0)
+{
+    TaskTable taskTable;
+    Task* task = new Task();
+    Task* task2 = new Task();
+    uint32_t taskId = taskTable.Insert(task);
+    ASSERT_TRUE(taskId != 0);
+    ASSERT_TRUE(taskTable.Find(taskId) == task);
+    ASSERT_TRUE(taskTable.Find(0) == nullptr);
+    ASSERT_TRUE(taskTable.Erase(taskId) == task);
+    ASSERT_TRUE(taskTable.Erase(taskId) == nullptr);
+    // the erased task is not read to be checked
+    ASSERT_TRUE(taskTable.Find(taskId) == nullptr);
+    // the slot is reused with a new generation, the stale taskId does not find the new task
+    uint32_t taskId2 = taskTable.Insert(task2);
+    ASSERT_TRUE(taskId2 != taskId);
+    ASSERT_TRUE(taskTable.Find(taskId) == nullptr);
+    ASSERT_TRUE(taskTable.Find(taskId2) == task2);
+
+    uint32_t overflowId = 1 | TaskTable::OVERFLOW_FLAG;
+    ASSERT_TRUE(taskTable.InsertOverflow(overflowId, task));
+    ASSERT_FALSE(taskTable.InsertOverflow(overflowId, task));
+    ASSERT_TRUE(taskTable.Find(overflowId) == task);
+    ASSERT_TRUE(taskTable.GetTaskNum() == 2);
+    uint32_t visited = 0;
+    taskTable.ForEach([&visited](Task*) {
+        visited++;
+    });
+    ASSERT_TRUE(visited == 2);
+    ASSERT_TRUE(taskTable.Erase(overflowId) == task);
+    ASSERT_TRUE(taskTable.Erase(taskId2) == task2);
+    ASSERT_TRUE(taskTable.GetTaskNum() == 0);
+    delete task;
+    delete task2;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest423, testing::ext::TestSize.Level0)
+{
+    // contention benchmark, 16 threads submit, look up and complete tasks
+    constexpr uint32_t threadCount = 16;
+    constexpr uint32_t roundCount = 20000;
+    constexpr uint32_t lookupCount = 4; // 4: lookups per task, as in enqueue, perform and result handling
+    TaskManager& taskManager = TaskManager::GetInstance();
+    std::atomic<uint32_t> failedCount = 0;
+    std::vector<std::thread> threads;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&taskManager, &failedCount] {
+            Task* task = new Task();
+            for (uint32_t round = 0; round < roundCount; round++) {
+                taskManager.StoreTask(task);
+                uint32_t taskId = task->taskId_;
+                for (uint32_t lookup = 0; lookup < lookupCount; lookup++) {
+                    if (taskManager.GetTask(taskId) != task) {
+                        failedCount++;
+                    }
+                }
+                if (taskManager.GetTaskForPerform(taskId) != task) {
+                    failedCount++;
+                }
+                taskManager.RemoveRunningTask(taskId);
+                if (!taskManager.RemoveTask(taskId) || taskManager.GetTask(taskId) != nullptr) {
+                    failedCount++;
+                }
+            }
+            delete task;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    HILOG_INFO("taskpool:: task table benchmark, threads:%{public}u, tasks:%{public}u, cost:%{public}lld us",
+        threadCount, threadCount * roundCount, static_cast<long long>(cost.count()));
+    ASSERT_TRUE(failedCount == 0);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest424, testing::ext::TestSize.Level0)
+{
+    TaskEventRing ring;
+    TaskEvent event;
+    for (uint32_t i = 1; i <= TaskEventRing::CAPACITY + 10; i++) { // 10: overwrite the oldest 10 events
+        event.taskId = i;
+        event.workerId = 1;
+        event.priority = Priority::LOW;
+        event.timestamp = i;
+        ring.Push(event);
+    }
+    ASSERT_TRUE(ring.GetPendingNum() == TaskEventRing::CAPACITY);
+    std::vector<TaskEvent> events;
+    ring.Take(events, TaskEventRing::CAPACITY);
+    ASSERT_TRUE(events.size() == TaskEventRing::CAPACITY);
+    ASSERT_TRUE(events.front().taskId == 11);
+    ASSERT_TRUE(events.back().taskId == TaskEventRing::CAPACITY + 10);
+    ASSERT_TRUE(events.back().priority == Priority::LOW);
+    ASSERT_TRUE(ring.GetPendingNum() == 0);
+
+    LogManager logManager;
+    TaskEventRing* eventRing = logManager.AcquireEventRing();
+    ASSERT_TRUE(eventRing != nullptr);
+    ASSERT_FALSE(logManager.RecordTaskEvent(eventRing, TaskEventType::PERFORM, 1, Priority::HIGH, 1));
+    ASSERT_FALSE(logManager.IsEmpty());
+    logManager.PrintLog();
+    ASSERT_TRUE(logManager.IsEmpty());
+    logManager.ReleaseEventRing(eventRing);
+    // the released ring is reused
+    ASSERT_TRUE(logManager.AcquireEventRing() == eventRing);
+    logManager.ReleaseEventRing(eventRing);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest425, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    DependencyGraph graph;
+    std::set<uint32_t> dependIds{2, 3};
+    ASSERT_TRUE(graph.AddDependencies(1, dependIds));
+    ASSERT_TRUE(graph.HasPredecessor(1));
+    ASSERT_TRUE(graph.HasSuccessor(2));
+    ASSERT_FALSE(graph.HasPredecessor(2));
+    // 2 depending on 1 closes a cycle, nothing of the failed call is kept
+    std::set<uint32_t> cycleIds{1, 4};
+    ASSERT_FALSE(graph.AddDependencies(2, cycleIds));
+    ASSERT_TRUE(graph.GetNodeNum() == 3);
+    ASSERT_TRUE(graph.GetDependInfo(1) == " 2 3");
+    ASSERT_TRUE(graph.TryPark(1, Priority::LOW));
+    ASSERT_FALSE(graph.TryPark(2, Priority::LOW));
+    ASSERT_TRUE(graph.Complete(2).empty());
+    auto readyTasks = graph.Complete(3);
+    ASSERT_TRUE(readyTasks.size() == 1);
+    ASSERT_TRUE(readyTasks[0].first == 1);
+    ASSERT_TRUE(readyTasks[0].second == Priority::LOW);
+    ASSERT_TRUE(graph.GetNodeNum() == 0);
+
+    // the task pending on its dependency is not put into the queue until the dependency finishes
+    TaskManager& taskManager = TaskManager::GetInstance();
+    Task* task = new Task();
+    task->env_ = env;
+    taskManager.StoreTask(task);
+    uint32_t dependId = 425; // 425: not an id of the task table
+    std::set<uint32_t> taskIds{dependId};
+    ASSERT_TRUE(taskManager.StoreTaskDependency(task->taskId_, taskIds));
+    taskManager.EnqueueTaskId(task->taskId_, Priority::LOW);
+    ASSERT_FALSE(taskManager.EraseWaitingTaskId(task->taskId_, Priority::LOW));
+    taskManager.NotifyDependencyTaskInfo(dependId);
+    ASSERT_FALSE(taskManager.IsDependendByTaskId(task->taskId_));
+    ASSERT_TRUE(taskManager.EraseWaitingTaskId(task->taskId_, Priority::LOW));
+    taskManager.RemoveTask(task->taskId_);
+    delete task;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest426, testing::ext::TestSize.Level0)
+{
+    // dependency benchmark on 10k nodes: build a chain, check a cycle against it, then run it down
+    constexpr uint32_t nodeCount = 10000;
+    DependencyGraph graph;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 1; i < nodeCount; i++) {
+        std::set<uint32_t> dependIds{i};
+        ASSERT_TRUE(graph.AddDependencies(i + 1, dependIds));
+    }
+    auto buildCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    std::set<uint32_t> cycleIds{nodeCount};
+    ASSERT_FALSE(graph.AddDependencies(1, cycleIds));
+    // a fan-in on top of the chain
+    std::set<uint32_t> fanIds;
+    for (uint32_t i = 1; i <= nodeCount; i++) {
+        fanIds.insert(i);
+    }
+    ASSERT_TRUE(graph.AddDependencies(nodeCount + 1, fanIds));
+    ASSERT_TRUE(graph.GetNodeNum() == nodeCount + 1);
+    for (uint32_t i = 2; i <= nodeCount + 1; i++) {
+        ASSERT_TRUE(graph.TryPark(i, Priority::DEFAULT));
+    }
+    uint32_t readyNum = 0;
+    for (uint32_t i = 1; i <= nodeCount; i++) {
+        readyNum += graph.Complete(i).size();
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    HILOG_INFO("taskpool:: dependency benchmark, nodes:%{public}u, build:%{public}lld us, total:%{public}lld us",
+        nodeCount, static_cast<long long>(buildCost.count()), static_cast<long long>(cost.count()));
+    ASSERT_TRUE(readyNum == nodeCount);
+    ASSERT_TRUE(graph.GetNodeNum() == 0);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest427, testing::ext::TestSize.Level0)
+{
+    // 0 chunkSize splits the length into 4 chunks per thread
+    ASSERT_TRUE(ParallelGroup::GetChunkSize(100, 0, 5) == 5);
+    ASSERT_TRUE(ParallelGroup::GetChunkSize(3, 0, 8) == 1);
+    ASSERT_TRUE(ParallelGroup::GetChunkSize(0, 0, 0) == 1);
+    ASSERT_TRUE(ParallelGroup::GetChunkSize(100, 7, 5) == 7);
+    ASSERT_TRUE(ParallelGroup::GetChunkNum(100, 7) == 15);
+    ASSERT_TRUE(ParallelGroup::GetChunkNum(0, 7) == 0);
+    ASSERT_TRUE(ParallelGroup::GetChunkNum(UINT32_MAX, UINT32_MAX) == 1);
+
+    napi_env env = (napi_env)engine_;
+    TaskGroup taskGroup(env);
+    for (uint32_t taskId = 100; taskId < 110; taskId++) {
+        taskGroup.taskIds_.push_back(taskId);
+    }
+    ASSERT_TRUE(taskGroup.GetTaskIndex(100) == 0);
+    ASSERT_TRUE(taskGroup.GetTaskIndex(109) == 9);
+    ASSERT_TRUE(taskGroup.GetTaskIndex(1) == 10);
+    // the index follows the tasks added later
+    taskGroup.taskIds_.push_back(1);
+    ASSERT_TRUE(taskGroup.GetTaskIndex(1) == 10);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest428, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    // 5 chunks: the levels have 5, 3, 2 and 1 values
+    ParallelGroup group(env, 5, Priority::DEFAULT);
+    group.SetReduceFunction("add", std::make_shared<FunctionSerialization>(env, nullptr));
+    ASSERT_TRUE(group.IsMapReduce());
+    ASSERT_TRUE(NativeEngineTest::GetParallelGroupLevelNum(group) == 4);
+    napi_value promise = NapiHelper::CreatePromise(env, NativeEngineTest::GetParallelGroupDeferred(group));
+    ASSERT_TRUE(promise != nullptr);
+
+    ParallelGroup::Slot slot {0, 1};
+    auto pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 1));
+    ASSERT_TRUE(pair.first == nullptr);
+    // the last chunk of an odd level moves up until it has a neighbour
+    slot = {0, 4};
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 4));
+    ASSERT_TRUE(pair.first == nullptr);
+    ASSERT_TRUE(NativeEngineTest::GetParallelGroupValue(group, 2, 1) != nullptr);
+    // the values keep the order of the chunks
+    slot = {0, 0};
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 0));
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.first) == 0);
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.second) == 1);
+    ASSERT_TRUE(slot == ParallelGroup::Slot(1, 0));
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 100));
+    ASSERT_TRUE(pair.first == nullptr);
+    slot = {0, 3};
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 3));
+    ASSERT_TRUE(pair.first == nullptr);
+    slot = {0, 2};
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 2));
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.first) == 2);
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.second) == 3);
+    ASSERT_TRUE(slot == ParallelGroup::Slot(1, 1));
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 200));
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.first) == 100);
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.second) == 200);
+    ASSERT_TRUE(slot == ParallelGroup::Slot(2, 0));
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 300));
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.first) == 300);
+    ASSERT_TRUE(NapiHelper::GetUint32Value(env, pair.second) == 4);
+    ASSERT_TRUE(slot == ParallelGroup::Slot(3, 0));
+    // the root settles the group
+    pair = group.UpdateSlot(env, slot, NapiHelper::CreateUint32(env, 304));
+    ASSERT_TRUE(pair.first == nullptr);
+    ASSERT_TRUE(group.IsSettled());
+    ASSERT_TRUE(group.IsFinished());
+    group.StoreTaskSlot(1, slot);
+    ASSERT_FALSE(group.IsFinished());
+    ASSERT_TRUE(group.TakeTaskSlot(1) == slot);
+    ASSERT_TRUE(group.IsFinished());
+    group.ReleaseData(env);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest429, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value func = nullptr;
+    GetSendableFunction(env, "foo", func);
+    napi_value argv[] = { NapiHelper::CreateUint32(env, 100), NapiHelper::CreateUint32(env, 0), func };
+    napi_value result = NativeEngineTest::ParallelFor(env, argv, 3);
+    bool isPromise = false;
+    napi_is_promise(env, result, &isPromise);
+    ASSERT_TRUE(isPromise);
+
+    napi_value emptyRange = NapiHelper::CreateObject(env);
+    napi_set_named_property(env, emptyRange, "start", NapiHelper::CreateUint32(env, 10));
+    napi_set_named_property(env, emptyRange, "end", NapiHelper::CreateUint32(env, 10));
+    napi_value argv1[] = { emptyRange, NapiHelper::CreateUint32(env, 3), func };
+    result = NativeEngineTest::ParallelFor(env, argv1, 3);
+    ASSERT_TRUE(result != nullptr);
+
+    napi_value array = NapiHelper::CreateArrayWithLength(env, 10);
+    for (uint32_t i = 0; i < 10; i++) {
+        napi_set_element(env, array, i, NapiHelper::CreateUint32(env, i));
+    }
+    napi_value argv2[] = { array, func, func, NapiHelper::CreateUint32(env, 3) };
+    result = NativeEngineTest::MapReduce(env, argv2, 4);
+    isPromise = false;
+    napi_is_promise(env, result, &isPromise);
+    ASSERT_TRUE(isPromise);
+
+    napi_value invalidRange = NapiHelper::CreateObject(env);
+    napi_set_named_property(env, invalidRange, "start", NapiHelper::CreateUint32(env, 10));
+    napi_set_named_property(env, invalidRange, "end", NapiHelper::CreateUint32(env, 1));
+    napi_value argv3[] = { invalidRange, NapiHelper::CreateUint32(env, 3), func };
+    result = NativeEngineTest::ParallelFor(env, argv3, 3);
+    ASSERT_TRUE(result == nullptr);
+    napi_value exception = nullptr;
+    napi_get_and_clear_last_exception(env, &exception);
+
+    napi_value argv4[] = { array, func, NapiHelper::CreateUint32(env, 1) };
+    result = NativeEngineTest::MapReduce(env, argv4, 3);
+    ASSERT_TRUE(result == nullptr);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest430, testing::ext::TestSize.Level0)
+{
+    DeadlineQueue queue;
+    ASSERT_TRUE(queue.IsEmpty());
+    ASSERT_EQ(queue.GetFirstDeadline(), UINT64_MAX);
+    ASSERT_EQ(queue.DequeueTaskId().first, 0);
+    queue.EnqueueTaskId(1, Priority::LOW, 300);
+    queue.EnqueueTaskId(2, Priority::HIGH, 100);
+    queue.EnqueueTaskId(3, Priority::MEDIUM, 200);
+    queue.EnqueueTaskId(4, Priority::IDLE, 100);
+    queue.EnqueueTaskId(3, Priority::MEDIUM, 50);
+    ASSERT_EQ(queue.GetTaskNum(), 5);
+    ASSERT_EQ(queue.GetFirstDeadline(), 50);
+    // the earliest entry of task 3 is erased
+    ASSERT_TRUE(queue.EraseWaitingTaskId(3));
+    ASSERT_FALSE(queue.EraseWaitingTaskId(5));
+    ASSERT_EQ(queue.GetFirstDeadline(), 100);
+    // the same deadline keeps the enqueue order
+    auto taskInfo = queue.DequeueTaskId();
+    ASSERT_EQ(taskInfo.first, 2);
+    ASSERT_EQ(taskInfo.second, Priority::HIGH);
+    taskInfo = queue.DequeueTaskId();
+    ASSERT_EQ(taskInfo.first, 4);
+    ASSERT_EQ(taskInfo.second, Priority::IDLE);
+    ASSERT_EQ(queue.DequeueTaskId().first, 3);
+    ASSERT_EQ(queue.DequeueTaskId().first, 1);
+    ASSERT_TRUE(queue.IsEmpty());
+    ASSERT_FALSE(queue.EraseWaitingTaskId(3));
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest431, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    uint32_t baseId = UINT32_MAX - 10;
+    std::vector<uint32_t> expected = { baseId + 2, baseId + 5, baseId + 4, baseId + 1 };
+    std::vector<uint32_t> taskIds = NativeEngineTest::DequeueDeadlineTasks(env);
+    ASSERT_EQ(taskIds, expected);
+
+    napi_value deadlineInfo = TaskManager::GetInstance().GetDeadlineInfo(env);
+    napi_value waitingNum = NapiHelper::GetNameProperty(env, deadlineInfo, "waitingNum");
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, waitingNum), 0);
+    napi_value droppedNum = NapiHelper::GetNameProperty(env, deadlineInfo, "droppedNum");
+    ASSERT_TRUE(NapiHelper::GetUint64Value(env, droppedNum) >= 1);
+    napi_value boostedNum = NapiHelper::GetNameProperty(env, deadlineInfo, "boostedNum");
+    ASSERT_TRUE(NapiHelper::GetUint64Value(env, boostedNum) >= 1);
+    napi_value missedNum = NapiHelper::GetNameProperty(env, deadlineInfo, "missedNum");
+    ASSERT_TRUE(NapiHelper::GetUint64Value(env, missedNum) >= NapiHelper::GetUint64Value(env, droppedNum));
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest432, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value taskValue = GeneratorTask(env, NapiHelper::CreateObject(env));
+    Task* task = nullptr;
+    napi_unwrap(env, taskValue, reinterpret_cast<void**>(&task));
+
+    napi_value options = NapiHelper::CreateObject(env);
+    napi_set_named_property(env, options, "deadline", NapiHelper::CreateUint32(env, 60000));
+    napi_value argv[] = { taskValue, options };
+    napi_value result = NativeEngineTest::Execute(env, argv, 2);
+    ASSERT_NE(result, nullptr);
+    ASSERT_TRUE(task->HasDeadline());
+    TaskManager::GetInstance().EraseWaitingTaskId(task->taskId_, Priority::DEFAULT);
+
+    napi_value invalidOptions = NapiHelper::CreateObject(env);
+    napi_set_named_property(env, invalidOptions, "deadline", NapiHelper::CreateObject(env));
+    napi_value argv1[] = { taskValue, invalidOptions };
+    result = NativeEngineTest::Execute(env, argv1, 2);
+    ASSERT_TRUE(result == nullptr);
+    napi_value exception = nullptr;
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest433, testing::ext::TestSize.Level0)
+{
+    uv_loop_t loop;
+    uv_loop_init(&loop);
+    TimerWheel* wheel = new TimerWheel(&loop);
+    struct FiredTimer {
+        std::vector<uint32_t>* fired;
+        uint32_t id;
+    };
+    std::vector<uint32_t> fired {};
+    FiredTimer timers[] = { {&fired, 1}, {&fired, 2}, {&fired, 3}, {&fired, 4} };
+    auto onTimer = [](void* data) {
+        FiredTimer* timer = static_cast<FiredTimer*>(data);
+        timer->fired->push_back(timer->id);
+    };
+    // 100 ms is beyond the slots of level 0, the timer moves down a level before it fires
+    wheel->AddTimer(100, 0, onTimer, &timers[0]);
+    wheel->AddTimer(10, 0, onTimer, &timers[1]);
+    uint64_t timerId = wheel->AddTimer(20, 0, onTimer, &timers[2]);
+    wheel->AddTimer(30, 0, onTimer, &timers[3]);
+    ASSERT_EQ(wheel->GetTimerNum(), 4U);
+    ASSERT_EQ(wheel->CancelTimer(timerId), &timers[2]);
+    ASSERT_EQ(wheel->CancelTimer(timerId), nullptr);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    std::vector<uint32_t> expected {2, 4, 1};
+    ASSERT_EQ(fired, expected);
+    ASSERT_EQ(wheel->GetTimerNum(), 0U);
+
+    // a periodic timer canceled from its own callback is not fired again
+    struct PeriodicTimer {
+        TimerWheel* wheel;
+        uint64_t timerId;
+        uint32_t count;
+    };
+    PeriodicTimer periodicTimer {wheel, 0, 0};
+    periodicTimer.timerId = wheel->AddTimer(5, 5, [](void* data) {
+        PeriodicTimer* timer = static_cast<PeriodicTimer*>(data);
+        if (++timer->count == 3) { // 3: fired three times
+            timer->wheel->CancelTimer(timer->timerId);
+        }
+    }, &periodicTimer);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    ASSERT_EQ(periodicTimer.count, 3U);
+    ASSERT_EQ(wheel->GetTimerNum(), 0U);
+
+    wheel->Close();
+    uv_run(&loop, UV_RUN_DEFAULT);
+    delete wheel;
+    ASSERT_EQ(uv_loop_close(&loop), 0);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest434, testing::ext::TestSize.Level0)
+{
+    // benchmark: 50k concurrent delayed timers on the timer wheel and on one uv_timer_t each
+    constexpr uint32_t timerNum = 50000;
+    constexpr uint32_t maxDelay = 200; // 200: the delays are spread over 200 ms
+    uint32_t firedNum = 0;
+    auto onFired = [](void* data) {
+        (*static_cast<uint32_t*>(data))++;
+    };
+    uv_loop_t loop;
+    uv_loop_init(&loop);
+    TimerWheel* wheel = new TimerWheel(&loop);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < timerNum; i++) {
+        wheel->AddTimer(i % maxDelay + 1, 0, onFired, &firedNum);
+    }
+    auto addCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    auto wheelCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(firedNum, timerNum);
+    wheel->Close();
+    uv_run(&loop, UV_RUN_DEFAULT);
+    delete wheel;
+
+    firedNum = 0;
+    std::vector<uv_timer_t> handles(timerNum);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < timerNum; i++) {
+        uv_timer_init(&loop, &handles[i]);
+        handles[i].data = &firedNum;
+        uv_timer_start(&handles[i], [](uv_timer_t* handle) {
+            (*static_cast<uint32_t*>(handle->data))++;
+        }, i % maxDelay + 1, 0);
+    }
+    auto uvAddCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    uv_run(&loop, UV_RUN_DEFAULT);
+    auto uvCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(firedNum, timerNum);
+    for (uv_timer_t& handle : handles) {
+        uv_close(reinterpret_cast<uv_handle_t*>(&handle), nullptr);
+    }
+    uv_run(&loop, UV_RUN_DEFAULT);
+    ASSERT_EQ(uv_loop_close(&loop), 0);
+    HILOG_INFO("taskpool:: 50k delayed timers, wheel add %{public}lld us total %{public}lld us, "
+        "uv_timer_t add %{public}lld us total %{public}lld us", static_cast<long long>(addCost.count()),
+        static_cast<long long>(wheelCost.count()), static_cast<long long>(uvAddCost.count()),
+        static_cast<long long>(uvCost.count()));
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest435, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value taskValue = GeneratorTask(env, NapiHelper::CreateObject(env));
+    Task* task = nullptr;
+    napi_unwrap(env, taskValue, reinterpret_cast<void**>(&task));
+    napi_value cb = nullptr;
+    napi_value result = nullptr;
+    std::string funcName = "SetResultTransferList";
+    napi_create_function(env, funcName.c_str(), funcName.size(), Task::SetResultTransferList, nullptr, &cb);
+
+    napi_call_function(env, taskValue, cb, 0, nullptr, &result);
+    ASSERT_TRUE(task->hasResultTransferList_);
+    ASSERT_TRUE(task->resultTransferList_.empty());
+
+    napi_value keys = NapiHelper::CreateArrayWithLength(env, 2);
+    napi_set_element(env, keys, 0, NapiHelper::CreateUint32(env, 1));
+    napi_value key = nullptr;
+    napi_create_string_utf8(env, "pixels", NAPI_AUTO_LENGTH, &key);
+    napi_set_element(env, keys, 1, key);
+    napi_value argv[] = { keys };
+    napi_call_function(env, taskValue, cb, 1, argv, &result);
+    std::vector<std::string> expected {"1", "pixels"};
+    ASSERT_EQ(task->resultTransferList_, expected);
+
+    napi_value exception = nullptr;
+    napi_value invalidKeys = NapiHelper::CreateArrayWithLength(env, 1);
+    napi_set_element(env, invalidKeys, 0, NapiHelper::CreateObject(env));
+    napi_value argv1[] = { invalidKeys };
+    napi_call_function(env, taskValue, cb, 1, argv1, &result);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+    ASSERT_EQ(task->resultTransferList_, expected);
+
+    exception = nullptr;
+    napi_value argv2[] = { keys, keys };
+    napi_call_function(env, taskValue, cb, 2, argv2, &result);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest436, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    ASSERT_TRUE(taskManager.IsResultTransfer());
+    napi_value argv[] = { NapiHelper::CreateBooleanValue(env, false) };
+    NativeEngineTest::SetResultTransferMode(env, argv, 1);
+    ASSERT_FALSE(taskManager.IsResultTransfer());
+
+    napi_value exception = nullptr;
+    napi_value argv1[] = { NapiHelper::CreateUint32(env, 1) };
+    NativeEngineTest::SetResultTransferMode(env, argv1, 1);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+    ASSERT_FALSE(taskManager.IsResultTransfer());
+
+    napi_value info = NativeEngineTest::GetTaskPoolInfo(env, nullptr, 0);
+    napi_value resultTransferInfo = NapiHelper::GetNameProperty(env, info, "resultTransferInfo");
+    napi_value isTransfer = NapiHelper::GetNameProperty(env, resultTransferInfo, "isTransfer");
+    ASSERT_FALSE(NapiHelper::GetBooleanValue(env, isTransfer));
+
+    napi_value argv2[] = { NapiHelper::CreateBooleanValue(env, true) };
+    NativeEngineTest::SetResultTransferMode(env, argv2, 1);
+    ASSERT_TRUE(taskManager.IsResultTransfer());
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest437, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    // { pixels: ArrayBuffer(16), view: Uint8Array over ArrayBuffer(8), width: 4 }
+    napi_value result = NapiHelper::CreateObject(env);
+    void* data = nullptr;
+    napi_value pixels = nullptr;
+    napi_create_arraybuffer(env, 16, &data, &pixels);
+    napi_set_named_property(env, result, "pixels", pixels);
+    napi_value viewBuffer = nullptr;
+    napi_create_arraybuffer(env, 8, &data, &viewBuffer);
+    napi_value view = nullptr;
+    napi_create_typedarray(env, napi_uint8_array, 8, viewBuffer, 0, &view);
+    napi_set_named_property(env, result, "view", view);
+    napi_set_named_property(env, result, "width", NapiHelper::CreateUint32(env, 4));
+
+    size_t byteLength = 0;
+    ASSERT_EQ(NativeEngineTest::CollectResultBuffers(env, result, byteLength), 2U);
+    ASSERT_EQ(byteLength, 24U);
+    ASSERT_EQ(NativeEngineTest::CollectResultBuffers(env, view, byteLength), 1U);
+    ASSERT_EQ(byteLength, 8U);
+    ASSERT_EQ(NativeEngineTest::CollectResultBuffers(env, NapiHelper::CreateUint32(env, 4), byteLength), 0U);
+
+    Task* task = new Task();
+    ASSERT_EQ(NativeEngineTest::GetResultTransferNum(env, task, result), 0U);
+    task->resultTransferList_ = {"pixels", "width", "missing"};
+    ASSERT_EQ(NativeEngineTest::GetResultTransferNum(env, task, result), 1U);
+    ASSERT_EQ(NativeEngineTest::GetResultTransferNum(env, task, pixels), 1U);
+    delete task;
+
+    // nothing is serialized here, so the buffers are still attached and count as copied
+    auto getBytes = [env](const char* name) {
+        napi_value info = NativeEngineTest::GetTaskPoolInfo(env, nullptr, 0);
+        napi_value resultTransferInfo = NapiHelper::GetNameProperty(env, info, "resultTransferInfo");
+        int64_t bytes = 0;
+        napi_get_value_int64(env, NapiHelper::GetNameProperty(env, resultTransferInfo, name), &bytes);
+        return bytes;
+    };
+    int64_t copiedBytes = getBytes("copiedBytes");
+    int64_t transferredBytes = getBytes("transferredBytes");
+    NativeEngineTest::RecordResultBytes(env, result);
+    ASSERT_EQ(getBytes("copiedBytes"), copiedBytes + 24);
+    ASSERT_EQ(getBytes("transferredBytes"), transferredBytes);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest438, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    Task* task = new Task();
+    taskManager.StoreTask(task);
+    // the receiver counts its calls in calls[0] and keeps the argc of the last call in calls[1]
+    uint32_t calls[2] = {0, 0};
+    auto receiver = [](napi_env environment, napi_callback_info info) -> napi_value {
+        size_t argc = 0;
+        void* data = nullptr;
+        napi_get_cb_info(environment, info, &argc, nullptr, nullptr, &data);
+        uint32_t* counter = static_cast<uint32_t*>(data);
+        counter[0]++;
+        counter[1] = static_cast<uint32_t>(argc);
+        return nullptr;
+    };
+    napi_value func = nullptr;
+    napi_create_function(env, "receiver", NAPI_AUTO_LENGTH, receiver, calls, &func);
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    auto serializeBatch = [env, undefined]() {
+        std::vector<void*> batch {};
+        for (uint32_t i = 0; i < 3; i++) { // 3: messages in the batch
+            napi_value argsArray = NapiHelper::CreateArrayWithLength(env, 2); // 2: sendData(i, i)
+            napi_set_element(env, argsArray, 0, NapiHelper::CreateUint32(env, i));
+            napi_set_element(env, argsArray, 1, NapiHelper::CreateUint32(env, i));
+            void* serializationArgs = nullptr;
+            napi_serialize_inner(env, argsArray, undefined, undefined, true, false, &serializationArgs);
+            batch.push_back(serializationArgs);
+        }
+        return batch;
+    };
+
+    auto callbackInfo = std::make_shared<CallbackInfo>(env, 1, NapiHelper::CreateReference(env, func, 1));
+    taskManager.RegisterCallback(env, task->taskId_, callbackInfo, "TaskpoolTest438");
+    ASSERT_TRUE(taskManager.HasSendDataCallback(task->taskId_));
+    taskManager.IncreaseSendDataRefCount(task->taskId_);
+    NativeEngineTest::ExecuteOnReceiveDataCallback(new TaskResultInfo(env, task->taskId_, serializeBatch()));
+    ASSERT_EQ(calls[0], 3U);
+    ASSERT_EQ(calls[1], 2U);
+
+    calls[0] = 0;
+    callbackInfo->isBatch = true;
+    taskManager.IncreaseSendDataRefCount(task->taskId_);
+    NativeEngineTest::ExecuteOnReceiveDataCallback(new TaskResultInfo(env, task->taskId_, serializeBatch()));
+    ASSERT_EQ(calls[0], 1U);
+    ASSERT_EQ(calls[1], 1U);
+
+    taskManager.RegisterCallback(env, task->taskId_, nullptr, "TaskpoolTest438");
+    ASSERT_FALSE(taskManager.HasSendDataCallback(task->taskId_));
+    taskManager.RemoveTask(task->taskId_);
+    delete task;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest439, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    Task* task = new Task();
+    taskManager.StoreTask(task);
+    // the first message is posted at once, the task has no host env so it is dropped
+    task->AppendSendData(env, nullptr);
+    ASSERT_TRUE(task->sendDataBatch_.empty());
+    task->FlushSendData(env);
+    ASSERT_TRUE(task->sendDataBatch_.empty());
+    napi_value exception = nullptr;
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_TRUE(exception == nullptr);
+    taskManager.RemoveTask(task->taskId_);
+    delete task;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest440, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    uint32_t moduleNum = taskManager.GetPreloadModuleNum();
+    // no worker is created for 0 workers, a module given twice is loaded once
+    taskManager.Prewarm(0, {"TaskpoolTest440A", "TaskpoolTest440B", "TaskpoolTest440A", ""});
+    ASSERT_EQ(taskManager.GetPreloadModuleNum(), moduleNum + 2);
+    std::vector<std::string> modules = taskManager.GetPreloadModules(moduleNum);
+    ASSERT_EQ(modules.size(), 2U);
+    ASSERT_EQ(modules[0], "TaskpoolTest440A");
+    ASSERT_EQ(modules[1], "TaskpoolTest440B");
+    ASSERT_TRUE(taskManager.GetPreloadModules(moduleNum + 2).empty());
+    ASSERT_EQ(NativeEngineTest::PreloadModules(env), moduleNum + 2);
+
+    taskManager.RecordWorkerStartupTime(12);
+    napi_value info = NativeEngineTest::GetTaskPoolInfo(env, nullptr, 0);
+    napi_value prewarmInfo = NapiHelper::GetNameProperty(env, info, "prewarmInfo");
+    napi_value num = NapiHelper::GetNameProperty(env, prewarmInfo, "moduleNum");
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, num), moduleNum + 2);
+    napi_value startupTime = NapiHelper::GetNameProperty(env, prewarmInfo, "workerStartupTime");
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, startupTime), 12U);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest441, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    napi_value exception = nullptr;
+    napi_value argv[] = { NapiHelper::CreateUint32(env, 1) };
+    NativeEngineTest::Prewarm(env, argv, 1);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+
+    napi_value options = NapiHelper::CreateObject(env);
+    napi_set_named_property(env, options, "workers", NapiHelper::CreateInt32(env, -1));
+    napi_value argv1[] = { options };
+    exception = nullptr;
+    NativeEngineTest::Prewarm(env, argv1, 1);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+
+    uint32_t moduleNum = taskManager.GetPreloadModuleNum();
+    options = NapiHelper::CreateObject(env);
+    napi_value modules = NapiHelper::CreateArrayWithLength(env, 2); // 2: a module and a number
+    napi_value module = nullptr;
+    std::string moduleName = "TaskpoolTest441";
+    napi_create_string_utf8(env, moduleName.c_str(), moduleName.size(), &module);
+    napi_set_element(env, modules, 0, module);
+    napi_set_element(env, modules, 1, NapiHelper::CreateUint32(env, 1));
+    napi_set_named_property(env, options, "modules", modules);
+    napi_value argv2[] = { options };
+    exception = nullptr;
+    NativeEngineTest::Prewarm(env, argv2, 1);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_NE(exception, nullptr);
+    ASSERT_EQ(taskManager.GetPreloadModuleNum(), moduleNum);
+
+    napi_set_element(env, modules, 1, module);
+    napi_set_named_property(env, options, "workers", NapiHelper::CreateUint32(env, 0));
+    exception = nullptr;
+    NativeEngineTest::Prewarm(env, argv2, 1);
+    napi_get_and_clear_last_exception(env, &exception);
+    ASSERT_EQ(exception, nullptr);
+    ASSERT_EQ(taskManager.GetPreloadModuleNum(), moduleNum + 1);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest442, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    std::vector<uint32_t> result = NativeEngineTest::EnqueueAffinityTasks(env);
+    // idle: bound and dequeued by the worker, busy: dispatched globally, detached: never bound again
+    std::vector<uint32_t> expected = {1, 1, 0, 1, 0, 1, 0, 1};
+    ASSERT_EQ(result, expected);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest443, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    SequenceRunner* seqRunner = new SequenceRunner(Priority::DEFAULT);
+    Task* task = new Task();
+    Worker* worker = reinterpret_cast<Worker*>(0x1000); // 0x1000: only compared, never dereferenced
+    task->worker_ = worker;
+    seqRunner->UpdateAffinityWorker(task);
+    ASSERT_EQ(seqRunner->GetAffinityWorker(), nullptr);
+
+    seqRunner->isAffinity_ = true;
+    seqRunner->affinityIdleTimeout_ = 1000; // 1000: ms
+    seqRunner->UpdateAffinityWorker(task);
+    ASSERT_EQ(seqRunner->GetAffinityWorker(), worker);
+    // a canceled task has no worker, the runner stays bound
+    task->worker_ = nullptr;
+    seqRunner->UpdateAffinityWorker(task);
+    ASSERT_EQ(seqRunner->GetAffinityWorker(), worker);
+    // idle for longer than the timeout
+    seqRunner->affinityTime_ = ConcurrentHelper::GetMilliseconds() - 2000; // 2000: ms
+    ASSERT_EQ(seqRunner->GetAffinityWorker(), nullptr);
+    ASSERT_EQ(seqRunner->affinityWorker_, nullptr);
+    delete task;
+    delete seqRunner;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest444, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    AsyncRunner* asyncRunner = new AsyncRunner();
+    void* async = reinterpret_cast<void*>(asyncRunner);
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 0));
+    asyncRunner->rate_ = 2; // 2: tasks per second
+    asyncRunner->burst_ = 2; // 2: burst
+    asyncRunner->tokens_ = 2; // 2: a full bucket
+    asyncRunner->refillTime_ = 1000; // 1000: ms
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 1000));
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 1000));
+    ASSERT_FALSE(NativeEngineTest::TakeRateToken(async, 1000));
+    // 0.8 token after 400 ms
+    ASSERT_FALSE(NativeEngineTest::TakeRateToken(async, 1400));
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 1600));
+    // the bucket holds no more than the burst however long it is idle
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 60000));
+    ASSERT_TRUE(NativeEngineTest::TakeRateToken(async, 60000));
+    ASSERT_FALSE(NativeEngineTest::TakeRateToken(async, 60000));
+    delete asyncRunner;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest445, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    AsyncRunner* asyncRunner = new AsyncRunner();
+    asyncRunner->runningCapacity_ = 2; // 2: running capacity
+    asyncRunner->waitingCapacity_ = 2; // 2: waiting capacity
+    asyncRunner->rate_ = 1;
+    asyncRunner->burst_ = 1;
+    asyncRunner->tokens_ = 1;
+    asyncRunner->refillTime_ = UINT64_MAX; // no refill during the test
+    asyncRunner->highWatermark_ = 2; // 2: backpressure at two waiting tasks
+    asyncRunner->IncreaseCount();
+    void* async = reinterpret_cast<void*>(asyncRunner);
+    std::vector<Task*> tasks {};
+    for (uint32_t i = 0; i < 4; i++) { // 4: one runs, two wait for a token, one discards the first waiting
+        Task* task = new Task();
+        tasks.push_back(task);
+        NativeEngineTest::AddTasksToAsyncRunner(async, reinterpret_cast<void*>(task));
+    }
+    ASSERT_EQ(asyncRunner->runningCount_, 1);
+    ASSERT_EQ(asyncRunner->tasks_.size(), 2);
+    ASSERT_EQ(asyncRunner->tasks_.front(), tasks[2]);
+    ASSERT_TRUE(asyncRunner->isBackpressured_);
+
+    napi_value runnerInfo = asyncRunner->GetRunnerInfo(env);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "runningNum")), 1);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "waitingNum")), 2);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "maxWaitingNum")), 2);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "discardedNum")), 1);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "rateLimitedNum")), 3);
+    ASSERT_EQ(NapiHelper::GetUint32Value(env, NapiHelper::GetNameProperty(env, runnerInfo, "backpressureNum")), 1);
+
+    // drained once the waiting queue is down to the low watermark
+    asyncRunner->RemoveWaitingTask(tasks[2]);
+    asyncRunner->CheckWatermarks();
+    ASSERT_TRUE(asyncRunner->isBackpressured_);
+    asyncRunner->RemoveWaitingTask(tasks[3]);
+    asyncRunner->CheckWatermarks();
+    ASSERT_FALSE(asyncRunner->isBackpressured_);
+    ASSERT_EQ(asyncRunner->backpressureNum_, 1);
+    for (Task* task : tasks) {
+        delete task;
+    }
+    delete asyncRunner;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest446, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value asyncGlobal = NapiHelper::CreateObject(env);
+    std::string conName = "AsyncRunnerConstructor446";
+    napi_value constructor = nullptr;
+    napi_value asyncResult = nullptr;
+    napi_create_function(env, conName.c_str(), conName.size(), AsyncRunner::AsyncRunnerConstructor, nullptr,
+                         &constructor);
+    napi_value runningCapacity = NapiHelper::CreateUint32(env, 1);
+    napi_call_function(env, asyncGlobal, constructor, 1, &runningCapacity, &asyncResult);
+    AsyncRunner* asyncRunner = nullptr;
+    napi_unwrap(env, asyncGlobal, reinterpret_cast<void**>(&asyncRunner));
+    ASSERT_NE(asyncRunner, nullptr);
+
+    napi_value setRateLimit = nullptr;
+    napi_create_function(env, "setRateLimit", NAPI_AUTO_LENGTH, AsyncRunner::SetRateLimit, nullptr, &setRateLimit);
+    napi_value result = nullptr;
+    napi_value exception = nullptr;
+    napi_value invalidRate = NapiHelper::CreateInt32(env, -1);
+    napi_call_function(env, asyncGlobal, setRateLimit, 1, &invalidRate, &result);
+    ASSERT_TRUE(NapiHelper::IsExceptionPending(env));
+    napi_get_and_clear_last_exception(env, &exception);
+    napi_value rateArgv[] = {NapiHelper::CreateUint32(env, 5), NapiHelper::CreateUint32(env, 2)};
+    napi_call_function(env, asyncGlobal, setRateLimit, 2, rateArgv, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    ASSERT_EQ(asyncRunner->rate_, 5);
+    ASSERT_EQ(asyncRunner->burst_, 2);
+    ASSERT_EQ(asyncRunner->tokens_, 2);
+
+    napi_value callback = nullptr;
+    GetSendableFunction(env, "foo", callback);
+    napi_value onBackpressure = nullptr;
+    napi_value onDrain = nullptr;
+    napi_create_function(env, "onBackpressure", NAPI_AUTO_LENGTH, AsyncRunner::OnBackpressure, nullptr,
+                         &onBackpressure);
+    napi_create_function(env, "onDrain", NAPI_AUTO_LENGTH, AsyncRunner::OnDrain, nullptr, &onDrain);
+    napi_value drainArgv[] = {NapiHelper::CreateUint32(env, 1), callback};
+    napi_call_function(env, asyncGlobal, onDrain, 2, drainArgv, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    // the high watermark has to be above the low one
+    napi_value backpressureArgv[] = {NapiHelper::CreateUint32(env, 1), callback};
+    napi_call_function(env, asyncGlobal, onBackpressure, 2, backpressureArgv, &result);
+    ASSERT_TRUE(NapiHelper::IsExceptionPending(env));
+    napi_get_and_clear_last_exception(env, &exception);
+    backpressureArgv[0] = NapiHelper::CreateUint32(env, 3);
+    napi_call_function(env, asyncGlobal, onBackpressure, 2, backpressureArgv, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    ASSERT_EQ(asyncRunner->highWatermark_, 3);
+    ASSERT_EQ(asyncRunner->lowWatermark_, 1);
+    ASSERT_EQ(asyncRunner->backpressureCallbacks_.size(), 1);
+    ASSERT_EQ(asyncRunner->drainCallbacks_.size(), 1);
+
+    napi_value runnerInfos = AsyncRunnerManager::GetInstance().GetAsyncRunnerInfos(env);
+    ASSERT_TRUE(NapiHelper::IsArray(env, runnerInfos));
+    ASSERT_GE(NapiHelper::GetArrayLength(env, runnerInfos), 1);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest447, testing::ext::TestSize.Level0)
+{
+    std::vector<uint32_t> cpus = CpuTopology::ParseCpuList("0-3,6,8-9\n");
+    std::vector<uint32_t> expected = {0, 1, 2, 3, 6, 8, 9};
+    ASSERT_EQ(cpus, expected);
+    expected = {5};
+    ASSERT_EQ(CpuTopology::ParseCpuList("5"), expected);
+    ASSERT_TRUE(CpuTopology::ParseCpuList("").empty());
+    ASSERT_TRUE(CpuTopology::ParseCpuList("3-1").empty());
+    ASSERT_TRUE(CpuTopology::ParseCpuList("0-a").empty());
+    ASSERT_TRUE(CpuTopology::ParseCpuList("0,,1").empty());
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest448, testing::ext::TestSize.Level0)
+{
+    std::string root = CreateFakeCpuRoot("taskpool_cpu_capacity", {160, 160, 160, 160, 480, 480, 1024}, {});
+    CpuTopology capacityTopology(root);
+    ASSERT_TRUE(capacityTopology.IsHeterogeneous());
+    std::vector<uint32_t> expected = {0, 1, 2, 3};
+    ASSERT_EQ(capacityTopology.GetCpus(CoreClass::EFFICIENCY), expected);
+    // the middle cores count as performance cores
+    expected = {4, 5, 6};
+    ASSERT_EQ(capacityTopology.GetCpus(CoreClass::PERFORMANCE), expected);
+    // an unbound worker runs on all the cores
+    expected = {0, 1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(capacityTopology.GetCpus(CoreClass::NONE), expected);
+
+    // the max frequencies rate the cores if some core has no capacity
+    root = CreateFakeCpuRoot("taskpool_cpu_freq", {512, 512, 0, 0}, {1800000, 1800000, 2400000, 2400000});
+    CpuTopology freqTopology(root);
+    ASSERT_TRUE(freqTopology.IsHeterogeneous());
+    expected = {2, 3};
+    ASSERT_EQ(freqTopology.GetCpus(CoreClass::PERFORMANCE), expected);
+
+    root = CreateFakeCpuRoot("taskpool_cpu_same", {1024, 1024}, {});
+    CpuTopology sameTopology(root);
+    ASSERT_FALSE(sameTopology.IsHeterogeneous());
+
+    CpuTopology missingTopology("/nonexistent/taskpool_cpu");
+    ASSERT_FALSE(missingTopology.IsHeterogeneous());
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest449, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value obj = NapiHelper::CreateObject(env);
+    napi_value napiTask = GeneratorTask(env, obj);
+    Task* task = nullptr;
+    napi_unwrap(env, napiTask, reinterpret_cast<void**>(&task));
+    ASSERT_NE(task, nullptr);
+    napi_value setWorkload = NapiHelper::GetNameProperty(env, napiTask, "setWorkload");
+    napi_value result = nullptr;
+    napi_value workload = NapiHelper::CreateUint32(env, 5); // 5: not a workload
+    napi_call_function(env, napiTask, setWorkload, 1, &workload, &result);
+    ASSERT_TRUE(NapiHelper::IsExceptionPending(env));
+    napi_value exception = nullptr;
+    napi_get_and_clear_last_exception(env, &exception);
+    workload = NapiHelper::CreateUint32(env, static_cast<uint32_t>(Workload::COMPUTE));
+    napi_call_function(env, napiTask, setWorkload, 1, &workload, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    ASSERT_EQ(task->workload_, Workload::COMPUTE);
+
+    std::vector<uint32_t> workers = NativeEngineTest::GetCoreClassWorkers(env);
+    std::vector<uint32_t> expected = {1, 0, 0, 0, 1, 0, 0};
+    ASSERT_EQ(workers, expected);
+
+    // a worker is bound only while it runs a task with a workload
+    std::vector<uint32_t> coreClasses = NativeEngineTest::BindCoreClass(env);
+    expected = {static_cast<uint32_t>(CoreClass::PERFORMANCE), static_cast<uint32_t>(CoreClass::NONE),
+        static_cast<uint32_t>(CoreClass::EFFICIENCY), static_cast<uint32_t>(CoreClass::NONE)};
+    ASSERT_EQ(coreClasses, expected);
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest450, testing::ext::TestSize.Level0)
+{
+    // a hot slot gives every taskId of its generations once, then its generation wraps and it stays in use
+    constexpr uint32_t generationNum = (TaskTable::OVERFLOW_FLAG >> TaskTable::INDEX_BITS) - 1;
+    constexpr uint32_t indexMask = (1U << TaskTable::INDEX_BITS) - 1;
+    TaskTable taskTable;
+    Task* task = new Task();
+    std::unordered_set<uint32_t> taskIds {};
+    uint32_t firstId = taskTable.Insert(task);
+    ASSERT_TRUE(taskTable.Erase(firstId) == task);
+    taskIds.insert(firstId);
+    for (uint32_t i = 1; i < generationNum; i++) {
+        uint32_t taskId = taskTable.Insert(task);
+        ASSERT_EQ(taskId & indexMask, firstId & indexMask);
+        ASSERT_TRUE(taskIds.insert(taskId).second);
+        ASSERT_TRUE(taskTable.Find(firstId) == nullptr);
+        ASSERT_TRUE(taskTable.Erase(taskId) == task);
+    }
+    uint32_t nextId = taskTable.Insert(task);
+    ASSERT_EQ(nextId, firstId);
+    ASSERT_TRUE(taskTable.Erase(nextId) == task);
+
+    // the overflow ids follow each other
+    uint32_t overflowId = taskTable.NextOverflowId();
+    ASSERT_TRUE((overflowId & TaskTable::OVERFLOW_FLAG) != 0);
+    ASSERT_EQ(taskTable.NextOverflowId(), overflowId + 1);
+    delete task;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest451, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    TaskManager& taskManager = TaskManager::GetInstance();
+    Task* task = new Task();
+    taskManager.StoreTask(task);
+    // a single message is posted at once, even if the turn sending it keeps running
+    task->AppendSendData(env, nullptr);
+    ASSERT_TRUE(task->sendDataBatch_.empty());
+    // the burst right after it waits in the batch for the host to take it
+    task->AppendSendData(env, nullptr);
+    task->AppendSendData(env, nullptr);
+    ASSERT_EQ(task->sendDataBatch_.size(), 2U);
+    std::vector<void*> batch = task->TakeSendData();
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_TRUE(task->sendDataBatch_.empty());
+    // a turn blocking longer than the interval posts the batch with its next message
+    task->AppendSendData(env, nullptr);
+    usleep(20000); // 20000: us, longer than the 16 ms interval
+    task->AppendSendData(env, nullptr);
+    ASSERT_TRUE(task->sendDataBatch_.empty());
+    taskManager.RemoveTask(task->taskId_);
+    delete task;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest452, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    // the expired task stops its timeout timer and finishes as canceled
+    ASSERT_TRUE(NativeEngineTest::RejectExpiredTask(env));
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest453, testing::ext::TestSize.Level0)
+{
+    // the policy named by the system parameter at launch
+    std::shared_ptr<ThreadCountPolicy> policy = ThreadCountPolicy::Create("latency", 50); // 50: 50ms
+    ASSERT_TRUE(std::string(policy->GetName()) == "latency");
+    ASSERT_EQ(std::static_pointer_cast<LatencyThreadCountPolicy>(policy)->GetSlo(), 50);
+    policy = ThreadCountPolicy::Create("latency", 0);
+    ASSERT_EQ(std::static_pointer_cast<LatencyThreadCountPolicy>(policy)->GetSlo(),
+              LatencyThreadCountPolicy::DEFAULT_SLO);
+    policy = ThreadCountPolicy::Create("unknown", 50); // 50: 50ms
+    ASSERT_TRUE(std::string(policy->GetName()) == "heuristic");
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest454, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    napi_value func = nullptr;
+    GetSendableFunction(env, "foo", func);
+    auto function = FunctionCache::GetInstance().GetSerialization(env, func);
+    ASSERT_TRUE(function != nullptr);
+    Task* task = CreateSharedFunctionTask(env, function, 1);
+    Task* otherTask = CreateSharedFunctionTask(env, function, 2); // 2: the argument of the task
+    function = nullptr;
+    size_t retiredNum = NativeEngineTest::GetRetiredFunctionNum(env);
+    ASSERT_TRUE(NativeEngineTest::RetireFunctionCacheEntry(env, func));
+    ASSERT_EQ(NativeEngineTest::GetRetiredFunctionNum(env), retiredNum + 1);
+
+    // the retired data is kept while a task still holds it and released by the last one
+    ASSERT_TRUE(DeserializesTo(env, task, 1));
+    ASSERT_EQ(NativeEngineTest::GetRetiredFunctionNum(env), retiredNum + 1);
+    ASSERT_TRUE(DeserializesTo(env, otherTask, 2)); // 2: the argument of the task
+    ASSERT_EQ(NativeEngineTest::GetRetiredFunctionNum(env), retiredNum);
+    delete task->currentTaskInfo_;
+    delete task;
+    delete otherTask->currentTaskInfo_;
+    delete otherTask;
+}
+
+HWTEST_F(NativeEngineTest, TaskpoolTest455, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    ExceptionScope scope(env);
+    AsyncRunner* asyncRunner = new AsyncRunner();
+    asyncRunner->runningCapacity_ = 1;
+    asyncRunner->rate_ = 1;
+    asyncRunner->burst_ = 1;
+    asyncRunner->refillTime_ = UINT64_MAX; // no refill during the test
+    asyncRunner->IncreaseCount();
+    void* async = reinterpret_cast<void*>(asyncRunner);
+    Task* task = new Task();
+    NativeEngineTest::AddTasksToAsyncRunner(async, reinterpret_cast<void*>(task));
+    ASSERT_EQ(asyncRunner->tasks_.size(), 1);
+    ASSERT_EQ(asyncRunner->rateLimitedNum_, 1);
+
+    // the task checked again for a token is not counted again, and the env keeps a single rate timer
+    uint32_t timerNum = TimerWheel::GetTimerNum(env);
+    NativeEngineTest::DispatchWaitingTasks(async, env);
+    NativeEngineTest::DispatchWaitingTasks(async, env);
+    ASSERT_EQ(asyncRunner->rateLimitedNum_, 1);
+    ASSERT_EQ(asyncRunner->rateTimers_.size(), 1);
+    ASSERT_EQ(TimerWheel::GetTimerNum(env), timerNum + 1);
+
+    // the pending rate timer and its message are released with the env
+    NativeEngineTest::ReleaseRunnerEnvData(async, env);
+    ASSERT_TRUE(asyncRunner->rateTimers_.empty());
+    ASSERT_EQ(TimerWheel::GetTimerNum(env), timerNum);
+    asyncRunner->RemoveWaitingTask(task);
+    delete task;
+    delete asyncRunner;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_count_policy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+static constexpr int32_t MAX_TASK_DURATION = 100; // 100: 100ms
+static constexpr uint32_t STEP_SIZE = 2;
+static constexpr uint64_t EWMA_SHIFT = 3; // 3: alpha = 1/8
+static constexpr uint32_t WAIT_PERCENTILE = 90; // 90: p90
+static constexpr uint32_t PERCENT = 100;
+static constexpr uint32_t MIN_PERCENTILE_SAMPLES = 8; // 8: use the EWMA until the histogram has enough samples
+
+std::shared_ptr<ThreadCountPolicy> ThreadCountPolicy::Create(const std::string& name, uint64_t slo)
+{
+    if (name == "latency") {
+        return std::make_shared<LatencyThreadCountPolicy>(slo);
+    }
+    return std::make_shared<HeuristicThreadCountPolicy>();
+}
+
+uint32_t HeuristicThreadCountPolicy::ComputeSuitableIdleNum(const ThreadCountLoad& load)
+{
+    uint32_t targetNum = 0;
+    if (load.nonIdleTaskNum != 0 && load.totalExecCount == 0) {
+        // this branch is used for avoiding time-consuming tasks that may block the taskpool
+        targetNum = std::min(STEP_SIZE, load.nonIdleTaskNum);
+    } else if (load.totalExecCount != 0) {
+        auto durationPerTask = static_cast<double>(load.totalExecTime) / load.totalExecCount;
+        uint32_t result = std::ceil(durationPerTask * load.nonIdleTaskNum / MAX_TASK_DURATION);
+        targetNum = std::min(result, load.nonIdleTaskNum);
+    }
+    return targetNum == 0 ? 1 : targetNum;
+}
+
+LatencyThreadCountPolicy::LatencyThreadCountPolicy(uint64_t slo) : slo_(slo == 0 ? DEFAULT_SLO : slo) {}
+
+void LatencyThreadCountPolicy::SetSlo(uint64_t slo)
+{
+    slo_ = slo == 0 ? DEFAULT_SLO : slo;
+}
+
+uint64_t LatencyThreadCountPolicy::GetSlo() const
+{
+    return slo_;
+}
+
+uint32_t LatencyThreadCountPolicy::ComputeSuitableIdleNum(const ThreadCountLoad& load)
+{
+    uint32_t taskNum = load.nonIdleTaskNum;
+    if (taskNum == 0) {
+        return 1;
+    }
+    uint64_t slo = slo_;
+    uint32_t targetNum = 0;
+    if (load.totalExecCount == 0) {
+        // nothing has finished yet, the run time is unknown and the tasks may block the taskpool
+        targetNum = std::min(STEP_SIZE, taskNum);
+    } else {
+        // with n workers the last of the queued tasks waits about taskNum * runTime / n
+        uint64_t result = (GetRunTimeEstimate() * taskNum + slo - 1) / slo;
+        targetNum = static_cast<uint32_t>(std::min<uint64_t>(result, taskNum));
+    }
+    uint64_t waitTime = GetWorstWaitTime();
+    if (waitTime > slo) {
+        // the queueing delay is over the SLO, grow in proportion to the overshoot and at most double the target
+        uint64_t extra = (static_cast<uint64_t>(targetNum) * (waitTime - slo) + slo - 1) / slo;
+        extra = std::clamp<uint64_t>(extra, 1, std::max(targetNum, STEP_SIZE));
+        targetNum = static_cast<uint32_t>(std::min<uint64_t>(targetNum + extra, taskNum));
+    }
+    return targetNum == 0 ? 1 : targetNum;
+}
+
+void LatencyThreadCountPolicy::OnTaskDequeued(Priority priority, uint64_t waitTime)
+{
+    if (priority >= Priority::NUMBER) {
+        return;
+    }
+    WaitStat& stat = waitStats_[priority];
+    UpdateEwma(stat.ewma, waitTime);
+    uint32_t index = 0;
+    while (waitTime != 0 && index < BUCKET_NUM - 1) {
+        waitTime >>= 1;
+        index++;
+    }
+    stat.buckets[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyThreadCountPolicy::OnTaskExecuted(uint64_t duration)
+{
+    UpdateEwma(runTimeEwma_, duration);
+}
+
+void LatencyThreadCountPolicy::OnBalance()
+{
+    // halve the histograms so that the percentile follows the recent load
+    for (WaitStat& stat : waitStats_) {
+        for (auto& bucket : stat.buckets) {
+            uint32_t count = bucket.load(std::memory_order_relaxed);
+            bucket.fetch_sub(count - count / 2, std::memory_order_relaxed); // 2: half
+        }
+    }
+}
+
+uint64_t LatencyThreadCountPolicy::GetRunTimeEstimate() const
+{
+    return runTimeEwma_.load(std::memory_order_relaxed) >> EWMA_SHIFT;
+}
+
+uint64_t LatencyThreadCountPolicy::GetWaitTimeEstimate(Priority priority) const
+{
+    if (priority >= Priority::NUMBER) {
+        return 0;
+    }
+    return waitStats_[priority].ewma.load(std::memory_order_relaxed) >> EWMA_SHIFT;
+}
+
+uint64_t LatencyThreadCountPolicy::GetWaitTimePercentile(Priority priority, uint32_t percentile) const
+{
+    if (priority >= Priority::NUMBER) {
+        return 0;
+    }
+    const WaitStat& stat = waitStats_[priority];
+    std::array<uint32_t, BUCKET_NUM> counts {};
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < BUCKET_NUM; i++) {
+        counts[i] = stat.buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = (total * std::min(percentile, PERCENT) + PERCENT - 1) / PERCENT;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_NUM; i++) {
+        seen += counts[i];
+        if (seen >= rank && i != BUCKET_NUM - 1) {
+            return (1ULL << i) - 1;
+        }
+    }
+    // the last bucket is unbounded, report its lower bound
+    return 1ULL << (BUCKET_NUM - 2); // 2: the last bucket starts at 2^(BUCKET_NUM - 2)
+}
+
+void LatencyThreadCountPolicy::UpdateEwma(std::atomic<uint64_t>& ewma, uint64_t sample)
+{
+    // ewma is kept scaled by 2^EWMA_SHIFT: ewma += sample - ewma / 2^EWMA_SHIFT
+    uint64_t oldValue = ewma.load(std::memory_order_relaxed);
+    uint64_t newValue = 0;
+    do {
+        newValue = oldValue == 0 ? (sample << EWMA_SHIFT) : oldValue + sample - (oldValue >> EWMA_SHIFT);
+    } while (!ewma.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed));
+}
+
+uint64_t LatencyThreadCountPolicy::GetWorstWaitTime() const
+{
+    uint64_t worst = 0;
+    for (uint32_t i = 0; i < Priority::NUMBER; i++) {
+        auto priority = static_cast<Priority>(i);
+        if (priority == Priority::IDLE) {
+            // idle tasks only run when nothing else is queued, they do not count against the SLO
+            continue;
+        }
+        uint64_t waitTime = GetWaitTimeEstimate(priority);
+        uint64_t samples = 0;
+        for (const auto& bucket : waitStats_[i].buckets) {
+            samples += bucket.load(std::memory_order_relaxed);
+        }
+        if (samples >= MIN_PERCENTILE_SAMPLES) {
+            waitTime = std::max(waitTime, GetWaitTimePercentile(priority, WAIT_PERCENTILE));
+        }
+        worst = std::max(worst, waitTime);
+    }
+    return worst;
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
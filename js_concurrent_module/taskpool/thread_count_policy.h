@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_THREAD_COUNT_POLICY_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_THREAD_COUNT_POLICY_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "utils.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Platform;
+
+// the load seen by the TaskManager when it decides how many workers should be idle
+struct ThreadCountLoad {
+    uint32_t nonIdleTaskNum = 0;
+    uint32_t totalExecCount = 0;
+    uint64_t totalExecTime = 0;
+};
+
+// Decides how many idle workers the taskpool needs for the queued tasks, the TaskManager grows the pool towards
+// this number in TryExpand and shrinks it in TriggerLoadBalance.
+// The On* hooks are called concurrently by the workers and must be thread safe.
+class ThreadCountPolicy {
+public:
+    virtual ~ThreadCountPolicy() = default;
+
+    // "latency" gives a LatencyThreadCountPolicy with the SLO in ms, any other name the default policy
+    static std::shared_ptr<ThreadCountPolicy> Create(const std::string& name, uint64_t slo);
+
+    virtual const char* GetName() const = 0;
+    virtual uint32_t ComputeSuitableIdleNum(const ThreadCountLoad& load) = 0;
+
+    // waitTime is the time in ms that a task spent in the queue of the priority
+    virtual void OnTaskDequeued([[maybe_unused]] Priority priority, [[maybe_unused]] uint64_t waitTime) {}
+    virtual void OnTaskExecuted([[maybe_unused]] uint64_t duration) {}
+    // called by the balance timer
+    virtual void OnBalance() {}
+};
+
+// The default policy, sizes the pool so that the queued tasks finish within 100ms
+// using the average execution time.
+class HeuristicThreadCountPolicy : public ThreadCountPolicy {
+public:
+    const char* GetName() const override
+    {
+        return "heuristic";
+    }
+
+    uint32_t ComputeSuitableIdleNum(const ThreadCountLoad& load) override;
+};
+
+// Sizes the pool to keep the queueing delay of the non-idle priorities under an SLO.
+// The run time and the per-priority wait time are tracked with EWMAs, the wait time also with a decaying
+// log2 histogram for the percentile. The feed-forward target comes from the queue length and the run time,
+// it is raised when the observed wait exceeds the SLO.
+class LatencyThreadCountPolicy : public ThreadCountPolicy {
+public:
+    static constexpr uint64_t DEFAULT_SLO = 100; // 100: 100ms
+    static constexpr uint32_t BUCKET_NUM = 16; // 16: log2 buckets, the last one holds everything above 16s
+
+    explicit LatencyThreadCountPolicy(uint64_t slo = DEFAULT_SLO);
+    ~LatencyThreadCountPolicy() override = default;
+
+    const char* GetName() const override
+    {
+        return "latency";
+    }
+
+    uint32_t ComputeSuitableIdleNum(const ThreadCountLoad& load) override;
+    void OnTaskDequeued(Priority priority, uint64_t waitTime) override;
+    void OnTaskExecuted(uint64_t duration) override;
+    void OnBalance() override;
+
+    void SetSlo(uint64_t slo);
+    uint64_t GetSlo() const;
+    // in ms, 0 if there is no sample yet
+    uint64_t GetRunTimeEstimate() const;
+    uint64_t GetWaitTimeEstimate(Priority priority) const;
+    // the upper bound of the histogram bucket holding the percentile, 0 if there is no sample yet
+    uint64_t GetWaitTimePercentile(Priority priority, uint32_t percentile) const;
+
+private:
+    struct WaitStat {
+        std::atomic<uint64_t> ewma {0}; // scaled by 8, see EWMA_SHIFT
+        std::array<std::atomic<uint32_t>, BUCKET_NUM> buckets {};
+    };
+
+    static void UpdateEwma(std::atomic<uint64_t>& ewma, uint64_t sample);
+    uint64_t GetWorstWaitTime() const;
+
+    std::atomic<uint64_t> slo_;
+    std::atomic<uint64_t> runTimeEwma_ {0}; // scaled by 8, see EWMA_SHIFT
+    std::array<WaitStat, Priority::NUMBER> waitStats_ {};
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_THREAD_COUNT_POLICY_H
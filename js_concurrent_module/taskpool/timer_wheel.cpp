@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+#include "helper/concurrent_helper.h"
+#include "helper/napi_helper.h"
+#include "tools/log.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Concurrent::Common::Helper;
+
+static constexpr uint32_t TIMER_INDEX_BITS = 32; // 32: the node index in the low half of the timer id
+static constexpr uint64_t TIMER_INDEX_MASK = 0xFFFFFFFF; // 0xFFFFFFFF: the low half
+
+std::unordered_map<napi_env, TimerWheel*> TimerWheel::timerWheels_ {};
+std::mutex TimerWheel::timerWheelsMutex_;
+
+static uint64_t RotateRight(uint64_t bits, uint32_t shift)
+{
+    shift &= 63; // 63: rotate within 64 bits
+    return shift == 0 ? bits : (bits >> shift) | (bits << (64 - shift)); // 64: bits of uint64_t
+}
+
+TimerWheel::TimerWheel(uv_loop_t* loop) : loop_(loop)
+{
+    heads_.fill(NIL);
+    handle_ = new uv_timer_t;
+    uv_timer_init(loop_, handle_);
+    handle_->data = this;
+    uv_update_time(loop_);
+    currentTick_ = uv_now(loop_);
+}
+
+TimerWheel::~TimerWheel()
+{
+    Close();
+}
+
+TimerWheel* TimerWheel::GetTimerWheel(napi_env env, bool create)
+{
+    std::lock_guard<std::mutex> lock(timerWheelsMutex_);
+    auto iter = timerWheels_.find(env);
+    if (iter != timerWheels_.end()) {
+        return iter->second;
+    }
+    if (!create) {
+        return nullptr;
+    }
+    uv_loop_t* loop = NapiHelper::GetLibUV(env);
+    if (loop == nullptr) {
+        HILOG_ERROR("taskpool:: the loop of the timer wheel is nullptr");
+        return nullptr;
+    }
+    TimerWheel* wheel = new TimerWheel(loop);
+    wheel->env_ = env;
+    timerWheels_.emplace(env, wheel);
+    napi_add_env_cleanup_hook(env, EnvCleanupHook, env);
+    return wheel;
+}
+
+void TimerWheel::EnvCleanupHook(void* data)
+{
+    TimerWheel* wheel = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(timerWheelsMutex_);
+        auto iter = timerWheels_.find(static_cast<napi_env>(data));
+        if (iter == timerWheels_.end()) {
+            return;
+        }
+        wheel = iter->second;
+        timerWheels_.erase(iter);
+    }
+    delete wheel;
+}
+
+uint64_t TimerWheel::AddTimer(napi_env env, uint64_t timeout, uint64_t repeat, Callback callback, void* data)
+{
+    TimerWheel* wheel = GetTimerWheel(env, true);
+    if (wheel == nullptr) {
+        return 0;
+    }
+    return wheel->AddTimer(timeout, repeat, callback, data);
+}
+
+void* TimerWheel::CancelTimer(napi_env env, uint64_t timerId)
+{
+    if (timerId == 0) {
+        return nullptr;
+    }
+    TimerWheel* wheel = GetTimerWheel(env, false);
+    if (wheel == nullptr) {
+        return nullptr;
+    }
+    return wheel->CancelTimer(timerId);
+}
+
+uint32_t TimerWheel::GetTimerNum(napi_env env)
+{
+    TimerWheel* wheel = GetTimerWheel(env, false);
+    return wheel == nullptr ? 0 : wheel->GetTimerNum();
+}
+
+uint64_t TimerWheel::AddTimer(uint64_t timeout, uint64_t repeat, Callback callback, void* data)
+{
+    if (handle_ == nullptr || callback == nullptr) {
+        return 0;
+    }
+    uv_update_time(loop_);
+    uint64_t now = uv_now(loop_);
+    if (timerNum_ == 0 && !isAdvancing_ && now > currentTick_) {
+        currentTick_ = now;
+    }
+    uint32_t index = AllocNode();
+    Node& node = nodes_[index];
+    // the earliest a timer can fire is the next tick
+    node.expiry = std::max(now + timeout, currentTick_ + 1);
+    node.repeat = repeat;
+    node.callback = callback;
+    node.data = data;
+    Insert(index);
+    Arm();
+    return (static_cast<uint64_t>(node.generation) << TIMER_INDEX_BITS) | (index + 1);
+}
+
+void* TimerWheel::CancelTimer(uint64_t timerId)
+{
+    uint64_t position = timerId & TIMER_INDEX_MASK;
+    if (position == 0 || position > nodes_.size()) {
+        return nullptr;
+    }
+    uint32_t index = static_cast<uint32_t>(position - 1);
+    Node& node = nodes_[index];
+    if (node.callback == nullptr || node.isCanceled ||
+        node.generation != static_cast<uint32_t>(timerId >> TIMER_INDEX_BITS)) {
+        return nullptr;
+    }
+    void* data = node.data;
+    if (node.list == NO_LIST) {
+        // the timer is in the batch being fired, the batch frees it
+        node.isCanceled = true;
+        return data;
+    }
+    Unlink(index);
+    FreeNode(index);
+    if (timerNum_ == 0) {
+        Arm();
+    }
+    return data;
+}
+
+uint32_t TimerWheel::GetTimerNum() const
+{
+    return timerNum_;
+}
+
+void TimerWheel::Close()
+{
+    if (handle_ == nullptr) {
+        return;
+    }
+    uv_timer_stop(handle_);
+    ConcurrentHelper::UvHandleClose(handle_);
+    if (timerNum_ != 0) {
+        HILOG_WARN("taskpool:: %{public}u timers are dropped with the timer wheel", timerNum_);
+    }
+    nodes_.clear();
+    freeHead_ = NIL;
+    timerNum_ = 0;
+    heads_.fill(NIL);
+    occupied_.fill(0);
+    armedTick_ = UINT64_MAX;
+}
+
+void TimerWheel::OnTimer(uv_timer_t* handle)
+{
+    TimerWheel* wheel = static_cast<TimerWheel*>(handle->data);
+    wheel->armedTick_ = UINT64_MAX;
+    wheel->Advance(uv_now(wheel->loop_));
+    wheel->Arm();
+}
+
+uint32_t TimerWheel::AllocNode()
+{
+    uint32_t index = freeHead_;
+    if (index == NIL) {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    } else {
+        freeHead_ = nodes_[index].next;
+    }
+    timerNum_++;
+    return index;
+}
+
+void TimerWheel::FreeNode(uint32_t index)
+{
+    Node& node = nodes_[index];
+    node.generation++;
+    node.callback = nullptr;
+    node.data = nullptr;
+    node.isCanceled = false;
+    node.list = NO_LIST;
+    node.prev = NIL;
+    node.next = freeHead_;
+    freeHead_ = index;
+    timerNum_--;
+}
+
+void TimerWheel::Insert(uint32_t index)
+{
+    Node& node = nodes_[index];
+    // expiry is never before currentTick_, it equals currentTick_ only while a slot above is moved down
+    uint64_t delta = node.expiry - currentTick_;
+    uint64_t slotTick = node.expiry;
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_NUM && (delta >> (SLOT_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    if ((delta >> (SLOT_BITS * LEVEL_NUM)) != 0) {
+        // beyond the top level, the timer waits in the farthest slot and is put back from there
+        slotTick = currentTick_ + (1ULL << (SLOT_BITS * LEVEL_NUM)) - 1;
+    }
+    uint32_t slot = static_cast<uint32_t>(slotTick >> (SLOT_BITS * level)) & SLOT_MASK;
+    uint32_t list = level * SLOT_NUM + slot;
+    node.list = list;
+    node.prev = NIL;
+    node.next = heads_[list];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[list] = index;
+    occupied_[level] |= 1ULL << slot;
+}
+
+void TimerWheel::Unlink(uint32_t index)
+{
+    Node& node = nodes_[index];
+    uint32_t list = node.list;
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[list] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (heads_[list] == NIL) {
+        occupied_[list / SLOT_NUM] &= ~(1ULL << (list % SLOT_NUM));
+    }
+    node.list = NO_LIST;
+    node.prev = NIL;
+    node.next = NIL;
+}
+
+uint64_t TimerWheel::GetNextTick() const
+{
+    uint64_t nextTick = UINT64_MAX;
+    for (uint32_t level = 0; level < LEVEL_NUM; level++) {
+        if (occupied_[level] == 0) {
+            continue;
+        }
+        // the slots of a level are handled in turn, one per 64^level ticks
+        uint32_t shift = SLOT_BITS * level;
+        uint64_t turn = (currentTick_ >> shift) + 1;
+        uint64_t bits = RotateRight(occupied_[level], static_cast<uint32_t>(turn & SLOT_MASK));
+        uint64_t tick = (turn + static_cast<uint64_t>(__builtin_ctzll(bits))) << shift;
+        nextTick = std::min(nextTick, tick);
+    }
+    return nextTick;
+}
+
+void TimerWheel::Advance(uint64_t now)
+{
+    isAdvancing_ = true;
+    while (true) {
+        uint64_t nextTick = GetNextTick();
+        if (nextTick > now) {
+            break;
+        }
+        currentTick_ = nextTick;
+        ExpireTick();
+    }
+    // nothing is due up to now, the slots ahead stay valid as they are indexed by the absolute tick
+    currentTick_ = std::max(currentTick_, now);
+    isAdvancing_ = false;
+}
+
+void TimerWheel::ExpireTick()
+{
+    // the levels above move their slot of this tick down first, the timers due now end up in level 0
+    for (uint32_t level = LEVEL_NUM - 1; level > 0; level--) {
+        uint32_t shift = SLOT_BITS * level;
+        if ((currentTick_ & ((1ULL << shift) - 1)) != 0) {
+            continue;
+        }
+        uint32_t slot = static_cast<uint32_t>(currentTick_ >> shift) & SLOT_MASK;
+        uint32_t list = level * SLOT_NUM + slot;
+        uint32_t index = heads_[list];
+        heads_[list] = NIL;
+        occupied_[level] &= ~(1ULL << slot);
+        while (index != NIL) {
+            uint32_t next = nodes_[index].next;
+            Insert(index);
+            index = next;
+        }
+    }
+    uint32_t slot = static_cast<uint32_t>(currentTick_) & SLOT_MASK;
+    std::vector<uint32_t> batch {};
+    for (uint32_t index = heads_[slot]; index != NIL; index = nodes_[index].next) {
+        batch.push_back(index);
+    }
+    for (uint32_t index : batch) {
+        nodes_[index].list = NO_LIST;
+    }
+    heads_[slot] = NIL;
+    occupied_[0] &= ~(1ULL << slot);
+    // the callbacks may add or cancel timers, the nodes are looked up again as nodes_ may grow
+    for (uint32_t index : batch) {
+        if (!nodes_[index].isCanceled) {
+            Callback callback = nodes_[index].callback;
+            callback(nodes_[index].data);
+        }
+        Node& node = nodes_[index];
+        if (node.isCanceled || node.repeat == 0) {
+            FreeNode(index);
+            continue;
+        }
+        node.expiry = currentTick_ + node.repeat;
+        Insert(index);
+    }
+}
+
+void TimerWheel::Arm()
+{
+    if (handle_ == nullptr || isAdvancing_) {
+        return;
+    }
+    uint64_t nextTick = GetNextTick();
+    if (nextTick == armedTick_) {
+        return;
+    }
+    armedTick_ = nextTick;
+    if (nextTick == UINT64_MAX) {
+        uv_timer_stop(handle_);
+        return;
+    }
+    uint64_t now = uv_now(loop_);
+    uv_timer_start(handle_, OnTimer, nextTick > now ? nextTick - now : 0, 0);
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_TIMER_WHEEL_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_TIMER_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <uv.h>
+#include <vector>
+
+#include "napi/native_api.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+// The delays, periods and timeouts of taskpool on one env, driven by a single uv_timer_t on the loop of the env.
+// A hierarchical timing wheel with 1 ms ticks: level 0 has one slot per tick and every slot of a level above covers
+// a whole turn of the level below. A timer is put into the lowest level whose turn reaches its expiry and moves
+// down a level each time the wheel reaches its slot, so insert and cancel are O(1) and the timers of a tick expire
+// in one batch. The uv timer is only armed for the ticks which have a slot to handle.
+// A wheel is used only by the thread of its env.
+class TimerWheel {
+public:
+    using Callback = void (*)(void* data);
+
+    explicit TimerWheel(uv_loop_t* loop);
+    ~TimerWheel();
+
+    // timeout and repeat are in milliseconds, repeat 0 fires once, returns the timer id, never 0
+    static uint64_t AddTimer(napi_env env, uint64_t timeout, uint64_t repeat, Callback callback, void* data);
+    // returns the data of the timer, or nullptr if it has fired or is unknown, the data stays with the caller
+    static void* CancelTimer(napi_env env, uint64_t timerId);
+    static uint32_t GetTimerNum(napi_env env);
+
+    uint64_t AddTimer(uint64_t timeout, uint64_t repeat, Callback callback, void* data);
+    void* CancelTimer(uint64_t timerId);
+    uint32_t GetTimerNum() const;
+    // closes the uv timer, the timers left are dropped without calling them
+    void Close();
+
+private:
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel& operator=(const TimerWheel &) = delete;
+    TimerWheel(TimerWheel &&) = delete;
+    TimerWheel& operator=(TimerWheel &&) = delete;
+
+    static constexpr uint32_t SLOT_BITS = 6; // 6: 64 slots per level
+    static constexpr uint32_t SLOT_NUM = 1U << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOT_NUM - 1;
+    static constexpr uint32_t LEVEL_NUM = 4; // 4: 64^4 ms, about 4.6 hours, longer timers are put off level by level
+    static constexpr uint32_t LIST_NUM = LEVEL_NUM * SLOT_NUM;
+    static constexpr uint32_t NO_LIST = LIST_NUM; // the timer is firing or free
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        uint64_t expiry = 0;
+        uint64_t repeat = 0;
+        Callback callback = nullptr;
+        void* data = nullptr;
+        uint32_t generation = 0; // the high half of the timer id, changes whenever the node is reused
+        uint32_t list = NO_LIST;
+        uint32_t prev = NIL;
+        uint32_t next = NIL; // also links the free list
+        bool isCanceled = false;
+    };
+
+    static TimerWheel* GetTimerWheel(napi_env env, bool create);
+    static void EnvCleanupHook(void* data);
+    static void OnTimer(uv_timer_t* handle);
+
+    uint32_t AllocNode();
+    void FreeNode(uint32_t index);
+    void Insert(uint32_t index);
+    void Unlink(uint32_t index);
+    // the earliest tick after currentTick_ with a slot to handle, UINT64_MAX if there is no timer
+    uint64_t GetNextTick() const;
+    void Advance(uint64_t now);
+    void ExpireTick();
+    void Arm();
+
+    // <env, wheel>
+    static std::unordered_map<napi_env, TimerWheel*> timerWheels_;
+    static std::mutex timerWheelsMutex_;
+
+    napi_env env_ = nullptr;
+    uv_loop_t* loop_ = nullptr;
+    uv_timer_t* handle_ = nullptr;
+    uint64_t currentTick_ = 0;
+    uint64_t armedTick_ = UINT64_MAX;
+    bool isAdvancing_ = false;
+    std::vector<Node> nodes_ {};
+    uint32_t freeHead_ = NIL;
+    uint32_t timerNum_ = 0;
+    std::array<uint32_t, LIST_NUM> heads_ {};
+    // one bit per slot which has timers
+    std::array<uint64_t, LEVEL_NUM> occupied_ {};
+
+    friend class NativeEngineTest;
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_TIMER_WHEEL_H
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "work_stealing_queue.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+static constexpr uint32_t PRIORITY_SHIFT = 32;
+static constexpr uint64_t TASK_ID_MASK = 0xFFFFFFFF;
+static constexpr int64_t INDEX_MASK = WorkStealingQueue::CAPACITY - 1;
+
+uint64_t WorkStealingQueue::Pack(uint32_t taskId, Priority priority)
+{
+    return (static_cast<uint64_t>(priority) << PRIORITY_SHIFT) | taskId;
+}
+
+std::pair<uint32_t, Priority> WorkStealingQueue::Unpack(uint64_t entry)
+{
+    return std::make_pair(static_cast<uint32_t>(entry & TASK_ID_MASK),
+                          static_cast<Priority>(entry >> PRIORITY_SHIFT));
+}
+
+bool WorkStealingQueue::Push(uint32_t taskId, Priority priority)
+{
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<int64_t>(CAPACITY)) {
+        return false;
+    }
+    buffer_[bottom & INDEX_MASK].store(Pack(taskId, priority), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+}
+
+std::pair<uint32_t, Priority> WorkStealingQueue::Pop()
+{
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        // the deque is empty
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return std::make_pair(0, Priority::DEFAULT);
+    }
+    uint64_t entry = buffer_[bottom & INDEX_MASK].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // the last entry, race against the thieves
+        bool success = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        if (!success) {
+            return std::make_pair(0, Priority::DEFAULT);
+        }
+    }
+    return Unpack(entry);
+}
+
+std::pair<uint32_t, Priority> WorkStealingQueue::Steal()
+{
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return std::make_pair(0, Priority::DEFAULT);
+    }
+    uint64_t entry = buffer_[top & INDEX_MASK].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        // lost the race against the owner or another thief
+        return std::make_pair(0, Priority::DEFAULT);
+    }
+    return Unpack(entry);
+}
+
+std::pair<uint32_t, Priority> WorkStealingQueue::PeekBottom() const
+{
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return std::make_pair(0, Priority::DEFAULT);
+    }
+    return Unpack(buffer_[(bottom - 1) & INDEX_MASK].load(std::memory_order_relaxed));
+}
+
+bool WorkStealingQueue::IsEmpty() const
+{
+    return GetSize() == 0;
+}
+
+uint32_t WorkStealingQueue::GetSize() const
+{
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<uint32_t>(bottom - top) : 0;
+}
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
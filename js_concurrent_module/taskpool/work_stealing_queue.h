@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_TASKPOOL_WORK_STEALING_QUEUE_H
+#define JS_CONCURRENT_MODULE_TASKPOOL_WORK_STEALING_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "utils.h"
+
+namespace Commonlibrary::Concurrent::TaskPoolModule {
+using namespace Commonlibrary::Platform;
+
+// A bounded Chase-Lev deque of <taskId, priority>.
+// Push and Pop may only be called by the owner worker thread, Steal may be called by any thread.
+class WorkStealingQueue {
+public:
+    static constexpr uint32_t CAPACITY = 128; // 128: power of 2
+
+    WorkStealingQueue() = default;
+    ~WorkStealingQueue() = default;
+
+    bool Push(uint32_t taskId, Priority priority);
+    std::pair<uint32_t, Priority> Pop();
+    std::pair<uint32_t, Priority> Steal();
+    // only a hint for the owner, the entry may have been stolen concurrently
+    std::pair<uint32_t, Priority> PeekBottom() const;
+
+    bool IsEmpty() const;
+    uint32_t GetSize() const;
+
+private:
+    WorkStealingQueue(const WorkStealingQueue &) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue &) = delete;
+    WorkStealingQueue(WorkStealingQueue &&) = delete;
+    WorkStealingQueue& operator=(WorkStealingQueue &&) = delete;
+
+    static uint64_t Pack(uint32_t taskId, Priority priority);
+    static std::pair<uint32_t, Priority> Unpack(uint64_t entry);
+
+    std::atomic<int64_t> top_ {0};
+    std::atomic<int64_t> bottom_ {0};
+    std::array<std::atomic<uint64_t>, CAPACITY> buffer_ {};
+};
+} // namespace Commonlibrary::Concurrent::TaskPoolModule
+#endif // JS_CONCURRENT_MODULE_TASKPOOL_WORK_STEALING_QUEUE_H
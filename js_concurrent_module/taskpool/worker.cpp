@@ -25,6 +25,7 @@
 #include "helper/hitrace_helper.h"
 #include "process_helper.h"
 #include "sequence_runner_manager.h"
+#include "function_cache.h"
 #include "taskpool.h"
 #include "task_group_manager.h"
 #include "native_engine.h"
@@ -38,6 +39,9 @@ using namespace Commonlibrary::Platform;
 static constexpr uint32_t TASKPOOL_TYPE = 2;
 static constexpr uint32_t WORKER_ALIVE_TIME = 1800000; // 1800000: 30min
 static constexpr int32_t MAX_REPORT_TIMES = 3;
+static constexpr size_t MAX_CACHED_FUNCTION_NUM = 32; // 32: deserialized functions kept by each worker
+static constexpr uint32_t MAX_RESULT_BUFFER_SCAN_NUM = 16; // 16: values of a result checked for buffers
+thread_local static Worker* g_currentWorker = nullptr;
 
 Worker::PriorityScope::PriorityScope(Worker* worker, Priority taskPriority) : worker_(worker)
 {
@@ -66,6 +70,11 @@ Worker::RunningScope::~RunningScope()
     worker_->idleState_ = true;
 }
 
+Worker* Worker::GetCurrentWorker()
+{
+    return g_currentWorker;
+}
+
 Worker* Worker::WorkerConstructor(napi_env env)
 {
     HITRACE_HELPER_METER_NAME("TaskWorkerConstructor: [Add Thread]");
@@ -256,13 +265,26 @@ void Worker::ExecuteInThread(const void* data)
     ConcurrentHelper::UvHandleInit(loop, worker->debuggerOnPostTaskSignal_, Worker::HandleDebuggerTask, worker);
 #endif
     if (worker->PrepareForWorkerInstance()) {
+        // a prewarmed worker has the modules loaded before it takes its first task
+        worker->PreloadModules();
+        uint64_t startupTime = ConcurrentHelper::GetMilliseconds() - worker->createTime_;
+        HILOG_DEBUG("taskpool:: worker startup time: %{public}s ms", std::to_string(startupTime).c_str());
+        TaskManager::GetInstance().RecordWorkerStartupTime(startupTime);
         // Call after uv_async_init
         worker->NotifyWorkerCreated();
 #if defined(ENABLE_TASKPOOL_FFRT)
         worker->InitFfrtInfo();
         worker->InitLoopHandleNum();
 #endif
+        g_currentWorker = worker;
+        TaskManager::GetInstance().AttachLocalQueue(worker);
+        worker->eventRing_ = TaskManager::GetInstance().logManager_.AcquireEventRing();
         worker->RunLoop();
+        TaskManager::GetInstance().logManager_.ReleaseEventRing(worker->eventRing_);
+        worker->eventRing_ = nullptr;
+        TaskManager::GetInstance().DetachLocalQueue(worker);
+        TaskManager::GetInstance().DetachAffinityQueue(worker);
+        g_currentWorker = nullptr;
     } else {
         HILOG_ERROR("taskpool:: Worker PrepareForWorkerInstance fail");
     }
@@ -345,6 +367,7 @@ void Worker::ReleaseWorkerThreadContent()
     }
 
     Timer::ClearEnvironmentTimer(workerEnv_);
+    ClearFunctionCache();
     // 2. delete NativeEngine created in worker thread
     if (!workerEngine->CallOffWorkerFunc(workerEngine)) {
         HILOG_ERROR("worker:: CallOffWorkerFunc error");
@@ -353,7 +376,7 @@ void Worker::ReleaseWorkerThreadContent()
     workerEnv_ = nullptr;
 }
 
-void Worker::NotifyExecuteTask()
+bool Worker::NotifyExecuteTask()
 {
     if (LIKELY(performTaskSignal_ != nullptr && !uv_is_closing(reinterpret_cast<uv_handle_t*>(performTaskSignal_)))) {
         int ret = uv_async_send(performTaskSignal_);
@@ -361,10 +384,12 @@ void Worker::NotifyExecuteTask()
             HILOG_ERROR("taskpool:: worker NotifyExecuteTask uv send failed");
             TaskManager::GetInstance().UvReportHisysEvent(this, "NotifyExecuteTask", "uv_async_send",
                 "uv send performTaskSignal_ failed", ret);
+            return false;
         }
-    } else {
-        HILOG_ERROR("taskpool:: performTaskSignal_ is invalid");
+        return true;
     }
+    HILOG_ERROR("taskpool:: performTaskSignal_ is invalid");
+    return false;
 }
 
 void Worker::NotifyIdle()
@@ -394,6 +419,61 @@ void Worker::TriggerGCCheck(const uv_async_t* req)
     workerEngine->NotifyTaskFinished();
 }
 
+void Worker::PreloadModules()
+{
+    TaskManager& taskManager = TaskManager::GetInstance();
+    if (LIKELY(preloadedModuleNum_ == taskManager.GetPreloadModuleNum())) {
+        return;
+    }
+    std::vector<std::string> modules = taskManager.GetPreloadModules(preloadedModuleNum_);
+    preloadedModuleNum_ += static_cast<uint32_t>(modules.size());
+    std::string traceLabel = "PreloadModules: " + std::to_string(modules.size());
+    HITRACE_HELPER_METER_NAME(traceLabel);
+    napi_status scopeStatus = napi_ok;
+    HandleScope scope(workerEnv_, scopeStatus);
+    if (scopeStatus != napi_ok) {
+        HILOG_ERROR("taskpool:: PreloadModules open handle scope failed");
+        return;
+    }
+    for (const std::string& module : modules) {
+        std::string moduleLabel = "PreloadModule: " + module;
+        HITRACE_HELPER_METER_NAME(moduleLabel);
+        // the module stays in the module table of the env, so the tasks importing it later find it loaded
+        napi_value result = nullptr;
+        napi_status status = napi_load_module(workerEnv_, module.c_str(), &result);
+        if (status != napi_ok || NapiHelper::IsExceptionPending(workerEnv_)) {
+            napi_value exception = nullptr;
+            napi_get_and_clear_last_exception(workerEnv_, &exception);
+            HILOG_WARN("taskpool:: failed to preload module %{public}s", module.c_str());
+        }
+    }
+}
+
+void Worker::BindCoreClass(Task* task)
+{
+    if (LIKELY(!TaskManager::GetInstance().IsCoreAffinityEnabled())) {
+        return;
+    }
+    CoreClass coreClass = CoreClass::NONE;
+    Workload workload = task->workload_;
+    if (workload == Workload::COMPUTE) {
+        coreClass = CoreClass::PERFORMANCE;
+    } else if (workload == Workload::BACKGROUND) {
+        coreClass = CoreClass::EFFICIENCY;
+    }
+    // the affinity only changes with the class, a worker of an unbound pool never binds
+    if (coreClass_ == coreClass) {
+        return;
+    }
+    // a worker which fails to bind still takes the class, so it is not tried on every task
+    if (SetThreadAffinity(CpuTopology::GetInstance().GetCpus(coreClass)) != 0) {
+        HILOG_WARN("taskpool:: worker %{public}d failed to bind to the cores", tid_);
+    }
+    coreClass_ = coreClass;
+    std::string traceLabel = "BindCoreClass: " + std::to_string(static_cast<uint32_t>(coreClass));
+    HITRACE_HELPER_METER_NAME(traceLabel);
+}
+
 void Worker::NotifyTaskFinished()
 {
     // trigger gc check by uv and return immediately if the handle is invalid
@@ -422,14 +502,21 @@ bool Worker::UpdateWorkerState(WorkerState expect, WorkerState desired)
 void Worker::PerformTask(const uv_async_t* req)
 {
     auto worker = static_cast<Worker*>(req->data);
-    auto taskInfo = TaskManager::GetInstance().DequeueTaskId();
+    worker->PreloadModules();
+    // the waking state must be cleared before dequeuing, otherwise a task enqueued in between could be
+    // counted as served by this worker and wait until some other worker becomes idle
+    bool wasWaking = worker->isWaking_ && TaskManager::GetInstance().NotifyWorkerWokenUp(worker);
+    auto taskInfo = TaskManager::GetInstance().DequeueTaskId(worker);
     if (taskInfo.first == 0) {
+        if (wasWaking) {
+            TaskManager::GetInstance().CountSpuriousWakeup();
+        }
         if (TaskManager::GetInstance().GetTotalTaskNum() != 0) {
             worker->NotifyExecuteTask();
         }
         return;
     }
-    TaskManager::GetInstance().RemoveTaskEnqueueTime(taskInfo.first);
+    TaskManager::GetInstance().NotifyTaskDequeued(taskInfo.first, taskInfo.second);
     uint64_t startTime = ConcurrentHelper::GetMilliseconds();
     worker->UpdateWorkerWakeUpTime();
     napi_env env = worker->workerEnv_;
@@ -447,6 +534,7 @@ void Worker::PerformTask(const uv_async_t* req)
         return;
     }
     AsyncStackScope asyncStackScope(task);
+    worker->BindCoreClass(task);
     // try to record the memory data for gc
     worker->NotifyTaskBegin();
 
@@ -461,25 +549,23 @@ void Worker::PerformTask(const uv_async_t* req)
         worker->UpdateLongTaskInfo(task);
     }
     worker->StoreTaskId(task->taskId_);
-    // tag for trace parse: Task Perform
-    auto loop = worker->GetWorkerLoop();
-    std::string taskIdStr = std::to_string(task->taskId_);
-    uint64_t loopAddress = reinterpret_cast<uint64_t>(loop);
-    std::string strTrace = "Task Perform: name : "  + task->name_ + ", taskId : " + taskIdStr
-                            + ", priority : " + std::to_string(taskInfo.second);
-    std::string taskLog = "Task Perform: "  + task->name_ + ", " + taskIdStr + ", "
-                          "runningLoop: " + std::to_string(loopAddress);
+    // tag for trace parse: Task Perform, only formatted when the trace is enabled
+    std::string strTrace = "";
+    if (UNLIKELY(HITRACE_HELPER_IS_ENABLED)) {
+        strTrace = "Task Perform: name : "  + task->name_ + ", taskId : " + std::to_string(task->taskId_)
+                   + ", priority : " + std::to_string(taskInfo.second);
+    }
     HITRACE_HELPER_METER_NAME(strTrace);
-    HILOG_DEBUG("taskpool:: %{public}s", taskLog.c_str());
-    task->runningTime_ = ConcurrentHelper::GetCurrentTimeStampWithMS();
-    taskLog += ", " + task->runningTime_;
-    TaskManager::GetInstance().PushLog(taskLog);
+    HILOG_DEBUG("taskpool:: Task Perform: %{public}u, worker: %{public}d", task->taskId_, worker->tid_);
+    // the event is formatted when the logs are printed
+    TaskManager::GetInstance().RecordTaskEvent(worker->eventRing_, TaskEventType::PERFORM, task->taskId_,
+                                               taskInfo.second, static_cast<uint32_t>(worker->tid_));
 
     napi_value func = nullptr;
     napi_value args = nullptr;
     napi_value errorInfo = task->DeserializeValue(env, &func, &args);
     if (UNLIKELY(func == nullptr || args == nullptr)) {
-        std::string errStr = "taskpool:: PerformTask Deserialize fail, id: " + taskIdStr;
+        std::string errStr = "taskpool:: PerformTask Deserialize fail, id: " + std::to_string(task->taskId_);
         if (errorInfo != nullptr) {
             errStr += "; errorInfo not nullptr";
             worker->NotifyTaskResult(env, task, errorInfo);
@@ -489,7 +575,7 @@ void Worker::PerformTask(const uv_async_t* req)
     }
     auto workerEngine = reinterpret_cast<NativeEngine*>(env);
     if (!worker->InitTaskPoolFunc(env, func, task)) {
-        HILOG_ERROR("taskpool:: PerformTask InitTaskPoolFunc fail, id:%{public}s", taskIdStr.c_str());
+        HILOG_ERROR("taskpool:: PerformTask InitTaskPoolFunc fail, id:%{public}u", task->taskId_);
         workerEngine->ClearCurrentTaskInfo();
         return;
     }
@@ -501,7 +587,7 @@ void Worker::PerformTask(const uv_async_t* req)
     }
 
     if (!task->CheckStartExecution(taskInfo.second)) { // LOCV_EXCL_BR_LINE
-        HILOG_ERROR("taskpool:: PerformTask CheckStartExecution fail, id:%{public}s", taskIdStr.c_str());
+        HILOG_ERROR("taskpool:: PerformTask CheckStartExecution fail, id:%{public}u", task->taskId_);
         if (task->ShouldDeleteTask()) {
             delete task;
         }
@@ -520,24 +606,27 @@ void Worker::NotifyTaskResult(napi_env env, Task* task, napi_value result)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
     HILOG_DEBUG("taskpool:: NotifyTaskResult task:%{public}s", std::to_string(task->taskId_).c_str());
-    void* resultData = nullptr;
-    std::string errString = "";
-    NativeEngine *engine = reinterpret_cast<NativeEngine*>(env);
-#if defined(ENABLE_CONCURRENCY_INTEROP)
-    if (ANIHelper::IsHybridVM(env)) {
-        napi_value undefined = NapiHelper::GetUndefinedValue(env);
-        napi_serialize_hybrid(env, result, undefined, undefined, &resultData);
-        if (resultData == nullptr) {
-            errString = "InterOp serialize failed";
-        }
-    } else {
-        SerializeOptions options(true, false, true);
-        engine->SerializeJSErrorWithError(env, result, options, &resultData, errString);
-    }
-#else
-    SerializeOptions options(true, false, true);
-    engine->SerializeJSErrorWithError(env, result, options, &resultData, errString);
-#endif
+    void* resultData = nullptr;
+    std::string errString = "";
+    // the messages sent by the task reach the host before its result
+    task->FlushSendData(env);
+    ResultBuffers buffers {};
+    if (task->success_) {
+        CollectResultBuffers(env, result, buffers);
+    }
+#if defined(ENABLE_CONCURRENCY_INTEROP)
+    if (ANIHelper::IsHybridVM(env)) {
+        napi_value undefined = NapiHelper::GetUndefinedValue(env);
+        napi_serialize_hybrid(env, result, undefined, undefined, &resultData);
+        if (resultData == nullptr) {
+            errString = "InterOp serialize failed";
+        }
+    } else {
+        SerializeResult(env, task, result, &resultData, errString);
+    }
+#else
+    SerializeResult(env, task, result, &resultData, errString);
+#endif
     if (resultData == nullptr && task->success_) {
         task->success_ = false;
         std::string errMessage = "taskpool: failed to serialize result.\nSerialize error: " + errString;
@@ -546,10 +635,129 @@ void Worker::NotifyTaskResult(napi_env env, Task* task, napi_value result)
         NotifyTaskResult(env, task, err);
         return;
     }
+    RecordResultBytes(env, buffers);
     task->result_ = resultData;
     NotifyHandleTaskResult(task);
 }
 
+void Worker::SerializeResult(napi_env env, Task* task, napi_value result, void** resultData, std::string& errString)
+{
+    bool hasResultTransferList = false;
+    bool defaultCloneSendable = false;
+    {
+        std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
+        hasResultTransferList = task->hasResultTransferList_;
+        defaultCloneSendable = task->defaultCloneSendable_;
+    }
+    if (hasResultTransferList && task->success_) {
+        napi_value undefined = NapiHelper::GetUndefinedValue(env);
+        napi_value transferList = GetResultTransferList(env, task, result);
+        napi_serialize_inner_with_error(env, result, transferList, undefined, false, defaultCloneSendable,
+                                        resultData, errString);
+        return;
+    }
+    NativeEngine* engine = reinterpret_cast<NativeEngine*>(env);
+    SerializeOptions options(TaskManager::GetInstance().IsResultTransfer(), defaultCloneSendable, true);
+    engine->SerializeJSErrorWithError(env, result, options, resultData, errString);
+}
+
+static napi_value GetBackingArrayBuffer(napi_env env, napi_value value)
+{
+    if (NapiHelper::IsArrayBuffer(env, value)) {
+        return value;
+    }
+    bool isTypedArray = false;
+    napi_is_typedarray(env, value, &isTypedArray);
+    if (!isTypedArray) {
+        return nullptr;
+    }
+    napi_typedarray_type type = napi_uint8_array;
+    size_t length = 0;
+    void* data = nullptr;
+    napi_value arrayBuffer = nullptr;
+    size_t byteOffset = 0;
+    napi_get_typedarray_info(env, value, &type, &length, &data, &arrayBuffer, &byteOffset);
+    return arrayBuffer;
+}
+
+void Worker::CollectResultBuffers(napi_env env, napi_value result, ResultBuffers& buffers)
+{
+    auto addBuffer = [env, &buffers](napi_value value) {
+        napi_value arrayBuffer = GetBackingArrayBuffer(env, value);
+        if (arrayBuffer == nullptr) {
+            return false;
+        }
+        for (const auto& buffer : buffers) {
+            if (NapiHelper::IsStrictEqual(env, buffer.first, arrayBuffer)) {
+                return true;
+            }
+        }
+        void* data = nullptr;
+        size_t byteLength = 0;
+        napi_get_arraybuffer_info(env, arrayBuffer, &data, &byteLength);
+        buffers.emplace_back(arrayBuffer, byteLength);
+        return true;
+    };
+    if (addBuffer(result) || !NapiHelper::IsObject(env, result)) {
+        return;
+    }
+    // only the first level is looked at, a deep walk would cost more than the copy it reports
+    napi_value keys = nullptr;
+    napi_get_property_names(env, result, &keys);
+    uint32_t keyNum = std::min(NapiHelper::GetArrayLength(env, keys), MAX_RESULT_BUFFER_SCAN_NUM);
+    for (uint32_t i = 0; i < keyNum; i++) {
+        napi_value value = nullptr;
+        napi_get_property(env, result, NapiHelper::GetElement(env, keys, i), &value);
+        addBuffer(value);
+    }
+}
+
+napi_value Worker::GetResultTransferList(napi_env env, Task* task, napi_value result)
+{
+    std::vector<std::string> keys {};
+    {
+        std::lock_guard<std::recursive_mutex> lock(task->taskMutex_);
+        keys = task->resultTransferList_;
+    }
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    if (keys.empty()) {
+        return undefined;
+    }
+    napi_value transferList = NapiHelper::CreateArrayWithLength(env, 0);
+    uint32_t index = 0;
+    // a result which is a buffer itself is transferred by any list which is not empty
+    napi_value arrayBuffer = GetBackingArrayBuffer(env, result);
+    if (arrayBuffer != nullptr) {
+        napi_set_element(env, transferList, index++, arrayBuffer);
+    } else if (NapiHelper::IsObject(env, result)) {
+        for (const std::string& key : keys) {
+            napi_value value = NapiHelper::GetNameProperty(env, result, key.c_str());
+            arrayBuffer = value == nullptr ? nullptr : GetBackingArrayBuffer(env, value);
+            if (arrayBuffer != nullptr) {
+                napi_set_element(env, transferList, index++, arrayBuffer);
+            }
+        }
+    }
+    return index == 0 ? undefined : transferList;
+}
+
+void Worker::RecordResultBytes(napi_env env, const ResultBuffers& buffers)
+{
+    uint64_t transferredBytes = 0;
+    uint64_t copiedBytes = 0;
+    for (const auto& [arrayBuffer, byteLength] : buffers) {
+        // a transferred buffer is detached from the worker, a copied one stays
+        bool isDetached = false;
+        napi_is_detached_arraybuffer(env, arrayBuffer, &isDetached);
+        if (isDetached) {
+            transferredBytes += byteLength;
+        } else {
+            copiedBytes += byteLength;
+        }
+    }
+    TaskManager::GetInstance().RecordResultBytes(transferredBytes, copiedBytes);
+}
+
 void Worker::NotifyHandleTaskResult(Task* task)
 {
     if (!task->IsReadyToHandle()) {
@@ -588,9 +796,10 @@ void Worker::TaskResultCallback(napi_env env, napi_value result, bool success, v
         HILOG_FATAL("taskpool:: %{public}s", error.c_str());
         return;
     }
-    Task* task = static_cast<Task*>(data);
-    if (TaskManager::GetInstance().GetTask(task->taskId_) == nullptr) {
-        std::string error = "task is nullptr, taskId: " + std::to_string(task->taskId_);
+    uint32_t taskId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data));
+    Task* task = TaskManager::GetInstance().GetTask(taskId);
+    if (task == nullptr) {
+        std::string error = "task is nullptr, taskId: " + std::to_string(taskId);
         TaskManager::GetInstance().UvReportHisysEvent(nullptr, "TaskResultCallback", "", error, -1);
         HILOG_FATAL("taskpool:: task is nullptr");
         return;
@@ -643,7 +852,7 @@ void Worker::StoreTaskId(uint32_t taskId)
 bool Worker::InitTaskPoolFunc(napi_env env, napi_value func, Task* task)
 {
     auto workerEngine = reinterpret_cast<NativeEngine*>(env);
-    bool success = workerEngine->InitTaskPoolFunc(env, func, task);
+    bool success = workerEngine->InitTaskPoolFunc(env, func, TaskManager::GetTaskInfoData(task->taskId_));
     napi_value exception;
     napi_get_and_clear_last_exception(env, &exception);
     if (exception != nullptr) {
@@ -664,6 +873,38 @@ bool Worker::InitTaskPoolFunc(napi_env env, napi_value func, Task* task)
     return true;
 }
 
+napi_value Worker::GetCachedFunction(napi_env env, uint64_t functionId)
+{
+    auto iter = functionCache_.find(functionId);
+    if (iter == functionCache_.end()) {
+        FunctionCache::GetInstance().CountDeserialization(false);
+        return nullptr;
+    }
+    FunctionCache::GetInstance().CountDeserialization(true);
+    return NapiHelper::GetReferenceValue(env, iter->second);
+}
+
+void Worker::CacheFunction(napi_env env, uint64_t functionId, napi_value func)
+{
+    // the engine binds the running task to the function, an async function may still be running
+    // when the next task starts, so only plain functions are shared between executions
+    if (NapiHelper::IsAsyncFunction(env, func) || NapiHelper::IsGeneratorFunction(env, func)) {
+        return;
+    }
+    if (functionCache_.size() >= MAX_CACHED_FUNCTION_NUM) {
+        ClearFunctionCache();
+    }
+    functionCache_.emplace(functionId, NapiHelper::CreateReference(env, func, 1));
+}
+
+void Worker::ClearFunctionCache()
+{
+    for (auto& [_, funcRef] : functionCache_) {
+        NapiHelper::DeleteReference(workerEnv_, funcRef);
+    }
+    functionCache_.clear();
+}
+
 void Worker::UpdateExecutedInfo()
 {
     // if the worker is blocked, just skip
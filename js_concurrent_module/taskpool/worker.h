@@ -16,7 +16,11 @@
 #ifndef JS_CONCURRENT_MODULE_TASKPOOL_WORKER_H
 #define JS_CONCURRENT_MODULE_TASKPOOL_WORKER_H
 
+#include <deque>
 #include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #if defined(ENABLE_TASKPOOL_FFRT)
 #include "cpp/task.h"
@@ -24,10 +28,13 @@
 #if defined(ENABLE_CONCURRENCY_INTEROP)
     #include "helper/hybrid_concurrent_helper.h"
 #endif
+#include "affinity_helper.h"
+#include "cpu_topology.h"
 #include "helper/concurrent_helper.h"
 #include "helper/error_helper.h"
 #include "helper/napi_helper.h"
 #include "helper/object_helper.h"
+#include "log_manager.h"
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 #include "native_engine/native_engine.h"
@@ -35,6 +42,7 @@
 #include "task.h"
 #include "task_runner.h"
 #include "tools/log.h"
+#include "work_stealing_queue.h"
 
 namespace Commonlibrary::Concurrent::TaskPoolModule {
 using namespace Commonlibrary::Concurrent::Common;
@@ -65,8 +73,14 @@ public:
     using DebuggerPostTask = std::function<void()>;
 
     static Worker* WorkerConstructor(napi_env env);
+    // the worker whose thread is the current thread, nullptr on other threads
+    static Worker* GetCurrentWorker();
 
-    void NotifyExecuteTask();
+    bool NotifyExecuteTask();
+
+    // the per-worker cache of deserialized concurrent functions, only used on the worker thread
+    napi_value GetCachedFunction(napi_env env, uint64_t functionId);
+    void CacheFunction(napi_env env, uint64_t functionId, napi_value func);
 
     void NotifyTaskBegin();
     // the function will only be called when the task is finished or
@@ -187,13 +201,25 @@ private:
     bool IsRunnable(uint64_t currTime) const;
     void UpdateWorkerWakeUpTime();
     void EraseRunningTaskId(uint32_t taskId);
+    void ClearFunctionCache();
 
     static void HandleFunctionResult(napi_env env, Task* task);
     static void PerformTask(const uv_async_t* req);
     static void TaskResultCallback(napi_env env, napi_value result, bool success, void* data);
     static void ReleaseWorkerHandles(const uv_async_t* req);
     static void TriggerGCCheck(const uv_async_t* req);
+    // loads the modules added by prewarm since the last call
+    void PreloadModules();
+    // binds the worker thread to the cores for the workload of the task once the workloads are enabled
+    void BindCoreClass(Task* task);
     static std::string GetFuncNameFromError(napi_env env, napi_value error);
+    // for the result transfer, <ArrayBuffer, byteLength> of the result itself or of its first level
+    using ResultBuffers = std::vector<std::pair<napi_value, size_t>>;
+    static void SerializeResult(napi_env env, Task* task, napi_value result, void** resultData,
+                                std::string& errString);
+    static void CollectResultBuffers(napi_env env, napi_value result, ResultBuffers& buffers);
+    static napi_value GetResultTransferList(napi_env env, Task* task, napi_value result);
+    static void RecordResultBytes(napi_env env, const ResultBuffers& buffers);
 
 #if defined(ENABLE_TASKPOOL_FFRT)
     void InitFfrtInfo();
@@ -217,6 +243,9 @@ private:
     std::atomic<bool> idleState_ = true; // true means the worker is idle
     std::atomic<uint64_t> idlePoint_ = ConcurrentHelper::GetMilliseconds();
     std::atomic<uint64_t> startTime_ = ConcurrentHelper::GetMilliseconds();
+    uint64_t createTime_ = ConcurrentHelper::GetMilliseconds();
+    uint32_t preloadedModuleNum_ = 0; // only used on the worker thread
+    std::atomic<CoreClass> coreClass_ {CoreClass::NONE}; // changed on the worker thread only
     std::atomic<uint64_t> wakeUpTime_ = ConcurrentHelper::GetMilliseconds();
     std::atomic<WorkerState> state_ {WorkerState::IDLE};
     std::atomic<bool> hasExecuted_ = false; // false means this worker hasn't execute any tasks
@@ -230,6 +259,18 @@ private:
     std::atomic<bool> isExecutingLongTask_ = false;
     std::mutex longMutex_;
     std::unordered_set<uint32_t> longTasksSet_ {};
+    WorkStealingQueue* localQueue_ {nullptr};
+    uint32_t localQueueIndex_ = 0;
+    uint32_t localExecuteCount_ = 0;
+    // for the worker affinity of SequenceRunner, the tasks bound to this worker, written under affinityMutex_
+    std::mutex affinityMutex_;
+    std::deque<std::pair<uint32_t, Priority>> affinityQueue_ {};
+    bool isAffinityClosed_ = false;
+    std::atomic<uint32_t> affinityTaskNum_ = 0;
+    std::atomic<bool> isWaking_ = false; // true means the worker has been signaled but not run PerformTask yet
+    uint64_t idleSeq_ = 0; // the order in which the worker became idle, written under workersMutex_
+    TaskEventRing* eventRing_ {nullptr}; // only written by the worker thread
+    std::unordered_map<uint64_t, napi_ref> functionCache_ {}; // <FunctionSerialization::id, function>
     friend class TaskManager;
     friend class NativeEngineTest;
 
@@ -14,12 +14,24 @@
  */
 
 #include "async_lock.h"
+
+#include <algorithm>
+#include <chrono>
+
 #include "async_lock_manager.h"
+#include "deadlock_helpers.h"
 #include "tools/log.h"
+#include "wait_for_graph.h"
 
 namespace Commonlibrary::Concurrent::LocksModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
 
+uint64_t AsyncLock::GetNowMillis()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
 AsyncLock::AsyncLock(const std::string &lockName)
 {
     lockName_ = lockName;
@@ -41,15 +53,35 @@ napi_value AsyncLock::LockAsync(napi_env env, napi_ref cb, LockMode mode, const
         ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "env is not alive");
         return nullptr;
     }
+    uint64_t callSiteId = LockRequest::GetCallSiteId(env, cb);
+    std::shared_ptr<const std::string> stacktrace = LockRequest::CaptureStack(env, this, mode);
+    std::unique_lock<std::mutex> guard(asyncLockMutex_);
+    if (CanGrantAtOnceUnsafe(mode)) {
+        // nothing to wait for: the lock is granted at once and the callback is called directly, like a
+        // synchronous shared request, without the async work and timer of a waiting request
+        LockRequest *lockRequest = new LockRequest(this, AsyncLockManager::GetCurrentTid(env), env, cb, mode,
+                                                   options, deferred, callSiteId, std::move(stacktrace), true);
+        lockStatus_ = mode;
+        lastGrantMode_ = mode;
+        RecordWaitUnsafe(mode, 0);
+        AddHeldRequestUnsafe(lockRequest);
+        guard.unlock();
+        lockRequest->CallCallback();
+        return promise;
+    }
+    guard.unlock();
     if (!CanAcquireLock(mode) && options.isAvailable) {
         napi_value err;
         NAPI_CALL(env, napi_create_string_utf8(env, "The lock is acquired", NAPI_AUTO_LENGTH, &err));
         napi_reject_deferred(env, deferred, err);
     } else {
-        LockRequest *lockRequest =
-            new LockRequest(this, AsyncLockManager::GetCurrentTid(env), env, cb, mode, options, deferred);
+        LockRequest *lockRequest = new LockRequest(this, AsyncLockManager::GetCurrentTid(env), env, cb, mode,
+                                                   options, deferred, callSiteId, std::move(stacktrace));
         std::unique_lock<std::mutex> lock(asyncLockMutex_);
         pendingList_.push_back(lockRequest);
+        if (mode == LOCK_MODE_EXCLUSIVE) {
+            pendingExclusiveNum_++;
+        }
         ProcessPendingLockRequestUnsafe(env, lockRequest);
     }
     return promise;
@@ -68,10 +100,12 @@ void AsyncLock::CleanUpLockRequestOnCompletion(LockRequest* lockRequest)
         // There are may be other shared lock requests in the heldList_.
         // IF so, we mustn't change the status.
         lockStatus_ = LOCK_MODE_UNLOCK;
+        heldSinceMillis_.store(0, std::memory_order_relaxed);
     }
     napi_env env = lockRequest->GetEnv();
     delete lockRequest;
     if (pendingList_.empty()) {
+        UpdateWaitEdgesUnsafe();
         if (refCount_ == 0 && heldList_.empty()) {
             lock.unlock();
             AsyncLockManager::CheckAndRemoveLock(this);
@@ -90,15 +124,20 @@ bool AsyncLock::CleanUpLockRequest(LockRequest *lockRequest)
         return false;
     }
     // we won the race, need to remove the request from the queue and handle the time out event
-    pendingList_.erase(it);
+    ErasePendingRequestUnsafe(it);
+    UpdateWaitEdgesUnsafe();
     return true;
 }
 
 template <bool isAsync>
-void AsyncLock::ProcessLockRequest(napi_env env, LockRequest *lockRequest)
+void AsyncLock::ProcessLockRequest(napi_env env, std::list<LockRequest *>::iterator it)
 {
-    heldList_.push_back(lockRequest);
-    pendingList_.pop_front();
+    LockRequest *lockRequest = *it;
+    uint64_t now = GetNowMillis();
+    uint64_t creationMillis = lockRequest->GetCreationMillis();
+    RecordWaitUnsafe(lockRequest->GetMode(), now > creationMillis ? now - creationMillis : 0);
+    AddHeldRequestUnsafe(lockRequest);
+    ErasePendingRequestUnsafe(it);
     asyncLockMutex_.unlock();
     if constexpr (isAsync) {
         lockRequest->CallCallbackAsync();
@@ -123,26 +162,170 @@ void AsyncLock::ProcessPendingLockRequest(napi_env env, LockRequest* syncLockReq
 
 void AsyncLock::ProcessPendingLockRequestUnsafe(napi_env env, LockRequest *syncLockRequest)
 {
-    LockRequest *lockRequest = pendingList_.front();
-    if (!CanAcquireLockUnsafe(lockRequest->GetMode())) {
-        return;
+    // the mutex is released while a granted callback is called, so the next request is looked up again each time
+    for (auto it = NextGrantUnsafe(); it != pendingList_.end(); it = NextGrantUnsafe()) {
+        LockRequest *lockRequest = *it;
+        lockStatus_ = lockRequest->GetMode();
+        lastGrantMode_ = lockStatus_;
+        if (lockStatus_ == LOCK_MODE_EXCLUSIVE) {
+            readBatchLeft_ = 0;
+            ProcessLockRequest<true>(env, it);
+            continue;
+        }
+        if (readBatchLeft_ > 0) {
+            readBatchLeft_--;
+        }
+        if (syncLockRequest == lockRequest) {
+            ProcessLockRequest<false>(env, it);
+        } else {
+            ProcessLockRequest<true>(env, it);
+        }
+    }
+    UpdateWaitEdgesUnsafe();
+}
+
+bool AsyncLock::CanGrantAtOnceUnsafe(LockMode mode)
+{
+    if (!CanAcquireLockUnsafe(mode)) {
+        return false;
+    }
+    if (mode == LOCK_MODE_EXCLUSIVE || policy_ == LOCK_POLICY_FIFO) {
+        return pendingList_.empty();
+    }
+    if (policy_ == LOCK_POLICY_READER_PREFERRING) {
+        return true;
+    }
+    // a waiting exclusive request closes the lock to new shared requests
+    return pendingExclusiveNum_ == 0;
+}
+
+std::list<LockRequest *>::iterator AsyncLock::NextGrantUnsafe()
+{
+    if (pendingList_.empty()) {
+        return pendingList_.end();
     }
-    lockStatus_ = lockRequest->GetMode();
-    if (lockStatus_ == LOCK_MODE_SHARED) {
-        do {
-            if (syncLockRequest == lockRequest) {
-                ProcessLockRequest<false>(env, lockRequest);
-            } else {
-                ProcessLockRequest<true>(env, lockRequest);
+    bool isFree = heldList_.empty() || lockStatus_ == LOCK_MODE_UNLOCK;
+    if (!isFree && lockStatus_ != LOCK_MODE_SHARED) {
+        return pendingList_.end();
+    }
+    if (policy_ == LOCK_POLICY_FIFO) {
+        auto front = pendingList_.begin();
+        return (isFree || (*front)->GetMode() == LOCK_MODE_SHARED) ? front : pendingList_.end();
+    }
+    auto isShared = [](const LockRequest *request) { return request->GetMode() == LOCK_MODE_SHARED; };
+    auto firstShared = pendingExclusiveNum_ == pendingList_.size() ? pendingList_.end() :
+        std::find_if(pendingList_.begin(), pendingList_.end(), isShared);
+    auto firstExclusive = pendingExclusiveNum_ == 0 ? pendingList_.end() :
+        std::find_if_not(pendingList_.begin(), pendingList_.end(), isShared);
+    switch (policy_) {
+        case LOCK_POLICY_READER_PREFERRING:
+            if (firstShared != pendingList_.end()) {
+                return firstShared;
             }
-            if (pendingList_.empty()) {
-                break;
+            return isFree ? firstExclusive : pendingList_.end();
+        case LOCK_POLICY_WRITER_PREFERRING:
+            if (firstExclusive == pendingList_.end()) {
+                return firstShared;
             }
-            lockRequest = pendingList_.front();
-        } while (lockRequest->GetMode() == LOCK_MODE_SHARED);
-    } else {
-        ProcessLockRequest<true>(env, lockRequest);
+            return isFree ? firstExclusive : pendingList_.end();
+        case LOCK_POLICY_PHASE_FAIR:
+            if (firstExclusive == pendingList_.end()) {
+                return firstShared;
+            }
+            if (!isFree) {
+                return readBatchLeft_ > 0 ? firstShared : pendingList_.end();
+            }
+            if (lastGrantMode_ == LOCK_MODE_EXCLUSIVE && firstShared != pendingList_.end()) {
+                // the read phase after a write phase takes the shared requests waiting now, not the later ones
+                readBatchLeft_ = pendingList_.size() - pendingExclusiveNum_;
+                return firstShared;
+            }
+            return firstExclusive;
+        default:
+            return pendingList_.end();
+    }
+}
+
+void AsyncLock::ErasePendingRequestUnsafe(std::list<LockRequest *>::iterator it)
+{
+    if ((*it)->GetMode() == LOCK_MODE_EXCLUSIVE) {
+        pendingExclusiveNum_--;
+    }
+    pendingList_.erase(it);
+}
+
+void AsyncLock::RecordWaitUnsafe(LockMode mode, uint64_t waitMillis)
+{
+    // 64: the bits of waitMillis, a wait in [2^(i-1), 2^i) has i significant bits
+    size_t bucket = waitMillis == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(waitMillis));
+    bucket = std::min(bucket, WAIT_HISTOGRAM_SIZE - 1);
+    WaitHistogram &waits = mode == LOCK_MODE_SHARED ? sharedWaits_ : exclusiveWaits_;
+    waits[bucket]++;
+}
+
+void AsyncLock::SetPolicy(napi_env env, LockPolicy policy)
+{
+    std::unique_lock<std::mutex> lock(asyncLockMutex_);
+    policy_ = policy;
+    readBatchLeft_ = 0;
+    // the waiting requests may be granted under the new policy
+    if (!pendingList_.empty()) {
+        ProcessPendingLockRequestUnsafe(env);
+    }
+}
+
+AsyncLock::WaitHistogram AsyncLock::GetWaitHistogram(LockMode mode)
+{
+    std::unique_lock<std::mutex> lock(asyncLockMutex_);
+    return mode == LOCK_MODE_SHARED ? sharedWaits_ : exclusiveWaits_;
+}
+
+void AsyncLock::UpdateWaitEdgesUnsafe()
+{
+    std::vector<WaitEdge> edges {};
+    if (!heldList_.empty() && !pendingList_.empty()) {
+        // the shared holders are often on a few threads
+        std::vector<tid_t> holderTids {};
+        for (LockRequest *holder : heldList_) {
+            if (std::find(holderTids.begin(), holderTids.end(), holder->GetTid()) == holderTids.end()) {
+                holderTids.push_back(holder->GetTid());
+            }
+        }
+        for (LockRequest *waiter : pendingList_) {
+            for (tid_t holderTid : holderTids) {
+                edges.push_back(WaitEdge {waiter->GetTid(), holderTid});
+            }
+        }
+    }
+    if (edges.empty() && !hasWaitEdges_) {
+        // the lock has never been waited for since it was last free, the graph has nothing of it
+        return;
+    }
+    hasWaitEdges_ = !edges.empty();
+    std::string lockName = anonymousLockId_ == 0 ? lockName_ : "anonymous #" + std::to_string(anonymousLockId_);
+    DeadlockInfo deadlock = WaitForGraph::GetInstance().UpdateLock(this, lockName, std::move(edges));
+    if (!deadlock.IsEmpty()) {
+        std::string warning = CreateDeadlockWarningMessage(std::move(deadlock));
+        HILOG_WARN("DeadlockDetector: %{public}s", warning.c_str());
+    }
+}
+
+void AsyncLock::AddHeldRequestUnsafe(LockRequest *lockRequest)
+{
+    if (heldList_.empty()) {
+        heldSinceMillis_.store(GetNowMillis(), std::memory_order_relaxed);
+    }
+    heldList_.push_back(lockRequest);
+}
+
+uint64_t AsyncLock::GetHeldMillis() const
+{
+    uint64_t heldSince = heldSinceMillis_.load(std::memory_order_relaxed);
+    if (heldSince == 0) {
+        return 0;
     }
+    uint64_t now = GetNowMillis();
+    return now > heldSince ? now - heldSince : 0;
 }
 
 bool AsyncLock::CanAcquireLockUnsafe(LockMode mode)
@@ -246,7 +429,8 @@ std::vector<RequestCreationInfo> AsyncLock::GetSatisfiedRequestInfos()
     std::vector<RequestCreationInfo> result;
     std::unique_lock<std::mutex> lock(asyncLockMutex_);
     for (auto *request : heldList_) {
-        result.push_back(RequestCreationInfo { request->GetTid(), request->GetCreationStacktrace() });
+        result.push_back(
+            RequestCreationInfo { request->GetTid(), request->GetCallSiteId(), request->GetCreationStacktrace() });
     }
     return result;
 }
@@ -256,7 +440,8 @@ std::vector<RequestCreationInfo> AsyncLock::GetPendingRequestInfos()
     std::vector<RequestCreationInfo> result;
     std::unique_lock<std::mutex> lock(asyncLockMutex_);
     for (auto *request : pendingList_) {
-        result.push_back(RequestCreationInfo { request->GetTid(), request->GetCreationStacktrace() });
+        result.push_back(
+            RequestCreationInfo { request->GetTid(), request->GetCallSiteId(), request->GetCreationStacktrace() });
     }
     return result;
 }
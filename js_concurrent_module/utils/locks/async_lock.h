@@ -16,7 +16,10 @@
 #ifndef JS_CONCURRENT_MODULE_UTILS_LOCKS_ASYNC_LOCK_H
 #define JS_CONCURRENT_MODULE_UTILS_LOCKS_ASYNC_LOCK_H
 
+#include <array>
+#include <atomic>
 #include <list>
+#include <memory>
 #include <string>
 #include "common.h"
 #include "lock_request.h"
@@ -26,9 +29,26 @@
 
 namespace Commonlibrary::Concurrent::LocksModule {
 
+// The order in which the waiting requests get the lock:
+// FIFO grants the first request, and the shared requests following it together.
+// READER_PREFERRING grants every shared request while the lock is not held exclusively, the exclusive ones wait
+// until no shared request is left.
+// WRITER_PREFERRING grants the first exclusive request once the lock is free, a waiting exclusive request keeps
+// new shared requests from joining the holders.
+// PHASE_FAIR alternates: after an exclusive holder the shared requests waiting at that moment are granted
+// together, after them the first exclusive request, so neither side waits for more than one phase of the other.
+enum LockPolicy {
+    LOCK_POLICY_FIFO,
+    LOCK_POLICY_READER_PREFERRING,
+    LOCK_POLICY_WRITER_PREFERRING,
+    LOCK_POLICY_PHASE_FAIR,
+    LOCK_POLICY_MAX
+};
+
 struct RequestCreationInfo {
     tid_t tid;
-    std::string creationStacktrace;
+    uint64_t callSiteId;
+    std::shared_ptr<const std::string> creationStacktrace;
 };
 
 class AsyncLock {
@@ -37,11 +57,20 @@ public:
     explicit AsyncLock(uint32_t lockId);
     ~AsyncLock() = default;
 
+    // 16: bucket 0 counts the waits below 1 ms, bucket i the waits in [2^(i-1), 2^i) ms, the last one the rest
+    static constexpr size_t WAIT_HISTOGRAM_SIZE = 16;
+    using WaitHistogram = std::array<uint64_t, WAIT_HISTOGRAM_SIZE>;
+
+    static uint64_t GetNowMillis();
+
     napi_value LockAsync(napi_env env, napi_ref cb, LockMode mode, const LockOptions &options);
     void CleanUpLockRequestOnCompletion(LockRequest* lockRequest);
     bool CleanUpLockRequest(LockRequest *lockRequest);
     napi_status FillLockState(napi_env env, napi_value held, napi_value pending);
     void ProcessPendingLockRequest(napi_env env, LockRequest* syncLockRequest = nullptr);
+    void SetPolicy(napi_env env, LockPolicy policy);
+    // the waits of the granted requests of the mode, an uncontended request counts as a wait of 0 ms
+    WaitHistogram GetWaitHistogram(LockMode mode);
 
     // Increment the reference counter
     uint32_t IncRefCount();
@@ -62,14 +91,29 @@ public:
     {
         return anonymousLockId_;
     }
+    // how long the lock has been held without being free in between, 0 if it is free
+    uint64_t GetHeldMillis() const;
+    bool IsHeld() const
+    {
+        return heldSinceMillis_.load(std::memory_order_relaxed) != 0;
+    }
+    bool CanAcquireLock(LockMode mode);
 
 private:
     bool CanAcquireLockUnsafe(LockMode mode);
-    bool CanAcquireLock(LockMode mode);
+    // a new request is granted without being queued
+    bool CanGrantAtOnceUnsafe(LockMode mode);
+    // the pending request to be granted next under the policy, or the end of pendingList_
+    std::list<LockRequest *>::iterator NextGrantUnsafe();
     napi_value CreateLockInfo(napi_env env, const LockRequest *rq);
     template <bool isAsync>
-    void ProcessLockRequest(napi_env env, LockRequest *lockRequest);
+    void ProcessLockRequest(napi_env env, std::list<LockRequest *>::iterator it);
+    void ErasePendingRequestUnsafe(std::list<LockRequest *>::iterator it);
+    void RecordWaitUnsafe(LockMode mode, uint64_t waitMillis);
     void ProcessPendingLockRequestUnsafe(napi_env env, LockRequest* syncLockRequest = nullptr);
+    void AddHeldRequestUnsafe(LockRequest *lockRequest);
+    // replaces the edges of the lock in the wait-for graph after its holders or waiters have changed
+    void UpdateWaitEdgesUnsafe();
 
     std::list<LockRequest *> pendingList_ {};
     std::list<LockRequest *> heldList_ {};
@@ -78,6 +122,15 @@ private:
     uint32_t anonymousLockId_ {};  // 0 for Non-anonymous lock
     std::mutex asyncLockMutex_;
     uint32_t refCount_ = 1;
+    std::atomic<uint64_t> heldSinceMillis_ {0};  // 0 while the lock is free
+    bool hasWaitEdges_ = false;
+    LockPolicy policy_ = LOCK_POLICY_FIFO;
+    size_t pendingExclusiveNum_ = 0;
+    LockMode lastGrantMode_ = LOCK_MODE_UNLOCK;
+    // the shared requests left in the read phase of PHASE_FAIR
+    size_t readBatchLeft_ = 0;
+    WaitHistogram sharedWaits_ {};
+    WaitHistogram exclusiveWaits_ {};
 };
 
 }  // namespace Commonlibrary::Concurrent::LocksModule
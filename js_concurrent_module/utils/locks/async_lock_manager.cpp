@@ -20,6 +20,7 @@
 
 #include "async_lock.h"
 #include "deadlock_helpers.h"
+#include "wait_for_graph.h"
 #include "helper/error_helper.h"
 #include "helper/hitrace_helper.h"
 #include "helper/napi_helper.h"
@@ -31,9 +32,7 @@ using namespace Commonlibrary::Concurrent::Common::Helper;
 
 static thread_local napi_ref asyncLockClassRef = nullptr;
 
-std::mutex AsyncLockManager::lockMutex;
-std::unordered_map<std::string, AsyncLock *> AsyncLockManager::lockMap = {};
-std::unordered_map<uint32_t, AsyncLock *> AsyncLockManager::anonymousLockMap = {};
+std::array<AsyncLockManager::LockShard, AsyncLockManager::LOCK_SHARD_NUM> AsyncLockManager::lockShards {};
 std::atomic<uint32_t> AsyncLockManager::nextId = 1;
 
 static napi_value AsyncLockOptionsCtor(napi_env env, napi_callback_info cbinfo)
@@ -67,20 +66,22 @@ void AsyncLockManager::CollectLockDependencies(std::vector<AsyncLockDependency>
             return;
         }
         auto holderTid = holderInfos[0].tid;
-        dependencies.push_back(
-            AsyncLockDependency {INVALID_TID, holderTid, lockName, holderInfos[0].creationStacktrace});
+        dependencies.push_back(AsyncLockDependency {INVALID_TID, holderTid, lockName, holderInfos[0].callSiteId,
+            std::move(holderInfos[0].creationStacktrace)});
         for (auto &waiterInfo : lock->GetPendingRequestInfos()) {
-            dependencies.push_back(
-                AsyncLockDependency {waiterInfo.tid, holderTid, lockName, waiterInfo.creationStacktrace});
+            dependencies.push_back(AsyncLockDependency {waiterInfo.tid, holderTid, lockName, waiterInfo.callSiteId,
+                std::move(waiterInfo.creationStacktrace)});
         }
     };
-    std::unique_lock<std::mutex> guard(lockMutex);
-    for (auto [name, lock] : lockMap) {
-        lockProcessor(name, lock);
-    }
-    for (auto [id, lock] : anonymousLockMap) {
-        std::string lockName = "anonymous #" + std::to_string(id);
-        lockProcessor(lockName, lock);
+    for (LockShard &shard : lockShards) {
+        std::unique_lock<std::mutex> guard(shard.mutex);
+        for (auto [name, lock] : shard.lockMap) {
+            lockProcessor(name, lock);
+        }
+        for (auto [id, lock] : shard.anonymousLockMap) {
+            std::string lockName = "anonymous #" + std::to_string(id);
+            lockProcessor(lockName, lock);
+        }
     }
 }
 
@@ -88,15 +89,14 @@ void AsyncLockManager::DumpLocksInfoForThread(tid_t targetTid, std::string &resu
 {
     std::vector<AsyncLockDependency> deps;
     CollectLockDependencies(deps);
-    auto deadlock = CheckDeadlocks(deps);
+    auto deadlock = WaitForGraph::GetInstance().FindCycle();
     result = CreateFullLockInfosMessage(targetTid, std::move(deps), std::move(deadlock));
 }
 
 void AsyncLockManager::CheckDeadlocksAndLogWarning()
 {
-    std::vector<AsyncLockDependency> deps;
-    CollectLockDependencies(deps);
-    auto deadlock = CheckDeadlocks(deps);
+    // the wait-for graph is kept up to date by the locks, neither the shards nor the locks are locked here
+    auto deadlock = WaitForGraph::GetInstance().FindCycle();
     if (!deadlock.IsEmpty()) {
         std::string warning = CreateDeadlockWarningMessage(std::move(deadlock));
         HILOG_WARN("DeadlockDetector: %{public}s", warning.c_str());
@@ -113,8 +113,10 @@ napi_value AsyncLockManager::Init(napi_env env, napi_value exports)
         DECLARE_NAPI_STATIC_FUNCTION("request", Request),
         DECLARE_NAPI_STATIC_FUNCTION("query", Query),
         DECLARE_NAPI_STATIC_FUNCTION("queryAll", QueryAll),
+        DECLARE_NAPI_STATIC_FUNCTION("setStackCapturePolicy", SetStackCapturePolicy),
         DECLARE_NAPI_INSTANCE_PROPERTY("name", name),
         DECLARE_NAPI_INSTANCE_OBJECT_PROPERTY("lockAsync"),
+        DECLARE_NAPI_INSTANCE_OBJECT_PROPERTY("setPolicy"),
     };
 
     napi_value asyncLockManagerClass = nullptr;
@@ -132,6 +134,35 @@ napi_value AsyncLockManager::Init(napi_env env, napi_value exports)
     };
     napi_define_properties(env, asyncLockMode, sizeof(exportMode) / sizeof(exportMode[0]), exportMode);
 
+    // StackCaptureMode enum
+    napi_value stackCaptureMode = NapiHelper::CreateObject(env);
+    napi_value captureOff = NapiHelper::CreateUint32(env, STACK_CAPTURE_OFF);
+    napi_value captureSampled = NapiHelper::CreateUint32(env, STACK_CAPTURE_SAMPLED);
+    napi_value captureAlways = NapiHelper::CreateUint32(env, STACK_CAPTURE_ALWAYS);
+    napi_value captureWaiting = NapiHelper::CreateUint32(env, STACK_CAPTURE_WAITING);
+    napi_property_descriptor exportCaptureMode[] = {
+        DECLARE_NAPI_PROPERTY("OFF", captureOff),
+        DECLARE_NAPI_PROPERTY("SAMPLED", captureSampled),
+        DECLARE_NAPI_PROPERTY("ALWAYS", captureAlways),
+        DECLARE_NAPI_PROPERTY("WAITING", captureWaiting),
+    };
+    napi_define_properties(env, stackCaptureMode, sizeof(exportCaptureMode) / sizeof(exportCaptureMode[0]),
+                           exportCaptureMode);
+
+    // AsyncLockPolicy enum
+    napi_value asyncLockPolicy = NapiHelper::CreateObject(env);
+    napi_value fifoPolicy = NapiHelper::CreateUint32(env, LOCK_POLICY_FIFO);
+    napi_value readerPreferringPolicy = NapiHelper::CreateUint32(env, LOCK_POLICY_READER_PREFERRING);
+    napi_value writerPreferringPolicy = NapiHelper::CreateUint32(env, LOCK_POLICY_WRITER_PREFERRING);
+    napi_value phaseFairPolicy = NapiHelper::CreateUint32(env, LOCK_POLICY_PHASE_FAIR);
+    napi_property_descriptor exportPolicy[] = {
+        DECLARE_NAPI_PROPERTY("FIFO", fifoPolicy),
+        DECLARE_NAPI_PROPERTY("READER_PREFERRING", readerPreferringPolicy),
+        DECLARE_NAPI_PROPERTY("WRITER_PREFERRING", writerPreferringPolicy),
+        DECLARE_NAPI_PROPERTY("PHASE_FAIR", phaseFairPolicy),
+    };
+    napi_define_properties(env, asyncLockPolicy, sizeof(exportPolicy) / sizeof(exportPolicy[0]), exportPolicy);
+
     // AsyncLockOptions
     napi_value asyncLockOptionsClass = nullptr;
     napi_define_class(env, "AsyncLockOptions", NAPI_AUTO_LENGTH, AsyncLockOptionsCtor, nullptr, 0, nullptr,
@@ -150,6 +181,8 @@ napi_value AsyncLockManager::Init(napi_env env, napi_value exports)
         DECLARE_NAPI_PROPERTY("AsyncLock", asyncLockManagerClass),
         DECLARE_NAPI_PROPERTY("AsyncLockMode", asyncLockMode),
         DECLARE_NAPI_PROPERTY("AsyncLockOptions", asyncLockOptionsClass),
+        DECLARE_NAPI_PROPERTY("AsyncLockPolicy", asyncLockPolicy),
+        DECLARE_NAPI_PROPERTY("StackCaptureMode", stackCaptureMode),
     };
     napi_define_properties(env, locks, sizeof(locksProperties) / sizeof(locksProperties[0]), locksProperties);
 
@@ -194,6 +227,7 @@ napi_value AsyncLockManager::Constructor(napi_env env, napi_callback_info cbinfo
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_PROPERTY("name", name),
         DECLARE_NAPI_FUNCTION_WITH_DATA("lockAsync", LockAsync, thisVar),
+        DECLARE_NAPI_FUNCTION_WITH_DATA("setPolicy", SetPolicy, thisVar),
     };
     NAPI_CALL(env, napi_define_properties(env, thisVar, sizeof(properties) / sizeof(properties[0]), properties));
     NAPI_CALL(env, napi_wrap_sendable(env, thisVar, data, Destructor, nullptr));
@@ -219,50 +253,52 @@ napi_value AsyncLockManager::Request(napi_env env, napi_callback_info cbinfo)
 void AsyncLockManager::Destructor(napi_env env, void *data, [[maybe_unused]] void *hint)
 {
     std::unique_ptr<AsyncLockIdentity> identity(reinterpret_cast<AsyncLockIdentity *>(data));
-    std::unique_lock<std::mutex> guard(lockMutex);
+    LockShard &shard = GetLockShard(*identity);
+    std::unique_lock<std::mutex> guard(shard.mutex);
     if (identity->isAnonymous) {
         // no way to have >1 reference to an anonymous lock
-        auto it = anonymousLockMap.find(identity->id);
-        if ((it == anonymousLockMap.end())) {
+        auto it = shard.anonymousLockMap.find(identity->id);
+        if ((it == shard.anonymousLockMap.end())) {
             return;
         }
         AsyncLock *asyncLock = it->second;
         if (!asyncLock->IsReadyForDeletion()) {
             return;
         }
-        anonymousLockMap.erase(it);
+        shard.anonymousLockMap.erase(it);
         delete asyncLock;
     } else {
-        auto it = lockMap.find(identity->name);
-        if ((it == lockMap.end())) {
+        auto it = shard.lockMap.find(identity->name);
+        if ((it == shard.lockMap.end())) {
             return;
         }
         AsyncLock *asyncLock = it->second;
         if (!asyncLock->IsReadyForDeletion()) {
             return;
         }
-        lockMap.erase(it);
+        shard.lockMap.erase(it);
         delete asyncLock;
     }
 }
 
 void AsyncLockManager::CheckAndRemoveLock(AsyncLock *lock)
 {
-    std::unique_lock<std::mutex> guard(lockMutex);
+    uint32_t id = lock->GetLockId();
+    AsyncLockIdentity identity {id != 0, id, id == 0 ? lock->GetLockName() : ""};
+    LockShard &shard = GetLockShard(identity);
+    std::unique_lock<std::mutex> guard(shard.mutex);
     if (!lock->IsReadyForDeletion()) {
         return;
     }
-    uint32_t id = lock->GetLockId();
     if (id == 0) {
-        std::string name = lock->GetLockName();
-        auto it = lockMap.find(name);
-        if (it != lockMap.end()) {
-            lockMap.erase(it);
+        auto it = shard.lockMap.find(identity.name);
+        if (it != shard.lockMap.end()) {
+            shard.lockMap.erase(it);
         }
     } else {
-        auto it = anonymousLockMap.find(id);
-        if (it != anonymousLockMap.end()) {
-            anonymousLockMap.erase(it);
+        auto it = shard.anonymousLockMap.find(id);
+        if (it != shard.anonymousLockMap.end()) {
+            shard.anonymousLockMap.erase(it);
         }
     }
     delete lock;
@@ -283,7 +319,7 @@ napi_value AsyncLockManager::LockAsync(napi_env env, napi_callback_info cbinfo)
 
     AsyncLock *asyncLock = nullptr;
     {
-        std::unique_lock<std::mutex> guard(lockMutex);
+        std::unique_lock<std::mutex> guard(GetLockShard(*id).mutex);
         asyncLock = FindAsyncLockUnsafe(id);
     }
     if (asyncLock == nullptr) {
@@ -322,7 +358,7 @@ napi_value AsyncLockManager::Query(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
 
-    // later on we can decide to cache the check result if needed
+    // a deadlock is reported by the lock as soon as it forms, this repeats the warning for the caller
     CheckDeadlocksAndLogWarning();
 
     napi_value undefined;
@@ -340,7 +376,7 @@ napi_value AsyncLockManager::Query(napi_env env, napi_callback_info cbinfo)
     AsyncLockIdentity identity{false, 0, nameStr};
     AsyncLock *lock = nullptr;
     {
-        std::unique_lock<std::mutex> guard(lockMutex);
+        std::unique_lock<std::mutex> guard(GetLockShard(identity).mutex);
         lock = FindAsyncLockUnsafe(&identity);
     }
     if (lock == nullptr) {
@@ -359,13 +395,75 @@ napi_value AsyncLockManager::QueryAll(napi_env env, napi_callback_info cbinfo)
         return nullptr;
     }
 
-    // later on we can decide to cache the check result if needed
+    // a deadlock is reported by the lock as soon as it forms, this repeats the warning for the caller
     CheckDeadlocksAndLogWarning();
     return CreateLockStates(env, [] ([[maybe_unused]] const AsyncLockIdentity &identity) {
         return true;
     });
 }
 
+napi_value AsyncLockManager::SetPolicy(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
+    if (argc != 1) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid number of arguments");
+        return nullptr;
+    }
+    napi_value arg;
+    napi_value thisVar;
+    NAPI_CALL(env, napi_get_cb_info(env, cbinfo, &argc, &arg, &thisVar, nullptr));
+    if (!NapiHelper::IsNumber(env, arg)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid argument type");
+        return nullptr;
+    }
+    uint32_t policy = NapiHelper::GetUint32Value(env, arg);
+    if (policy >= LOCK_POLICY_MAX) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid lock policy.");
+        return nullptr;
+    }
+
+    AsyncLockIdentity *id;
+    NAPI_CALL(env, napi_unwrap_sendable(env, thisVar, reinterpret_cast<void **>(&id)));
+    AsyncLock *asyncLock = nullptr;
+    {
+        std::unique_lock<std::mutex> guard(GetLockShard(*id).mutex);
+        asyncLock = FindAsyncLockUnsafe(id);
+    }
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    if (asyncLock == nullptr) {
+        ErrorHelper::ThrowError(env, ErrorHelper::ERR_NO_SUCH_ASYNCLOCK);
+        return undefined;
+    }
+    asyncLock->SetPolicy(env, static_cast<LockPolicy>(policy));
+    return undefined;
+}
+
+napi_value AsyncLockManager::SetStackCapturePolicy(napi_env env, napi_callback_info cbinfo)
+{
+    size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
+    if (argc < 1 || argc > 2U) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid number of arguments");
+        return nullptr;
+    }
+    napi_value argv[2U] = {nullptr};
+    NAPI_CALL(env, napi_get_cb_info(env, cbinfo, &argc, argv, nullptr, nullptr));
+    if (!NapiHelper::IsNumber(env, argv[0]) || (argc > 1 && !NapiHelper::IsNumber(env, argv[1]))) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid argument type");
+        return nullptr;
+    }
+    uint32_t mode = NapiHelper::GetUint32Value(env, argv[0]);
+    uint32_t value = argc > 1 ? NapiHelper::GetUint32Value(env, argv[1]) : 0;
+    if (mode >= STACK_CAPTURE_MAX ||
+        !LockRequest::SetStackCapturePolicy(static_cast<StackCaptureMode>(mode), value)) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Invalid stack capture policy.");
+        return nullptr;
+    }
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
 napi_value AsyncLockManager::CreateLockState(napi_env env, AsyncLock *asyncLock)
 {
     napi_value undefined;
@@ -395,10 +493,34 @@ napi_value AsyncLockManager::CreateLockState(napi_env env, AsyncLock *asyncLock)
         ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Cannot create an object");
         return undefined;
     }
+    napi_value sharedWaits = CreateWaitHistogram(env, asyncLock->GetWaitHistogram(LOCK_MODE_SHARED));
+    napi_value exclusiveWaits = CreateWaitHistogram(env, asyncLock->GetWaitHistogram(LOCK_MODE_EXCLUSIVE));
+    if (sharedWaits == nullptr || exclusiveWaits == nullptr) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "Cannot create an object");
+        return undefined;
+    }
+    napi_property_descriptor waitProperties[] = {
+        DECLARE_NAPI_PROPERTY("sharedWaitHistogram", sharedWaits),
+        DECLARE_NAPI_PROPERTY("exclusiveWaitHistogram", exclusiveWaits),
+    };
+    NAPI_CALL(env, napi_define_properties(env, result, sizeof(waitProperties) / sizeof(waitProperties[0]),
+                                          waitProperties));
 
     return result;
 }
 
+napi_value AsyncLockManager::CreateWaitHistogram(napi_env env, const AsyncLock::WaitHistogram &histogram)
+{
+    napi_value array;
+    NAPI_CALL(env, napi_create_array_with_length(env, histogram.size(), &array));
+    for (uint32_t i = 0; i < histogram.size(); i++) {
+        napi_value count;
+        NAPI_CALL(env, napi_create_int64(env, static_cast<int64_t>(histogram[i]), &count));
+        NAPI_CALL(env, napi_set_element(env, array, i, count));
+    }
+    return array;
+}
+
 napi_value AsyncLockManager::CreateLockStates(napi_env env,
     const std::function<bool(const AsyncLockIdentity& identity)> &pred)
 {
@@ -408,34 +530,39 @@ napi_value AsyncLockManager::CreateLockStates(napi_env env,
     napi_value array;
     NAPI_CALL(env, napi_create_array(env, &array));
 
-    std::unique_lock<std::mutex> guard(lockMutex);
     uint32_t idx = 0;
-    for (auto &entry : anonymousLockMap) {
-        AsyncLockIdentity identity = {true, entry.first, ""};
-        if (pred(identity)) {
-            napi_value v = CreateLockState(env, entry.second);
-            napi_is_exception_pending(env, &pendingException);
-            if (pendingException) {
-                return undefined;
+    for (LockShard &shard : lockShards) {
+        std::unique_lock<std::mutex> guard(shard.mutex);
+        for (auto &entry : shard.anonymousLockMap) {
+            AsyncLockIdentity identity = {true, entry.first, ""};
+            if (pred(identity)) {
+                napi_value v = CreateLockState(env, entry.second);
+                napi_is_exception_pending(env, &pendingException);
+                if (pendingException) {
+                    return undefined;
+                }
+                napi_value index;
+                NAPI_CALL(env, napi_create_uint32(env, idx, &index));
+                NAPI_CALL(env, napi_set_property(env, array, index, v));
+                ++idx;
             }
-            napi_value index;
-            NAPI_CALL(env, napi_create_uint32(env, idx, &index));
-            NAPI_CALL(env, napi_set_property(env, array, index, v));
-            ++idx;
         }
     }
-    for (auto &entry : lockMap) {
-        AsyncLockIdentity identity = {false, 0, entry.first};
-        if (pred(identity)) {
-            napi_value v = CreateLockState(env, entry.second);
-            napi_is_exception_pending(env, &pendingException);
-            if (pendingException) {
-                return undefined;
+    for (LockShard &shard : lockShards) {
+        std::unique_lock<std::mutex> guard(shard.mutex);
+        for (auto &entry : shard.lockMap) {
+            AsyncLockIdentity identity = {false, 0, entry.first};
+            if (pred(identity)) {
+                napi_value v = CreateLockState(env, entry.second);
+                napi_is_exception_pending(env, &pendingException);
+                if (pendingException) {
+                    return undefined;
+                }
+                napi_value index;
+                NAPI_CALL(env, napi_create_uint32(env, idx, &index));
+                NAPI_CALL(env, napi_set_property(env, array, index, v));
+                ++idx;
             }
-            napi_value index;
-            NAPI_CALL(env, napi_create_uint32(env, idx, &index));
-            NAPI_CALL(env, napi_set_property(env, array, index, v));
-            ++idx;
         }
     }
     return array;
@@ -443,37 +570,46 @@ napi_value AsyncLockManager::CreateLockStates(napi_env env,
 
 void AsyncLockManager::Request(uint32_t id)
 {
-    std::unique_lock<std::mutex> guard(lockMutex);
     AsyncLockIdentity identity{true, id, ""};
+    LockShard &shard = GetLockShard(identity);
+    std::unique_lock<std::mutex> guard(shard.mutex);
     AsyncLock *lock = FindAsyncLockUnsafe(&identity);
     if (lock == nullptr) {
-        anonymousLockMap.emplace(id, new AsyncLock(id));
+        shard.anonymousLockMap.emplace(id, new AsyncLock(id));
     }
 }
 
 void AsyncLockManager::Request(const std::string &name)
 {
-    std::unique_lock<std::mutex> guard(lockMutex);
     AsyncLockIdentity identity{false, 0, name};
+    LockShard &shard = GetLockShard(identity);
+    std::unique_lock<std::mutex> guard(shard.mutex);
     AsyncLock *lock = FindAsyncLockUnsafe(&identity);
     if (lock == nullptr) {
-        lockMap.emplace(name, new AsyncLock(name));
+        shard.lockMap.emplace(name, new AsyncLock(name));
     } else {
         lock->IncRefCount();
     }
 }
 
+AsyncLockManager::LockShard &AsyncLockManager::GetLockShard(const AsyncLockIdentity &identity)
+{
+    size_t hash = identity.isAnonymous ? identity.id : std::hash<std::string> {}(identity.name);
+    return lockShards[hash % LOCK_SHARD_NUM];
+}
+
 AsyncLock* AsyncLockManager::FindAsyncLockUnsafe(AsyncLockIdentity *id)
 {
+    LockShard &shard = GetLockShard(*id);
     if (id->isAnonymous) {
-        auto it = anonymousLockMap.find(id->id);
-        if (it == anonymousLockMap.end()) {
+        auto it = shard.anonymousLockMap.find(id->id);
+        if (it == shard.anonymousLockMap.end()) {
             return nullptr;
         }
         return it->second;
     } else {
-        auto it = lockMap.find(id->name);
-        if (it == lockMap.end()) {
+        auto it = shard.lockMap.find(id->name);
+        if (it == shard.lockMap.end()) {
             return nullptr;
         }
         return it->second;
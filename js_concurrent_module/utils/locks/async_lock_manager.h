@@ -16,6 +16,7 @@
 #ifndef JS_CONCURRENT_MODULE_UTILS_LOCKS_ASYNC_LOCK_MANAGER_H
 #define JS_CONCURRENT_MODULE_UTILS_LOCKS_ASYNC_LOCK_MANAGER_H
 
+#include <array>
 #include <string>
 #include <cstdint>
 #include <unordered_map>
@@ -35,7 +36,9 @@ struct AsyncLockDependency {
     tid_t waiterTid;
     tid_t holderTid;
     std::string name;
-    std::string creationStacktrace;
+    uint64_t callSiteId;
+    // shared with the request, turned into text only when a lock dump is produced
+    std::shared_ptr<const std::string> creationStacktrace;
 };
 
 class AsyncLockManager {
@@ -49,6 +52,8 @@ public:
     static napi_value LockAsync(napi_env env, napi_callback_info cbinfo);
     static napi_value Query(napi_env env, napi_callback_info cbinfo);
     static napi_value QueryAll(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetStackCapturePolicy(napi_env env, napi_callback_info cbinfo);
+    static napi_value SetPolicy(napi_env env, napi_callback_info cbinfo);
 
     static tid_t GetCurrentTid(napi_env env);
     static void DumpLocksInfoForThread(tid_t targetTid, std::string &result);
@@ -67,8 +72,10 @@ public:
 private:
     static napi_value CreateLockStates(napi_env env, const std::function<bool(const AsyncLockIdentity& ident)> &pred);
     static napi_value CreateLockState(napi_env env, AsyncLock *asyncLock);
+    static napi_value CreateWaitHistogram(napi_env env, const AsyncLock::WaitHistogram &histogram);
     static void Request(uint32_t id);
     static void Request(const std::string &name);
+    // the caller holds the mutex of the shard of id
     static AsyncLock *FindAsyncLockUnsafe(AsyncLockIdentity *id);
     static bool GetLockMode(napi_env env, napi_value val, LockMode &mode);
     static bool GetLockOptions(napi_env env, napi_value val, LockOptions &options);
@@ -76,9 +83,18 @@ private:
     static void CollectLockDependencies(std::vector<AsyncLockDependency> &dependencies);
     static void CheckDeadlocksAndLogWarning();
 
-    static std::mutex lockMutex;
-    static std::unordered_map<std::string, AsyncLock *> lockMap;
-    static std::unordered_map<uint32_t, AsyncLock *> anonymousLockMap;
+    // The locks are spread over the shards by the hash of the name or by the id, so the threads requesting and
+    // releasing different locks rarely share a mutex. The reference count of a lock is changed under the mutex
+    // of its shard, which keeps a lock from being found and deleted at once.
+    static constexpr size_t LOCK_SHARD_NUM = 16; // 16: the worker and taskpool threads requesting locks at once
+    struct alignas(64) LockShard { // 64: a cache line, the mutexes of two shards never share one
+        std::mutex mutex;
+        std::unordered_map<std::string, AsyncLock *> lockMap {};
+        std::unordered_map<uint32_t, AsyncLock *> anonymousLockMap {};
+    };
+    static LockShard &GetLockShard(const AsyncLockIdentity &identity);
+
+    static std::array<LockShard, LOCK_SHARD_NUM> lockShards;
     static std::atomic<uint32_t> nextId;
 };
 
@@ -19,18 +19,27 @@
 
 namespace Commonlibrary::Concurrent::LocksModule {
 
+static std::string GetCreationPoint(const AsyncLockDependency &dependency)
+{
+    if (dependency.creationStacktrace == nullptr) {
+        return "call site #" + std::to_string(dependency.callSiteId) + ", stack not captured by the capture policy";
+    }
+    return *dependency.creationStacktrace;
+}
+
 std::string CreateDeadlockWarningMessage(DeadlockInfo &&deadlock)
 {
     std::stringstream s;
-    auto vertexPrinter = [](tid_t tid) { return "TID " + std::to_string(tid); };
-    auto edgePrinter = [](const AsyncLockDependency *edata) {
-        if (edata == nullptr) {
-            return std::string(" <-- lock {NULL} -- WAITED BY ");
-        }
-        return " <-- lock {" + edata->name + "} -- WAITED BY ";
-    };
-    s << "!!! DEADLOCK WARNING !!!\n"
-      << LockGraph::CycleAsString(deadlock, "Possible deadlock: ", "\n", vertexPrinter, edgePrinter);
+    s << "!!! DEADLOCK WARNING !!!\n";
+    if (deadlock.IsEmpty() || deadlock.lockNames.size() + 1 != deadlock.tids.size()) {
+        return s.str();
+    }
+    // from the holder back to its waiters
+    s << "Possible deadlock: TID " << deadlock.tids.back();
+    for (size_t i = deadlock.lockNames.size(); i > 0; i--) {
+        s << " <-- lock {" << deadlock.lockNames[i - 1] << "} -- WAITED BY TID " << deadlock.tids[i - 1];
+    }
+    s << "\n";
     return s.str();
 }
 
@@ -41,12 +50,12 @@ std::string CreateFullLockInfosMessage(tid_t targetTid, std::vector<AsyncLockDep
     s << "\nThread's async locks information:\n";
     for (auto &maybeHeld : dependencies) {
         if ((maybeHeld.holderTid == targetTid) && (maybeHeld.waiterTid == INVALID_TID)) {
-            s << "HELD: lock {" + maybeHeld.name + "} , taken at:\n" + maybeHeld.creationStacktrace + "\n";
+            s << "HELD: lock {" + maybeHeld.name + "} , taken at:\n" + GetCreationPoint(maybeHeld) + "\n";
         }
     }
     for (auto &maybeWaiting : dependencies) {
         if (maybeWaiting.waiterTid == targetTid) {
-            s << "WAITING: lock {" + maybeWaiting.name + "} , taken at:\n" + maybeWaiting.creationStacktrace + "\n";
+            s << "WAITING: lock {" + maybeWaiting.name + "} , taken at:\n" + GetCreationPoint(maybeWaiting) + "\n";
         }
     }
     if (!deadlock.IsEmpty()) {
@@ -57,18 +66,4 @@ std::string CreateFullLockInfosMessage(tid_t targetTid, std::vector<AsyncLockDep
     return s.str();
 }
 
-DeadlockInfo CheckDeadlocks(const std::vector<AsyncLockDependency> &dependencies)
-{
-    LockGraph::AdjacencyList adjlist;
-    for (auto &dep : dependencies) {
-        if (dep.waiterTid == INVALID_TID) {
-            // this is the "held only" edge, skip
-            continue;
-        }
-        adjlist.push_back(std::make_tuple(dep.waiterTid, dep.holderTid, &dep));
-    }
-    LockGraph g(std::move(adjlist));
-    return g.FindFirstCycle();
-}
-
 }  // namespace Commonlibrary::Concurrent::LocksModule
\ No newline at end of file
@@ -17,18 +17,16 @@
 #define JS_CONCURRENT_MODULE_UTILS_LOCKS_DEADLOCK_HELPERS_H
 
 #include "common.h"
-#include "graph.h"
 #include "async_lock_manager.h"
+#include "wait_for_graph.h"
 
 namespace Commonlibrary::Concurrent::LocksModule {
 
-using LockGraph = Graph<tid_t, AsyncLockDependency>;
-using DeadlockInfo = LockGraph::Path;
+using DeadlockInfo = WaitCycle;
 
 std::string CreateDeadlockWarningMessage(DeadlockInfo &&deadlock);
 std::string CreateFullLockInfosMessage(tid_t targetTid, std::vector<AsyncLockDependency> &&dependencies,
                                        DeadlockInfo &&deadlock);
-DeadlockInfo CheckDeadlocks(const std::vector<AsyncLockDependency> &dependencies);
 
 }  // namespace Commonlibrary::Concurrent::LocksModule
 
@@ -22,10 +22,29 @@
 namespace Commonlibrary::Concurrent::LocksModule {
 using namespace Commonlibrary::Concurrent::Common::Helper;
 
+static constexpr uint32_t POLICY_MODE_SHIFT = 32; // 32: the mode in the high half of the policy
+static constexpr uint64_t POLICY_VALUE_MASK = 0xFFFFFFFF; // 0xFFFFFFFF: the value in the low half
+
+std::atomic<uint64_t> LockRequest::stackCapturePolicy_ =
+    static_cast<uint64_t>(STACK_CAPTURE_ALWAYS) << POLICY_MODE_SHIFT;
+std::atomic<uint32_t> LockRequest::sampleCount_ = 0;
+
+bool LockRequest::SetStackCapturePolicy(StackCaptureMode mode, uint32_t value)
+{
+    if (mode < STACK_CAPTURE_OFF || mode >= STACK_CAPTURE_MAX || (mode == STACK_CAPTURE_SAMPLED && value == 0)) {
+        return false;
+    }
+    stackCapturePolicy_.store((static_cast<uint64_t>(mode) << POLICY_MODE_SHIFT) | value, std::memory_order_relaxed);
+    return true;
+}
+
 LockRequest::LockRequest(AsyncLock *lock, tid_t tid, napi_env env, napi_ref cb, LockMode mode,
-                         const LockOptions &options, napi_deferred deferred)
+                         const LockOptions &options, napi_deferred deferred, uint64_t callSiteId,
+                         std::shared_ptr<const std::string> creationStacktrace, bool isUncontended)
     : lock_(lock),
       tid_(tid),
+      callSiteId_(callSiteId),
+      creationStacktrace_(std::move(creationStacktrace)),
       engine_(reinterpret_cast<NativeEngine *>(env)),
       env_(env),
       callback_(cb),
@@ -33,11 +52,13 @@ LockRequest::LockRequest(AsyncLock *lock, tid_t tid, napi_env env, napi_ref cb,
       options_(options),
       deferred_(deferred),
       work_(nullptr),
-      engineId_(engine_->GetId())
+      engineId_(engine_->GetId()),
+      isUncontended_(isUncontended)
 {
-    // saving the creation point (file, function and line) for future use
-    NativeEngine *engine = reinterpret_cast<NativeEngine *>(env);
-    engine->BuildJsStackTrace(creationStacktrace_);
+    if (isUncontended_) {
+        return;
+    }
+    creationMillis_ = AsyncLock::GetNowMillis();
 
     AddEnvCleanupHook();
     InitTimer();
@@ -51,6 +72,46 @@ LockRequest::LockRequest(AsyncLock *lock, tid_t tid, napi_env env, napi_ref cb,
     }
 }
 
+std::shared_ptr<const std::string> LockRequest::CaptureStack(napi_env env, AsyncLock *lock, LockMode mode)
+{
+    uint64_t policy = stackCapturePolicy_.load(std::memory_order_relaxed);
+    uint32_t value = static_cast<uint32_t>(policy & POLICY_VALUE_MASK);
+    bool shouldCapture = false;
+    switch (policy >> POLICY_MODE_SHIFT) {
+        case STACK_CAPTURE_SAMPLED:
+            shouldCapture = sampleCount_.fetch_add(1, std::memory_order_relaxed) % value == 0;
+            break;
+        case STACK_CAPTURE_ALWAYS:
+            shouldCapture = true;
+            break;
+        case STACK_CAPTURE_WAITING:
+            // only the time the lock is held at the request counts, a request granted later is not captured then.
+            // A request on a free lock is granted at once, the lock may change hands before the request is queued
+            shouldCapture = lock->IsHeld() && lock->GetHeldMillis() >= value && !lock->CanAcquireLock(mode);
+            break;
+        default:
+            break;
+    }
+    if (!shouldCapture) {
+        return nullptr;
+    }
+    // saving the creation point (file, function and line) for future use
+    std::string stacktrace;
+    reinterpret_cast<NativeEngine *>(env)->BuildJsStackTrace(stacktrace);
+    return std::make_shared<const std::string>(std::move(stacktrace));
+}
+
+uint64_t LockRequest::GetCallSiteId(napi_env env, napi_ref cb)
+{
+    napi_value callback = NapiHelper::GetReferenceValue(env, cb);
+    if (callback == nullptr) {
+        return 0;
+    }
+    napi_value name = NapiHelper::GetNameProperty(env, callback, "name");
+    std::string callbackName = NapiHelper::IsString(env, name) ? NapiHelper::GetString(env, name) : "";
+    return std::hash<std::string> {}(callbackName);
+}
+
 void LockRequest::DeallocateTimeoutTimerCallback(uv_handle_t* handle)
 {
     delete handle;
@@ -98,7 +159,9 @@ void LockRequest::CallCallbackAsync()
 void LockRequest::CallCallback()
 {
     HITRACE_HELPER_METER_NAME("AsyncLock Callback, " + GetLockInfo());
-    RemoveEnvCleanupHook();
+    if (!isUncontended_) {
+        RemoveEnvCleanupHook();
+    }
     if (AbortIfNeeded()) {
         Release();
         lock_->CleanUpLockRequestOnCompletion(this);
@@ -290,6 +353,9 @@ void LockRequest::Release()
     CloseTimer();
     NAPI_CALL_RETURN_VOID(env_, napi_delete_reference(env_, callback_));
     callback_ = nullptr;
+    if (work_ == nullptr) {
+        return;
+    }
     NAPI_CALL_RETURN_VOID(env_, napi_delete_async_work(env_, work_));
     work_ = nullptr;
 }
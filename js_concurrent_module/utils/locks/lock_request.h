@@ -34,6 +34,17 @@ enum LockMode {
     LOCK_MODE_MAX
 };
 
+// When the creation stack of a lock request is captured for the lock dumps and the deadlock reports.
+// Building a JS stack is the costly part of a request, every request gets a cheap call site id instead, which is
+// the hash of the name of its callback.
+enum StackCaptureMode {
+    STACK_CAPTURE_OFF,
+    STACK_CAPTURE_SAMPLED,  // one request in N
+    STACK_CAPTURE_ALWAYS,
+    STACK_CAPTURE_WAITING,  // the requests made while the lock has been held for T ms or longer
+    STACK_CAPTURE_MAX
+};
+
 struct LockOptions {
     bool isAvailable = false;
     napi_ref signal = nullptr;
@@ -44,8 +55,20 @@ class AsyncLock;
 
 class LockRequest : public std::enable_shared_from_this<LockRequest> {
 public:
+    // An uncontended request is granted and called before lockAsync returns, so it skips the env cleanup hook,
+    // the timeout timer and the async work which only a waiting request needs.
     LockRequest(AsyncLock* lock, tid_t tid, napi_env env, napi_ref cb, LockMode mode, const LockOptions &options,
-        napi_deferred deferred);
+        napi_deferred deferred, uint64_t callSiteId, std::shared_ptr<const std::string> creationStacktrace,
+        bool isUncontended = false);
+
+    // value is N for STACK_CAPTURE_SAMPLED and T for STACK_CAPTURE_WAITING, the default policy is always, so the
+    // holders granted at once have their stacks too
+    static bool SetStackCapturePolicy(StackCaptureMode mode, uint32_t value);
+    // the same for the requests of one callback, it reads the callback name, so it is called before the lock mutex
+    static uint64_t GetCallSiteId(napi_env env, napi_ref cb);
+    // the creation stack of a new request on the lock as the policy asks, nullptr if it is not captured.
+    // It walks the JS stack, so it is called before the lock mutex is taken.
+    static std::shared_ptr<const std::string> CaptureStack(napi_env env, AsyncLock *lock, LockMode mode);
 
     std::weak_ptr<LockRequest> GetWeakPtr()
     {
@@ -57,7 +80,19 @@ public:
         return tid_;
     }
 
-    std::string GetCreationStacktrace()
+    uint64_t GetCallSiteId() const
+    {
+        return callSiteId_;
+    }
+
+    // the time a waiting request is queued at, 0 for an uncontended one
+    uint64_t GetCreationMillis() const
+    {
+        return creationMillis_;
+    }
+
+    // nullptr if the stack is not captured, the text is shared with the dumps instead of being copied
+    std::shared_ptr<const std::string> GetCreationStacktrace() const
     {
         return creationStacktrace_;
     }
@@ -103,7 +138,9 @@ private:
 
     AsyncLock* lock_;
     tid_t tid_;
-    std::string creationStacktrace_;
+    uint64_t callSiteId_;
+    uint64_t creationMillis_ {0};
+    std::shared_ptr<const std::string> creationStacktrace_ {};
     NativeEngine *engine_;
     napi_env env_;
     napi_ref callback_;
@@ -114,6 +151,11 @@ private:
     uv_timer_t *timeoutTimer_ {nullptr};
     uint64_t engineId_;
     std::atomic_bool envIsInvalid_ {false};
+    bool isUncontended_ {false};
+
+    // the mode in the high half and its value in the low half, so that they are changed together
+    static std::atomic<uint64_t> stackCapturePolicy_;
+    static std::atomic<uint32_t> sampleCount_;
 };
 
 }  // namespace Commonlibrary::Concurrent::LocksModule
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wait_for_graph.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace Commonlibrary::Concurrent::LocksModule {
+
+static bool operator<(const WaitEdge &lhs, const WaitEdge &rhs)
+{
+    return lhs.waiterTid < rhs.waiterTid || (lhs.waiterTid == rhs.waiterTid && lhs.holderTid < rhs.holderTid);
+}
+
+static bool operator==(const WaitEdge &lhs, const WaitEdge &rhs)
+{
+    return lhs.waiterTid == rhs.waiterTid && lhs.holderTid == rhs.holderTid;
+}
+
+WaitForGraph &WaitForGraph::GetInstance()
+{
+    static WaitForGraph graph;
+    return graph;
+}
+
+WaitCycle WaitForGraph::UpdateLock(const void *lock, const std::string &lockName, std::vector<WaitEdge> &&edges)
+{
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+        [](const WaitEdge &edge) { return edge.waiterTid == edge.holderTid; }), edges.end());
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::lock_guard<std::mutex> guard(graphMutex_);
+    std::vector<WaitEdge> oldEdges {};
+    auto iter = lockEdges_.find(lock);
+    if (iter != lockEdges_.end()) {
+        oldEdges = std::move(iter->second.edges);
+        lockEdges_.erase(iter);
+    }
+    // both are sorted, the edges kept by the lock are neither removed nor checked again
+    std::vector<WaitEdge> addedEdges {};
+    std::vector<WaitEdge> removedEdges {};
+    std::set_difference(edges.begin(), edges.end(), oldEdges.begin(), oldEdges.end(), std::back_inserter(addedEdges));
+    std::set_difference(oldEdges.begin(), oldEdges.end(), edges.begin(), edges.end(),
+                        std::back_inserter(removedEdges));
+    for (const WaitEdge &edge : removedEdges) {
+        RemoveEdgeUnsafe(lock, edge);
+    }
+    if (edges.empty()) {
+        return WaitCycle {};
+    }
+    lockEdges_.emplace(lock, LockEdges {lockName, std::move(edges)});
+    for (const WaitEdge &edge : addedEdges) {
+        AddEdgeUnsafe(lock, edge);
+    }
+    for (const WaitEdge &edge : addedEdges) {
+        // the new edge is the last one of the waiter with this lock and holder
+        const std::vector<Edge> &waiterEdges = waitsFor_[edge.waiterTid];
+        size_t index = waiterEdges.size();
+        while (index > 0 &&
+               (waiterEdges[index - 1].holderTid != edge.holderTid || waiterEdges[index - 1].lock != lock)) {
+            index--;
+        }
+        // the index of a step is one past the edge it follows
+        std::vector<SearchStep> path =
+            FindPathUnsafe({{edge.waiterTid, index}, {edge.holderTid, 0}}, edge.waiterTid);
+        if (!path.empty()) {
+            return CreateCycleUnsafe(path, 0);
+        }
+    }
+    return WaitCycle {};
+}
+
+WaitCycle WaitForGraph::FindCycle() const
+{
+    enum class Color : uint8_t { GREY, BLACK };
+    std::lock_guard<std::mutex> guard(graphMutex_);
+    // a vertex without a color is not visited yet
+    std::unordered_map<tid_t, Color> colors {};
+    for (const auto &[root, rootEdges] : waitsFor_) {
+        if (colors.find(root) != colors.end()) {
+            continue;
+        }
+        std::vector<SearchStep> path {{root, 0}};
+        colors[root] = Color::GREY;
+        while (!path.empty()) {
+            SearchStep &step = path.back();
+            auto iter = waitsFor_.find(step.tid);
+            if (iter == waitsFor_.end() || step.edgeIndex >= iter->second.size()) {
+                colors[step.tid] = Color::BLACK;
+                path.pop_back();
+                continue;
+            }
+            tid_t holderTid = iter->second[step.edgeIndex++].holderTid;
+            auto color = colors.find(holderTid);
+            if (color == colors.end()) {
+                colors[holderTid] = Color::GREY;
+                path.push_back({holderTid, 0});
+            } else if (color->second == Color::GREY) {
+                auto begin = std::find_if(path.begin(), path.end(),
+                    [holderTid](const SearchStep &pathStep) { return pathStep.tid == holderTid; });
+                return CreateCycleUnsafe(path, static_cast<size_t>(begin - path.begin()));
+            }
+        }
+    }
+    return WaitCycle {};
+}
+
+size_t WaitForGraph::GetEdgeNum() const
+{
+    std::lock_guard<std::mutex> guard(graphMutex_);
+    return edgeNum_;
+}
+
+void WaitForGraph::AddEdgeUnsafe(const void *lock, const WaitEdge &edge)
+{
+    waitsFor_[edge.waiterTid].push_back(Edge {edge.holderTid, lock});
+    edgeNum_++;
+}
+
+void WaitForGraph::RemoveEdgeUnsafe(const void *lock, const WaitEdge &edge)
+{
+    auto iter = waitsFor_.find(edge.waiterTid);
+    if (iter == waitsFor_.end()) {
+        return;
+    }
+    std::vector<Edge> &waiterEdges = iter->second;
+    for (size_t index = 0; index < waiterEdges.size(); index++) {
+        if (waiterEdges[index].holderTid == edge.holderTid && waiterEdges[index].lock == lock) {
+            waiterEdges[index] = waiterEdges.back();
+            waiterEdges.pop_back();
+            edgeNum_--;
+            break;
+        }
+    }
+    if (waiterEdges.empty()) {
+        waitsFor_.erase(iter);
+    }
+}
+
+std::vector<WaitForGraph::SearchStep> WaitForGraph::FindPathUnsafe(std::vector<SearchStep> &&path, tid_t to) const
+{
+    std::unordered_set<tid_t> visited {};
+    for (const SearchStep &step : path) {
+        visited.insert(step.tid);
+    }
+    // the first steps are given, only the last one is searched from
+    size_t baseSize = path.size() - 1;
+    while (path.size() > baseSize) {
+        SearchStep &step = path.back();
+        auto iter = waitsFor_.find(step.tid);
+        if (iter == waitsFor_.end() || step.edgeIndex >= iter->second.size()) {
+            path.pop_back();
+            continue;
+        }
+        tid_t holderTid = iter->second[step.edgeIndex++].holderTid;
+        if (holderTid == to) {
+            return std::move(path);
+        }
+        if (!visited.insert(holderTid).second) {
+            continue;
+        }
+        if (visited.size() > MAX_SEARCH_VERTICES) {
+            // too large to check online, a query still finds the cycle
+            break;
+        }
+        path.push_back({holderTid, 0});
+    }
+    return {};
+}
+
+WaitCycle WaitForGraph::CreateCycleUnsafe(const std::vector<SearchStep> &path, size_t begin) const
+{
+    WaitCycle cycle {};
+    for (size_t index = begin; index < path.size(); index++) {
+        const Edge &edge = waitsFor_.at(path[index].tid)[path[index].edgeIndex - 1];
+        cycle.tids.push_back(path[index].tid);
+        auto lockEdges = lockEdges_.find(edge.lock);
+        cycle.lockNames.push_back(lockEdges == lockEdges_.end() ? "" : lockEdges->second.lockName);
+    }
+    cycle.tids.push_back(path[begin].tid);
+    return cycle;
+}
+
+}  // namespace Commonlibrary::Concurrent::LocksModule
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JS_CONCURRENT_MODULE_UTILS_LOCKS_WAIT_FOR_GRAPH_H
+#define JS_CONCURRENT_MODULE_UTILS_LOCKS_WAIT_FOR_GRAPH_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+
+namespace Commonlibrary::Concurrent::LocksModule {
+
+// tids[i] waits for tids[i + 1] through the lock lockNames[i], the last tid is the first one again
+struct WaitCycle {
+    std::vector<tid_t> tids;
+    std::vector<std::string> lockNames;
+    bool IsEmpty() const
+    {
+        return tids.empty();
+    }
+};
+
+struct WaitEdge {
+    tid_t waiterTid;
+    tid_t holderTid;
+};
+
+// The wait-for graph of the threads using async locks, an edge runs from a thread with a pending request to a
+// thread holding the same lock. Every lock owns the edges of its own requests and replaces them whenever its
+// holders or waiters change, so the graph is always up to date and a query does not rebuild it.
+// The edges of a vertex are kept in a vector, the graph takes O(V + E) memory.
+// A new edge closes a cycle only if its holder already reaches its waiter, which is checked at once by a search
+// from the holder bounded by MAX_SEARCH_VERTICES.
+// A thread waiting for a lock held by itself is normal for async callbacks, such an edge is not added. A callback
+// awaiting its own nested request is only shown by the lock dump of the request timeout.
+class WaitForGraph {
+public:
+    static WaitForGraph &GetInstance();
+
+    WaitForGraph() = default;
+    ~WaitForGraph() = default;
+
+    // replaces the edges of the lock, returns the first cycle closed by one of the new edges
+    WaitCycle UpdateLock(const void *lock, const std::string &lockName, std::vector<WaitEdge> &&edges);
+    WaitCycle FindCycle() const;
+    size_t GetEdgeNum() const;
+
+private:
+    WaitForGraph(const WaitForGraph &) = delete;
+    WaitForGraph &operator=(const WaitForGraph &) = delete;
+    WaitForGraph(WaitForGraph &&) = delete;
+    WaitForGraph &operator=(WaitForGraph &&) = delete;
+
+    static constexpr size_t MAX_SEARCH_VERTICES = 1024; // 1024: far more threads than a process runs JS on
+
+    struct Edge {
+        tid_t holderTid;
+        const void *lock;
+    };
+
+    struct LockEdges {
+        std::string lockName;
+        std::vector<WaitEdge> edges;
+    };
+
+    struct SearchStep {
+        tid_t tid;
+        size_t edgeIndex;  // one past the edge of tid the search follows
+    };
+
+    void AddEdgeUnsafe(const void *lock, const WaitEdge &edge);
+    void RemoveEdgeUnsafe(const void *lock, const WaitEdge &edge);
+    // searches on from the last step of path, returns the path whose last step has an edge to `to`, or nothing
+    std::vector<SearchStep> FindPathUnsafe(std::vector<SearchStep> &&path, tid_t to) const;
+    WaitCycle CreateCycleUnsafe(const std::vector<SearchStep> &path, size_t begin) const;
+
+    // <waiter tid, the edges to its holders>
+    std::unordered_map<tid_t, std::vector<Edge>> waitsFor_ {};
+    std::unordered_map<const void *, LockEdges> lockEdges_ {};
+    size_t edgeNum_ = 0;
+    mutable std::mutex graphMutex_;
+};
+
+}  // namespace Commonlibrary::Concurrent::LocksModule
+#endif  // JS_CONCURRENT_MODULE_UTILS_LOCKS_WAIT_FOR_GRAPH_H
@@ -15,16 +15,22 @@
 #include <unistd.h>
 #include <sys/syscall.h>
 
+#include <chrono>
 #include <ctime>
+#include <functional>
 #include <latch>
+#include <numeric>
 #include <thread>
 #include <gtest/gtest.h>
 
 #include "ark_native_engine.h"
 #include "locks/async_lock.h"
 #include "locks/async_lock_manager.h"
+#include "locks/deadlock_helpers.h"
 #include "locks/lock_request.h"
+#include "locks/wait_for_graph.h"
 #include "test/unittest/common/test_common.h"
+#include "tools/log.h"
 
 using namespace Commonlibrary::Concurrent::LocksModule;
 
@@ -139,6 +145,13 @@ public:
         nanosleep(&ts, nullptr);
     }
 
+    // AsyncLock.request(name) on the engine of the calling thread
+    static napi_status RequestLock(napi_value name, napi_value &lock)
+    {
+        napi_value args[1] {name};
+        return napi_call_function(GetEnv(), undefined_, asyncLockRequest_, 1, args, &lock);
+    }
+
 protected:
     static thread_local NativeEngine *engine_;
     static thread_local EcmaVM *vm_;
@@ -728,3 +741,365 @@ TEST_F(LocksTest, PendingSharedRequestAfterGC)
     Loop(LOOP_ONCE);
     ASSERT_EQ(callbackData.callCount, 2U);
 }
+
+struct NestedLockData {
+    AsyncLock *lock = nullptr;
+    uint32_t callCount = 0;
+    uint32_t callCountAfterNestedLock = 0;
+};
+
+static napi_value NestedLockCb(napi_env env, napi_callback_info info)
+{
+    NestedLockData *data = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, reinterpret_cast<void **>(&data));
+    data->callCount += 1;
+    if (data->callCount == 1) {
+        // the lock is held by this callback, so the nested request has to wait
+        napi_value callback;
+        napi_create_function(env, "nestedlock", NAPI_AUTO_LENGTH, NestedLockCb, data, &callback);
+        napi_ref callbackRef;
+        napi_create_reference(env, callback, 1, &callbackRef);
+        LockOptions options;
+        data->lock->LockAsync(env, callbackRef, LOCK_MODE_EXCLUSIVE, options);
+        data->callCountAfterNestedLock = data->callCount;
+    }
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+TEST_F(LocksTest, UncontendedExclusiveLock)
+{
+    napi_env env = GetEnv();
+    std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+    NestedLockData data;
+    data.lock = lock.get();
+    napi_value callback = CreateFunction("uncontendedexclusivelock", NestedLockCb, &data);
+    napi_ref callbackRef;
+    napi_create_reference(env, callback, 1, &callbackRef);
+
+    LockOptions options;
+    napi_value result = lock->LockAsync(env, callbackRef, LOCK_MODE_EXCLUSIVE, options);
+    bool isPromise = false;
+    napi_is_promise(env, result, &isPromise);
+    ASSERT_TRUE(isPromise);
+    // the free lock is granted and the callback is called before lockAsync returns
+    ASSERT_EQ(data.callCount, 1U);
+    ASSERT_EQ(data.callCountAfterNestedLock, 1U);
+    LoopUntil([&data] () { return data.callCount == 2U; });
+    ASSERT_TRUE(lock->GetSatisfiedRequestInfos().empty());
+    ASSERT_TRUE(lock->GetPendingRequestInfos().empty());
+}
+
+static napi_value CountingCb(napi_env env, napi_callback_info info)
+{
+    uint32_t *callCount = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, reinterpret_cast<void **>(&callCount));
+    *callCount += 1;
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+TEST_F(LocksTest, UncontendedLockBenchmark)
+{
+    // 1M uncontended lock/unlock cycles, each is granted, called and released within lockAsync
+    constexpr uint32_t cycleNum = 1000000;
+    napi_env env = GetEnv();
+    std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+    uint32_t callCount = 0;
+    napi_value callback = CreateFunction("uncontendedlockbenchmark", CountingCb, &callCount);
+    LockOptions options;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < cycleNum; i++) {
+        napi_handle_scope scope;
+        napi_open_handle_scope(env, &scope);
+        napi_ref callbackRef;
+        napi_create_reference(env, callback, 1, &callbackRef);
+        lock->LockAsync(env, callbackRef, i % 2 == 0 ? LOCK_MODE_EXCLUSIVE : LOCK_MODE_SHARED, options);
+        napi_close_handle_scope(env, scope);
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    HILOG_INFO("AsyncLock uncontended benchmark, cycles: %{public}u, cost: %{public}lld us",
+        cycleNum, static_cast<long long>(cost.count()));
+    ASSERT_EQ(callCount, cycleNum);
+    ASSERT_TRUE(lock->GetSatisfiedRequestInfos().empty());
+}
+
+struct StackCaptureData {
+    AsyncLock *lock = nullptr;
+    std::vector<RequestCreationInfo> heldInfos {};
+};
+
+static napi_value StackCaptureCb(napi_env env, napi_callback_info info)
+{
+    StackCaptureData *data = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, reinterpret_cast<void **>(&data));
+    data->heldInfos = data->lock->GetSatisfiedRequestInfos();
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+// takes the free lock once, returns the creation info the request has while it holds the lock
+static RequestCreationInfo TakeLockOnce(napi_env env, AsyncLock *lock)
+{
+    StackCaptureData data;
+    data.lock = lock;
+    napi_value callback;
+    napi_create_function(env, "stackcapture", NAPI_AUTO_LENGTH, StackCaptureCb, &data, &callback);
+    napi_ref callbackRef;
+    napi_create_reference(env, callback, 1, &callbackRef);
+    LockOptions options;
+    lock->LockAsync(env, callbackRef, LOCK_MODE_EXCLUSIVE, options);
+    EXPECT_EQ(data.heldInfos.size(), 1U);
+    return data.heldInfos.empty() ? RequestCreationInfo {} : data.heldInfos[0];
+}
+
+TEST_F(LocksTest, StackCapturePolicy)
+{
+    napi_env env = GetEnv();
+    std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+    ASSERT_FALSE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_SAMPLED, 0));
+    ASSERT_FALSE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_MAX, 0));
+
+    // by default a holder granted at once has its stack too
+    RequestCreationInfo first = TakeLockOnce(env, lock.get());
+    ASSERT_NE(first.creationStacktrace, nullptr);
+
+    // the requests of one callback have one call site id
+    ASSERT_TRUE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_OFF, 0));
+    RequestCreationInfo second = TakeLockOnce(env, lock.get());
+    ASSERT_EQ(second.creationStacktrace, nullptr);
+    ASSERT_EQ(second.callSiteId, first.callSiteId);
+
+    // 2: one request in two
+    ASSERT_TRUE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_SAMPLED, 2));
+    uint32_t capturedNum = 0;
+    for (uint32_t i = 0; i < 4U; i++) {
+        if (TakeLockOnce(env, lock.get()).creationStacktrace != nullptr) {
+            capturedNum++;
+        }
+    }
+    ASSERT_EQ(capturedNum, 2U);
+    ASSERT_TRUE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_ALWAYS, 0));
+
+    // a request without the stack is reported by its call site id
+    std::vector<AsyncLockDependency> dependencies;
+    dependencies.push_back(AsyncLockDependency {INVALID_TID, 1, "lock", second.callSiteId, nullptr});
+    std::string message = CreateFullLockInfosMessage(1, std::move(dependencies), DeadlockInfo {});
+    ASSERT_NE(message.find("call site #" + std::to_string(second.callSiteId)), std::string::npos);
+}
+
+TEST_F(LocksTest, WaitingStackCapture)
+{
+    napi_env env = GetEnv();
+    std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+    LockOptions options;
+    // 60000: the lock is never held that long, so the waiting request does not capture its stack
+    for (uint32_t heldMillis : {0U, 60000U}) {
+        ASSERT_TRUE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_WAITING, heldMillis));
+        NestedLockData data;
+        data.lock = lock.get();
+        napi_value callback = CreateFunction("waitingstackcapture", NestedLockCb, &data);
+        napi_ref callbackRef;
+        napi_create_reference(env, callback, 1, &callbackRef);
+        lock->LockAsync(env, callbackRef, LOCK_MODE_EXCLUSIVE, options);
+        // the nested request has waited and now holds the lock, its callback is not called yet
+        std::vector<RequestCreationInfo> heldInfos = lock->GetSatisfiedRequestInfos();
+        ASSERT_EQ(heldInfos.size(), 1U);
+        ASSERT_EQ(heldInfos[0].creationStacktrace != nullptr, heldMillis == 0);
+        LoopUntil([&data] () { return data.callCount == 2U; });
+    }
+    ASSERT_TRUE(LockRequest::SetStackCapturePolicy(STACK_CAPTURE_ALWAYS, 0));
+}
+
+struct GrantOrderData {
+    std::string *order = nullptr;
+    char name = 0;
+    // called while the request holds the lock
+    std::function<void()> onGranted {};
+};
+
+static napi_value GrantOrderCb(napi_env env, napi_callback_info info)
+{
+    GrantOrderData *data = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, nullptr, reinterpret_cast<void **>(&data));
+    data->order->push_back(data->name);
+    if (data->onGranted) {
+        data->onGranted();
+    }
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+static void RequestInOrder(AsyncLock *lock, LockMode mode, GrantOrderData &data)
+{
+    napi_env env = LocksTest::GetEnv();
+    napi_value callback;
+    napi_create_function(env, "grantorder", NAPI_AUTO_LENGTH, GrantOrderCb, &data, &callback);
+    napi_ref callbackRef;
+    napi_create_reference(env, callback, 1, &callbackRef);
+    LockOptions options;
+    lock->LockAsync(env, callbackRef, mode, options);
+}
+
+TEST_F(LocksTest, LockPolicyGrantOrder)
+{
+    napi_env env = GetEnv();
+    // X holds the lock exclusively while A (shared), B (exclusive) and C (shared) are queued,
+    // A asks for the shared lock D again while it holds the lock
+    std::vector<std::pair<LockPolicy, std::string>> expectedOrders {
+        {LOCK_POLICY_FIFO, "XABCD"},
+        {LOCK_POLICY_READER_PREFERRING, "XADCB"},
+        {LOCK_POLICY_WRITER_PREFERRING, "XBADC"},
+        {LOCK_POLICY_PHASE_FAIR, "XACBD"},
+    };
+    for (const auto &[policy, expectedOrder] : expectedOrders) {
+        std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+        lock->SetPolicy(env, policy);
+        std::string order;
+        GrantOrderData d {&order, 'D'};
+        GrantOrderData c {&order, 'C'};
+        GrantOrderData b {&order, 'B'};
+        GrantOrderData a {&order, 'A', [&lock, &d] () { RequestInOrder(lock.get(), LOCK_MODE_SHARED, d); }};
+        GrantOrderData x {&order, 'X', [&lock, &a, &b, &c] () {
+            RequestInOrder(lock.get(), LOCK_MODE_SHARED, a);
+            RequestInOrder(lock.get(), LOCK_MODE_EXCLUSIVE, b);
+            RequestInOrder(lock.get(), LOCK_MODE_SHARED, c);
+        }};
+        RequestInOrder(lock.get(), LOCK_MODE_EXCLUSIVE, x);
+        LoopUntil([&lock] () {
+            return lock->GetSatisfiedRequestInfos().empty() && lock->GetPendingRequestInfos().empty();
+        });
+        ASSERT_EQ(order, expectedOrder);
+
+        AsyncLock::WaitHistogram sharedWaits = lock->GetWaitHistogram(LOCK_MODE_SHARED);
+        AsyncLock::WaitHistogram exclusiveWaits = lock->GetWaitHistogram(LOCK_MODE_EXCLUSIVE);
+        ASSERT_EQ(std::accumulate(sharedWaits.begin(), sharedWaits.end(), uint64_t {0}), 3U);
+        ASSERT_EQ(std::accumulate(exclusiveWaits.begin(), exclusiveWaits.end(), uint64_t {0}), 2U);
+        // X is granted without waiting
+        ASSERT_GE(exclusiveWaits[0], 1U);
+    }
+}
+
+TEST_F(LocksTest, WaitForGraphCycle)
+{
+    WaitForGraph graph;
+    int lockA = 0;
+    int lockB = 0;
+    int lockC = 0;
+    // 1 and 3 wait for 2 on lock a, a thread waiting for itself adds no edge
+    ASSERT_TRUE(graph.UpdateLock(&lockA, "a", {{1, 2}, {1, 1}, {3, 2}}).IsEmpty());
+    ASSERT_EQ(graph.GetEdgeNum(), 2U);
+    // 2 waits for 3 on lock b, the new edge closes 2 -> 3 -> 2 at once
+    WaitCycle cycle = graph.UpdateLock(&lockB, "b", {{2, 3}});
+    ASSERT_EQ(cycle.tids, (std::vector<tid_t> {2, 3, 2}));
+    ASSERT_EQ(cycle.lockNames, (std::vector<std::string> {"b", "a"}));
+    ASSERT_FALSE(graph.FindCycle().IsEmpty());
+    std::string warning = CreateDeadlockWarningMessage(std::move(cycle));
+    ASSERT_NE(warning.find("TID 2 <-- lock {a} -- WAITED BY TID 3 <-- lock {b} -- WAITED BY TID 2"),
+              std::string::npos);
+
+    // 3 gets the lock a, the cycle is gone
+    ASSERT_TRUE(graph.UpdateLock(&lockA, "a", {{1, 2}}).IsEmpty());
+    ASSERT_TRUE(graph.FindCycle().IsEmpty());
+    cycle = graph.UpdateLock(&lockC, "c", {{3, 1}});
+    ASSERT_EQ(cycle.tids, (std::vector<tid_t> {3, 1, 2, 3}));
+
+    ASSERT_TRUE(graph.UpdateLock(&lockA, "a", {}).IsEmpty());
+    ASSERT_TRUE(graph.UpdateLock(&lockB, "b", {}).IsEmpty());
+    ASSERT_TRUE(graph.UpdateLock(&lockC, "c", {}).IsEmpty());
+    ASSERT_EQ(graph.GetEdgeNum(), 0U);
+    ASSERT_TRUE(graph.FindCycle().IsEmpty());
+}
+
+TEST_F(LocksTest, NestedExclusiveNoCycle)
+{
+    // the callback holding the lock exclusively requests it again without awaiting it, which is not a deadlock
+    napi_env env = GetEnv();
+    std::unique_ptr<AsyncLock> lock = std::make_unique<AsyncLock>(1);
+    NestedLockData data;
+    data.lock = lock.get();
+    napi_value callback = CreateFunction("nestedexclusivenocycle", NestedLockCb, &data);
+    napi_ref callbackRef;
+    napi_create_reference(env, callback, 1, &callbackRef);
+    LockOptions options;
+    lock->LockAsync(env, callbackRef, LOCK_MODE_EXCLUSIVE, options);
+    ASSERT_EQ(data.callCount, 1U);
+    ASSERT_TRUE(WaitForGraph::GetInstance().FindCycle().IsEmpty());
+    LoopUntil([&data] () { return data.callCount == 2U; });
+    ASSERT_TRUE(WaitForGraph::GetInstance().FindCycle().IsEmpty());
+}
+
+TEST_F(LocksTest, WaitForGraphLongChain)
+{
+    // 2000: a chain longer than the online search goes, only the full search finds the cycle closing it
+    constexpr tid_t chainLength = 2000;
+    WaitForGraph graph;
+    std::vector<int> locks(chainLength);
+    for (tid_t i = 0; i + 1 < chainLength; i++) {
+        ASSERT_TRUE(graph.UpdateLock(&locks[i], "chain", {{i + 1, i + 2}}).IsEmpty());
+    }
+    ASSERT_TRUE(graph.FindCycle().IsEmpty());
+    graph.UpdateLock(&locks[chainLength - 1], "chain", {{chainLength, 1}});
+    ASSERT_EQ(graph.FindCycle().tids.size(), chainLength + 1);
+    ASSERT_EQ(graph.GetEdgeNum(), chainLength);
+}
+
+static uint32_t RequestDistinctLocks(uint32_t threadIndex, uint32_t requestNum, std::latch &start, std::latch &done)
+{
+    napi_env env = LocksTest::GetEnv();
+    uint32_t lockNum = 0;
+    start.wait();
+    for (uint32_t i = 0; i < requestNum; i++) {
+        napi_handle_scope scope;
+        napi_open_handle_scope(env, &scope);
+        std::string name = "registry-" + std::to_string(threadIndex) + "-" + std::to_string(i);
+        napi_value lockName;
+        napi_create_string_utf8(env, name.c_str(), NAPI_AUTO_LENGTH, &lockName);
+        napi_value lock;
+        if (LocksTest::RequestLock(lockName, lock) == napi_ok) {
+            lockNum++;
+        }
+        napi_close_handle_scope(env, scope);
+    }
+    done.count_down();
+    return lockNum;
+}
+
+TEST_F(LocksTest, LockRegistryScaling)
+{
+    // 2000: requests of distinct names per thread, the threads only meet in the registry
+    constexpr uint32_t requestNum = 2000;
+    for (uint32_t threadNum : {1U, 2U, 4U, 8U, 16U}) {
+        std::latch ready(threadNum);
+        std::latch start(1);
+        std::latch done(threadNum);
+        std::vector<uint32_t> lockNums(threadNum, 0);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadNum; t++) {
+            threads.emplace_back([t, threadNum, &ready, &start, &done, &lockNums]() {
+                LocksTest::InitializeEngine();
+                ready.count_down();
+                lockNums[t] = RequestDistinctLocks(threadNum * 100 + t, requestNum, start, done); // 100: > threads
+                LocksTest::TriggerGC();
+                LocksTest::DestroyEngine();
+            });
+        }
+        ready.wait();
+        auto begin = std::chrono::steady_clock::now();
+        start.count_down();
+        done.wait();
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        HILOG_INFO("AsyncLock registry benchmark, threads: %{public}u, requests: %{public}u, cost: %{public}lld us",
+            threadNum, threadNum * requestNum, static_cast<long long>(cost.count()));
+        for (uint32_t lockNum : lockNums) {
+            ASSERT_EQ(lockNum, requestNum);
+        }
+    }
+}
@@ -17,20 +17,23 @@
 #include "tools/log.h"
 
 namespace Commonlibrary::Concurrent::WorkerModule {
-void MessageQueue::Enqueue(MessageDataType data)
+void MessageQueue::Enqueue(MessageDataType data, bool isBatch)
 {
     std::lock_guard<std::mutex> lock(queueLock_);
-    queue_.push_back(data);
+    queue_.push_back({data, isBatch});
 }
 
-bool MessageQueue::Dequeue(MessageDataType *data)
+bool MessageQueue::Dequeue(MessageDataType *data, bool *isBatch)
 {
     std::unique_lock<std::mutex> lock(queueLock_);
     if (queue_.empty()) {
         return false;
     }
     if (data != nullptr) {
-        *data = queue_.front();
+        *data = queue_.front().data;
+        if (isBatch != nullptr) {
+            *isBatch = queue_.front().isBatch;
+        }
         queue_.pop_front();
     } else {
         HILOG_ERROR("worker:: data is nullptr.");
@@ -48,7 +51,7 @@ void MessageQueue::Clear(napi_env env)
     std::lock_guard<std::mutex> lock(queueLock_);
     size_t size = queue_.size();
     for (size_t i = 0; i < size; i++) {
-        MessageDataType data = queue_.front();
+        MessageDataType data = queue_.front().data;
         napi_delete_serialization_data(env, data);
         queue_.pop_front();
     }
@@ -57,7 +60,7 @@ void MessageQueue::Clear(napi_env env)
 void MessageQueue::EnqueueFront(MessageDataType data)
 {
     std::lock_guard<std::mutex> lock(queueLock_);
-    queue_.push_front(data);
+    queue_.push_front({data, false});
 }
 
 bool MessageQueue::Peekqueue(MessageDataType *data)
@@ -67,7 +70,7 @@ bool MessageQueue::Peekqueue(MessageDataType *data)
         return false;
     }
     if (data != nullptr) {
-        *data = queue_.front();
+        *data = queue_.front().data;
         return true;
     }
     return false;
@@ -106,4 +109,116 @@ void MarkedMessageQueue::Clear(napi_env env)
         queue_.pop();
     }
 }
+
+RingMessageQueue::RingMessageQueue()
+{
+    head_ = new Segment();
+    tail_ = head_;
+}
+
+RingMessageQueue::~RingMessageQueue()
+{
+    while (head_ != nullptr) {
+        Segment* next = head_->next.load(std::memory_order_relaxed);
+        delete head_;
+        head_ = next;
+    }
+    for (auto& segment : spareSegments_) {
+        delete segment.exchange(nullptr, std::memory_order_relaxed);
+    }
+}
+
+RingMessageQueue::Segment* RingMessageQueue::AllocSegment()
+{
+    for (auto& spare : spareSegments_) {
+        Segment* segment = spare.exchange(nullptr, std::memory_order_acquire);
+        if (segment != nullptr) {
+            return segment;
+        }
+    }
+    return new Segment();
+}
+
+void RingMessageQueue::RecycleSegment(Segment* segment)
+{
+    segment->next.store(nullptr, std::memory_order_relaxed);
+    for (auto& spare : spareSegments_) {
+        Segment* expected = nullptr;
+        if (spare.compare_exchange_strong(expected, segment, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+    delete segment;
+}
+
+void RingMessageQueue::Enqueue(MessageDataType data, bool isBatch)
+{
+    if (tailIndex_ == SEGMENT_SIZE) {
+        Segment* segment = AllocSegment();
+        tail_->next.store(segment, std::memory_order_release);
+        tail_ = segment;
+        tailIndex_ = 0;
+    }
+    tail_->slots[tailIndex_++] = {data, isBatch};
+    // publishes the slot, and the link to a new segment, to the consumer
+    enqueueNum_.store(enqueueNum_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void RingMessageQueue::DiscardPending(napi_env env)
+{
+    discardEnv_.store(env, std::memory_order_relaxed);
+    discardNum_.store(enqueueNum_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+bool RingMessageQueue::Dequeue(MessageDataType *data, bool *isBatch)
+{
+    while (true) {
+        uint64_t num = dequeueNum_.load(std::memory_order_relaxed);
+        if (num == enqueueNum_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (headIndex_ == SEGMENT_SIZE) {
+            // the producer links the next segment before it publishes the first message in it
+            Segment* next = head_->next.load(std::memory_order_acquire);
+            RecycleSegment(head_);
+            head_ = next;
+            headIndex_ = 0;
+        }
+        MessageEntry message = head_->slots[headIndex_++];
+        dequeueNum_.store(num + 1, std::memory_order_release);
+        if (message.data != nullptr && num < discardNum_.load(std::memory_order_acquire)) {
+            napi_delete_serialization_data(discardEnv_.load(std::memory_order_relaxed), message.data);
+            continue;
+        }
+        if (data != nullptr) {
+            *data = message.data;
+            if (isBatch != nullptr) {
+                *isBatch = message.isBatch;
+            }
+        } else {
+            HILOG_ERROR("worker:: data is nullptr.");
+        }
+        return true;
+    }
+}
+
+void RingMessageQueue::Clear(napi_env env)
+{
+    MessageDataType data = nullptr;
+    while (Dequeue(&data)) {
+        napi_delete_serialization_data(env, data);
+    }
+}
+
+bool RingMessageQueue::IsEmpty() const
+{
+    return GetSize() == 0;
+}
+
+size_t RingMessageQueue::GetSize() const
+{
+    // dequeueNum_ first, it never passes the enqueueNum_ read after it
+    uint64_t dequeueNum = dequeueNum_.load(std::memory_order_acquire);
+    return static_cast<size_t>(enqueueNum_.load(std::memory_order_acquire) - dequeueNum);
+}
 }  // namespace Commonlibrary::Concurrent::WorkerModule
@@ -16,6 +16,9 @@
 #ifndef JS_CONCURRENT_MODULE_WORKER_MESSAGE_QUEUE_H
 #define JS_CONCURRENT_MODULE_WORKER_MESSAGE_QUEUE_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <mutex>
 #include <queue>
@@ -24,11 +27,18 @@
 
 namespace Commonlibrary::Concurrent::WorkerModule {
 using MessageDataType = void*;
+
+// a queued message, postMessages posts an array of messages as one batch message
+struct MessageEntry {
+    MessageDataType data {nullptr};
+    bool isBatch {false};
+};
+
 class MessageQueue final {
 public:
-    void Enqueue(MessageDataType data);
+    void Enqueue(MessageDataType data, bool isBatch = false);
     void EnqueueFront(MessageDataType data);
-    bool Dequeue(MessageDataType *data);
+    bool Dequeue(MessageDataType *data, bool *isBatch = nullptr);
     bool Peekqueue(MessageDataType *data);
     bool IsEmpty() const;
     void Clear(napi_env env);
@@ -39,7 +49,7 @@ public:
 
 private:
     std::mutex queueLock_;
-    std::deque<MessageDataType> queue_;
+    std::deque<MessageEntry> queue_;
 };
 
 class MarkedMessageQueue final {
@@ -59,5 +69,56 @@ private:
     std::mutex queueLock_;
     std::queue<std::pair<uint32_t, MessageDataType>> queue_;
 };
+
+// A queue from one producer thread to one consumer thread without a lock on either side.
+// The messages are written into segments of SEGMENT_SIZE slots. A producer that fills its segment links a new
+// one, and the consumer hands a segment it has read through back to the producer, so the segments go round like
+// a ring and only a burst longer than the free segments allocates.
+// Enqueue and DiscardPending belong to the producer, Dequeue and Clear to the consumer, IsEmpty and GetSize may
+// be called on any thread.
+class RingMessageQueue final {
+public:
+    RingMessageQueue();
+    ~RingMessageQueue();
+
+    void Enqueue(MessageDataType data, bool isBatch = false);
+    // the messages enqueued so far are deleted by the consumer instead of being dequeued, the close signals stay
+    void DiscardPending(napi_env env);
+    bool Dequeue(MessageDataType *data, bool *isBatch = nullptr);
+    void Clear(napi_env env);
+    bool IsEmpty() const;
+    size_t GetSize() const;
+
+private:
+    RingMessageQueue(const RingMessageQueue &) = delete;
+    RingMessageQueue& operator=(const RingMessageQueue &) = delete;
+    RingMessageQueue(RingMessageQueue &&) = delete;
+    RingMessageQueue& operator=(RingMessageQueue &&) = delete;
+
+    static constexpr uint32_t SEGMENT_SIZE = 256; // 256: 4 KB of slots on 64-bit
+    static constexpr uint32_t SPARE_SEGMENT_NUM = 2; // 2: the segments kept for reuse when the queue drains
+    static constexpr size_t CACHE_LINE_SIZE = 64; // 64: the producer and consumer fields do not share a line
+
+    struct Segment {
+        std::array<MessageEntry, SEGMENT_SIZE> slots {};
+        std::atomic<Segment*> next {nullptr};
+    };
+
+    Segment* AllocSegment();
+    void RecycleSegment(Segment* segment);
+
+    // producer
+    alignas(CACHE_LINE_SIZE) Segment* tail_ = nullptr;
+    uint32_t tailIndex_ = 0;
+    std::atomic<uint64_t> enqueueNum_ {0};
+    // consumer
+    alignas(CACHE_LINE_SIZE) Segment* head_ = nullptr;
+    uint32_t headIndex_ = 0;
+    std::atomic<uint64_t> dequeueNum_ {0};
+    // the messages before discardNum_ are deleted with discardEnv_
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> discardNum_ {0};
+    std::atomic<napi_env> discardEnv_ {nullptr};
+    std::array<std::atomic<Segment*>, SPARE_SEGMENT_NUM> spareSegments_ {};
+};
 }  // namespace Commonlibrary::Concurrent::WorkerModule
 #endif // JS_CONCURRENT_MODULE_WORKER_MESSAGE_QUEUE_H
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 #include <uv.h>
@@ -1225,6 +1226,48 @@ public:
         napi_create_runtime(env, &workerEnv);
         worker->workerEnv_ = workerEnv;
     }
+
+    static void InitHostMessageQueue(Worker* worker)
+    {
+        worker->InitHostMessageQueue();
+    }
+
+    static size_t GetMessageNum(Worker* worker, bool toHost)
+    {
+        if (toHost) {
+            return worker->hostMessageAtFrontQueue_[WorkerEventPriority::HIGH]->GetSize();
+        }
+        return worker->workerMessageQueue_.GetSize();
+    }
+
+    static MessageEntry DequeueWorkerMessage(Worker* worker)
+    {
+        MessageEntry entry {};
+        worker->workerMessageQueue_.Dequeue(&entry.data, &entry.isBatch);
+        return entry;
+    }
+
+    // onmessage of the host counts the messages and sums their data
+    static void SetMessageCounterRef(Worker* worker, napi_env env, uint32_t* counter)
+    {
+        auto func = [](napi_env env, napi_callback_info info) -> napi_value {
+            size_t argc = 1;
+            napi_value event = nullptr;
+            void* data = nullptr;
+            napi_get_cb_info(env, info, &argc, &event, nullptr, &data);
+            uint32_t* counter = static_cast<uint32_t*>(data);
+            uint32_t value = 0;
+            napi_get_value_uint32(env, NapiHelper::GetNameProperty(env, event, "data"), &value);
+            counter[0]++;
+            counter[1] += value;
+            return nullptr;
+        };
+        napi_value funcValue = nullptr;
+        napi_create_function(env, "onmessage", NAPI_AUTO_LENGTH, func, counter, &funcValue);
+        napi_value obj = NapiHelper::CreateObject(env);
+        napi_set_named_property(env, obj, "onmessage", funcValue);
+        worker->workerRef_ = NapiHelper::CreateReference(env, obj, 1);
+    }
 protected:
     static thread_local NativeEngine *engine_;
     static thread_local EcmaVM *vm_;
@@ -1992,6 +2035,40 @@ HWTEST_F(WorkersTest, MessageQueueTest002, testing::ext::TestSize.Level0)
     queue.Clear(env);
 }
 
+//messageQueue and ringMessageQueue keep the batch flag of a message next to its data
+HWTEST_F(WorkersTest, MessageQueueTest003, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    MessageDataType batchData = nullptr;
+    MessageDataType singleData = nullptr;
+    napi_serialize_inner(env, undefined, undefined, undefined, false, true, &batchData);
+    napi_serialize_inner(env, undefined, undefined, undefined, false, true, &singleData);
+    MessageQueue queue;
+    queue.Enqueue(batchData, true);
+    queue.EnqueueFront(singleData);
+    MessageDataType data = nullptr;
+    bool isBatch = true;
+    ASSERT_TRUE(queue.Dequeue(&data, &isBatch));
+    ASSERT_EQ(data, singleData);
+    ASSERT_FALSE(isBatch);
+    ASSERT_TRUE(queue.Dequeue(&data, &isBatch));
+    ASSERT_EQ(data, batchData);
+    ASSERT_TRUE(isBatch);
+
+    RingMessageQueue ringQueue;
+    ringQueue.Enqueue(batchData, true);
+    ringQueue.Enqueue(singleData);
+    ASSERT_TRUE(ringQueue.Dequeue(&data, &isBatch));
+    ASSERT_EQ(data, batchData);
+    ASSERT_TRUE(isBatch);
+    ASSERT_TRUE(ringQueue.Dequeue(&data, &isBatch));
+    ASSERT_EQ(data, singleData);
+    ASSERT_FALSE(isBatch);
+    napi_delete_serialization_data(env, batchData);
+    napi_delete_serialization_data(env, singleData);
+}
+
 //messageQueue MARKEDMESSAGEQUEUE
 HWTEST_F(WorkersTest, MarkedMessageQueue001, testing::ext::TestSize.Level0)
 {
@@ -2013,6 +2090,182 @@ HWTEST_F(WorkersTest, MarkedMessageQueue001, testing::ext::TestSize.Level0)
     ASSERT_TRUE(queue.IsEmpty());
 }
 
+//ringMessageQueue FIFO across segments
+HWTEST_F(WorkersTest, RingMessageQueue001, testing::ext::TestSize.Level0)
+{
+    RingMessageQueue queue;
+    ASSERT_TRUE(queue.IsEmpty());
+    MessageDataType data = nullptr;
+    ASSERT_FALSE(queue.Dequeue(&data));
+    constexpr uintptr_t count = 1000; // 1000: spans a few segments
+    for (uintptr_t round = 0; round < 2; round++) { // 2: the second round reuses the spare segments
+        for (uintptr_t i = 1; i <= count; i++) {
+            queue.Enqueue(reinterpret_cast<MessageDataType>(i));
+        }
+        ASSERT_EQ(queue.GetSize(), count);
+        for (uintptr_t i = 1; i <= count; i++) {
+            ASSERT_TRUE(queue.Dequeue(&data));
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(data), i);
+        }
+        ASSERT_TRUE(queue.IsEmpty());
+        ASSERT_FALSE(queue.Dequeue(&data));
+    }
+    queue.Enqueue(nullptr);
+    ASSERT_TRUE(queue.Dequeue(nullptr));
+    ASSERT_TRUE(queue.IsEmpty());
+}
+
+//ringMessageQueue DiscardPending keeps the close signal and later messages
+HWTEST_F(WorkersTest, RingMessageQueue002, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    RingMessageQueue queue;
+    napi_value undefined = NapiHelper::GetUndefinedValue(env);
+    MessageDataType data = nullptr;
+    for (int i = 0; i < NUM_10; i++) {
+        napi_serialize_inner(env, undefined, undefined, undefined, false, true, &data);
+        queue.Enqueue(data);
+    }
+    queue.Enqueue(nullptr);
+    queue.DiscardPending(env);
+    MessageDataType kept = nullptr;
+    napi_serialize_inner(env, undefined, undefined, undefined, false, true, &kept);
+    queue.Enqueue(kept);
+    ASSERT_EQ(queue.GetSize(), static_cast<size_t>(NUM_10 + 2)); // 2: the close signal and kept
+    ASSERT_TRUE(queue.Dequeue(&data));
+    ASSERT_EQ(data, nullptr);
+    ASSERT_TRUE(queue.Dequeue(&data));
+    ASSERT_EQ(data, kept);
+    ASSERT_TRUE(queue.IsEmpty());
+    queue.Enqueue(data);
+    queue.Clear(env);
+    ASSERT_TRUE(queue.IsEmpty());
+}
+
+template<typename Queue>
+static long long MessageQueueThroughput(Queue& queue, uintptr_t count, bool& isOrdered)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::thread consumer([&queue, count, &isOrdered] {
+        uintptr_t expected = 1;
+        MessageDataType data = nullptr;
+        while (expected <= count) {
+            if (!queue.Dequeue(&data)) {
+                std::this_thread::yield();
+                continue;
+            }
+            isOrdered = isOrdered && reinterpret_cast<uintptr_t>(data) == expected;
+            expected++;
+        }
+    });
+    for (uintptr_t i = 1; i <= count; i++) {
+        queue.Enqueue(reinterpret_cast<MessageDataType>(i));
+    }
+    consumer.join();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+//ringMessageQueue benchmark, millions of small messages from one thread to another against the mutex deque
+HWTEST_F(WorkersTest, RingMessageQueue003, testing::ext::TestSize.Level0)
+{
+    constexpr uintptr_t count = 2000000; // 2000000: small postMessage calls
+    bool isOrdered = true;
+    RingMessageQueue ringQueue;
+    long long ringCost = MessageQueueThroughput(ringQueue, count, isOrdered);
+    ASSERT_TRUE(isOrdered);
+    ASSERT_TRUE(ringQueue.IsEmpty());
+    MessageQueue mutexQueue;
+    long long mutexCost = MessageQueueThroughput(mutexQueue, count, isOrdered);
+    ASSERT_TRUE(isOrdered);
+    ASSERT_TRUE(mutexQueue.IsEmpty());
+    HILOG_INFO("worker:: message queue benchmark, messages:%{public}zu, ring:%{public}lld us, mutex:%{public}lld us",
+        static_cast<size_t>(count), ringCost, mutexCost);
+}
+
+static napi_value CreateUint32Array(napi_env env, uint32_t length)
+{
+    napi_value array = nullptr;
+    napi_create_array_with_length(env, length, &array);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value value = nullptr;
+        napi_create_uint32(env, i + 1, &value);
+        napi_set_element(env, array, i, value);
+    }
+    return array;
+}
+
+//worker postMessages, the array goes to the worker as one message
+HWTEST_F(WorkersTest, PostMessagesTest001, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    Worker* worker = new Worker(env, nullptr);
+    napi_value thisVar = NapiHelper::CreateObject(env);
+    napi_wrap(env, thisVar, worker, [](napi_env env, void* data, void* hint) {}, nullptr, nullptr);
+    napi_value cb = nullptr;
+    napi_create_function(env, "postMessages", NAPI_AUTO_LENGTH, Worker::PostMessages, nullptr, &cb);
+
+    napi_value result = nullptr;
+    napi_value argv[1] = { nullptr };
+    napi_create_string_utf8(env, "host", NAPI_AUTO_LENGTH, &argv[0]);
+    napi_call_function(env, thisVar, cb, 1, argv, &result);
+    ASSERT_TRUE(NapiHelper::IsExceptionPending(env));
+    napi_value exception = nullptr;
+    napi_get_and_clear_last_exception(env, &exception);
+
+    argv[0] = CreateUint32Array(env, 0);
+    napi_call_function(env, thisVar, cb, 1, argv, &result);
+    ASSERT_EQ(GetMessageNum(worker, false), 0);
+
+    constexpr uint32_t messageNum = 3; // 3: messages in the batch
+    argv[0] = CreateUint32Array(env, messageNum);
+    napi_call_function(env, thisVar, cb, 1, argv, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    ASSERT_EQ(GetMessageNum(worker, false), 1);
+    MessageEntry entry = DequeueWorkerMessage(worker);
+    ASSERT_TRUE(entry.isBatch);
+    napi_value messages = nullptr;
+    ASSERT_EQ(napi_deserialize(env, entry.data, &messages), napi_ok);
+    napi_delete_serialization_data(env, entry.data);
+    ASSERT_EQ(NapiHelper::GetArrayLength(env, messages), messageNum);
+    uint32_t last = 0;
+    napi_get_value_uint32(env, NapiHelper::GetElement(env, messages, messageNum - 1), &last);
+    ASSERT_EQ(last, messageNum);
+
+    void* unwrapped = nullptr;
+    napi_remove_wrap(env, thisVar, &unwrapped);
+    delete worker;
+}
+
+//worker postMessages to host, one message in the queue and an onmessage event per element
+HWTEST_F(WorkersTest, PostMessagesTest002, testing::ext::TestSize.Level0)
+{
+    napi_env env = (napi_env)engine_;
+    Worker* worker = new Worker(env, nullptr);
+    InitHostMessageQueue(worker);
+    SetMainThread(worker, false);
+    UpdateWorkerState(worker, Worker::RunnerState::RUNNING);
+    uint32_t counter[2] = { 0, 0 }; // 2: the number and the sum of the messages
+    SetMessageCounterRef(worker, env, counter);
+    napi_value cb = nullptr;
+    napi_create_function(env, "postMessages", NAPI_AUTO_LENGTH, Worker::PostMessagesToHost, worker, &cb);
+
+    constexpr uint32_t messageNum = 100; // 100: messages in the batch
+    napi_value result = nullptr;
+    napi_value argv[1] = { CreateUint32Array(env, messageNum) };
+    napi_value global = nullptr;
+    napi_get_global(env, &global);
+    napi_call_function(env, global, cb, 1, argv, &result);
+    ASSERT_FALSE(NapiHelper::IsExceptionPending(env));
+    ASSERT_EQ(GetMessageNum(worker, true), 1);
+    HostOnMessageInner(worker, WorkerEventPriority::HIGH);
+    ASSERT_EQ(GetMessageNum(worker, true), 0);
+    ASSERT_EQ(counter[0], messageNum);
+    ASSERT_EQ(counter[1], messageNum * (messageNum + 1) / 2); // 2: the sum of 1 to messageNum
+
+    UpdateWorkerState(worker, Worker::RunnerState::TERMINATED);
+    delete worker;
+}
+
 HWTEST_F(WorkersTest, WorkerTest001, testing::ext::TestSize.Level0)
 {
     napi_env env = (napi_env)engine_;
@@ -98,6 +98,7 @@ napi_value Worker::InitWorker(napi_env env, napi_value exports)
     napi_property_descriptor properties[] = {
         DECLARE_NAPI_FUNCTION("postMessage", PostMessage),
         DECLARE_NAPI_FUNCTION("postMessageWithSharedSendable", PostMessageWithSharedSendable),
+        DECLARE_NAPI_FUNCTION("postMessages", PostMessages),
         DECLARE_NAPI_FUNCTION("terminate", Terminate),
         DECLARE_NAPI_FUNCTION("on", On),
         DECLARE_NAPI_FUNCTION("registerGlobalCallObject", RegisterGlobalCallObject),
@@ -216,6 +217,7 @@ napi_value Worker::InitPort(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION_WITH_DATA("postMessage", PostMessageToHost, worker),
         DECLARE_NAPI_FUNCTION_WITH_DATA("postMessageWithSharedSendable", PostMessageWithSharedSendableToHost, worker),
         DECLARE_NAPI_FUNCTION_WITH_DATA("postMessageAtFront", PostMessageAtFrontToHost, worker),
+        DECLARE_NAPI_FUNCTION_WITH_DATA("postMessages", PostMessagesToHost, worker),
         DECLARE_NAPI_FUNCTION_WITH_DATA("callGlobalCallObjectMethod", GlobalCall, worker),
         DECLARE_NAPI_FUNCTION_WITH_DATA("close", CloseWorker, worker),
         DECLARE_NAPI_FUNCTION_WITH_DATA("cancelTasks", ParentPortCancelTask, worker),
@@ -612,7 +614,13 @@ napi_value Worker::PostMessageWithSharedSendable(napi_env env, napi_callback_inf
     return CommonPostMessage(env, cbinfo, false);
 }
 
-napi_value Worker::CommonPostMessage(napi_env env, napi_callback_info cbinfo, bool cloneSendable)
+napi_value Worker::PostMessages(napi_env env, napi_callback_info cbinfo)
+{
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    return CommonPostMessage(env, cbinfo, true, true);
+}
+
+napi_value Worker::CommonPostMessage(napi_env env, napi_callback_info cbinfo, bool cloneSendable, bool isBatch)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
     size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
@@ -632,6 +640,13 @@ napi_value Worker::CommonPostMessage(napi_env env, napi_callback_info cbinfo, bo
         WorkerThrowError(env, ErrorHelper::ERR_WORKER_NOT_RUNNING, "maybe worker is terminated when PostMessage");
         return nullptr;
     }
+    if (isBatch && !NapiHelper::IsArray(env, argv[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of messages must be an array.");
+        return nullptr;
+    }
+    if (isBatch && NapiHelper::GetArrayLength(env, argv[0]) == 0) {
+        return NapiHelper::GetUndefinedValue(env);
+    }
 
     MessageDataType data = nullptr;
     napi_status serializeStatus = napi_ok;
@@ -681,7 +696,8 @@ napi_value Worker::CommonPostMessage(napi_env env, napi_callback_info cbinfo, bo
         WorkerThrowError(env, ErrorHelper::ERR_WORKER_SERIALIZATION, serializeErr.c_str());
         return nullptr;
     }
-    worker->PostMessageInner(data);
+    // the array is serialized as one message, the receiver dispatches its elements
+    worker->PostMessageInner(data, isBatch);
     return NapiHelper::GetUndefinedValue(env);
 }
 
@@ -1020,7 +1036,13 @@ napi_value Worker::PostMessageWithSharedSendableToHost(napi_env env, napi_callba
     return CommonPostMessageToHost(env, cbinfo, false);
 }
 
-napi_value Worker::CommonPostMessageToHost(napi_env env, napi_callback_info cbinfo, bool cloneSendable)
+napi_value Worker::PostMessagesToHost(napi_env env, napi_callback_info cbinfo)
+{
+    HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
+    return CommonPostMessageToHost(env, cbinfo, true, true);
+}
+
+napi_value Worker::CommonPostMessageToHost(napi_env env, napi_callback_info cbinfo, bool cloneSendable, bool isBatch)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
     size_t argc = NapiHelper::GetCallbackInfoArgc(env, cbinfo);
@@ -1044,6 +1066,13 @@ napi_value Worker::CommonPostMessageToHost(napi_env env, napi_callback_info cbin
         HILOG_DEBUG("worker:: when post message to host occur worker is not in running.");
         return nullptr;
     }
+    if (isBatch && !NapiHelper::IsArray(env, argv[0])) {
+        ErrorHelper::ThrowError(env, ErrorHelper::TYPE_ERROR, "the type of messages must be an array.");
+        return nullptr;
+    }
+    if (isBatch && NapiHelper::GetArrayLength(env, argv[0]) == 0) {
+        return NapiHelper::GetUndefinedValue(env);
+    }
 
     MessageDataType data = nullptr;
     napi_status serializeStatus = napi_ok;
@@ -1094,7 +1123,7 @@ napi_value Worker::CommonPostMessageToHost(napi_env env, napi_callback_info cbin
         WorkerThrowError(env, ErrorHelper::ERR_WORKER_SERIALIZATION, serializeErr.c_str());
         return nullptr;
     }
-    worker->PostMessageToHostInner(data);
+    worker->PostMessageToHostInner(data, isBatch);
     return NapiHelper::GetUndefinedValue(env);
 }
 
@@ -1795,7 +1824,8 @@ void Worker::HostOnMessageInner(WorkerEventPriority priority)
     bool isCallable = NapiHelper::IsCallable(hostEnv_, callback);
 
     MessageDataType data = nullptr;
-    while (hostMessageAtFrontQueue_[priority]->Dequeue(&data)) {
+    bool isBatch = false;
+    while (hostMessageAtFrontQueue_[priority]->Dequeue(&data, &isBatch)) {
         // receive close signal.
         if (data == nullptr) {
             HILOG_DEBUG("worker:: worker received close signal");
@@ -1823,17 +1853,16 @@ void Worker::HostOnMessageInner(WorkerEventPriority priority)
             HostOnMessageErrorInner();
             continue;
         }
-        napi_value event = nullptr;
-        napi_create_object(hostEnv_, &event);
-        napi_set_named_property(hostEnv_, event, "data", result);
-        napi_value argv[1] = { event };
-        if (isCallable) {
-            napi_value callbackResult = nullptr;
-            napi_call_function(hostEnv_, obj, callback, 1, argv, &callbackResult);
+        if (!isBatch) {
+            HostDispatchMessage(obj, callback, isCallable, result);
+        } else {
+            // the messages of postMessages
+            uint32_t length = NapiHelper::GetArrayLength(hostEnv_, result);
+            for (uint32_t i = 0; i < length && !HostIsStop(); i++) {
+                HandleScope messageScope(hostEnv_, status);
+                HostDispatchMessage(obj, callback, isCallable, NapiHelper::GetElement(hostEnv_, result, i));
+            }
         }
-        // handle listeners.
-        HandleEventListeners(hostEnv_, obj, 1, argv, "message");
-        HandleHostException();
 #if defined(ENABLE_WORKER_EVENTHANDLER)
         if (isMainThreadWorker_ && !isLimitedWorker_) {
             auto handler = OHOS::AppExecFwk::EventHandler::Current();
@@ -1847,6 +1876,21 @@ void Worker::HostOnMessageInner(WorkerEventPriority priority)
     }
 }
 
+void Worker::HostDispatchMessage(napi_value obj, napi_value callback, bool isCallable, napi_value message)
+{
+    napi_value event = nullptr;
+    napi_create_object(hostEnv_, &event);
+    napi_set_named_property(hostEnv_, event, "data", message);
+    napi_value argv[1] = { event };
+    if (isCallable) {
+        napi_value callbackResult = nullptr;
+        napi_call_function(hostEnv_, obj, callback, 1, argv, &callbackResult);
+    }
+    // handle listeners.
+    HandleEventListeners(hostEnv_, obj, 1, argv, "message");
+    HandleHostException();
+}
+
 void Worker::HostOnGlobalCall(const uv_async_t* req)
 {
     HITRACE_HELPER_METER_NAME(__PRETTY_FUNCTION__);
@@ -2162,13 +2206,13 @@ void Worker::HostOnErrorInner()
     }
 }
 
-void Worker::PostMessageInner(MessageDataType data)
+void Worker::PostMessageInner(MessageDataType data, bool isBatch)
 {
     if (IsTerminated()) {
         HILOG_DEBUG("worker:: worker has been terminated when PostMessageInner.");
         return;
     }
-    workerMessageQueue_.Enqueue(data);
+    workerMessageQueue_.Enqueue(data, isBatch);
     std::lock_guard<std::mutex> lock(workerOnmessageMutex_);
     if (data == nullptr) {
         HILOG_INFO("worker:: host post nullptr to worker.");
@@ -2422,7 +2466,8 @@ void Worker::WorkerOnMessageInner()
         return;
     }
     MessageDataType data = nullptr;
-    while (!IsTerminated() && workerMessageQueue_.Dequeue(&data)) {
+    bool isBatch = false;
+    while (!IsTerminated() && workerMessageQueue_.Dequeue(&data, &isBatch)) {
         AsyncStackScope asyncStackScope(this);
         if (data == nullptr) {
             HILOG_DEBUG("worker:: worker reveive terminate signal");
@@ -2452,19 +2497,32 @@ void Worker::WorkerOnMessageInner()
             WorkerOnMessageErrorInner();
             continue;
         }
-
-        napi_value event = nullptr;
-        napi_create_object(workerEnv_, &event);
-        napi_set_named_property(workerEnv_, event, "data", result);
-        napi_value argv[1] = { event };
-        CallWorkerFunction(1, argv, "onmessage", true);
-
-        napi_value obj = NapiHelper::GetReferenceValue(workerEnv_, this->workerPort_);
-        ParentPortHandleEventListeners(workerEnv_, obj, 1, argv, "message", true);
+        if (!isBatch) {
+            WorkerDispatchMessage(result);
+            continue;
+        }
+        // the messages of postMessages, a close() in onmessage stops the rest
+        uint32_t length = NapiHelper::GetArrayLength(workerEnv_, result);
+        for (uint32_t i = 0; i < length && !IsTerminated(); i++) {
+            HandleScope messageScope(workerEnv_, status);
+            WorkerDispatchMessage(NapiHelper::GetElement(workerEnv_, result, i));
+        }
     }
     napi_close_handle_scope(workerEnv_, scope);
 }
 
+void Worker::WorkerDispatchMessage(napi_value message)
+{
+    napi_value event = nullptr;
+    napi_create_object(workerEnv_, &event);
+    napi_set_named_property(workerEnv_, event, "data", message);
+    napi_value argv[1] = { event };
+    CallWorkerFunction(1, argv, "onmessage", true);
+
+    napi_value obj = NapiHelper::GetReferenceValue(workerEnv_, this->workerPort_);
+    ParentPortHandleEventListeners(workerEnv_, obj, 1, argv, "message", true);
+}
+
 bool Worker::HandleEventListeners(napi_env env, napi_value recv, size_t argc, const napi_value* argv, const char* type)
 {
     std::string listener(type);
@@ -2574,11 +2632,11 @@ void Worker::WorkerOnMessageErrorInner()
     ParentPortHandleEventListeners(workerEnv_, obj, 0, nullptr, "messageerror", true);
 }
 
-void Worker::PostMessageToHostInner(MessageDataType data)
+void Worker::PostMessageToHostInner(MessageDataType data, bool isBatch)
 {
     std::lock_guard<std::recursive_mutex> lock(liveStatusLock_);
     if (hostEnv_ != nullptr && !HostIsStop() && !isHostEnvExited_) {
-        hostMessageAtFrontQueue_[WorkerEventPriority::HIGH]->Enqueue(data);
+        hostMessageAtFrontQueue_[WorkerEventPriority::HIGH]->Enqueue(data, isBatch);
 #if defined(ENABLE_WORKER_EVENTHANDLER)
         if (isMainThreadWorker_ && !isLimitedWorker_) {
             PostWorkerMessageTask();
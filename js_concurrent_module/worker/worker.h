@@ -186,13 +186,23 @@ public:
     */
     static napi_value PostMessageWithSharedSendable(napi_env env, napi_callback_info cbinfo);
 
+    /**
+    * Post an array of messages with one serialization and one wakeup, each is an onmessage event on the worker.
+    *
+    * @param env NAPI environment parameters.
+    * @param thisVar The callback information of the js layer.
+    */
+    static napi_value PostMessages(napi_env env, napi_callback_info cbinfo);
+
     /**
     * postMessage implementation
     *
     * @param env NAPI environment parameters.
     * @param thisVar The callback information of the js layer.
+    * @param isBatch The message is an array of messages from postMessages.
     */
-    static napi_value CommonPostMessage(napi_env env, napi_callback_info cbinfo, bool cloneSendable);
+    static napi_value CommonPostMessage(napi_env env, napi_callback_info cbinfo, bool cloneSendable,
+                                        bool isBatch = false);
 
     /**
      * Add event listeners to host.
@@ -210,13 +220,23 @@ public:
     */
     static napi_value PostMessageWithSharedSendableToHost(napi_env env, napi_callback_info cbinfo);
 
+    /**
+    * Post an array of messages with one serialization and one wakeup, each is an onmessage event on the host.
+    *
+    * @param env NAPI environment parameters.
+    * @param thisVar The callback information of the js layer.
+    */
+    static napi_value PostMessagesToHost(napi_env env, napi_callback_info cbinfo);
+
     /**
     * postMessage implementation
     *
     * @param env NAPI environment parameters.
     * @param thisVar The callback information of the js layer.
+    * @param isBatch The message is an array of messages from postMessages.
     */
-    static napi_value CommonPostMessageToHost(napi_env env, napi_callback_info cbinfo, bool cloneSendable);
+    static napi_value CommonPostMessageToHost(napi_env env, napi_callback_info cbinfo, bool cloneSendable,
+                                              bool isBatch = false);
 
     /**
      * Post a message and insert it into the queue header.
@@ -494,7 +514,8 @@ public:
     bool ClearWorkerTasks()
     {
         if (hostEnv_ != nullptr) {
-            workerMessageQueue_.Clear(hostEnv_);
+            // the host is the producer, the worker deletes the messages when it comes to them
+            workerMessageQueue_.DiscardPending(hostEnv_);
             return true;
         }
         return false;
@@ -561,7 +582,9 @@ public:
 
 private:
     void WorkerOnMessageInner();
+    void WorkerDispatchMessage(napi_value message);
     void HostOnMessageInner(WorkerEventPriority priority = WorkerEventPriority::HIGH);
+    void HostDispatchMessage(napi_value obj, napi_value callback, bool isCallable, napi_value message);
     void HostOnErrorInner();
     void HostOnAllErrorsInner();
     void HostOnMessageErrorInner();
@@ -581,8 +604,8 @@ private:
                                         const napi_value* argv, const char* type, bool tryCatch);
     void TerminateInner();
 
-    void PostMessageInner(MessageDataType data);
-    void PostMessageToHostInner(MessageDataType data);
+    void PostMessageInner(MessageDataType data, bool isBatch = false);
+    void PostMessageToHostInner(MessageDataType data, bool isBatch = false);
 
     void TerminateWorker();
 
@@ -653,12 +676,13 @@ private:
     bool isRelativePath_ {false};
     int32_t scopeId_ {-1};
 
-    MessageQueue workerMessageQueue_ {};
+    // host to worker, and the errors of the worker to host, each has a single producer thread
+    RingMessageQueue workerMessageQueue_ {};
     std::mutex globalCallMutex_;
     MarkedMessageQueue hostGlobalCallQueue_ {};
     MessageQueue workerGlobalCallQueue_ {};
-    MessageQueue errorQueue_ {};
-    MessageQueue exceptionQueue_ {};
+    RingMessageQueue errorQueue_ {};
+    RingMessageQueue exceptionQueue_ {};
     std::atomic<bool> workerOnMessageInitState_ {false};
     std::atomic<bool> workerOnTerminateInitState_ {false};
 